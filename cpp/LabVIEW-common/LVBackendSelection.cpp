@@ -0,0 +1,110 @@
+#include "LVBackendSelection.h"
+#include "LVException.h"
+
+#include <algorithm>
+#include <cstdio>
+
+// svm_type and kernel_type values of libsvm (identical in the sparse and dense versions)
+static const int32_t LVSvmTypeCSVC = 0;
+static const int32_t LVSvmTypeEpsilonSVR = 3;
+static const int32_t LVKernelLinear = 0;
+static const int32_t LVKernelPrecomputed = 4;
+
+// Formats a number for the reasons (printf is sufficient, the reason is informative only)
+static std::string LVFormatNumber(const char *format, double value) {
+	char buffer[64];
+	snprintf(buffer, sizeof(buffer), format, value);
+	return buffer;
+}
+
+LVBackendChoice LVSelectBackend(const LVProblemProfile &profile, int32_t svmType, int32_t kernelType) {
+	LVBackendChoice choice;
+
+	if (kernelType == LVKernelPrecomputed) {
+		choice.backend = LVBackend::Sparse;
+		choice.reason = "precomputed kernel (the sample serial number at index 0 requires the sparse layout)";
+		return choice;
+	}
+
+	if (kernelType == LVKernelLinear && (svmType == LVSvmTypeCSVC || svmType == LVSvmTypeEpsilonSVR)
+		&& (profile.n_features >= LVBackendLinearMinFeatures || profile.l >= LVBackendLinearMinSamples)) {
+		choice.backend = LVBackend::Linear;
+		choice.reason = "linear kernel with " + std::to_string(profile.l) + " samples and " + std::to_string(profile.n_features)
+			+ " features (at least " + std::to_string(LVBackendLinearMinSamples) + " samples or " + std::to_string(LVBackendLinearMinFeatures)
+			+ " features), liblinear trains without kernel evaluations";
+		return choice;
+	}
+
+	double denseBytes = static_cast<double>(profile.l) * static_cast<double>(profile.n_features) * sizeof(double);
+	std::string densityText = "density " + LVFormatNumber("%.3g", profile.density);
+
+	if (profile.density >= LVBackendDenseMinDensity) {
+		if (denseBytes <= static_cast<double>(LVBackendDenseMaxBytes)) {
+			choice.backend = LVBackend::Dense;
+			choice.reason = densityText + " (at least " + LVFormatNumber("%.3g", LVBackendDenseMinDensity)
+				+ "), dense kernel evaluations are faster than merging sparse vectors";
+		}
+		else {
+			choice.backend = LVBackend::Sparse;
+			choice.reason = densityText + ", but the dense problem would need " + LVFormatNumber("%.0f", denseBytes / (1 << 20))
+				+ " MB (more than " + std::to_string(LVBackendDenseMaxBytes >> 20) + " MB)";
+		}
+		return choice;
+	}
+
+	choice.backend = LVBackend::Sparse;
+	choice.reason = densityText + " (less than " + LVFormatNumber("%.3g", LVBackendDenseMinDensity) + "), sparse kernel evaluations skip the zeros";
+	return choice;
+}
+
+bool LVCheckBackend(int32_t backend) {
+	if (backend == -1)
+		return false;
+
+	if (backend < static_cast<int32_t>(LVBackend::Sparse) || backend > static_cast<int32_t>(LVBackend::Linear))
+		throw LVException(__FILE__, __LINE__, "Invalid engine (-1: automatic, 0: libsvm, 1: libsvm-dense, 2: liblinear).");
+
+	return true;
+}
+
+const char * LVBackendName(LVBackend backend) {
+	switch (backend) {
+	case LVBackend::Sparse:
+		return "libsvm";
+	case LVBackend::Dense:
+		return "libsvm-dense";
+	case LVBackend::Linear:
+		return "liblinear";
+	}
+	return "unknown";
+}
+
+void LVFinishProfile(LVProblemProfile &profile) {
+	double cells = static_cast<double>(profile.l) * static_cast<double>(profile.n_features);
+	profile.density = (cells > 0) ? static_cast<double>(profile.nnz) / cells : 0.0;
+}
+
+LVProblemProfile LVProfileDense(const LVArray_Hdl<LVArray_Hdl<double>> x_in) {
+	LVProblemProfile profile = {};
+	profile.l = (*x_in)->dimSize;
+	profile.n_features = LVDenseMaxLength(x_in);
+
+	size_t l = (*x_in)->dimSize;
+	const LVArray_Hdl<double> *x = (*x_in)->elt;
+
+	size_t nThreads = LVThreadCount(l, 256);
+	std::vector<uint64_t> nnz(nThreads, 0);
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			const double *values = (*x[i])->elt;
+			size_t n = (*x[i])->dimSize;
+			nnz[t] += n - static_cast<size_t>(std::count(values, values + n, 0.0));
+		}
+	});
+
+	for (uint64_t n : nnz)
+		profile.nnz += n;
+
+	LVFinishProfile(profile);
+	return profile;
+}
@@ -0,0 +1,93 @@
+/// <summary>
+/// Selection of the library (engine) that trains a problem fastest.
+/// The problem is profiled (samples, features, stored values) and the choice is made from the profile,
+/// the svm type and the kernel type, following the recommendations of the libsvm/liblinear authors:
+///		- linear kernels on many features or samples are trained by liblinear (no kernel evaluations)
+///		- kernels on dense data are evaluated faster by libsvm-dense (no index merging)
+///		- sparse data, very large dense copies and precomputed kernels stay with libsvm
+/// </summary>
+
+#ifndef LVBACKENDSELECTION_H_
+#define LVBACKENDSELECTION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LVTypeDecl.h"
+#include "LVParallel.h"
+#include "LVProblemConversion.h"
+
+/// <summary> Engines (values passed to/from LabVIEW). </summary>
+enum class LVBackend : int32_t {
+	Sparse = 0,		//!< LabVIEW-libsvm
+	Dense = 1,		//!< LabVIEW-libsvm-dense
+	Linear = 2		//!< LabVIEW-liblinear
+};
+
+// Thresholds of the selection
+const size_t LVBackendLinearMinFeatures = 1000;				// Linear kernels with at least this many features are trained by liblinear
+const size_t LVBackendLinearMinSamples = 20000;				// Linear kernels with at least this many samples are trained by liblinear
+const double LVBackendDenseMinDensity = 0.5;				// Fraction of stored values above which dense kernel evaluations are faster
+const uint64_t LVBackendDenseMaxBytes = uint64_t(1) << 30;	// Largest dense copy of a sparse problem
+
+/// <summary> Profile of a problem (LabVIEW cluster). </summary>
+struct LVProblemProfile {
+	uint64_t l;				//!< Number of samples.
+	uint64_t n_features;	//!< Largest feature index (number of columns of dense problems), bias excluded.
+	uint64_t nnz;			//!< Number of stored nonzero values, bias excluded.
+	double density;			//!< nnz / (l * n_features).
+};
+
+/// <summary> Selected engine and a description of why it was selected. </summary>
+struct LVBackendChoice {
+	LVBackend backend;
+	std::string reason;
+};
+
+/// <summary> Selects the engine for a problem, svmType and kernelType are the libsvm values (svm_parameter). </summary>
+LVBackendChoice LVSelectBackend(const LVProblemProfile &profile, int32_t svmType, int32_t kernelType);
+
+/// <summary> Returns true if an engine is requested, false for -1 (automatic selection). Throws LVException if invalid. </summary>
+bool LVCheckBackend(int32_t backend);
+
+/// <summary> Name of an engine, as used in the reasons. </summary>
+const char * LVBackendName(LVBackend backend);
+
+/// <summary> Computes the density of a profile with l, n_features and nnz set. </summary>
+void LVFinishProfile(LVProblemProfile &profile);
+
+/// <summary> Profiles sparse vectors (validated as by LVSparseMaxIndex), the bias feature is excluded if hasBias. </summary>
+template<class Node>
+LVProblemProfile LVProfileSparse(const LVArray_Hdl<LVArray_Hdl<Node>> x_in, bool hasBias) {
+	LVProblemProfile profile = {};
+	profile.l = (*x_in)->dimSize;
+	profile.n_features = static_cast<uint64_t>(LVSparseMaxIndex(x_in, hasBias));
+
+	size_t l = (*x_in)->dimSize;
+	const LVArray_Hdl<Node> *x = (*x_in)->elt;
+	size_t nExcluded = hasBias ? 2 : 1;
+
+	size_t nThreads = LVThreadCount(l, 1024);
+	std::vector<uint64_t> nnz(nThreads, 0);
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			const Node *xi = (*x[i])->elt;
+			size_t n = (*x[i])->dimSize - nExcluded;
+			for (size_t k = 0; k < n; k++)
+				nnz[t] += (xi[k].value != 0) ? 1 : 0;
+		}
+	});
+
+	for (uint64_t n : nnz)
+		profile.nnz += n;
+
+	LVFinishProfile(profile);
+	return profile;
+}
+
+/// <summary> Profiles dense vectors (the number of features is the length of the longest vector). </summary>
+LVProblemProfile LVProfileDense(const LVArray_Hdl<LVArray_Hdl<double>> x_in);
+
+#endif // LVBACKENDSELECTION_H_
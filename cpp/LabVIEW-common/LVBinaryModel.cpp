@@ -0,0 +1,225 @@
+#include "LVBinaryModel.h"
+#include "LVException.h"
+#include "LVUtility.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <errno.h>
+
+static const char LVBinaryMagic[8] = { 'L', 'V', 'S', 'V', 'M', 'B', 'I', 'N' };
+
+// Rounds offset up to the next multiple of LVBinaryAlignment
+static inline uint64_t LVBinaryAlign(uint64_t offset) {
+	return (offset + LVBinaryAlignment - 1) / LVBinaryAlignment * LVBinaryAlignment;
+}
+
+//
+//-- Writer
+//
+
+LVBinaryWriter::LVBinaryWriter(LVBinaryKind kind) : m_kind(kind) {}
+
+void LVBinaryWriter::addSection(uint32_t id, size_t eltSize, const void *data, size_t count) {
+	beginSection(id, eltSize);
+	if (data != nullptr && count > 0)
+		appendChunk(data, count);
+}
+
+void LVBinaryWriter::beginSection(uint32_t id, size_t eltSize) {
+	if (eltSize == 0)
+		throw LVException(__FILE__, __LINE__, "Binary model: section element size must be nonzero.");
+
+	PendingSection section;
+	section.desc.id = id;
+	section.desc.eltSize = static_cast<uint32_t>(eltSize);
+	section.desc.offset = 0;
+	section.desc.count = 0;
+	m_sections.push_back(section);
+}
+
+void LVBinaryWriter::appendChunk(const void *data, size_t count) {
+	if (m_sections.empty())
+		throw LVException(__FILE__, __LINE__, "Binary model: appendChunk called before beginSection.");
+
+	if (count == 0)
+		return;
+
+	PendingSection &section = m_sections.back();
+	Chunk chunk = { data, count * section.desc.eltSize };
+	section.chunks.push_back(chunk);
+	section.desc.count += count;
+}
+
+void LVBinaryWriter::layout(LVBinaryHeader &header, std::vector<LVBinarySection> &table) const {
+	std::memcpy(header.magic, LVBinaryMagic, sizeof(header.magic));
+	header.version = LVBinaryVersion;
+	header.kind = static_cast<uint32_t>(m_kind);
+	header.byteOrder = LVBinaryByteOrderMark;
+	header.nSections = static_cast<uint32_t>(m_sections.size());
+
+	table.clear();
+	uint64_t offset = sizeof(LVBinaryHeader) + m_sections.size() * sizeof(LVBinarySection);
+	for (const PendingSection &section : m_sections) {
+		LVBinarySection desc = section.desc;
+		offset = LVBinaryAlign(offset);
+		desc.offset = offset;
+		offset += desc.count * desc.eltSize;
+		table.push_back(desc);
+	}
+
+	header.fileSize = offset;
+}
+
+size_t LVBinaryWriter::size() const {
+	LVBinaryHeader header;
+	std::vector<LVBinarySection> table;
+	layout(header, table);
+	return static_cast<size_t>(header.fileSize);
+}
+
+void LVBinaryWriter::writeBuffer(char *dst) const {
+	LVBinaryHeader header;
+	std::vector<LVBinarySection> table;
+	layout(header, table);
+
+	std::memcpy(dst, &header, sizeof(header));
+	if (!table.empty())
+		std::memcpy(dst + sizeof(header), table.data(), table.size() * sizeof(LVBinarySection));
+
+	uint64_t pos = sizeof(header) + table.size() * sizeof(LVBinarySection);
+	for (size_t i = 0; i < m_sections.size(); i++) {
+		// Zero the alignment padding to keep the output deterministic
+		std::memset(dst + pos, 0, static_cast<size_t>(table[i].offset - pos));
+		pos = table[i].offset;
+
+		for (const Chunk &chunk : m_sections[i].chunks) {
+			std::memcpy(dst + pos, chunk.data, chunk.bytes);
+			pos += chunk.bytes;
+		}
+	}
+}
+
+void LVBinaryWriter::writeFile(const char *path) const {
+	LVBinaryHeader header;
+	std::vector<LVBinarySection> table;
+	layout(header, table);
+
+	errno = 0;
+	std::unique_ptr<FILE, int(*)(FILE*)> fp(fopen(path, "wb"), fclose);
+	if (!fp)
+		throw LVException(__FILE__, __LINE__, "Binary model: unable to open file for writing (" + LVErrnoString(errno) + ").");
+
+	static const char zeros[LVBinaryAlignment] = { 0 };
+	bool ok = fwrite(&header, sizeof(header), 1, fp.get()) == 1;
+	if (ok && !table.empty())
+		ok = fwrite(table.data(), sizeof(LVBinarySection), table.size(), fp.get()) == table.size();
+
+	uint64_t pos = sizeof(header) + table.size() * sizeof(LVBinarySection);
+	for (size_t i = 0; ok && i < m_sections.size(); i++) {
+		size_t padding = static_cast<size_t>(table[i].offset - pos);
+		if (padding > 0)
+			ok = fwrite(zeros, 1, padding, fp.get()) == padding;
+		pos = table[i].offset;
+
+		for (const Chunk &chunk : m_sections[i].chunks) {
+			if (!ok)
+				break;
+			ok = fwrite(chunk.data, 1, chunk.bytes, fp.get()) == chunk.bytes;
+			pos += chunk.bytes;
+		}
+	}
+
+	if (!ok)
+		throw LVException(__FILE__, __LINE__, "Binary model: write failed (" + LVErrnoString(errno) + ").");
+
+	if (fclose(fp.release()) != 0)
+		throw LVException(__FILE__, __LINE__, "Binary model: unable to close file (" + LVErrnoString(errno) + ").");
+}
+
+//
+//-- Reader
+//
+
+LVBinaryReader::LVBinaryReader(const char *data, size_t size, LVBinaryKind expectedKind)
+	: m_data(data), m_size(size), m_table(nullptr), m_nSections(0) {
+	if (!LVIsBinaryModel(data, size))
+		throwInvalid("not a binary model file");
+
+	if (size < sizeof(LVBinaryHeader))
+		throwInvalid("file is truncated");
+
+	LVBinaryHeader header;
+	std::memcpy(&header, data, sizeof(header));
+
+	if (header.byteOrder != LVBinaryByteOrderMark)
+		throwInvalid("file was written on a platform with different byte order");
+
+	if (header.version != LVBinaryVersion)
+		throwInvalid("unsupported format version " + std::to_string(header.version) + " (expected " + std::to_string(LVBinaryVersion) + ")");
+
+	if (header.kind != static_cast<uint32_t>(expectedKind))
+		throwInvalid("the file was written by a different library (sparse/dense/linear model or dataset)");
+
+	if (header.fileSize != size)
+		throwInvalid("file size does not match header (truncated file?)");
+
+	uint64_t tableEnd = sizeof(LVBinaryHeader) + static_cast<uint64_t>(header.nSections) * sizeof(LVBinarySection);
+	if (tableEnd > size)
+		throwInvalid("section table is truncated");
+
+	m_nSections = header.nSections;
+	m_table = reinterpret_cast<const LVBinarySection*>(data + sizeof(LVBinaryHeader));
+
+	// Validate all sections up front, so that later accesses only need to check the type
+	for (uint32_t i = 0; i < m_nSections; i++) {
+		const LVBinarySection &s = m_table[i];
+		if (s.eltSize == 0 || s.offset % LVBinaryAlignment != 0 || s.offset < tableEnd || s.offset > size)
+			throwInvalid("section " + std::to_string(s.id) + " has an invalid descriptor");
+		if (s.count > (size - s.offset) / s.eltSize)
+			throwInvalid("section " + std::to_string(s.id) + " exceeds the file size");
+	}
+}
+
+const LVBinarySection * LVBinaryReader::find(uint32_t id) const {
+	for (uint32_t i = 0; i < m_nSections; i++) {
+		if (m_table[i].id == id)
+			return &m_table[i];
+	}
+	return nullptr;
+}
+
+bool LVBinaryReader::hasSection(uint32_t id) const {
+	return find(id) != nullptr;
+}
+
+const void * LVBinaryReader::sectionData(uint32_t id, size_t eltSize, size_t &count, bool required) const {
+	const LVBinarySection *s = find(id);
+	if (s == nullptr) {
+		if (required)
+			throwInvalid("required section " + std::to_string(id) + " is missing");
+		count = 0;
+		return nullptr;
+	}
+
+	if (s->eltSize != eltSize)
+		throwInvalid("section " + std::to_string(id) + " has unexpected element size " + std::to_string(s->eltSize));
+
+	count = static_cast<size_t>(s->count);
+	return (count > 0) ? m_data + s->offset : nullptr;
+}
+
+void LVBinaryReader::throwInvalid(const std::string &reason) {
+	throw LVException(__FILE__, __LINE__, "Invalid binary model: " + reason + ".");
+}
+
+bool LVIsBinaryModel(const char *data, size_t size) {
+	return data != nullptr && size >= sizeof(LVBinaryMagic) && std::memcmp(data, LVBinaryMagic, sizeof(LVBinaryMagic)) == 0;
+}
+
+std::unique_ptr<uint64_t[]> LVBinaryCopyAligned(const char *data, size_t size) {
+	std::unique_ptr<uint64_t[]> buffer(new uint64_t[(size + sizeof(uint64_t) - 1) / sizeof(uint64_t)]);
+	if (size > 0)
+		std::memcpy(buffer.get(), data, size);
+	return buffer;
+}
@@ -0,0 +1,157 @@
+/// <summary>
+/// Versioned binary container used for the binary model files of all three libraries (and binary datasets, see LVDatasetBlocks.h).
+///
+/// Layout:
+///		LVBinaryHeader				(32 bytes)
+///		LVBinarySection[nSections]	(24 bytes each)
+///		section data				(each section starts on a LVBinaryAlignment boundary)
+///
+/// Every section is a contiguous block of fixed-size elements stored in native byte order,
+/// so that a memory mapped file can be used directly by the solvers without parsing.
+/// The contents of each section (id, element type) are defined by the wrapper that writes it.
+/// </summary>
+
+#ifndef LVBINARYMODEL_H_
+#define LVBINARYMODEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Increment when the layout of the container or one of the sections changes
+const uint32_t LVBinaryVersion = 1;
+
+// Alignment of every section relative to the start of the file (cache line/SIMD friendly)
+const size_t LVBinaryAlignment = 64;
+
+// Written as a native uint32 to detect files from platforms with different byte order
+const uint32_t LVBinaryByteOrderMark = 0x01020304;
+
+// Identifies which library the model belongs to
+enum class LVBinaryKind : uint32_t {
+	Sparse = 1,		// LabVIEW-libsvm
+	Dense = 2,		// LabVIEW-libsvm-dense
+	Linear = 3,		// LabVIEW-liblinear
+	Dataset = 4		// Binary datasets (LVWriteBinaryDataset)
+};
+
+struct LVBinaryHeader {
+	char magic[8];			// "LVSVMBIN"
+	uint32_t version;		// LVBinaryVersion
+	uint32_t kind;			// LVBinaryKind
+	uint32_t byteOrder;		// LVBinaryByteOrderMark
+	uint32_t nSections;		// Number of entries in the section table
+	uint64_t fileSize;		// Total size in bytes (used to detect truncated files)
+};
+
+struct LVBinarySection {
+	uint32_t id;			// Wrapper defined section id
+	uint32_t eltSize;		// Size of each element in bytes
+	uint64_t offset;		// Offset from the start of the file (aligned)
+	uint64_t count;			// Number of elements
+};
+
+static_assert(sizeof(LVBinaryHeader) == 32, "LVBinaryHeader must be 32 bytes.");
+static_assert(sizeof(LVBinarySection) == 24, "LVBinarySection must be 24 bytes.");
+
+/// <summary>
+/// Collects sections and writes them as a binary model.
+/// Sections reference the caller's memory, which must stay valid until the write has completed.
+/// A section may be gathered from several non-contiguous chunks (e.g. one chunk per support vector).
+/// </summary>
+class LVBinaryWriter {
+public:
+	explicit LVBinaryWriter(LVBinaryKind kind);
+
+	/// <summary> Adds a contiguous section of count elements. Empty sections are stored with a zero count. </summary>
+	template<class T>
+	void addSection(uint32_t id, const T *data, size_t count) {
+		addSection(id, sizeof(T), data, count);
+	}
+
+	void addSection(uint32_t id, size_t eltSize, const void *data, size_t count);
+
+	/// <summary> Starts a section that is gathered from chunks appended with appendChunk. </summary>
+	void beginSection(uint32_t id, size_t eltSize);
+
+	/// <summary> Appends count elements to the last section started by beginSection. </summary>
+	void appendChunk(const void *data, size_t count);
+
+	/// <summary> Total size of the binary model in bytes. </summary>
+	size_t size() const;
+
+	/// <summary> Writes the binary model to a file. Throws LVException on failure. </summary>
+	void writeFile(const char *path) const;
+
+	/// <summary> Writes the binary model to dst, which must have room for size() bytes. </summary>
+	void writeBuffer(char *dst) const;
+
+private:
+	struct Chunk {
+		const void *data;
+		size_t bytes;
+	};
+
+	struct PendingSection {
+		LVBinarySection desc;
+		std::vector<Chunk> chunks;
+	};
+
+	// Computes the section offsets and the total size
+	void layout(LVBinaryHeader &header, std::vector<LVBinarySection> &table) const;
+
+	LVBinaryKind m_kind;
+	std::vector<PendingSection> m_sections;
+};
+
+/// <summary>
+/// Validates and provides typed access to a binary model residing in memory (typically a memory map).
+/// The reader does not copy anything, pointers returned are into the original buffer.
+/// </summary>
+class LVBinaryReader {
+public:
+	/// <summary> Validates the header and section table. Throws LVException if the data is not a valid model of the expected kind. </summary>
+	LVBinaryReader(const char *data, size_t size, LVBinaryKind expectedKind);
+
+	/// <summary> Returns true if the model contains the section. </summary>
+	bool hasSection(uint32_t id) const;
+
+	/// <summary> Returns a pointer to the section data and its element count (nullptr if empty). Throws LVException if required and missing. </summary>
+	template<class T>
+	const T * section(uint32_t id, size_t &count, bool required = true) const {
+		return static_cast<const T*>(sectionData(id, sizeof(T), count, required));
+	}
+
+	/// <summary> Returns the single element of a section (e.g. parameters). Throws LVException if missing. </summary>
+	template<class T>
+	const T & scalar(uint32_t id) const {
+		size_t count = 0;
+		const T *value = section<T>(id, count);
+		if (count != 1)
+			throwInvalid("section " + std::to_string(id) + " must contain exactly one element");
+		return *value;
+	}
+
+private:
+	const void * sectionData(uint32_t id, size_t eltSize, size_t &count, bool required) const;
+	const LVBinarySection * find(uint32_t id) const;
+	[[noreturn]] static void throwInvalid(const std::string &reason);
+
+	const char *m_data;
+	size_t m_size;
+	const LVBinarySection *m_table;
+	uint32_t m_nSections;
+};
+
+/// <summary> Returns true if the buffer starts with the binary model magic (used to select binary or text parsing). </summary>
+bool LVIsBinaryModel(const char *data, size_t size);
+
+/// <summary>
+/// Copies a binary model into 8-byte aligned memory, so that the sections can be accessed in place.
+/// Required for buffers without alignment guarantees, e.g. LabVIEW string data (4 bytes past the start of the handle).
+/// </summary>
+std::unique_ptr<uint64_t[]> LVBinaryCopyAligned(const char *data, size_t size);
+
+#endif // LVBINARYMODEL_H_
@@ -0,0 +1,57 @@
+#include "LVCancellation.h"
+
+namespace {
+	thread_local LVStopCondition *currentCondition = nullptr;
+}
+
+LVCancellationToken::LVCancellationToken(double maxSeconds, int64_t maxIterations) : m_cancelled(false), m_progress(0), m_log(0), m_logTag(0), m_maxSeconds(maxSeconds), m_maxIterations(maxIterations) {}
+
+LVStopCondition::LVStopCondition(std::shared_ptr<const LVCancellationToken> token) : m_token(std::move(token)), m_iterations(0), m_reason(static_cast<int32_t>(LVStopReason::None)) {
+	if (m_token && m_token->maxSeconds() > 0)
+		m_deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(m_token->maxSeconds()));
+}
+
+void LVStopCondition::checkpoint(int64_t iterations) {
+	if (!m_token)
+		return;
+
+	int64_t done = m_iterations += iterations;
+
+	LVStopReason reason = this->reason();
+	if (reason == LVStopReason::None) {
+		if (m_token->cancelled())
+			reason = LVStopReason::Cancelled;
+		else if (m_token->maxIterations() > 0 && done > m_token->maxIterations())
+			reason = LVStopReason::IterationBudget;
+		else if (m_token->maxSeconds() > 0 && std::chrono::steady_clock::now() > m_deadline)
+			reason = LVStopReason::TimeBudget;
+		else
+			return;
+
+		// The first reason is kept, so that all threads of the run report the same
+		int32_t none = static_cast<int32_t>(LVStopReason::None);
+		if (!m_reason.compare_exchange_strong(none, static_cast<int32_t>(reason)))
+			reason = static_cast<LVStopReason>(none);
+	}
+
+	switch (reason) {
+	case LVStopReason::Cancelled:
+		throw LVStopped(__FILE__, __LINE__, reason, "The run was cancelled.");
+	case LVStopReason::TimeBudget:
+		throw LVStopped(__FILE__, __LINE__, reason, "The run exceeded its time budget (" + std::to_string(m_token->maxSeconds()) + " s).");
+	default:
+		throw LVStopped(__FILE__, __LINE__, reason, "The run exceeded its iteration budget (" + std::to_string(m_token->maxIterations()) + " solver iterations).");
+	}
+}
+
+LVStopCondition * LVStopCondition::current() {
+	return currentCondition;
+}
+
+LVStopScope::LVStopScope(LVStopCondition *condition) : m_previous(currentCondition) {
+	currentCondition = condition;
+}
+
+LVStopScope::~LVStopScope() {
+	currentCondition = m_previous;
+}
@@ -0,0 +1,158 @@
+/// <summary>
+/// Cooperative cancellation of training, cross-validation and parameter searches.
+/// A cancellation token is created from LabVIEW, passed to a cancellable entry point and cancelled from any other VI.
+/// It can also carry budgets, a wall-clock time and a number of solver iterations, that every run started with it may use.
+/// The solvers of libsvm and liblinear cannot be interrupted from outside, a run tests its stop condition at checkpoints instead.
+/// A stopped run throws LVStopped at its next checkpoint, so checkpoints are only placed where nothing but the wrappers' own code
+/// is unwound: between the folds, classes and grid points the wrappers train themselves (the tasks of the thread pool, see LVThreadPool.h),
+/// and at the outer iterations of the native solvers. Nothing is thrown through a library solver, whose allocations would leak:
+/// its progress output (every 1000 iterations of libsvm's solver, every 10 iterations of liblinear's coordinate descent solvers
+/// and every Newton iteration of its primal solvers, see the print functions of the wrappers) only counts the iterations.
+/// A library solver that has started therefore runs to completion, and a stopped run fails at the next checkpoint after it.
+/// Under a stop condition the wrappers cross-validate fold by fold and train liblinear's one-vs-rest models class by class
+/// instead of calling the library loops. A single training under a token runs as an abandonable job (see LVJobQueue::runAbandonable):
+/// a stopped run returns while the library solver completes in the background on copies of its inputs.
+/// The token also carries the progress user event the parameter searches post their results to (see LVGridSearch.h)
+/// and the log event of the runs started with it (see LVLogging.h).
+/// </summary>
+
+#ifndef LVCANCELLATION_H_
+#define LVCANCELLATION_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <extcode.h>
+
+#include "LVException.h"
+
+// LabVIEW error codes of stopped runs (LVException defaults to 7000)
+const int32_t LVErrorCancelled = 7001;
+const int32_t LVErrorBudgetExceeded = 7002;
+
+enum class LVStopReason : int32_t {
+	None = 0,
+	Cancelled = 1,
+	TimeBudget = 2,
+	IterationBudget = 3
+};
+
+/// <summary> Shared between the VI that cancels and the runs started with the token. </summary>
+class LVCancellationToken {
+public:
+	/// <summary> Budgets of every run started with the token, zero or negative for no limit. </summary>
+	LVCancellationToken(double maxSeconds, int64_t maxIterations);
+
+	LVCancellationToken(const LVCancellationToken&) = delete;
+	LVCancellationToken& operator=(const LVCancellationToken&) = delete;
+
+	/// <summary> Stops the runs in progress at their next checkpoint, and every run started later until reset. </summary>
+	void cancel() { m_cancelled = true; }
+
+	void reset() { m_cancelled = false; }
+
+	bool cancelled() const { return m_cancelled; }
+
+	double maxSeconds() const { return m_maxSeconds; }
+
+	int64_t maxIterations() const { return m_maxIterations; }
+
+	/// <summary> User event that receives the LVProgressEvent of the searches started with the token, 0 for none. </summary>
+	void setProgressEvent(LVUserEventRef event) { m_progress = event; }
+
+	LVUserEventRef progressEvent() const { return m_progress; }
+
+	/// <summary> User event that receives the solver output of the runs started with the token as LVLogEvent with the tag, 0 for the global logging event. </summary>
+	void setLogEvent(LVUserEventRef event, uint64_t tag) { m_logTag = tag; m_log = event; }
+
+	LVUserEventRef logEvent() const { return m_log; }
+
+	uint64_t logTag() const { return m_logTag; }
+
+private:
+	std::atomic<bool> m_cancelled;
+	std::atomic<LVUserEventRef> m_progress;
+	std::atomic<LVUserEventRef> m_log;
+	std::atomic<uint64_t> m_logTag;
+	const double m_maxSeconds;
+	const int64_t m_maxIterations;
+};
+
+/// <summary> Thrown at the checkpoint of a run that has been cancelled or has exceeded a budget. </summary>
+class LVStopped : public LVException {
+public:
+	LVStopped(const char * file, const int line, LVStopReason reason, const std::string msg) : LVException(file, line, (reason == LVStopReason::Cancelled) ? LVErrorCancelled : LVErrorBudgetExceeded, msg), m_reason(reason) {}
+
+	LVStopReason reason() const { return m_reason; }
+
+private:
+	LVStopReason m_reason;
+};
+
+/// <summary> Stop condition of one run: the cancellation of its token, and the budgets counted from the construction of the condition. </summary>
+class LVStopCondition {
+public:
+	/// <summary> Starts the budgets of the token, a run without token (nullptr) is never stopped. </summary>
+	explicit LVStopCondition(std::shared_ptr<const LVCancellationToken> token);
+
+	LVStopCondition(const LVStopCondition&) = delete;
+	LVStopCondition& operator=(const LVStopCondition&) = delete;
+
+	/// <summary>
+	/// Counts the solver iterations done since the previous checkpoint and throws LVStopped if the run is to stop.
+	/// Thread-safe, once a run has stopped every checkpoint throws for the same reason.
+	/// </summary>
+	void checkpoint(int64_t iterations = 0);
+
+	/// <summary> Counts the solver iterations done since the previous checkpoint without testing the condition, for the library solvers. Thread-safe. </summary>
+	void count(int64_t iterations) { m_iterations += iterations; }
+
+	/// <summary> Solver iterations counted so far. </summary>
+	int64_t iterations() const { return m_iterations; }
+
+	/// <summary> Reason the run has stopped, None while it goes on. </summary>
+	LVStopReason reason() const { return static_cast<LVStopReason>(m_reason.load()); }
+
+	std::shared_ptr<const LVCancellationToken> token() const { return m_token; }
+
+	/// <summary> Stop condition of the calling thread (see LVStopScope), nullptr if none. </summary>
+	static LVStopCondition * current();
+
+private:
+	std::shared_ptr<const LVCancellationToken> m_token;
+	std::chrono::steady_clock::time_point m_deadline;	// Unused without time budget
+	std::atomic<int64_t> m_iterations;
+	std::atomic<int32_t> m_reason;
+};
+
+/// <summary> Makes the condition the stop condition of the calling thread (nullptr for none), the previous one is restored when the scope ends. </summary>
+class LVStopScope {
+public:
+	explicit LVStopScope(LVStopCondition *condition);
+	~LVStopScope();
+
+	LVStopScope(const LVStopScope&) = delete;
+	LVStopScope& operator=(const LVStopScope&) = delete;
+
+private:
+	LVStopCondition *m_previous;
+};
+
+/// <summary> Checkpoint of the solvers: tests the stop condition of the calling thread, if any. Must not be called from inside a library solver. </summary>
+inline void LVCheckpoint(int64_t iterations = 0) {
+	LVStopCondition *condition = LVStopCondition::current();
+	if (condition != nullptr)
+		condition->checkpoint(iterations);
+}
+
+/// <summary> Counts solver iterations into the stop condition of the calling thread, if any, never throws (see LVStopCondition::count). </summary>
+inline void LVCountIterations(int64_t iterations) {
+	LVStopCondition *condition = LVStopCondition::current();
+	if (condition != nullptr)
+		condition->count(iterations);
+}
+
+#endif // LVCANCELLATION_H_
@@ -0,0 +1,208 @@
+#include "LVDataset.h"
+#include "LVException.h"
+#include "LVMemoryMap.h"
+#include "LVBinaryModel.h"
+
+#include <algorithm>
+#include <climits>
+
+// Line statistics of a chunk, gathered in a single scan
+struct LVDatasetChunkInfo {
+	size_t rows;		// Lines with content (upper bound of the vectors)
+	size_t colons;		// Upper bound of the nodes
+	size_t lineBreaks;
+};
+
+static LVDatasetChunkInfo LVScanDatasetChunk(const char *begin, const char *end) {
+	LVDatasetChunkInfo info = { 0, 0, 0 };
+	bool content = false;
+
+	for (const char *p = begin; p < end; p++) {
+		switch (*p) {
+		case '\n':
+			info.lineBreaks++;
+			if (content)
+				info.rows++;
+			content = false;
+			break;
+		case ':':
+			info.colons++;
+			content = true;
+			break;
+		case ' ':
+		case '\t':
+		case '\r':
+			break;
+		default:
+			content = true;
+			break;
+		}
+	}
+
+	if (content)
+		info.rows++;
+
+	return info;
+}
+
+void LVReadDataset(const char *data, size_t size, int32_t minIndex, bool skipMalformed, LVDataset &dataset, size_t firstLine) {
+	dataset = LVDataset();
+	const char *end = data + size;
+
+	// First pass counts the lines and nodes of each chunk, so that the second pass can parse directly into the final arrays
+	std::vector<const char*> bounds = LVSplitLines(data, end, LVThreadCount(size, 1 << 18));
+	size_t nChunks = bounds.size() - 1;
+
+	std::vector<LVDatasetChunkInfo> info(nChunks);
+	LVParallelFor(nChunks, [&](size_t c) {
+		info[c] = LVScanDatasetChunk(bounds[c], bounds[c + 1]);
+	});
+
+	std::vector<size_t> rowOffset(nChunks + 1, 0);
+	std::vector<size_t> nodeOffset(nChunks + 1, 0);
+	std::vector<size_t> lineOffset(nChunks + 1, 0);
+	for (size_t c = 0; c < nChunks; c++) {
+		rowOffset[c + 1] = rowOffset[c] + info[c].rows;
+		nodeOffset[c + 1] = nodeOffset[c] + info[c].colons;
+		lineOffset[c + 1] = lineOffset[c] + info[c].lineBreaks;
+	}
+
+	if (rowOffset[nChunks] > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Number of feature vectors too large (greater than " + std::to_string(INT_MAX) + ").");
+
+	dataset.y.resize(rowOffset[nChunks]);
+	dataset.rowStart.resize(rowOffset[nChunks] + 1, 0);
+	dataset.index.resize(nodeOffset[nChunks]);
+	dataset.value.resize(nodeOffset[nChunks]);
+
+	// Second pass, each chunk fills its reserved range (which is only partially used if lines are skipped)
+	std::vector<size_t> rowCount(nChunks, 0);
+	std::vector<size_t> nodeCount(nChunks, 0);
+	std::vector<int32_t> maxIndex(nChunks, 0);
+	std::vector<std::vector<uint64_t>> malformed(nChunks);
+
+	LVParallelFor(nChunks, [&](size_t c) {
+		LVTextCursor cursor(bounds[c], bounds[c + 1], firstLine + lineOffset[c]);
+		size_t row = rowOffset[c];
+		size_t node = nodeOffset[c];
+		int32_t chunkMax = 0;
+
+		while (cursor.skipEmptyLines()) {
+			size_t line = cursor.line();
+			size_t rowNode = node;
+
+			try {
+				double label = cursor.readDouble();
+
+				int32_t previous = minIndex - 1;
+				while (!cursor.atEndOfLine()) {
+					int32_t index = cursor.readInt();
+					cursor.expect(':');
+
+					if (index < minIndex)
+						cursor.fail("feature index " + std::to_string(index) + " is less than " + std::to_string(minIndex));
+					if (index <= previous)
+						cursor.fail("feature indices must be in ascending order");
+
+					dataset.value[node] = cursor.readDouble();
+					dataset.index[node] = index;
+					node++;
+					previous = index;
+				}
+
+				dataset.y[row] = label;
+				dataset.rowStart[row + 1] = node;
+				row++;
+				chunkMax = std::max(chunkMax, previous);
+			}
+			catch (LVException &) {
+				if (!skipMalformed)
+					throw;
+
+				// Discard the nodes of the line
+				node = rowNode;
+				malformed[c].push_back(line);
+			}
+
+			cursor.nextLine();
+		}
+
+		rowCount[c] = row - rowOffset[c];
+		nodeCount[c] = node - nodeOffset[c];
+		maxIndex[c] = chunkMax;
+	});
+
+	// Close the gaps left by skipped lines (chunks only move towards the front, so copying in order is safe)
+	size_t rowDst = 0;
+	size_t nodeDst = 0;
+	for (size_t c = 0; c < nChunks; c++) {
+		size_t rowSrc = rowOffset[c];
+		size_t nodeSrc = nodeOffset[c];
+
+		if (rowDst != rowSrc || nodeDst != nodeSrc) {
+			std::copy(dataset.y.begin() + rowSrc, dataset.y.begin() + rowSrc + rowCount[c], dataset.y.begin() + rowDst);
+			for (size_t r = 0; r < rowCount[c]; r++)
+				dataset.rowStart[rowDst + r + 1] = dataset.rowStart[rowSrc + r + 1] - nodeSrc + nodeDst;
+
+			std::copy(dataset.index.begin() + nodeSrc, dataset.index.begin() + nodeSrc + nodeCount[c], dataset.index.begin() + nodeDst);
+			std::copy(dataset.value.begin() + nodeSrc, dataset.value.begin() + nodeSrc + nodeCount[c], dataset.value.begin() + nodeDst);
+		}
+
+		rowDst += rowCount[c];
+		nodeDst += nodeCount[c];
+		dataset.maxIndex = std::max(dataset.maxIndex, maxIndex[c]);
+		dataset.malformedLines.insert(dataset.malformedLines.end(), malformed[c].begin(), malformed[c].end());
+	}
+
+	dataset.y.resize(rowDst);
+	dataset.rowStart.resize(rowDst + 1);
+	dataset.index.resize(nodeDst);
+	dataset.value.resize(nodeDst);
+}
+
+void LVReadDatasetFile(const char *path, int32_t minIndex, bool skipMalformed, LVDataset &dataset) {
+	LVMemoryMap map(path);
+	map.adviseSequential();
+	if (LVIsBinaryModel(map.data(), map.size()))
+		LVReadBinaryDataset(map.data(), map.size(), dataset);
+	else
+		LVReadDataset(map.data(), map.size(), minIndex, skipMalformed, dataset);
+}
+
+void LVWriteBinaryDataset(const char *path, const LVDataset &dataset) {
+	std::vector<uint64_t> rowStart(dataset.rowStart.begin(), dataset.rowStart.end());
+	int32_t maxIndex = dataset.maxIndex;
+
+	LVBinaryWriter writer(LVBinaryKind::Dataset);
+	writer.addSection(LVBinarySectionDatasetLabels, dataset.y.data(), dataset.y.size());
+	writer.addSection(LVBinarySectionDatasetRowStart, rowStart.data(), rowStart.size());
+	writer.addSection(LVBinarySectionDatasetIndex, dataset.index.data(), dataset.index.size());
+	writer.addSection(LVBinarySectionDatasetValue, dataset.value.data(), dataset.value.size());
+	writer.addSection(LVBinarySectionDatasetMaxIndex, &maxIndex, 1);
+	writer.writeFile(path);
+}
+
+void LVReadBinaryDataset(const char *data, size_t size, LVDataset &dataset) {
+	dataset = LVDataset();
+	LVBinaryReader reader(data, size, LVBinaryKind::Dataset);
+
+	size_t l = 0;
+	size_t nRowStart = 0;
+	size_t nIndex = 0;
+	size_t nValue = 0;
+	const double *y = reader.section<double>(LVBinarySectionDatasetLabels, l, false);
+	const uint64_t *rowStart = reader.section<uint64_t>(LVBinarySectionDatasetRowStart, nRowStart);
+	const int32_t *index = reader.section<int32_t>(LVBinarySectionDatasetIndex, nIndex, false);
+	const double *value = reader.section<double>(LVBinarySectionDatasetValue, nValue, false);
+
+	if (nRowStart != l + 1 || nIndex != nValue || rowStart[0] != 0 || rowStart[l] != nIndex)
+		throw LVException(__FILE__, __LINE__, "Invalid binary dataset: the sizes of the sections do not match.");
+	if (!std::is_sorted(rowStart, rowStart + l + 1))
+		throw LVException(__FILE__, __LINE__, "Invalid binary dataset: the row offsets are not ascending.");
+
+	dataset.y.assign(y, y + l);
+	dataset.rowStart.assign(rowStart, rowStart + l + 1);
+	dataset.index.assign(index, index + nIndex);
+	dataset.value.assign(value, value + nValue);
+	dataset.maxIndex = reader.scalar<int32_t>(LVBinarySectionDatasetMaxIndex);
+}
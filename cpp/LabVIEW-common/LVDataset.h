@@ -0,0 +1,96 @@
+/// <summary>
+/// Native reader/writer of data files in the libsvm format ("label index:value index:value ...", one vector per line).
+/// Files are memory mapped, split on line boundaries and parsed in parallel into a compressed sparse row (CSR) dataset,
+/// which the wrappers then copy into their LabVIEW problem layouts.
+/// Datasets can also be stored as binary files (the CSR arrays in a LVBinaryModel container), which are read without parsing.
+/// </summary>
+
+#ifndef LVDATASET_H_
+#define LVDATASET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LVParallel.h"
+#include "LVTextFormat.h"
+
+/// <summary>
+/// Dataset in compressed sparse row form.
+/// Vector i consists of the nodes rowStart[i] to rowStart[i+1]-1 of index/value (ascending indices, no terminating node).
+/// </summary>
+struct LVDataset {
+	std::vector<double> y;					//!< Label (or target value) of each vector.
+	std::vector<size_t> rowStart;			//!< Offset of each vector in index/value (one more entry than y).
+	std::vector<int32_t> index;				//!< Feature indices.
+	std::vector<double> value;				//!< Feature values.
+	int32_t maxIndex;						//!< Largest feature index (0 if there are no features).
+	std::vector<uint64_t> malformedLines;	//!< Line numbers (one-based) of the malformed lines that were skipped.
+
+	LVDataset() : maxIndex(0) {}
+
+	size_t rows() const { return y.size(); }
+	size_t nodes() const { return index.size(); }
+	size_t nodes(size_t row) const { return rowStart[row + 1] - rowStart[row]; }
+};
+
+/// <summary>
+/// Parses data in the libsvm format into dataset.
+/// Indices must be ascending and not less than minIndex (0 allows the serial number of precomputed kernels).
+/// If skipMalformed is false, the first malformed line is reported as an LVException with its line number,
+/// otherwise malformed lines are skipped and listed in dataset.malformedLines.
+/// firstLine is the line number of the first line of data (for data that is part of a larger file).
+/// </summary>
+void LVReadDataset(const char *data, size_t size, int32_t minIndex, bool skipMalformed, LVDataset &dataset, size_t firstLine = 1);
+
+/// <summary> Memory maps the file at path and parses it with LVReadDataset, binary datasets are detected and read with LVReadBinaryDataset. </summary>
+void LVReadDatasetFile(const char *path, int32_t minIndex, bool skipMalformed, LVDataset &dataset);
+
+// Sections of binary datasets (LVBinaryKind::Dataset)
+const uint32_t LVBinarySectionDatasetLabels = 1;		// double (one per vector)
+const uint32_t LVBinarySectionDatasetRowStart = 2;		// uint64_t (one more than the vectors)
+const uint32_t LVBinarySectionDatasetIndex = 3;			// int32_t (one per node)
+const uint32_t LVBinarySectionDatasetValue = 4;			// double (one per node)
+const uint32_t LVBinarySectionDatasetMaxIndex = 5;		// int32_t
+
+/// <summary> Writes the dataset as a binary file (see LVDatasetBlocks.h for reading it without loading it). </summary>
+void LVWriteBinaryDataset(const char *path, const LVDataset &dataset);
+
+/// <summary> Copies a binary dataset residing in memory (e.g. a memory map) into dataset. Throws LVException if it is invalid. </summary>
+void LVReadBinaryDataset(const char *data, size_t size, LVDataset &dataset);
+
+/// <summary>
+/// Formats l vectors in the libsvm format in parallel, the concatenation of the returned parts is the data file.
+/// formatRow(i, writer) must write vector i as a complete line (see LVPutDatasetLabel and LVPutDatasetNode),
+/// it is called concurrently for different rows.
+/// </summary>
+template<class F>
+std::vector<std::string> LVFormatDataset(size_t l, F formatRow) {
+	size_t nThreads = LVThreadCount(l, 256);
+	std::vector<std::string> parts(nThreads);
+
+	LVParallelFor(nThreads, [&](size_t t) {
+		LVTextWriter writer;
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++)
+			formatRow(i, writer);
+		parts[t] = std::move(writer.str());
+	});
+
+	return parts;
+}
+
+/// <summary> Starts a line with the label (shortest round-trip representation). </summary>
+inline void LVPutDatasetLabel(LVTextWriter &writer, double label) {
+	writer.putDoubleShortest(label);
+}
+
+/// <summary> Appends " index:value" to the line (shortest round-trip representation of the value). </summary>
+inline void LVPutDatasetNode(LVTextWriter &writer, int32_t index, double value) {
+	writer.put(' ');
+	writer.putInt(index);
+	writer.put(':');
+	writer.putDoubleShortest(value);
+}
+
+#endif // LVDATASET_H_
@@ -0,0 +1,142 @@
+#include "LVDatasetBlocks.h"
+#include "LVException.h"
+#include "LVTextFormat.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+
+LVDatasetBlocks::LVDatasetBlocks(const char *path, size_t blockBytes, size_t maxLabels)
+	: m_map(path), m_y(nullptr), m_rowStart(nullptr), m_index(nullptr), m_value(nullptr), m_maxIndex(0), m_inUse(SIZE_MAX) {
+	blockBytes = std::max<size_t>(blockBytes, 1);
+	m_blockRow.push_back(0);
+
+	if (LVIsBinaryModel(m_map.data(), m_map.size())) {
+		m_reader.reset(new LVBinaryReader(m_map.data(), m_map.size(), LVBinaryKind::Dataset));
+
+		size_t l = 0;
+		size_t nRowStart = 0;
+		size_t nIndex = 0;
+		size_t nValue = 0;
+		m_y = m_reader->section<double>(LVBinarySectionDatasetLabels, l, false);
+		m_rowStart = m_reader->section<uint64_t>(LVBinarySectionDatasetRowStart, nRowStart);
+		m_index = m_reader->section<int32_t>(LVBinarySectionDatasetIndex, nIndex, false);
+		m_value = m_reader->section<double>(LVBinarySectionDatasetValue, nValue, false);
+		m_maxIndex = m_reader->scalar<int32_t>(LVBinarySectionDatasetMaxIndex);
+
+		if (nRowStart != l + 1 || nIndex != nValue || m_rowStart[0] != 0 || m_rowStart[l] != nIndex)
+			throw LVException(__FILE__, __LINE__, "Invalid binary dataset: the sizes of the sections do not match.");
+		if (!std::is_sorted(m_rowStart, m_rowStart + l + 1))
+			throw LVException(__FILE__, __LINE__, "Invalid binary dataset: the row offsets are not ascending.");
+
+		// Blocks of whole vectors, the size of a vector is its label, offset and nodes
+		size_t bytes = 0;
+		for (size_t i = 0; i < l; i++) {
+			bytes += sizeof(double) + sizeof(uint64_t) + static_cast<size_t>(m_rowStart[i + 1] - m_rowStart[i]) * (sizeof(int32_t) + sizeof(double));
+			if (bytes >= blockBytes || i + 1 == l) {
+				m_blockRow.push_back(i + 1);
+				bytes = 0;
+			}
+		}
+
+		addLabels(m_y, l, maxLabels);
+	}
+	else {
+		const char *begin = m_map.data();
+		const char *end = begin + m_map.size();
+		m_blockText = LVSplitLines(begin, end, std::max<size_t>(1, (m_map.size() + blockBytes - 1) / blockBytes));
+
+		// Every block is parsed once (and released) to count its vectors
+		LVDatasetBlock block;
+		size_t line = 1;
+		for (size_t b = 0; b + 1 < m_blockText.size(); b++) {
+			m_blockLine.push_back(line);
+			line += LVCountLineBreaks(m_blockText[b], m_blockText[b + 1]);
+
+			if (b + 2 < m_blockText.size())
+				m_map.adviseWillNeed(static_cast<size_t>(m_blockText[b + 1] - begin), static_cast<size_t>(m_blockText[b + 2] - m_blockText[b + 1]));
+
+			m_blockRow.push_back(m_blockRow.back());
+			read(b, block);
+			m_blockRow.back() += block.rows;
+			m_maxIndex = std::max(m_maxIndex, block.parsed.maxIndex);
+			addLabels(block.y, block.rows, maxLabels);
+			release(b);
+		}
+	}
+}
+
+void LVDatasetBlocks::read(size_t b, LVDatasetBlock &block) const {
+	// One block at a time, so that the memory used does not grow with the file
+	if (m_inUse != SIZE_MAX && m_inUse != b)
+		throw LVException(__FILE__, __LINE__, "Block " + std::to_string(b) + " of the data file was read before block " + std::to_string(m_inUse) + " was released.");
+	m_inUse = b;
+
+	block.firstRow = m_blockRow[b];
+
+	if (m_reader) {
+		block.rows = m_blockRow[b + 1] - m_blockRow[b];
+		block.y = m_y + block.firstRow;
+		block.rowStart = m_rowStart + block.firstRow;
+		block.index = m_index;
+		block.value = m_value;
+		return;
+	}
+
+	LVReadDataset(m_blockText[b], static_cast<size_t>(m_blockText[b + 1] - m_blockText[b]), 1, false, block.parsed, m_blockLine[b]);
+
+	block.rows = block.parsed.rows();
+	block.parsedRowStart.assign(block.parsed.rowStart.begin(), block.parsed.rowStart.end());
+	block.y = block.parsed.y.data();
+	block.rowStart = block.parsedRowStart.data();
+	block.index = block.parsed.index.data();
+	block.value = block.parsed.value.data();
+}
+
+void LVDatasetBlocks::prefetch(size_t b) const {
+	for (const Range &range : ranges(b))
+		m_map.adviseWillNeed(range.offset, range.length);
+}
+
+void LVDatasetBlocks::release(size_t b) const {
+	for (const Range &range : ranges(b))
+		m_map.adviseDontNeed(range.offset, range.length);
+
+	if (m_inUse == b)
+		m_inUse = SIZE_MAX;
+}
+
+std::vector<LVDatasetBlocks::Range> LVDatasetBlocks::ranges(size_t b) const {
+	const char *base = m_map.data();
+	std::vector<Range> result;
+
+	if (!m_reader) {
+		result.push_back({ static_cast<size_t>(m_blockText[b] - base), static_cast<size_t>(m_blockText[b + 1] - m_blockText[b]) });
+		return result;
+	}
+
+	size_t first = m_blockRow[b];
+	size_t last = m_blockRow[b + 1];
+	size_t firstNode = static_cast<size_t>(m_rowStart[first]);
+	size_t nodes = static_cast<size_t>(m_rowStart[last]) - firstNode;
+
+	result.push_back({ static_cast<size_t>(reinterpret_cast<const char*>(m_y + first) - base), (last - first) * sizeof(double) });
+	result.push_back({ static_cast<size_t>(reinterpret_cast<const char*>(m_rowStart + first) - base), (last - first + 1) * sizeof(uint64_t) });
+	if (nodes > 0) {
+		result.push_back({ static_cast<size_t>(reinterpret_cast<const char*>(m_index + firstNode) - base), nodes * sizeof(int32_t) });
+		result.push_back({ static_cast<size_t>(reinterpret_cast<const char*>(m_value + firstNode) - base), nodes * sizeof(double) });
+	}
+
+	return result;
+}
+
+void LVDatasetBlocks::addLabels(const double *y, size_t n, size_t maxLabels) {
+	std::unordered_set<double> seen(m_labels.begin(), m_labels.end());
+	for (size_t i = 0; i < n; i++) {
+		if (seen.insert(y[i]).second) {
+			if (m_labels.size() == maxLabels)
+				throw LVException(__FILE__, __LINE__, "The data file has more than " + std::to_string(maxLabels) + " distinct labels.");
+			m_labels.push_back(y[i]);
+		}
+	}
+}
@@ -0,0 +1,95 @@
+/// <summary>
+/// Out-of-core access to a data file, one block of vectors at a time, for solvers that do not need the whole problem in memory (see LVDualBlockSolver).
+///		libsvm text		the file is split into blocks of about blockBytes bytes on line boundaries, a block is parsed every time it is read
+///		binary dataset	written by LVWriteBinaryDataset, the blocks reference the mapping directly (no parsing)
+/// The file is memory mapped. The caller prefetches the pages of the next block while it works on a block, and releases the pages
+/// of a block when it is done with it, so the resident memory stays at about two blocks whatever the size of the file.
+/// The blocks are used one at a time, reading a block before the previous one has been released throws LVException.
+/// </summary>
+
+#ifndef LVDATASETBLOCKS_H_
+#define LVDATASETBLOCKS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "LVDataset.h"
+#include "LVMemoryMap.h"
+#include "LVBinaryModel.h"
+
+/// <summary>
+/// Vectors firstRow to firstRow + rows - 1 of a data file.
+/// Vector firstRow + i has label y[i] and consists of the nodes rowStart[i] to rowStart[i + 1] - 1 of index/value.
+/// </summary>
+struct LVDatasetBlock {
+	size_t firstRow;
+	size_t rows;
+	const double *y;
+	const uint64_t *rowStart;
+	const int32_t *index;
+	const double *value;
+
+	// Storage of parsed text blocks (reused by the next read)
+	LVDataset parsed;
+	std::vector<uint64_t> parsedRowStart;
+
+	LVDatasetBlock() : firstRow(0), rows(0), y(nullptr), rowStart(nullptr), index(nullptr), value(nullptr) {}
+};
+
+class LVDatasetBlocks {
+public:
+	/// <summary>
+	/// Maps the file at path (libsvm text or binary dataset, detected automatically) and splits it into blocks of about blockBytes bytes.
+	/// Text files are parsed once to count the vectors and find the largest index and the labels (malformed lines are reported as LVException).
+	/// At most maxLabels distinct labels are collected, LVException is thrown if there are more.
+	/// </summary>
+	LVDatasetBlocks(const char *path, size_t blockBytes, size_t maxLabels);
+
+	size_t blocks() const { return m_blockRow.size() - 1; }
+	size_t rows() const { return m_blockRow.back(); }
+	int32_t maxIndex() const { return m_maxIndex; }
+
+	/// <summary> Distinct labels in order of first occurrence. </summary>
+	const std::vector<double> & labels() const { return m_labels; }
+
+	/// <summary> Reads block b, parsing it if the file is text. Throws LVException if another block has been read and not released. </summary>
+	void read(size_t b, LVDatasetBlock &block) const;
+
+	/// <summary> Asks the system to load the pages of block b in the background. </summary>
+	void prefetch(size_t b) const;
+
+	/// <summary> Releases the pages of block b, they are read from the file again by the next read of the block. Ends the use of the block. </summary>
+	void release(size_t b) const;
+
+private:
+	struct Range {
+		size_t offset;
+		size_t length;
+	};
+
+	// Byte ranges of the file used by block b
+	std::vector<Range> ranges(size_t b) const;
+
+	// Collects the labels in [y, y + n) that have not been seen before
+	void addLabels(const double *y, size_t n, size_t maxLabels);
+
+	LVMemoryMap m_map;
+	std::unique_ptr<LVBinaryReader> m_reader;
+
+	// Sections of binary datasets
+	const double *m_y;
+	const uint64_t *m_rowStart;
+	const int32_t *m_index;
+	const double *m_value;
+
+	std::vector<size_t> m_blockRow;			// First vector of every block (one more entry than blocks)
+	std::vector<const char*> m_blockText;	// Text blocks, block b is [m_blockText[b], m_blockText[b + 1])
+	std::vector<size_t> m_blockLine;		// Line number of the first line of every text block
+	int32_t m_maxIndex;
+	std::vector<double> m_labels;
+	mutable size_t m_inUse;					// Block that has been read and not released, SIZE_MAX for none
+};
+
+#endif // LVDATASETBLOCKS_H_
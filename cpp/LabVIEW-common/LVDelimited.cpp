@@ -0,0 +1,391 @@
+#include "LVDelimited.h"
+#include "LVException.h"
+#include "LVMemoryMap.h"
+#include "LVParallel.h"
+#include "LVTextFormat.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+LVDelimitedOptions LVMakeDelimitedOptions(uint8_t delimiter, int32_t headerRows, int32_t labelColumn, int32_t missingPolicy, double missingValue) {
+	if (delimiter == '\n' || delimiter == '\r' || delimiter == '"' || delimiter == '.' || delimiter == '-' || delimiter == '+' || (delimiter >= '0' && delimiter <= '9'))
+		throw LVException(__FILE__, __LINE__, "Invalid delimiter (it may not be a line break, quote, digit, sign or decimal point).");
+
+	if (headerRows < 0)
+		throw LVException(__FILE__, __LINE__, "The number of header rows must be non-negative.");
+
+	if (labelColumn < LVLabelColumnNone)
+		throw LVException(__FILE__, __LINE__, "Invalid label column (use -1 for the last column or -2 for no label).");
+
+	if (missingPolicy < static_cast<int32_t>(LVMissingPolicy::Error) || missingPolicy > static_cast<int32_t>(LVMissingPolicy::Replace))
+		throw LVException(__FILE__, __LINE__, "Invalid missing value policy (0: error, 1: skip row, 2: replace).");
+
+	LVDelimitedOptions options;
+	options.delimiter = static_cast<char>(delimiter);
+	options.headerRows = static_cast<size_t>(headerRows);
+	options.labelColumn = labelColumn;
+	options.missing = static_cast<LVMissingPolicy>(missingPolicy);
+	options.missingValue = missingValue;
+	return options;
+}
+
+//
+//-- Tokenizer
+//
+
+static inline bool LVIsFieldBlank(char c, char delimiter) {
+	return (c == ' ' || c == '\t' || c == '\r') && c != delimiter;
+}
+
+// Returns the end of the line starting at p (the line break or end)
+static inline const char * LVLineEnd(const char *p, const char *end) {
+	const char *eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+	return (eol != nullptr) ? eol : end;
+}
+
+static bool LVIsBlankLine(const char *begin, const char *end) {
+	for (const char *p = begin; p < end; p++) {
+		if (*p != ' ' && *p != '\t' && *p != '\r')
+			return false;
+	}
+	return true;
+}
+
+// Most frequent of tab, comma and semicolon in the line, or ' ' (runs of blanks) if none occur
+static char LVDetectDelimiter(const char *begin, const char *end) {
+	static const char candidates[] = { '\t', ',', ';' };
+
+	char delimiter = ' ';
+	ptrdiff_t best = 0;
+	for (char c : candidates) {
+		ptrdiff_t n = std::count(begin, end, c);
+		if (n > best) {
+			best = n;
+			delimiter = c;
+		}
+	}
+	return delimiter;
+}
+
+// Splits a line into fields, calls field(begin, end) for each field (blanks and enclosing quotes removed)
+// Returns the number of fields
+template<class F>
+static size_t LVSplitFields(const char *begin, const char *end, char delimiter, F field) {
+	size_t count = 0;
+	const char *p = begin;
+
+	// Runs of blanks separate the fields, leading and trailing blanks are ignored
+	if (delimiter == ' ') {
+		for (;;) {
+			while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+				p++;
+			if (p == end)
+				return count;
+
+			const char *start = p;
+			if (*p == '"') {
+				const char *quote = static_cast<const char*>(std::memchr(p + 1, '"', end - p - 1));
+				p = (quote != nullptr) ? quote + 1 : end;
+			}
+			while (p < end && *p != ' ' && *p != '\t' && *p != '\r')
+				p++;
+
+			const char *fieldEnd = p;
+			if (fieldEnd - start >= 2 && *start == '"' && *(fieldEnd - 1) == '"') {
+				start++;
+				fieldEnd--;
+			}
+
+			field(start, fieldEnd);
+			count++;
+		}
+	}
+
+	for (;;) {
+		while (p < end && LVIsFieldBlank(*p, delimiter))
+			p++;
+
+		const char *start = p;
+		const char *next;
+		if (p < end && *p == '"') {
+			// Delimiters within quotes belong to the field
+			const char *quote = static_cast<const char*>(std::memchr(p + 1, '"', end - p - 1));
+			const char *after = (quote != nullptr) ? quote + 1 : end;
+			next = static_cast<const char*>(std::memchr(after, delimiter, end - after));
+		}
+		else {
+			next = static_cast<const char*>(std::memchr(p, delimiter, end - p));
+		}
+
+		const char *fieldEnd = (next != nullptr) ? next : end;
+		while (fieldEnd > start && LVIsFieldBlank(*(fieldEnd - 1), delimiter))
+			fieldEnd--;
+
+		if (fieldEnd - start >= 2 && *start == '"' && *(fieldEnd - 1) == '"') {
+			start++;
+			fieldEnd--;
+		}
+
+		field(start, fieldEnd);
+		count++;
+
+		if (next == nullptr)
+			return count;
+		p = next + 1;
+	}
+}
+
+static inline bool LVIsMissingToken(const char *begin, const char *end) {
+	size_t n = static_cast<size_t>(end - begin);
+	return n == 0 ||
+		(n == 1 && *begin == '?') ||
+		(n == 2 && (std::strncmp(begin, "NA", 2) == 0 || std::strncmp(begin, "na", 2) == 0)) ||
+		(n == 3 && (std::strncmp(begin, "N/A", 3) == 0 || std::strncmp(begin, "n/a", 3) == 0));
+}
+
+enum class LVRowStatus { Ok, Missing, Malformed };
+
+// Parses one line into the label and the feature columns of xRow
+static LVRowStatus LVParseDelimitedRow(const char *begin, const char *end, const LVDelimitedOptions &options, char delimiter,
+	size_t nColumns, size_t labelColumn, double &y, double *xRow, std::string &reason) {
+	size_t column = 0;
+	size_t feature = 0;
+	bool missingLabel = false;
+	bool missingFeature = false;
+	bool malformed = false;
+
+	size_t nFields = LVSplitFields(begin, end, delimiter, [&](const char *fieldBegin, const char *fieldEnd) {
+		if (malformed || column >= nColumns) {
+			column++;
+			return;
+		}
+
+		double value;
+		bool missing = LVIsMissingToken(fieldBegin, fieldEnd);
+		if (!missing) {
+			if (!LVParseDouble(fieldBegin, fieldEnd, value)) {
+				reason = "invalid number '" + std::string(fieldBegin, fieldEnd) + "' in column " + std::to_string(column + 1);
+				malformed = true;
+				column++;
+				return;
+			}
+			missing = std::isnan(value);
+		}
+
+		if (column == labelColumn) {
+			if (missing)
+				missingLabel = true;
+			else
+				y = value;
+		}
+		else {
+			if (missing) {
+				if (!missingFeature)
+					reason = "missing value in column " + std::to_string(column + 1);
+				missingFeature = true;
+				value = options.missingValue;
+			}
+			xRow[feature++] = value;
+		}
+
+		column++;
+	});
+
+	if (malformed)
+		return LVRowStatus::Malformed;
+
+	if (nFields != nColumns) {
+		reason = "expected " + std::to_string(nColumns) + " columns, found " + std::to_string(nFields);
+		return LVRowStatus::Malformed;
+	}
+
+	if (missingLabel) {
+		reason = "missing label";
+		return LVRowStatus::Missing;
+	}
+
+	if (missingFeature && options.missing != LVMissingPolicy::Replace)
+		return LVRowStatus::Missing;
+
+	return LVRowStatus::Ok;
+}
+
+//
+//-- Reader
+//
+
+void LVReadDelimited(const char *data, size_t size, const LVDelimitedOptions &options, LVDenseTable &table) {
+	table = LVDenseTable();
+	const char *end = data + size;
+
+	// Header rows
+	const char *body = data;
+	size_t bodyLine = 1;
+	for (size_t i = 0; i < options.headerRows && body < end; i++) {
+		const char *eol = LVLineEnd(body, end);
+		body = (eol < end) ? eol + 1 : end;
+		bodyLine++;
+	}
+
+	// The first row with content defines the delimiter and the number of columns
+	const char *first = body;
+	while (first < end && LVIsBlankLine(first, LVLineEnd(first, end))) {
+		const char *eol = LVLineEnd(first, end);
+		first = (eol < end) ? eol + 1 : end;
+	}
+
+	if (first == end)
+		return;
+
+	const char *firstEnd = LVLineEnd(first, end);
+	char delimiter = (options.delimiter != '\0') ? options.delimiter : LVDetectDelimiter(first, firstEnd);
+	size_t nColumns = LVSplitFields(first, firstEnd, delimiter, [](const char*, const char*) {});
+
+	size_t labelColumn;
+	if (options.labelColumn == LVLabelColumnNone) {
+		labelColumn = SIZE_MAX;
+		table.cols = nColumns;
+	}
+	else {
+		labelColumn = (options.labelColumn == LVLabelColumnLast) ? nColumns - 1 : static_cast<size_t>(options.labelColumn);
+		if (labelColumn >= nColumns)
+			throw LVException(__FILE__, __LINE__, "The label column (" + std::to_string(labelColumn) + ") does not exist, the file has " + std::to_string(nColumns) + " columns.");
+		table.cols = nColumns - 1;
+	}
+
+	// First pass counts the rows of each chunk, so that the second pass can parse directly into the final arrays
+	std::vector<const char*> bounds = LVSplitLines(body, end, LVThreadCount(static_cast<size_t>(end - body), 1 << 18));
+	size_t nChunks = bounds.size() - 1;
+
+	std::vector<size_t> rowOffset(nChunks + 1, 0);
+	std::vector<size_t> lineOffset(nChunks + 1, 0);
+	LVParallelFor(nChunks, [&](size_t c) {
+		rowOffset[c + 1] = LVCountNonEmptyLines(bounds[c], bounds[c + 1]);
+		lineOffset[c + 1] = LVCountLineBreaks(bounds[c], bounds[c + 1]);
+	});
+
+	for (size_t c = 0; c < nChunks; c++) {
+		rowOffset[c + 1] += rowOffset[c];
+		lineOffset[c + 1] += lineOffset[c];
+	}
+
+	size_t nRows = rowOffset[nChunks];
+	if (nRows > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Number of rows too large (greater than " + std::to_string(INT_MAX) + ").");
+
+	size_t cols = table.cols;
+	table.y.resize(nRows);
+	table.x.resize(nRows * cols);
+
+	// Second pass, each chunk fills its reserved rows (only partially used if rows are skipped)
+	std::vector<size_t> rowCount(nChunks, 0);
+	std::vector<std::vector<uint64_t>> skipped(nChunks);
+
+	LVParallelFor(nChunks, [&](size_t c) {
+		LVScopedCLocale locale;
+		std::string reason;
+		size_t row = rowOffset[c];
+		size_t line = bodyLine + lineOffset[c];
+
+		const char *p = bounds[c];
+		const char *chunkEnd = bounds[c + 1];
+		while (p < chunkEnd) {
+			const char *eol = LVLineEnd(p, chunkEnd);
+
+			if (!LVIsBlankLine(p, eol)) {
+				double y = 0;
+				LVRowStatus status = LVParseDelimitedRow(p, eol, options, delimiter, nColumns, labelColumn, y, table.x.data() + row * cols, reason);
+
+				if (status == LVRowStatus::Ok) {
+					table.y[row] = y;
+					row++;
+				}
+				else if (options.missing == LVMissingPolicy::SkipRow || (status == LVRowStatus::Missing && options.missing == LVMissingPolicy::Replace)) {
+					skipped[c].push_back(line);
+				}
+				else {
+					throw LVException(__FILE__, __LINE__, "Parse error at line " + std::to_string(line) + ": " + reason + ".");
+				}
+			}
+
+			p = (eol < chunkEnd) ? eol + 1 : chunkEnd;
+			line++;
+		}
+
+		rowCount[c] = row - rowOffset[c];
+	});
+
+	// Close the gaps left by skipped rows (chunks only move towards the front, so copying in order is safe)
+	size_t rowDst = 0;
+	for (size_t c = 0; c < nChunks; c++) {
+		size_t rowSrc = rowOffset[c];
+		if (rowDst != rowSrc) {
+			std::copy(table.y.begin() + rowSrc, table.y.begin() + rowSrc + rowCount[c], table.y.begin() + rowDst);
+			std::copy(table.x.begin() + rowSrc * cols, table.x.begin() + (rowSrc + rowCount[c]) * cols, table.x.begin() + rowDst * cols);
+		}
+
+		rowDst += rowCount[c];
+		table.skippedLines.insert(table.skippedLines.end(), skipped[c].begin(), skipped[c].end());
+	}
+
+	table.y.resize(rowDst);
+	table.x.resize(rowDst * cols);
+}
+
+void LVReadDelimitedFile(const char *path, const LVDelimitedOptions &options, LVDenseTable &table) {
+	LVMemoryMap map(path);
+	map.adviseSequential();
+	LVReadDelimited(map.data(), map.size(), options, table);
+}
+
+//
+//-- Conversion
+//
+
+void LVConvertTable(const LVDenseTable &table, LVDataset &dataset) {
+	dataset = LVDataset();
+
+	size_t l = table.rows();
+	size_t cols = table.cols;
+	if (cols > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Number of columns too large (greater than " + std::to_string(INT_MAX) + ").");
+
+	// The columns define the feature space, even if the last columns only contain zeros
+	dataset.y = table.y;
+	dataset.maxIndex = static_cast<int32_t>(cols);
+	dataset.malformedLines = table.skippedLines;
+	dataset.rowStart.assign(l + 1, 0);
+
+	// Count the nonzeros of each row, then fill the nodes in parallel
+	size_t nThreads = LVThreadCount(l * cols, 1 << 16);
+
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			const double *row = table.row(i);
+			dataset.rowStart[i + 1] = static_cast<size_t>(std::count_if(row, row + cols, [](double v) { return v != 0; }));
+		}
+	});
+
+	for (size_t i = 0; i < l; i++)
+		dataset.rowStart[i + 1] += dataset.rowStart[i];
+
+	dataset.index.resize(dataset.rowStart[l]);
+	dataset.value.resize(dataset.rowStart[l]);
+
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			const double *row = table.row(i);
+			size_t node = dataset.rowStart[i];
+			for (size_t j = 0; j < cols; j++) {
+				if (row[j] != 0) {
+					dataset.index[node] = static_cast<int32_t>(j + 1);
+					dataset.value[node] = row[j];
+					node++;
+				}
+			}
+		}
+	});
+}
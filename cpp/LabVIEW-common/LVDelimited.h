@@ -0,0 +1,65 @@
+/// <summary>
+/// Native import of delimited text files (CSV, TSV, ...) with numeric columns.
+/// Files are memory mapped, split on line boundaries and parsed in parallel into a dense row-major table,
+/// which the wrappers then copy into their LabVIEW problem layouts (directly, or via LVDataset for the sparse layouts).
+/// </summary>
+
+#ifndef LVDELIMITED_H_
+#define LVDELIMITED_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "LVDataset.h"
+
+/// <summary> Handling of missing values (empty fields, "NA", "N/A", "?" and NaN). </summary>
+enum class LVMissingPolicy : int32_t {
+	Error = 0,		//!< Missing values are reported as an error with the line number.
+	SkipRow = 1,	//!< Rows with missing values (and malformed rows) are skipped and their line numbers returned.
+	Replace = 2		//!< Missing features are replaced by a constant, rows with a missing label are skipped.
+};
+
+/// <summary> Column selection for the label. </summary>
+const int32_t LVLabelColumnLast = -1;	//!< The last column holds the label.
+const int32_t LVLabelColumnNone = -2;	//!< There is no label column (all labels are zero, e.g. for prediction).
+
+struct LVDelimitedOptions {
+	char delimiter;				//!< Field delimiter, ' ' for runs of blanks, '\0' to detect tab, comma, semicolon or blanks.
+	size_t headerRows;			//!< Number of lines skipped at the beginning of the file.
+	int32_t labelColumn;		//!< Zero-based column of the label, or LVLabelColumnLast/LVLabelColumnNone.
+	LVMissingPolicy missing;
+	double missingValue;		//!< Replacement of missing features (LVMissingPolicy::Replace).
+};
+
+/// <summary> Validates the values passed from LabVIEW and assigns the options. Throws LVException if invalid. </summary>
+LVDelimitedOptions LVMakeDelimitedOptions(uint8_t delimiter, int32_t headerRows, int32_t labelColumn, int32_t missingPolicy, double missingValue);
+
+/// <summary> Dense table of the imported rows. </summary>
+struct LVDenseTable {
+	std::vector<double> y;					//!< Label of each row.
+	std::vector<double> x;					//!< Features, row-major (rows x cols).
+	size_t cols;							//!< Number of feature columns (label column excluded).
+	std::vector<uint64_t> skippedLines;		//!< Line numbers (one-based) of the rows that were skipped.
+
+	LVDenseTable() : cols(0) {}
+
+	size_t rows() const { return y.size(); }
+	const double * row(size_t i) const { return x.data() + i * cols; }
+};
+
+/// <summary>
+/// Parses delimited text into table. The number of columns is defined by the first row after the header,
+/// rows with a different number of columns or non-numeric fields are malformed.
+/// Malformed rows are reported as an LVException with the line number, unless the policy is LVMissingPolicy::SkipRow.
+/// Fields may be enclosed in double quotes, line breaks within fields are not supported.
+/// </summary>
+void LVReadDelimited(const char *data, size_t size, const LVDelimitedOptions &options, LVDenseTable &table);
+
+/// <summary> Memory maps the file at path and parses it with LVReadDelimited. </summary>
+void LVReadDelimitedFile(const char *path, const LVDelimitedOptions &options, LVDenseTable &table);
+
+/// <summary> Converts the table to a sparse dataset in parallel (column j is feature index j+1, zeros are dropped, maxIndex is cols). </summary>
+void LVConvertTable(const LVDenseTable &table, LVDataset &dataset);
+
+#endif // LVDELIMITED_H_
@@ -0,0 +1,400 @@
+/// <summary>
+/// Multi-threaded dual coordinate descent for binary L2-regularized linear classifiers, the problems solved by
+/// liblinear's dual solvers (L2-loss SVM, L1-loss SVM and logistic regression), after the asynchronous (PASSCoDe) scheme:
+///		every task owns a block of the vectors and updates their dual variables in random order,
+///		the resulting changes of w are added to the shared weights with atomic operations (lock-free), no task waits for another.
+/// The tasks run as throughput loops of the thread pool (see LVParallel.h), on the cores that are not reserved for predictions.
+/// The outer iterations (one pass over all vectors) are synchronized to evaluate the stopping criteria of the serial solvers.
+/// Shrinking is not used, every pass visits all vectors.
+/// The node type is a template parameter, since each library declares its own (layout compatible) node struct.
+/// LVDualBlockSolver solves the same problems out of core by block minimization, see below.
+/// </summary>
+
+#ifndef LVDUALCOORDINATEDESCENT_H_
+#define LVDUALCOORDINATEDESCENT_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "LVCancellation.h"
+#include "LVParallel.h"
+
+enum class LVDualLoss {
+	L2Hinge,	// L2R_L2LOSS_SVC_DUAL
+	L1Hinge,	// L2R_L1LOSS_SVC_DUAL
+	Logistic	// L2R_LR_DUAL
+};
+
+struct LVDualParameter {
+	LVDualLoss loss;
+	double Cp;			// Cost of the positive vectors
+	double Cn;			// Cost of the negative vectors
+	double eps;			// Stopping tolerance (as the serial solvers)
+	size_t maxIter;		// Largest number of outer iterations
+	size_t nThreads;	// Largest number of threads (at most one per core is used)
+};
+
+/// <summary> Adds value to target without a lock. </summary>
+inline void LVAtomicAdd(std::atomic<double> &target, double value) {
+	double current = target.load(std::memory_order_relaxed);
+	while (!target.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {}
+}
+
+template<class Node>
+double LVDualDot(const std::atomic<double> *w, const Node *x) {
+	double sum = 0;
+	for (; x->index != -1; x++)
+		sum += w[x->index - 1].load(std::memory_order_relaxed) * x->value;
+	return sum;
+}
+
+template<class Node>
+void LVDualAxpy(double a, const Node *x, std::atomic<double> *w) {
+	for (; x->index != -1; x++)
+		LVAtomicAdd(w[x->index - 1], a * x->value);
+}
+
+/// <summary> Projected gradient statistics of a pass over the vectors (stopping criteria of the serial solvers). </summary>
+struct LVDualStatistics {
+	double PGmax;
+	double PGmin;
+	size_t newtonIter;	// Newton steps of logistic regression
+
+	LVDualStatistics() : PGmax(-std::numeric_limits<double>::infinity()), PGmin(std::numeric_limits<double>::infinity()), newtonIter(0) {}
+
+	void merge(const LVDualStatistics &other) {
+		PGmax = std::max(PGmax, other.PGmax);
+		PGmin = std::min(PGmin, other.PGmin);
+		newtonIter += other.newtonIter;
+	}
+};
+
+/// <summary>
+/// Coordinate update of a single dual variable, the step of liblinear's solve_l2r_l1l2_svc and solve_l2r_lr_dual.
+/// Logistic regression keeps alpha and C - alpha of every vector (two entries per vector), the hinge losses one entry.
+/// </summary>
+class LVDualStep {
+public:
+	explicit LVDualStep(const LVDualParameter &param) : m_logistic(param.loss == LVDualLoss::Logistic), m_eps(param.eps) {
+		// Diagonal and upper bound of the dual variables by class (as the serial solvers, index 0 is negative and 1 positive)
+		m_diag[0] = 0;
+		m_diag[1] = 0;
+		m_upperBound[0] = param.Cn;
+		m_upperBound[1] = param.Cp;
+		if (param.loss == LVDualLoss::L2Hinge) {
+			m_diag[0] = 0.5 / param.Cn;
+			m_diag[1] = 0.5 / param.Cp;
+			m_upperBound[0] = std::numeric_limits<double>::infinity();
+			m_upperBound[1] = std::numeric_limits<double>::infinity();
+		}
+		m_innerEps = 1e-2;
+		m_innerEpsMin = std::min(1e-8, param.eps);
+	}
+
+	/// <summary> Number of dual variables stored per vector. </summary>
+	size_t width() const { return m_logistic ? 2 : 1; }
+
+	/// <summary> Diagonal of Q for a vector with squared norm xTx. </summary>
+	double diagonal(bool positive, double xTx) const { return m_diag[positive ? 1 : 0] + xTx; }
+
+	/// <summary> Initializes the dual variables of a vector, returns the coefficient to add to w (times x). </summary>
+	double initialize(bool positive, double *alpha) const {
+		if (!m_logistic) {
+			alpha[0] = 0;
+			return 0;
+		}
+
+		double C = m_upperBound[positive ? 1 : 0];
+		alpha[0] = std::min(0.001 * C, 1e-8);
+		alpha[1] = C - alpha[0];
+		return (positive ? 1.0 : -1.0) * alpha[0];
+	}
+
+	/// <summary>
+	/// Updates the dual variables of a vector with diagonal QD. wx is w'x before the update,
+	/// returns the coefficient to add to w (times x), 0 if the variables are unchanged.
+	/// </summary>
+	double update(bool positive, double QD, double wx, double *alpha, LVDualStatistics &statistics) const {
+		size_t yi = positive ? 1 : 0;
+		double ysign = positive ? 1.0 : -1.0;
+		double C = m_upperBound[yi];
+
+		if (!m_logistic) {
+			// Projected gradient step of liblinear's solve_l2r_l1l2_svc
+			double G = ysign * wx - 1 + alpha[0] * m_diag[yi];
+			double PG = 0;
+			if (alpha[0] == 0) {
+				if (G < 0)
+					PG = G;
+			}
+			else if (alpha[0] == C) {
+				if (G > 0)
+					PG = G;
+			}
+			else
+				PG = G;
+
+			statistics.PGmax = std::max(statistics.PGmax, PG);
+			statistics.PGmin = std::min(statistics.PGmin, PG);
+
+			if (std::fabs(PG) <= 1.0e-12)
+				return 0;
+
+			double alphaOld = alpha[0];
+			alpha[0] = std::min(std::max(alpha[0] - G / QD, 0.0), C);
+			return (alpha[0] - alphaOld) * ysign;
+		}
+
+		// Newton steps on the one-variable subproblem of liblinear's solve_l2r_lr_dual
+		double a = QD;
+		double b = ysign * wx;
+		size_t ind1 = 0;
+		size_t ind2 = 1;
+		double sign = 1;
+		if (0.5 * a * (alpha[ind2] - alpha[ind1]) + b < 0) {
+			std::swap(ind1, ind2);
+			sign = -1;
+		}
+
+		double alphaOld = alpha[ind1];
+		double z = alphaOld;
+		if (C - z < 0.5 * C)
+			z = 0.1 * z;
+		double gp = a * (z - alphaOld) + sign * b + std::log(z / (C - z));
+		statistics.PGmax = std::max(statistics.PGmax, std::fabs(gp));
+
+		const size_t maxInnerIter = 100;
+		const double eta = 0.1;
+		size_t innerIter = 0;
+		while (innerIter <= maxInnerIter) {
+			if (std::fabs(gp) < m_innerEps)
+				break;
+			double gpp = a + C / (C - z) / z;
+			double tmpz = z - gp / gpp;
+			if (tmpz <= 0)
+				z *= eta;
+			else
+				z = tmpz;
+			gp = a * (z - alphaOld) + sign * b + std::log(z / (C - z));
+			statistics.newtonIter++;
+			innerIter++;
+		}
+
+		if (innerIter == 0)
+			return 0;
+
+		alpha[ind1] = z;
+		alpha[ind2] = C - z;
+		return sign * (z - alphaOld) * ysign;
+	}
+
+	/// <summary>
+	/// Evaluates the stopping criteria of the serial solvers after a pass over all l vectors, returns true if converged.
+	/// Tightens the tolerance of the Newton steps of logistic regression when they are rarely needed (as solve_l2r_lr_dual).
+	/// </summary>
+	bool converged(const LVDualStatistics &statistics, size_t l) {
+		if (!m_logistic)
+			return statistics.PGmax - statistics.PGmin <= m_eps;
+
+		if (statistics.PGmax < m_eps)
+			return true;
+
+		if (statistics.newtonIter <= l / 10)
+			m_innerEps = std::max(m_innerEpsMin, 0.1 * m_innerEps);
+		return false;
+	}
+
+private:
+	bool m_logistic;
+	double m_eps;
+	double m_diag[2];
+	double m_upperBound[2];
+	double m_innerEps;
+	double m_innerEpsMin;
+};
+
+/// <summary>
+/// Solves the dual problem of the l -1 terminated vectors x (feature indices 1 to n) with labels y (> 0 is the positive class).
+/// Writes the n weights to w_out and returns the number of outer iterations, each of which is a checkpoint (see LVCancellation.h).
+/// </summary>
+template<class Node>
+size_t LVSolveDual(const Node * const *x, const double *y, size_t l, size_t n, const LVDualParameter &param, double *w_out) {
+	// More threads than cores would interrupt threads between reading w and updating it, the stale updates slow the convergence
+	size_t nThreads = std::max<size_t>(1, std::min(param.nThreads, LVThreadCount(l, 1024)));
+	LVDualStep step(param);
+	size_t width = step.width();
+
+	std::unique_ptr<std::atomic<double>[]> w(new std::atomic<double>[n]);
+	for (size_t j = 0; j < n; j++)
+		w[j].store(0.0, std::memory_order_relaxed);
+
+	std::vector<double> alpha(width * l, 0.0);
+	std::vector<double> QD(l);
+	std::vector<size_t> index(l);
+	for (size_t i = 0; i < l; i++)
+		index[i] = i;
+
+	std::mt19937 shuffle(0);
+	std::shuffle(index.begin(), index.end(), shuffle);
+
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t s = l * t / nThreads; s < l * (t + 1) / nThreads; s++) {
+			size_t i = index[s];
+			double xTx = 0;
+			for (const Node *xi = x[i]; xi->index != -1; xi++)
+				xTx += xi->value * xi->value;
+			QD[i] = step.diagonal(y[i] > 0, xTx);
+
+			double a = step.initialize(y[i] > 0, &alpha[width * i]);
+			if (a != 0)
+				LVDualAxpy(a, x[i], w.get());
+		}
+	});
+
+	// Statistics of the pass of every thread
+	std::vector<LVDualStatistics> statistics(nThreads);
+	std::vector<std::mt19937> random(nThreads);
+	for (size_t t = 0; t < nThreads; t++)
+		random[t].seed(static_cast<std::mt19937::result_type>(t + 1));
+
+	size_t iter = 0;
+	while (iter < param.maxIter) {
+		LVParallelFor(nThreads, [&](size_t t) {
+			auto begin = index.begin() + l * t / nThreads;
+			auto end = index.begin() + l * (t + 1) / nThreads;
+			std::shuffle(begin, end, random[t]);
+
+			LVDualStatistics pass;
+			for (auto it = begin; it != end; ++it) {
+				size_t i = *it;
+				const Node *xi = x[i];
+
+				double a = step.update(y[i] > 0, QD[i], LVDualDot(w.get(), xi), &alpha[width * i], pass);
+				if (a != 0)
+					LVDualAxpy(a, xi, w.get());
+			}
+
+			statistics[t] = pass;
+		});
+		iter++;
+		LVCheckpoint(1);
+
+		LVDualStatistics all;
+		for (size_t t = 0; t < nThreads; t++)
+			all.merge(statistics[t]);
+		if (step.converged(all, l))
+			break;
+	}
+
+	for (size_t j = 0; j < n; j++)
+		w_out[j] = w[j].load(std::memory_order_relaxed);
+
+	return iter;
+}
+
+/// <summary>
+/// Block minimization (Yu, Hsieh, Chang and Lin, "Large linear classification when data cannot fit in memory"):
+/// the vectors are visited one block at a time, and several coordinate descent passes are run on a block before moving on.
+/// Only w and the dual variables of all vectors stay in memory, the caller loads the blocks (e.g. from a memory mapped file).
+/// An outer iteration visits every block once, the first pass over each block gives the stopping criteria of the serial solvers.
+/// </summary>
+class LVDualBlockSolver {
+public:
+	/// <summary> l vectors with feature indices 1 to n, if bias >= 0 a bias feature (index n+1) with value bias is added to every vector. </summary>
+	LVDualBlockSolver(const LVDualParameter &param, size_t l, size_t n, double bias)
+		: m_step(param), m_l(l), m_n(n), m_bias(bias), m_w(n + (bias >= 0 ? 1 : 0), 0.0), m_alpha(m_step.width() * l, 0.0),
+		m_initialized(l, 0), m_random(0) {}
+
+	/// <summary>
+	/// Runs passes coordinate descent passes over the vectors firstRow to firstRow + rows - 1, vector firstRow + i consists of the nodes
+	/// rowStart[i] to rowStart[i + 1] - 1 of index/value and has label y[i] (> 0 is the positive class).
+	/// </summary>
+	void solveBlock(size_t firstRow, size_t rows, const uint64_t *rowStart, const int32_t *index, const double *value, const double *y, size_t passes) {
+		size_t width = m_step.width();
+		m_QD.resize(rows);
+		m_order.resize(rows);
+
+		for (size_t i = 0; i < rows; i++) {
+			bool positive = (y[i] > 0);
+			double xTx = (m_bias >= 0) ? m_bias * m_bias : 0.0;
+			for (uint64_t k = rowStart[i]; k < rowStart[i + 1]; k++)
+				xTx += value[k] * value[k];
+			m_QD[i] = m_step.diagonal(positive, xTx);
+			m_order[i] = i;
+
+			// The dual variables are initialized on the first visit of a vector
+			if (!m_initialized[firstRow + i]) {
+				double a = m_step.initialize(positive, &m_alpha[width * (firstRow + i)]);
+				if (a != 0)
+					axpy(a, rowStart[i], rowStart[i + 1], index, value);
+				m_initialized[firstRow + i] = 1;
+			}
+		}
+
+		for (size_t pass = 0; pass < passes; pass++) {
+			std::shuffle(m_order.begin(), m_order.end(), m_random);
+
+			LVDualStatistics statistics;
+			for (size_t s = 0; s < rows; s++) {
+				size_t i = m_order[s];
+				double wx = dot(rowStart[i], rowStart[i + 1], index, value);
+				double a = m_step.update(y[i] > 0, m_QD[i], wx, &m_alpha[width * (firstRow + i)], statistics);
+				if (a != 0)
+					axpy(a, rowStart[i], rowStart[i + 1], index, value);
+			}
+
+			if (pass == 0)
+				m_statistics.merge(statistics);
+		}
+	}
+
+	/// <summary> Ends an outer iteration (all blocks visited), returns true if the stopping criteria are met. </summary>
+	bool endIteration() {
+		bool converged = m_step.converged(m_statistics, m_l);
+		m_statistics = LVDualStatistics();
+		return converged;
+	}
+
+	/// <summary> Weights of the features 1 to n, followed by the weight of the bias feature if bias >= 0. </summary>
+	const std::vector<double> & w() const { return m_w; }
+
+private:
+	double dot(uint64_t begin, uint64_t end, const int32_t *index, const double *value) const {
+		double sum = (m_bias >= 0) ? m_w[m_n] * m_bias : 0.0;
+		for (uint64_t k = begin; k < end; k++) {
+			if (index[k] >= 1 && static_cast<size_t>(index[k]) <= m_n)
+				sum += m_w[index[k] - 1] * value[k];
+		}
+		return sum;
+	}
+
+	void axpy(double a, uint64_t begin, uint64_t end, const int32_t *index, const double *value) {
+		if (m_bias >= 0)
+			m_w[m_n] += a * m_bias;
+		for (uint64_t k = begin; k < end; k++) {
+			if (index[k] >= 1 && static_cast<size_t>(index[k]) <= m_n)
+				m_w[index[k] - 1] += a * value[k];
+		}
+	}
+
+	LVDualStep m_step;
+	size_t m_l;
+	size_t m_n;
+	double m_bias;
+	std::vector<double> m_w;
+	std::vector<double> m_alpha;
+	std::vector<char> m_initialized;
+	std::vector<double> m_QD;		// Diagonal of the current block
+	std::vector<size_t> m_order;	// Visiting order within the current block
+	std::mt19937 m_random;
+	LVDualStatistics m_statistics;	// First passes of the current outer iteration
+};
+
+#endif // LVDUALCOORDINATEDESCENT_H_
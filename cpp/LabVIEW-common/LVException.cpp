@@ -67,6 +67,11 @@ void LVException::returnError(lvError * err) {
 	populateErrorCluster(err);
 }
 
+void LVException::returnWarning(lvError * err) {
+	populateErrorCluster(err);
+	err->status = false;
+}
+
 void LVException::returnStdException(lvError * lvErr, const char * file, const int line, std::exception &ex){
 	std::string msg = "Std exception: ";
 	msg += ex.what();
@@ -88,6 +88,10 @@ public:
 	//! @param err A pointer to a labVIEW error cluster.
 	void returnError(lvError * err);
 
+	//! Inserts the exception into a labVIEW error cluster as a warning (status false), for calls that return their results regardless.
+	//! @param err A pointer to a labVIEW error cluster.
+	void returnWarning(lvError * err);
+
 	//! If this flag is set to true, line and file info will be appended to the message regardless of debug/release.
 	void addDebugInfo(bool debug) { m_debug = debug; }
 
@@ -0,0 +1,46 @@
+#include "LVFeatureHashing.h"
+#include "LVException.h"
+
+#include <string>
+
+LVFeatureHashing::LVFeatureHashing(int32_t bits, uint32_t seed, bool sign) : m_bits(bits), m_seed(seed), m_sign(sign) {
+	if (bits < 1 || bits > LVFeatureHashingMaxBits)
+		throw LVException(__FILE__, __LINE__, "The number of hash bits must be between 1 and " + std::to_string(LVFeatureHashingMaxBits) + " (" + std::to_string(bits) + ").");
+}
+
+uint32_t LVFeatureHashing::hash(uint32_t key) const {
+	const uint32_t c1 = 0xcc9e2d51;
+	const uint32_t c2 = 0x1b873593;
+
+	uint32_t k = key * c1;
+	k = (k << 15) | (k >> 17);
+	k *= c2;
+
+	uint32_t h = m_seed ^ k;
+	h = (h << 13) | (h >> 19);
+	h = h * 5 + 0xe6546b64;
+
+	// Length of the key and finalization mix
+	h ^= 4;
+	h ^= h >> 16;
+	h *= 0x85ebca6b;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35;
+	h ^= h >> 16;
+	return h;
+}
+
+void LVWriteBinaryHashing(const LVFeatureHashing &hashing, LVBinaryWriter &writer, LVBinaryHashingSettings &storage) {
+	storage.bits = static_cast<uint32_t>(hashing.bits());
+	storage.seed = hashing.seed();
+	storage.sign = hashing.sign() ? 1 : 0;
+	writer.addSection(LVBinarySectionHashing, &storage, 1);
+}
+
+std::shared_ptr<const LVFeatureHashing> LVReadBinaryHashing(const LVBinaryReader &reader) {
+	if (!reader.hasSection(LVBinarySectionHashing))
+		return nullptr;
+
+	const LVBinaryHashingSettings &settings = reader.scalar<LVBinaryHashingSettings>(LVBinarySectionHashing);
+	return std::make_shared<const LVFeatureHashing>(static_cast<int32_t>(settings.bits), settings.seed, settings.sign != 0);
+}
@@ -0,0 +1,159 @@
+/// <summary>
+/// Feature hashing ("hashing trick") shared by the wrappers.
+/// Raw feature indices of any range are mapped into a fixed space of 2^bits features, so the size of a model
+/// (and the cost of a prediction) no longer depends on the largest index seen in the data.
+/// Features that collide are summed. Optionally, a second hash gives every raw feature a sign, so that collisions cancel out on average.
+/// The settings are stored with models (binary model section, model handles), so that prediction hashes its inputs the same way.
+/// </summary>
+
+#ifndef LVFEATUREHASHING_H_
+#define LVFEATUREHASHING_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "LVTypeDecl.h"
+#include "LVUtility.h"
+#include "LVException.h"
+#include "LVParallel.h"
+#include "LVBinaryModel.h"
+
+class LVFeatureHashing {
+public:
+	/// <summary> Hashing into 2^bits features. Throws LVException if bits is outside of [1, LVFeatureHashingMaxBits]. </summary>
+	LVFeatureHashing(int32_t bits, uint32_t seed, bool sign);
+
+	int32_t bits() const { return m_bits; }
+	uint32_t seed() const { return m_seed; }
+	bool sign() const { return m_sign; }
+
+	/// <summary> Number of hashed features. </summary>
+	int32_t dimension() const { return int32_t(1) << m_bits; }
+
+	/// <summary> Hashed index of a raw index, in [firstIndex, firstIndex + dimension()), and the sign applied to its value. </summary>
+	int32_t index(int32_t raw, int32_t firstIndex, double &sign) const {
+		uint32_t h = hash(static_cast<uint32_t>(raw));
+		sign = (m_sign && (h >> 31) != 0) ? -1.0 : 1.0;
+		return firstIndex + static_cast<int32_t>(h & (static_cast<uint32_t>(dimension()) - 1));
+	}
+
+	/// <summary>
+	/// Hashes the n nodes [x, x + n) into out (replacing its contents) ordered by hashed index.
+	/// Colliding features are summed, features that sum to zero are not stored.
+	/// </summary>
+	template<class Node>
+	void apply(const Node *x, size_t n, int32_t firstIndex, std::vector<Node> &out) const {
+		out.resize(n);
+		for (size_t k = 0; k < n; k++) {
+			double sign;
+			out[k].index = index(x[k].index, firstIndex, sign);
+			out[k].value = sign * x[k].value;
+		}
+
+		std::sort(out.begin(), out.end(), [](const Node &a, const Node &b) { return a.index < b.index; });
+
+		size_t m = 0;
+		for (size_t k = 0; k < n;) {
+			Node node = out[k];
+			for (k++; k < n && out[k].index == node.index; k++)
+				node.value += out[k].value;
+
+			if (node.value != 0)
+				out[m++] = node;
+		}
+		out.resize(m);
+	}
+
+private:
+	/// <summary> MurmurHash3 (32-bit) of a single 4-byte key. </summary>
+	uint32_t hash(uint32_t key) const;
+
+	int32_t m_bits;
+	uint32_t m_seed;
+	bool m_sign;
+};
+
+// Largest number of hash bits (the hashed indices and an extra bias feature must fit in a positive int)
+const int32_t LVFeatureHashingMaxBits = 30;
+
+// Optional section of binary models holding the hashing settings (same id for all wrappers, outside the range used by the wrappers)
+const uint32_t LVBinarySectionHashing = 0x1002;		// LVBinaryHashingSettings
+
+struct LVBinaryHashingSettings {
+	uint32_t bits;
+	uint32_t seed;
+	uint32_t sign;
+};
+
+/// <summary>
+/// Hashes the -1 terminated vector [x, x + n) into out (replacing its contents), the result is -1 terminated as well.
+/// If hasBias, the node before the terminator is the bias feature, it is not hashed but moved to index firstIndex + dimension().
+/// </summary>
+template<class Node>
+void LVHashVector(const LVFeatureHashing &hashing, const Node *x, size_t n, bool hasBias, int32_t firstIndex, std::vector<Node> &out) {
+	size_t nExcluded = hasBias ? 2 : 1;
+	hashing.apply(x, n - nExcluded, firstIndex, out);
+
+	if (hasBias) {
+		Node bias = x[n - 2];
+		bias.index = firstIndex + hashing.dimension();
+		out.push_back(bias);
+	}
+
+	Node terminator = x[n - 1];
+	out.push_back(terminator);
+}
+
+/// <summary>
+/// Copies sparse vectors with their features hashed (see LVHashVector), the bias feature is kept if hasBias.
+/// The vectors must be -1 terminated (preceded by the bias feature if hasBias).
+/// </summary>
+template<class Node>
+void LVHashSparse(const LVArray_Hdl<LVArray_Hdl<Node>> x_in, bool hasBias, const LVFeatureHashing &hashing, int32_t firstIndex, LVArray_Hdl<LVArray_Hdl<Node>> &x_out) {
+	size_t l = (*x_in)->dimSize;
+	const LVArray_Hdl<Node> *x = (*x_in)->elt;
+	size_t nExcluded = hasBias ? 2 : 1;
+
+	// First pass: number of nodes of every hashed vector (collisions shrink the vectors, so they are hashed twice)
+	std::vector<size_t> size(l);
+	size_t nThreads = LVThreadCount(l, 256);
+	LVParallelFor(nThreads, [&](size_t t) {
+		std::vector<Node> hashed;
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			if (x[i] == nullptr || (*x[i])->dimSize < nExcluded || (*x[i])->elt[(*x[i])->dimSize - 1].index != -1)
+				throw LVException(__FILE__, __LINE__, "The index of the last element of each feature vector needs to be -1" + std::string(hasBias ? ", preceded by the bias feature" : "") + " (vector " + std::to_string(i) + ").");
+
+			LVHashVector(hashing, (*x[i])->elt, (*x[i])->dimSize, hasBias, firstIndex, hashed);
+			size[i] = hashed.size();
+		}
+	});
+
+	// Handles are allocated on the calling thread, the nodes are hashed in parallel
+	LVResizeHandleArrayHandle(x_out, l);
+	for (size_t i = 0; i < l; i++) {
+		LVResizeCompositeArrayHandle((*x_out)->elt[i], size[i]);
+		(*(*x_out)->elt[i])->dimSize = static_cast<uint32_t>(size[i]);
+	}
+	(*x_out)->dimSize = static_cast<uint32_t>(l);
+
+	LVArray_Hdl<Node> *out = (*x_out)->elt;
+	LVParallelFor(nThreads, [&](size_t t) {
+		std::vector<Node> hashed;
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			LVHashVector(hashing, (*x[i])->elt, (*x[i])->dimSize, hasBias, firstIndex, hashed);
+			std::copy(hashed.begin(), hashed.end(), (*out[i])->elt);
+		}
+	});
+}
+
+/// <summary> Adds the hashing section to a binary model, storage must stay valid until the model has been written. </summary>
+void LVWriteBinaryHashing(const LVFeatureHashing &hashing, LVBinaryWriter &writer, LVBinaryHashingSettings &storage);
+
+/// <summary> Returns the hashing stored in a binary model, or nullptr if there is none. </summary>
+std::shared_ptr<const LVFeatureHashing> LVReadBinaryHashing(const LVBinaryReader &reader);
+
+#endif // LVFEATUREHASHING_H_
@@ -0,0 +1,140 @@
+#include "LVFeatureSelection.h"
+#include "LVScaling.h"
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+//
+//-- F-score
+//
+
+LVClassStatistics::LVClassStatistics(size_t nClasses, size_t nFeatures)
+	: m_nClasses(nClasses), m_nFeatures(nFeatures), m_offset(0), m_samples(nClasses, 0),
+	m_count(nClasses * nFeatures, 0), m_mean(nClasses * nFeatures, 0), m_m2(nClasses * nFeatures, 0) {}
+
+void LVClassStatistics::merge(const LVClassStatistics &other) {
+	for (size_t c = 0; c < m_nClasses; c++)
+		m_samples[c] += other.m_samples[c];
+
+	for (size_t k = 0; k < m_count.size(); k++)
+		LVMergeMoments(m_count[k], m_mean[k], m_m2[k], other.m_count[k], other.m_mean[k], other.m_m2[k]);
+}
+
+std::vector<double> LVClassStatistics::fscores() const {
+	uint64_t nSamples = std::accumulate(m_samples.begin(), m_samples.end(), uint64_t(0));
+	std::vector<double> scores(m_nFeatures, 0.0);
+	std::vector<double> mean(m_nClasses);
+	std::vector<double> variance(m_nClasses);
+
+	for (size_t j = 0; j < m_nFeatures; j++) {
+		double total = 0;
+		for (size_t c = 0; c < m_nClasses; c++) {
+			size_t k = c * m_nFeatures + j;
+			uint64_t count = m_count[k];
+			double m = m_mean[k];
+			double m2 = m_m2[k];
+
+			// Rows without a stored value are zero for this feature
+			if (count < m_samples[c])
+				LVMergeMoments(count, m, m2, m_samples[c] - count, 0.0, 0.0);
+
+			mean[c] = m;
+			variance[c] = (count > 1) ? m2 / static_cast<double>(count - 1) : 0.0;
+			total += m * static_cast<double>(count);
+		}
+		total /= static_cast<double>(nSamples);
+
+		double between = 0;
+		double within = 0;
+		for (size_t c = 0; c < m_nClasses; c++) {
+			between += (mean[c] - total) * (mean[c] - total);
+			within += variance[c];
+		}
+
+		if (within > 0)
+			scores[j] = between / within;
+		else
+			scores[j] = (between > 0) ? std::numeric_limits<double>::infinity() : 0.0;
+	}
+
+	return scores;
+}
+
+size_t LVClassIndices(const double *y, size_t l, std::vector<size_t> &classIndex) {
+	std::vector<double> labels(y, y + l);
+	std::sort(labels.begin(), labels.end());
+	labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+
+	classIndex.resize(l);
+	for (size_t i = 0; i < l; i++) {
+		if (std::isnan(y[i]))
+			throw LVException(__FILE__, __LINE__, "Label " + std::to_string(i) + " is NaN.");
+		classIndex[i] = static_cast<size_t>(std::lower_bound(labels.begin(), labels.end(), y[i]) - labels.begin());
+	}
+
+	return labels.size();
+}
+
+//
+//-- Ranking and selection
+//
+
+std::vector<int32_t> LVRankFeatures(const std::vector<double> &scores, size_t firstIndex) {
+	std::vector<int32_t> ranking;
+	for (size_t j = firstIndex; j < scores.size(); j++)
+		ranking.push_back(static_cast<int32_t>(j));
+
+	std::stable_sort(ranking.begin(), ranking.end(), [&scores](int32_t a, int32_t b) {
+		if (std::isnan(scores[b]))
+			return !std::isnan(scores[a]);
+		return scores[a] > scores[b];
+	});
+
+	return ranking;
+}
+
+std::vector<char> LVSelectionMask(const int32_t *features, size_t nSelected, int32_t firstIndex, size_t nFeatures) {
+	if (features == nullptr || nSelected == 0)
+		throw LVException(__FILE__, __LINE__, "No features selected.");
+
+	int32_t maxIndex = *std::max_element(features, features + nSelected);
+	std::vector<char> mask(static_cast<size_t>(std::max(maxIndex, 0)) + 1, 0);
+	for (size_t k = 0; k < nSelected; k++) {
+		int32_t index = features[k];
+		if (index < firstIndex || (nFeatures > 0 && static_cast<size_t>(index) >= nFeatures))
+			throw LVException(__FILE__, __LINE__, "Invalid feature index " + std::to_string(index) + " in the selection.");
+		mask[index] = 1;
+	}
+
+	return mask;
+}
+
+void LVSelectDense(const LVArray_Hdl<LVArray_Hdl<double>> x_in, const std::vector<int32_t> &columns, LVArray_Hdl<LVArray_Hdl<double>> &x_out) {
+	size_t l = (*x_in)->dimSize;
+	size_t n = columns.size();
+	if (n == 0 || n > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Invalid number of selected features (" + std::to_string(n) + ").");
+
+	// Handles are allocated on the calling thread, the values are gathered in parallel
+	LVResizeHandleArrayHandle(x_out, l);
+	for (size_t i = 0; i < l; i++) {
+		LVResizeNumericArrayHandle((*x_out)->elt[i], n);
+		(*(*x_out)->elt[i])->dimSize = static_cast<uint32_t>(n);
+	}
+	(*x_out)->dimSize = static_cast<uint32_t>(l);
+
+	const LVArray_Hdl<double> *x = (*x_in)->elt;
+	LVArray_Hdl<double> *out = (*x_out)->elt;
+	size_t nThreads = LVThreadCount(l * n, 1 << 16);
+
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			const double *values = (x[i] != nullptr) ? (*x[i])->elt : nullptr;
+			size_t length = (x[i] != nullptr) ? (*x[i])->dimSize : 0;
+			double *selected = (*out[i])->elt;
+			for (size_t k = 0; k < n; k++)
+				selected[k] = (static_cast<size_t>(columns[k]) < length) ? values[columns[k]] : 0.0;
+		}
+	});
+}
@@ -0,0 +1,170 @@
+/// <summary>
+/// Feature ranking and selection shared by the three wrappers.
+///		F-score		between-class over within-class variance of every feature (as libsvm's fselect tool),
+///					the statistics of all classes and features are gathered in a single parallel pass
+///		selection	copies a problem keeping only the selected features (e.g. the best ranked ones)
+/// Recursive feature elimination needs a trained linear model and is implemented by LabVIEW-liblinear.
+/// </summary>
+
+#ifndef LVFEATURESELECTION_H_
+#define LVFEATURESELECTION_H_
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LVTypeDecl.h"
+#include "LVUtility.h"
+#include "LVException.h"
+#include "LVParallel.h"
+
+// Largest size of the per-thread class statistics of the F-score, fewer threads are used for problems with many classes and features
+const size_t LVFScoreMaxStatisticsBytes = size_t(256) << 20;
+
+/// <summary>
+/// Running mean and variance of the stored values of every feature, separately for every class.
+/// Each thread accumulates its own rows, the partial results are merged afterwards.
+/// </summary>
+class LVClassStatistics {
+public:
+	LVClassStatistics(size_t nClasses, size_t nFeatures);
+
+	/// <summary> Selects the class of the following values and counts a sample of it. </summary>
+	void beginRow(size_t classIndex) {
+		m_offset = classIndex * m_nFeatures;
+		m_samples[classIndex]++;
+	}
+
+	/// <summary> Adds a stored value of feature index of the current row (indices outside of [0, nFeatures) are ignored). </summary>
+	void add(int32_t index, double value) {
+		if (index < 0 || static_cast<size_t>(index) >= m_nFeatures)
+			return;
+
+		// Welford's update
+		size_t k = m_offset + static_cast<size_t>(index);
+		uint64_t n = ++m_count[k];
+		double delta = value - m_mean[k];
+		m_mean[k] += delta / static_cast<double>(n);
+		m_m2[k] += delta * (value - m_mean[k]);
+	}
+
+	/// <summary> Merges the statistics of another set of rows. </summary>
+	void merge(const LVClassStatistics &other);
+
+	/// <summary>
+	/// Computes the F-score of every feature, sum_c (mean_c - mean)^2 / sum_c var_c (the fselect formula for two classes).
+	/// Features without stored values in some rows are zero in those rows (sparse layouts).
+	/// Features that are constant within every class score +inf if the class means differ, zero otherwise.
+	/// </summary>
+	std::vector<double> fscores() const;
+
+private:
+	size_t m_nClasses;
+	size_t m_nFeatures;
+	size_t m_offset;
+	std::vector<uint64_t> m_samples;	// Samples of every class
+	std::vector<uint64_t> m_count;		// Stored values (class x feature)
+	std::vector<double> m_mean;
+	std::vector<double> m_m2;
+};
+
+/// <summary> Maps every label to its class (the position of the label among the sorted distinct labels), returns the number of classes. </summary>
+size_t LVClassIndices(const double *y, size_t l, std::vector<size_t> &classIndex);
+
+/// <summary>
+/// Computes the F-score of l rows with features [0, nFeatures) in parallel, y are the class labels.
+/// addRow(i, statistics) must add the stored values of row i, it is called concurrently for different rows.
+/// </summary>
+template<class F>
+std::vector<double> LVComputeFScores(const double *y, size_t l, size_t nFeatures, F addRow) {
+	std::vector<size_t> classIndex;
+	size_t nClasses = LVClassIndices(y, l, classIndex);
+	if (nClasses < 2)
+		throw LVException(__FILE__, __LINE__, "The F-score requires at least two classes (distinct labels).");
+
+	// The statistics of every thread hold nClasses x nFeatures entries
+	size_t statisticsBytes = nClasses * nFeatures * (sizeof(uint64_t) + 2 * sizeof(double));
+	size_t nThreads = std::min(LVThreadCount(l, 1024), std::max<size_t>(1, LVFScoreMaxStatisticsBytes / std::max<size_t>(1, statisticsBytes)));
+	std::vector<LVClassStatistics> statistics(nThreads, LVClassStatistics(nClasses, nFeatures));
+
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			statistics[t].beginRow(classIndex[i]);
+			addRow(i, statistics[t]);
+		}
+	});
+
+	for (size_t t = 1; t < nThreads; t++)
+		statistics[0].merge(statistics[t]);
+
+	return statistics[0].fscores();
+}
+
+/// <summary>
+/// Returns the features [firstIndex, scores.size()) ordered from the highest to the lowest score (ties in ascending index order).
+/// NaN scores are ranked last.
+/// </summary>
+std::vector<int32_t> LVRankFeatures(const std::vector<double> &scores, size_t firstIndex);
+
+/// <summary>
+/// Validates the selected feature indices (at least firstIndex, and less than nFeatures if nFeatures > 0) and returns a mask by index.
+/// Throws LVException if the selection is empty or an index is invalid.
+/// </summary>
+std::vector<char> LVSelectionMask(const int32_t *features, size_t nSelected, int32_t firstIndex, size_t nFeatures);
+
+/// <summary>
+/// Copies sparse vectors keeping only the features selected in mask (indices are kept), the bias feature is kept if hasBias.
+/// The vectors must be -1 terminated (preceded by the bias feature if hasBias).
+/// </summary>
+template<class Node>
+void LVSelectSparse(const LVArray_Hdl<LVArray_Hdl<Node>> x_in, bool hasBias, const std::vector<char> &mask, LVArray_Hdl<LVArray_Hdl<Node>> &x_out) {
+	size_t l = (*x_in)->dimSize;
+	const LVArray_Hdl<Node> *x = (*x_in)->elt;
+	size_t nExcluded = hasBias ? 2 : 1;
+
+	auto selected = [&mask](int32_t index) {
+		return index >= 0 && static_cast<size_t>(index) < mask.size() && mask[index] != 0;
+	};
+
+	// First pass: number of selected nodes of every vector
+	std::vector<size_t> size(l);
+	size_t nThreads = LVThreadCount(l, 256);
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			if (x[i] == nullptr || (*x[i])->dimSize < nExcluded || (*x[i])->elt[(*x[i])->dimSize - 1].index != -1)
+				throw LVException(__FILE__, __LINE__, "The index of the last element of each feature vector needs to be -1" + std::string(hasBias ? ", preceded by the bias feature" : "") + " (vector " + std::to_string(i) + ").");
+
+			const Node *xi = (*x[i])->elt;
+			size_t n = (*x[i])->dimSize - nExcluded;
+			size[i] = nExcluded + static_cast<size_t>(std::count_if(xi, xi + n, [&](const Node &node) { return selected(node.index); }));
+		}
+	});
+
+	// Handles are allocated on the calling thread, the nodes are copied in parallel
+	LVResizeHandleArrayHandle(x_out, l);
+	for (size_t i = 0; i < l; i++) {
+		LVResizeCompositeArrayHandle((*x_out)->elt[i], size[i]);
+		(*(*x_out)->elt[i])->dimSize = static_cast<uint32_t>(size[i]);
+	}
+	(*x_out)->dimSize = static_cast<uint32_t>(l);
+
+	LVArray_Hdl<Node> *out = (*x_out)->elt;
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			const Node *xi = (*x[i])->elt;
+			size_t n = (*x[i])->dimSize - nExcluded;
+			Node *node = std::copy_if(xi, xi + n, (*out[i])->elt, [&](const Node &node) { return selected(node.index); });
+
+			// Bias feature and terminator
+			std::copy(xi + n, xi + n + nExcluded, node);
+		}
+	});
+}
+
+/// <summary> Copies dense vectors keeping only the given columns (in the given order), columns beyond the end of a vector are zero. </summary>
+void LVSelectDense(const LVArray_Hdl<LVArray_Hdl<double>> x_in, const std::vector<int32_t> &columns, LVArray_Hdl<LVArray_Hdl<double>> &x_out);
+
+#endif // LVFEATURESELECTION_H_
@@ -0,0 +1,195 @@
+#include "LVGridSearch.h"
+#include "LVThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <random>
+
+LVProgressReporter::LVProgressReporter(const std::shared_ptr<const LVCancellationToken> &token) : m_event(token ? token->progressEvent() : 0), m_start(std::chrono::steady_clock::now()) {}
+
+void LVProgressReporter::fold(size_t point, size_t fold, double C, double gamma, double score) const {
+	post(LVProgressKind::Fold, point, static_cast<int32_t>(fold), C, gamma, score);
+}
+
+void LVProgressReporter::point(size_t point, double C, double gamma, double score) const {
+	post(LVProgressKind::GridPoint, point, -1, C, gamma, score);
+}
+
+void LVProgressReporter::post(LVProgressKind kind, size_t point, int32_t fold, double C, double gamma, double score) const {
+	if (m_event == 0)
+		return;
+
+	LVProgressEvent event;
+	event.kind = static_cast<int32_t>(kind);
+	event.point = static_cast<int32_t>(point);
+	event.fold = fold;
+	event.C = C;
+	event.gamma = gamma;
+	event.score = score;
+	event.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+	PostLVUserEvent(m_event, &event);
+}
+
+LVFolds LVMakeFolds(const double *y, size_t l, size_t nr_fold, bool stratified) {
+	nr_fold = std::min(nr_fold, l);
+
+	LVFolds folds;
+	folds.perm.resize(l);
+	folds.start.resize(nr_fold + 1);
+
+	std::mt19937 random(0);
+
+	if (!stratified || nr_fold == l) {
+		for (size_t i = 0; i < l; i++)
+			folds.perm[i] = i;
+		std::shuffle(folds.perm.begin(), folds.perm.end(), random);
+
+		for (size_t f = 0; f <= nr_fold; f++)
+			folds.start[f] = f * l / nr_fold;
+		return folds;
+	}
+
+	// Vectors grouped by class (in order of appearance), shuffled within each class
+	std::vector<double> labels;
+	std::vector<size_t> class_of(l);
+	for (size_t i = 0; i < l; i++) {
+		size_t c = static_cast<size_t>(std::find(labels.begin(), labels.end(), y[i]) - labels.begin());
+		if (c == labels.size())
+			labels.push_back(y[i]);
+		class_of[i] = c;
+	}
+
+	size_t nr_class = labels.size();
+	std::vector<size_t> count(nr_class, 0);
+	for (size_t i = 0; i < l; i++)
+		count[class_of[i]]++;
+
+	std::vector<size_t> class_start(nr_class + 1, 0);
+	for (size_t c = 0; c < nr_class; c++)
+		class_start[c + 1] = class_start[c] + count[c];
+
+	std::vector<size_t> index(l);
+	std::vector<size_t> next(class_start.begin(), class_start.end() - 1);
+	for (size_t i = 0; i < l; i++)
+		index[next[class_of[i]]++] = i;
+
+	for (size_t c = 0; c < nr_class; c++)
+		std::shuffle(index.begin() + class_start[c], index.begin() + class_start[c + 1], random);
+
+	// Every fold receives its share of every class
+	folds.start[0] = 0;
+	for (size_t f = 0; f < nr_fold; f++) {
+		size_t fold_count = 0;
+		for (size_t c = 0; c < nr_class; c++)
+			fold_count += (f + 1) * count[c] / nr_fold - f * count[c] / nr_fold;
+		folds.start[f + 1] = folds.start[f] + fold_count;
+	}
+
+	std::vector<size_t> position(folds.start.begin(), folds.start.end() - 1);
+	for (size_t c = 0; c < nr_class; c++) {
+		for (size_t f = 0; f < nr_fold; f++) {
+			size_t begin = class_start[c] + f * count[c] / nr_fold;
+			size_t end = class_start[c] + (f + 1) * count[c] / nr_fold;
+			for (size_t j = begin; j < end; j++)
+				folds.perm[position[f]++] = index[j];
+		}
+	}
+
+	return folds;
+}
+
+std::vector<double> LVCrossValidateGrid(const std::vector<LVGridPoint> &points, const LVFolds &folds, std::shared_ptr<const LVCancellationToken> token, const std::function<double(size_t, size_t)> &evaluate, std::unique_ptr<LVStopped> &stopped_out) {
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	size_t n_points = points.size();
+	size_t n_folds = folds.count();
+	double l = static_cast<double>(folds.perm.size());
+
+	LVProgressReporter progress(token);
+
+	std::mutex mutex;			// Guards the members of the grid points below
+	std::vector<std::unique_ptr<LVStopCondition>> conditions(n_points);	// Created by the first fold of the point, which starts its budgets
+	std::vector<double> loss(n_points, 0.0);
+	std::vector<size_t> remaining(n_points, n_folds);
+	std::vector<char> abandoned(n_points, 0);	// Set by the first fold of the point that exceeds the budgets
+	std::vector<double> scores(n_points, nan);
+
+	try {
+		// The tasks are claimed in order, fold by fold of one grid point after the other
+		LVThreadPool::instance().parallelFor(n_points * n_folds, [&](size_t t) {
+			size_t p = t / n_folds;
+			size_t f = t % n_folds;
+
+			LVStopCondition *condition;
+			bool skip;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!conditions[p])
+					conditions[p].reset(new LVStopCondition(token));
+				condition = conditions[p].get();
+				skip = abandoned[p] != 0;
+			}
+
+			// A grid point that exceeds its budgets is abandoned, its remaining folds are not trained. A cancellation ends the search
+			double fold_loss = nan;
+			if (!skip) {
+				try {
+					LVStopScope scope(condition);
+					LVCheckpoint();
+					double evaluated = evaluate(p, f);
+
+					// A fold that exceeded the budgets while it trained abandons its point as well
+					LVCheckpoint();
+					fold_loss = evaluated;
+				}
+				catch (LVStopped &ex) {
+					if (ex.reason() == LVStopReason::Cancelled)
+						throw;
+
+					std::lock_guard<std::mutex> lock(mutex);
+					abandoned[p] = 1;
+					if (!stopped_out)
+						stopped_out.reset(new LVStopped(ex));
+				}
+			}
+
+			if (!std::isnan(fold_loss))
+				progress.fold(p, f, points[p].C, points[p].gamma, fold_loss / static_cast<double>(folds.size(f)));
+
+			bool finished;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				loss[p] += fold_loss;
+				finished = --remaining[p] == 0;
+				if (finished)
+					scores[p] = loss[p] / l;
+			}
+
+			if (finished)
+				progress.point(p, points[p].C, points[p].gamma, loss[p] / l);
+		}, LVWorkPriority::Throughput);
+	}
+	catch (LVStopped &ex) {
+		stopped_out.reset(new LVStopped(ex));
+	}
+
+	if (std::none_of(scores.begin(), scores.end(), [](double score) { return !std::isnan(score); })) {
+		if (stopped_out)
+			throw LVStopped(*stopped_out);
+		throw LVException(__FILE__, __LINE__, "The grid search has no grid points.");
+	}
+
+	return scores;
+}
+
+size_t LVBestGridPoint(const std::vector<double> &scores, bool regression) {
+	size_t best = scores.size();
+	for (size_t p = 0; p < scores.size(); p++) {
+		if (std::isnan(scores[p]))
+			continue;
+		if (best == scores.size() || (regression ? scores[p] < scores[best] : scores[p] > scores[best]))
+			best = p;
+	}
+	return best;
+}
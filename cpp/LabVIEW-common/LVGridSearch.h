@@ -0,0 +1,94 @@
+/// <summary>
+/// Cross-validated parameter searches with live progress for LabVIEW.
+/// Every fold and grid point is posted as an LVProgressEvent to the progress user event of the run's cancellation token
+/// (see LVCancellation.h) as soon as it has finished, so the VI can draw a partial heatmap and cancel or narrow the search.
+/// LVCrossValidateGrid runs the folds of all grid points as tasks of the thread pool, claimed point by point:
+/// the points run in parallel and still finish roughly in order. Every grid point has the budgets of the token,
+/// a point that exceeds them is abandoned (NaN score) while the search goes on, a cancellation ends the search.
+/// </summary>
+
+#ifndef LVGRIDSEARCH_H_
+#define LVGRIDSEARCH_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <extcode.h>
+
+#include "LVCancellation.h"
+
+enum class LVProgressKind : int32_t {
+	Fold = 0,
+	GridPoint = 1
+};
+
+#include <lv_prolog.h>
+
+// Data of the progress user event (LabVIEW cluster)
+struct LVProgressEvent {
+	int32_t kind;		// LVProgressKind
+	int32_t point;		// Position of the grid point in the search
+	int32_t fold;		// -1 for grid points
+	double C;
+	double gamma;		// NaN for searches without gamma (liblinear)
+	double score;		// Accuracy (classification) or mean squared error (regression) of the fold or grid point, NaN if abandoned
+	double elapsed;		// Seconds since the start of the search
+};
+
+#include <lv_epilog.h>
+
+/// <summary> Posts the progress events of a search, the elapsed time is counted from the construction. Thread-safe. </summary>
+class LVProgressReporter {
+public:
+	/// <summary> Posts to the progress event of the token, nothing without token or event. </summary>
+	explicit LVProgressReporter(const std::shared_ptr<const LVCancellationToken> &token);
+
+	void fold(size_t point, size_t fold, double C, double gamma, double score) const;
+
+	void point(size_t point, double C, double gamma, double score) const;
+
+private:
+	void post(LVProgressKind kind, size_t point, int32_t fold, double C, double gamma, double score) const;
+
+	LVUserEventRef m_event;
+	std::chrono::steady_clock::time_point m_start;
+};
+
+/// <summary> Assignment of the vectors to folds: the vectors of fold f are perm[start[f]] to perm[start[f + 1] - 1]. </summary>
+struct LVFolds {
+	std::vector<size_t> perm;
+	std::vector<size_t> start;
+
+	size_t count() const { return start.size() - 1; }
+	size_t size(size_t f) const { return start[f + 1] - start[f]; }
+};
+
+/// <summary>
+/// Splits l vectors into nr_fold folds (leave-one-out if nr_fold exceeds l) as svm_cross_validation:
+/// stratified by the labels y for classification, random otherwise. The order is drawn from a fixed seed,
+/// so every grid point of a search (and every search of the same problem) uses the same folds.
+/// </summary>
+LVFolds LVMakeFolds(const double *y, size_t l, size_t nr_fold, bool stratified);
+
+struct LVGridPoint {
+	double C;
+	double gamma;
+};
+
+/// <summary>
+/// Cross-validates every grid point on the given folds and returns the score of each, NaN for abandoned points.
+/// evaluate(point, fold) trains on the vectors outside the fold and returns the summed loss of the vectors in the fold:
+/// the number of correct predictions (classification) or the sum of squared errors (regression).
+/// If the search ends early (cancellation) or points were abandoned, the scores so far are returned and stopped_out holds the reason,
+/// LVStopped is thrown if no point has finished.
+/// </summary>
+std::vector<double> LVCrossValidateGrid(const std::vector<LVGridPoint> &points, const LVFolds &folds, std::shared_ptr<const LVCancellationToken> token, const std::function<double(size_t, size_t)> &evaluate, std::unique_ptr<LVStopped> &stopped_out);
+
+/// <summary> Position of the best score (highest accuracy or lowest error), NaN scores are skipped. Ties keep the first point. </summary>
+size_t LVBestGridPoint(const std::vector<double> &scores, bool regression);
+
+#endif // LVGRIDSEARCH_H_
@@ -0,0 +1,94 @@
+/// <summary>
+/// Registry of native objects that are referenced from LabVIEW through opaque 64-bit handles.
+/// LabVIEW cannot validate raw pointers, so only handle values are passed across the Call Library Node.
+/// Stale or foreign handles are detected and reported as errors instead of crashing LabVIEW.
+/// </summary>
+
+#ifndef LVHANDLEREGISTRY_H_
+#define LVHANDLEREGISTRY_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "LVException.h"
+
+/// <summary>
+/// Thread-safe map from handle values to shared objects.
+/// Objects are shared, so an object stays alive while a call that looked it up is still using it,
+/// even if the handle is released concurrently.
+/// </summary>
+template<class T>
+class LVHandleRegistry {
+public:
+	/// <summary> The tag is stored in the upper 32 bits of every handle, so handles from other registries are rejected. </summary>
+	explicit LVHandleRegistry(uint32_t tag) : m_tag(static_cast<uint64_t>(tag) << 32), m_counter(0) {}
+
+	// Registries are process-wide singletons
+	LVHandleRegistry(const LVHandleRegistry&) = delete;
+	LVHandleRegistry& operator=(const LVHandleRegistry&) = delete;
+
+	/// <summary> Registers the object and returns its handle (never zero). </summary>
+	uint64_t add(std::shared_ptr<T> object) {
+		if (!object)
+			throw LVException(__FILE__, __LINE__, "Attempted to register a null object.");
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		// Counter wraps within the lower 32 bits, skipping zero and handles still in use
+		uint64_t handle;
+		do {
+			m_counter = (m_counter + 1) & 0xFFFFFFFFu;
+			handle = m_tag | m_counter;
+		} while (m_counter == 0 || m_objects.count(handle) != 0);
+
+		m_objects.emplace(handle, std::move(object));
+		return handle;
+	}
+
+	/// <summary> Returns the object referenced by the handle. Throws LVException if the handle is invalid. </summary>
+	std::shared_ptr<T> get(uint64_t handle) const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_objects.find(handle);
+		if (it == m_objects.end())
+			throw LVException(__FILE__, __LINE__, "Invalid handle (" + std::to_string(handle) + "), it was either never created, already released or belongs to another library.");
+		return it->second;
+	}
+
+	/// <summary> Releases the handle. The object is destroyed once no call is using it. Throws LVException if the handle is invalid. </summary>
+	void remove(uint64_t handle) {
+		std::shared_ptr<T> object;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto it = m_objects.find(handle);
+			if (it == m_objects.end())
+				throw LVException(__FILE__, __LINE__, "Invalid handle (" + std::to_string(handle) + "), it was either never created, already released or belongs to another library.");
+			object = std::move(it->second);
+			m_objects.erase(it);
+		}
+		// The object is destroyed here (outside the lock) if this was the last reference
+	}
+
+	/// <summary> Returns the number of live handles. </summary>
+	size_t size() const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_objects.size();
+	}
+
+private:
+	const uint64_t m_tag;
+	uint64_t m_counter;
+	mutable std::mutex m_mutex;
+	std::unordered_map<uint64_t, std::shared_ptr<T>> m_objects;
+};
+
+// Handle tags of each library (ASCII, for readability when debugging)
+const uint32_t LVHandleTagSparse = 0x53564D53;	// "SVMS"
+const uint32_t LVHandleTagDense = 0x53564D44;	// "SVMD"
+const uint32_t LVHandleTagLinear = 0x4C494E52;	// "LINR"
+const uint32_t LVHandleTagAuto = 0x4155544F;	// "AUTO" (models trained by the engine selected with LVsvm_train_auto)
+const uint32_t LVHandleTagJob = 0x4A4F4253;	// "JOBS" (asynchronous jobs, see LVJobQueue.h)
+const uint32_t LVHandleTagToken = 0x53544F50;	// "STOP" (cancellation tokens, see LVCancellation.h)
+
+#endif // LVHANDLEREGISTRY_H_
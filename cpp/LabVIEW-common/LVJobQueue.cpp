@@ -0,0 +1,283 @@
+#include "LVJobQueue.h"
+#include "LVException.h"
+#include "LVThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+
+LVJob::LVJob() : m_state(LVJobState::Queued), m_completion(0), m_handle(0), m_token(std::make_shared<LVCancellationToken>(0, 0)) {}
+
+void LVJob::setLogEvent(LVUserEventRef event) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_token->setLogEvent(event, m_handle);
+}
+
+LVJobState LVJob::state() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_state;
+}
+
+int64_t LVJob::iterations() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_condition ? m_condition->iterations() : 0;
+}
+
+bool LVJob::wait(int32_t timeoutMs) const {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	auto finished = [this] { return m_state == LVJobState::Completed || m_state == LVJobState::Failed; };
+	if (timeoutMs < 0) {
+		m_finished.wait(lock, finished);
+		return true;
+	}
+	return m_finished.wait_for(lock, std::chrono::milliseconds(timeoutMs), finished);
+}
+
+void LVJob::join() const {
+	wait(-1);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_error)
+		std::rethrow_exception(m_error);
+}
+
+struct LVJobQueue::Runner {
+	std::thread thread;
+	std::shared_ptr<LVJob> job;		// Job in progress, nullptr between jobs
+	bool running;
+
+	Runner() : running(false) {}
+};
+
+// Job threads and queued jobs, kept alive by the running job threads
+struct LVJobQueue::State : std::enable_shared_from_this<State> {
+	std::mutex mutex;				// Guards the members below
+	std::deque<std::shared_ptr<LVJob>> queue;
+	std::vector<std::unique_ptr<Runner>> runners;
+	size_t running;					// Job threads
+	size_t starting;				// Job threads that have not taken their first job yet
+	size_t maxRunning;
+	bool stop;
+
+	State() : running(0), starting(0), maxRunning(0), stop(false) {}
+
+	// Maximum number of running jobs, the mutex must be held
+	size_t runLimit() const {
+		return (maxRunning > 0) ? maxRunning : std::max<size_t>(1, std::thread::hardware_concurrency());
+	}
+
+	// Cancels the running jobs and takes the queued ones out of the queue, the mutex must be held
+	std::deque<std::shared_ptr<LVJob>> cancel() {
+		stop = true;
+		for (auto &runner : runners) {
+			if (runner->job)
+				runner->job->cancel();
+		}
+		return std::move(queue);
+	}
+
+	// Starts job threads for the queued jobs up to the limit, the mutex must be held
+	void dispatch() {
+		// A job needs a new thread unless a thread that has been started has yet to take one
+		size_t r = 0;
+		while (!stop && running < runLimit() && queue.size() > starting) {
+			// Reuse the first runner that has left its loop, the join does not wait on the mutex
+			while (r < runners.size() && runners[r]->running)
+				r++;
+			if (r == runners.size())
+				runners.emplace_back(new Runner());
+
+			Runner &runner = *runners[r];
+			if (runner.thread.joinable())
+				runner.thread.join();
+
+			runner.thread = std::thread(&State::work, shared_from_this(), r);
+			runner.running = true;
+			running++;
+			starting++;
+		}
+	}
+
+	void work(size_t self) {
+		LVThroughputScope throughput;
+
+		bool started = false;
+		for (;;) {
+			std::shared_ptr<LVJob> job;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				runners[self]->job.reset();
+				if (!started) {
+					starting--;
+					started = true;
+				}
+
+				// Exit when there is nothing to do, or when the limit has been lowered
+				if (stop || queue.empty() || running > runLimit()) {
+					runners[self]->running = false;
+					running--;
+					return;
+				}
+
+				job = std::move(queue.front());
+				queue.pop_front();
+				runners[self]->job = job;
+			}
+
+			auto condition = std::make_shared<LVStopCondition>(job->m_token);
+			{
+				std::lock_guard<std::mutex> jobLock(job->m_mutex);
+				job->m_state = LVJobState::Running;
+				job->m_condition = condition;
+			}
+
+			std::exception_ptr error;
+			try {
+				LVStopScope scope(condition.get());
+				LVCheckpoint();
+				job->run();
+			}
+			catch (...) {
+				error = std::current_exception();
+			}
+
+			finish(*job, error);
+		}
+	}
+
+	// Marks the job as finished and posts its completion event
+	static void finish(LVJob &job, std::exception_ptr error) {
+		LVUserEventRef completion;
+		uint64_t handle;
+		{
+			std::lock_guard<std::mutex> jobLock(job.m_mutex);
+			job.m_error = error;
+			job.m_state = error ? LVJobState::Failed : LVJobState::Completed;
+			completion = job.m_completion;
+			handle = job.m_handle;
+		}
+		job.m_finished.notify_all();
+
+		if (completion != 0)
+			PostLVUserEvent(completion, &handle);
+	}
+};
+
+LVJobQueue & LVJobQueue::instance() {
+	static LVJobQueue queue;
+	return queue;
+}
+
+LVJobQueue::LVJobQueue() : m_jobs(LVHandleTagJob), m_state(std::make_shared<State>()) {
+	// The job threads use the thread pool settings, constructing the pool first destroys it after the queue
+	LVThreadPool::instance();
+}
+
+LVJobQueue::~LVJobQueue() {
+	// The discarded jobs are not marked as failed, their completion events would be posted during the unload
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	m_state->cancel();
+	for (auto &runner : m_state->runners) {
+		if (runner->thread.joinable())
+			runner->thread.detach();
+	}
+}
+
+void LVJobQueue::shutdown() {
+	std::deque<std::shared_ptr<LVJob>> discarded;
+	std::vector<std::thread> threads;
+	{
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+		discarded = m_state->cancel();
+		for (auto &runner : m_state->runners)
+			threads.push_back(std::move(runner->thread));
+	}
+
+	for (auto &job : discarded) {
+		LVStopped stopped(__FILE__, __LINE__, LVStopReason::Cancelled, "The job was discarded by the shutdown of the library.");
+		State::finish(*job, std::make_exception_ptr(stopped));
+	}
+
+	for (std::thread &thread : threads) {
+		if (thread.joinable())
+			thread.join();
+	}
+
+	// Jobs submitted during the shutdown were queued
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	m_state->stop = false;
+	m_state->dispatch();
+}
+
+uint64_t LVJobQueue::submit(std::shared_ptr<LVJob> job, LVUserEventRef completion) {
+	uint64_t handle = m_jobs.add(job);
+	{
+		std::lock_guard<std::mutex> jobLock(job->m_mutex);
+		job->m_handle = handle;
+		job->m_completion = completion;
+	}
+
+	try {
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+		m_state->queue.push_back(job);
+		m_state->dispatch();
+	}
+	catch (...) {
+		// Unable to start a job thread (and no thread is running that would take the job), the job is withdrawn
+		m_jobs.remove(handle);
+		throw;
+	}
+	return handle;
+}
+
+void LVJobQueue::release(uint64_t handle) {
+	std::shared_ptr<LVJob> job = m_jobs.get(handle);
+	{
+		std::lock_guard<std::mutex> jobLock(job->m_mutex);
+		job->m_completion = 0;
+	}
+	m_jobs.remove(handle);
+}
+
+void LVJobQueue::runAbandonable(std::shared_ptr<LVJob> job, int32_t pollMs) {
+	LVCheckpoint();
+
+	LVStopCondition *condition = LVStopCondition::current();
+	std::shared_ptr<const LVCancellationToken> token = (condition != nullptr) ? condition->token() : nullptr;
+	if (token) {
+		std::lock_guard<std::mutex> jobLock(job->m_mutex);
+		job->m_token->setLogEvent(token->logEvent(), token->logTag());
+	}
+
+	uint64_t handle = submit(job, 0);
+
+	int64_t counted = 0;
+	try {
+		bool finished;
+		do {
+			finished = job->wait(pollMs);
+
+			int64_t done = job->iterations();
+			LVCheckpoint(done - counted);
+			counted = done;
+		} while (!finished);
+	}
+	catch (...) {
+		job->cancel();
+		release(handle);
+		throw;
+	}
+
+	release(handle);
+	job->join();
+}
+
+void LVJobQueue::setMaxRunning(size_t maxRunning) {
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	m_state->maxRunning = maxRunning;
+	m_state->dispatch();
+}
+
+size_t LVJobQueue::maxRunning() const {
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	return m_state->runLimit();
+}
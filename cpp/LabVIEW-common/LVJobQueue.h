@@ -0,0 +1,136 @@
+/// <summary>
+/// Asynchronous jobs (training, cross-validation) for LabVIEW callers that must not block while a model is trained.
+/// A job copies its inputs out of LabVIEW memory when it is queued, so the calling VI returns right away with a job handle
+/// and can poll, wait for or collect the job later. Queued jobs are executed in order by job threads, at most
+/// maxRunning at a time (one per core by default), so any number of jobs can be in flight without tying up LabVIEW's threads.
+/// The job threads run in an LVThroughputScope (see LVThreadPool.h), so they stay off the cores reserved for predictions.
+/// Optionally, the handle of a job is posted to a LabVIEW user event (U64 data) when the job has finished.
+/// A job can be cancelled, it runs under the stop condition of its own cancellation token (see LVCancellation.h).
+/// The token also carries the log event of the job.
+/// Every library has its own queue (the wrapper libraries are separate binaries). The job threads are stopped by the shutdown
+/// function of the library, which is to be called before the library is unloaded (see LVThreadPool.h).
+/// </summary>
+
+#ifndef LVJOBQUEUE_H_
+#define LVJOBQUEUE_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <extcode.h>
+
+#include "LVCancellation.h"
+#include "LVHandleRegistry.h"
+
+// State of a job as reported to LabVIEW
+enum class LVJobState : int32_t {
+	Queued = 0,
+	Running = 1,
+	Completed = 2,
+	Failed = 3
+};
+
+/// <summary> Base class of the jobs of the wrappers, which copy their inputs in the constructor and store their results in run(). </summary>
+class LVJob {
+public:
+	LVJob();
+	virtual ~LVJob() {}
+
+	LVJob(const LVJob&) = delete;
+	LVJob& operator=(const LVJob&) = delete;
+
+	LVJobState state() const;
+
+	/// <summary> Waits until the job has finished or timeoutMs has elapsed (negative to wait indefinitely), returns whether it has finished. </summary>
+	bool wait(int32_t timeoutMs) const;
+
+	/// <summary> Waits until the job has finished and rethrows the exception of a failed job. </summary>
+	void join() const;
+
+	/// <summary> Stops a running job at its next checkpoint, a queued job fails without running. </summary>
+	void cancel() { m_token->cancel(); }
+
+	/// <summary> Solver iterations counted by the job so far (see LVCancellation.h). </summary>
+	int64_t iterations() const;
+
+	/// <summary> Logs the solver output of the job to the event (LVLogEvent tagged with the job handle, see LVLogging.h), 0 for the global logging event. </summary>
+	void setLogEvent(LVUserEventRef event);
+
+protected:
+	/// <summary> Executes the job on a job thread, exceptions mark the job as failed. </summary>
+	virtual void run() = 0;
+
+private:
+	friend class LVJobQueue;
+
+	mutable std::mutex m_mutex;
+	mutable std::condition_variable m_finished;
+	LVJobState m_state;
+	std::exception_ptr m_error;
+	LVUserEventRef m_completion;		// Zero if no event is posted
+	uint64_t m_handle;
+	std::shared_ptr<LVCancellationToken> m_token;	// Without budgets
+	std::shared_ptr<LVStopCondition> m_condition;	// Stop condition of the run, nullptr until the job runs
+};
+
+class LVJobQueue {
+public:
+	/// <summary> Queue of the library, created on first use. </summary>
+	static LVJobQueue & instance();
+
+	/// <summary>
+	/// Discards the queued jobs and cancels the running ones without waiting for them: the static destruction runs under the
+	/// loader lock on Windows, where a job thread cannot exit (and a libsvm solver only stops when it has finished).
+	/// </summary>
+	~LVJobQueue();
+
+	/// <summary>
+	/// Cancels the queued and running jobs and waits for the job threads to exit. The queued jobs fail without running,
+	/// the running ones stop at their next checkpoint, after the library solver in progress (see LVCancellation.h). Jobs submitted afterwards are executed as before.
+	/// </summary>
+	void shutdown();
+
+	LVJobQueue(const LVJobQueue&) = delete;
+	LVJobQueue& operator=(const LVJobQueue&) = delete;
+
+	/// <summary> Queues the job and returns its handle. If completion is not zero, the handle is posted to it when the job has finished. </summary>
+	uint64_t submit(std::shared_ptr<LVJob> job, LVUserEventRef completion);
+
+	/// <summary> Returns the job referenced by the handle. Throws LVException if the handle is invalid. </summary>
+	std::shared_ptr<LVJob> get(uint64_t handle) const { return m_jobs.get(handle); }
+
+	/// <summary> Releases the handle, a job that has not finished yet still runs to completion (without posting its event). </summary>
+	void release(uint64_t handle);
+
+	/// <summary>
+	/// Runs the job and waits for it, for a library solver that cannot be stopped: the stop condition of the calling thread
+	/// (see LVCancellation.h) is tested before the job and every pollMs while it runs, the iterations of the job count into its budgets
+	/// and the solver output goes to the log event of its token. When the run is to stop, LVStopped is thrown right away and the job
+	/// is abandoned (cancelled and released), it runs to completion on its job thread on the copies of its inputs.
+	/// A run that exceeds a budget only while the job completes is stopped as well. Rethrows the exception of a failed job.
+	/// </summary>
+	void runAbandonable(std::shared_ptr<LVJob> job, int32_t pollMs = 50);
+
+	/// <summary> Limits the number of jobs running at the same time (0 for one per core). </summary>
+	void setMaxRunning(size_t maxRunning);
+
+	size_t maxRunning() const;
+
+private:
+	struct Runner;
+	struct State;
+
+	LVJobQueue();
+
+	LVHandleRegistry<LVJob> m_jobs;
+	std::shared_ptr<State> m_state;		// Shared with the job threads, which may outlive the queue
+};
+
+#endif // LVJOBQUEUE_H_
@@ -0,0 +1,237 @@
+#include "LVLogging.h"
+#include "LVCancellation.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+LVLogBuffer::LVLogBuffer(size_t capacity) : m_tail(0), m_head(0) {
+	size_t size = 1;
+	while (size < capacity)
+		size *= 2;
+
+	m_slots.reset(new Slot[size]);
+	m_mask = size - 1;
+	for (size_t i = 0; i < size; i++)
+		m_slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool LVLogBuffer::push(LVUserEventRef event, uint64_t tag, bool tagged, const char *message) {
+	size_t position = m_tail.load(std::memory_order_relaxed);
+	Slot *slot;
+	for (;;) {
+		slot = &m_slots[position & m_mask];
+		size_t sequence = slot->sequence.load(std::memory_order_acquire);
+		intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+		if (difference == 0) {
+			// The slot is free, claim the position
+			if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (difference < 0) {
+			// The slot has not been read since the previous round, the buffer is full
+			return false;
+		}
+		else {
+			// Another producer claimed the position
+			position = m_tail.load(std::memory_order_relaxed);
+		}
+	}
+
+	size_t length = std::min(std::strlen(message), LVLogMessageSize);
+	std::memcpy(slot->text, message, length);
+	slot->length = static_cast<uint32_t>(length);
+	slot->event = event;
+	slot->tag = tag;
+	slot->tagged = tagged;
+	slot->sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+bool LVLogBuffer::pop(Entry &entry) {
+	size_t position = m_head.load(std::memory_order_relaxed);
+	Slot *slot;
+	for (;;) {
+		slot = &m_slots[position & m_mask];
+		size_t sequence = slot->sequence.load(std::memory_order_acquire);
+		intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+		if (difference == 0) {
+			if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (difference < 0) {
+			// Not written yet, the buffer is empty
+			return false;
+		}
+		else {
+			position = m_head.load(std::memory_order_relaxed);
+		}
+	}
+
+	entry.event = slot->event;
+	entry.tag = slot->tag;
+	entry.tagged = slot->tagged;
+	entry.text.assign(slot->text, slot->length);
+
+	// Free the slot for the next round
+	slot->sequence.store(position + m_mask + 1, std::memory_order_release);
+	return true;
+}
+
+// Buffer and flusher of the logger, kept alive by the running flusher
+struct LVLogger::State {
+	LVLogBuffer buffer;
+	std::atomic<uint64_t> dropped;
+	std::atomic<bool> started;			// Set while the flusher runs (or is being started)
+
+	std::mutex flushMutex;				// Serializes the flushes
+	std::mutex mutex;					// Guards the members below
+	std::condition_variable wake;
+	std::chrono::milliseconds interval;
+	bool stop;
+	std::thread thread;
+
+	State() : buffer(4096), dropped(0), started(false), interval(100), stop(false) {}
+
+	void flush() {
+		std::lock_guard<std::mutex> flushLock(flushMutex);
+
+		// One batch per destination, in the order of their first message
+		std::vector<LVLogBuffer::Entry> batches;
+		LVLogBuffer::Entry entry;
+		while (buffer.pop(entry)) {
+			auto batch = std::find_if(batches.begin(), batches.end(), [&](const LVLogBuffer::Entry &b) {
+				return b.event == entry.event && b.tag == entry.tag && b.tagged == entry.tagged;
+			});
+
+			if (batch == batches.end())
+				batches.push_back(entry);
+			else
+				batch->text += entry.text;
+		}
+
+		uint64_t lost = dropped.exchange(0);
+
+		for (auto &batch : batches) {
+			if (lost > 0)
+				batch.text += "(" + std::to_string(lost) + " log messages were dropped)\n";
+
+			LStrHandle text = reinterpret_cast<LStrHandle>(DSNewHandle(sizeof(int32_t) + batch.text.size()));
+			if (text == nullptr)
+				continue;
+			MoveBlock(batch.text.data(), (*text)->str, batch.text.size());
+			(*text)->cnt = static_cast<int32>(batch.text.size());
+
+			// The event data is copied by PostLVUserEvent
+			if (batch.tagged) {
+				LVLogEvent event;
+				event.tag = batch.tag;
+				event.text = text;
+				PostLVUserEvent(batch.event, &event);
+			}
+			else {
+				PostLVUserEvent(batch.event, &text);
+			}
+
+			DSDisposeHandle(text);
+		}
+	}
+
+	// Starts the flusher unless it runs or the logger is being destroyed
+	void start(const std::shared_ptr<State> &self) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (started || stop)
+			return;
+
+		thread = std::thread(&State::run, self);
+		started = true;
+	}
+
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (!stop) {
+			std::chrono::milliseconds current = interval;
+			wake.wait_for(lock, current, [&] { return stop || interval != current; });
+			if (stop)
+				break;
+
+			lock.unlock();
+			flush();
+			lock.lock();
+		}
+	}
+};
+
+LVLogger & LVLogger::instance() {
+	static LVLogger logger;
+	return logger;
+}
+
+LVLogger::LVLogger() : m_state(std::make_shared<State>()) {}
+
+LVLogger::~LVLogger() {
+	{
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+		m_state->stop = true;
+		if (m_state->thread.joinable())
+			m_state->thread.detach();
+	}
+	m_state->wake.notify_all();
+}
+
+void LVLogger::log(LVUserEventRef event, uint64_t tag, bool tagged, const char *message) {
+	if (!m_state->started.load(std::memory_order_acquire))
+		m_state->start(m_state);
+
+	if (!m_state->buffer.push(event, tag, tagged, message))
+		m_state->dropped++;
+}
+
+void LVLogger::flush() {
+	m_state->flush();
+}
+
+void LVLogger::setInterval(std::chrono::milliseconds interval) {
+	{
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+		m_state->interval = interval;
+	}
+	m_state->wake.notify_all();
+}
+
+std::chrono::milliseconds LVLogger::interval() const {
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	return m_state->interval;
+}
+
+void LVLogger::shutdown() {
+	std::thread thread;
+	{
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+		m_state->stop = true;
+		thread = std::move(m_state->thread);
+	}
+	m_state->wake.notify_all();
+
+	if (thread.joinable())
+		thread.join();
+
+	{
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+		m_state->stop = false;
+		m_state->started = false;
+	}
+
+	m_state->flush();
+}
+
+void LVLog(const char *message, LVUserEventRef global) {
+	LVStopCondition *condition = LVStopCondition::current();
+	std::shared_ptr<const LVCancellationToken> token = (condition != nullptr) ? condition->token() : nullptr;
+
+	LVUserEventRef event = token ? token->logEvent() : 0;
+	if (event != 0)
+		LVLogger::instance().log(event, token->logTag(), true, message);
+	else if (global != 0)
+		LVLogger::instance().log(global, 0, false, message);
+}
@@ -0,0 +1,121 @@
+/// <summary>
+/// Batched logging of the solver output to LabVIEW user events.
+/// The print functions of the wrappers are called by the solvers, from any thread and many times per second during large trainings.
+/// They only write the message into a lock-free ring buffer. A background flusher drains the buffer at a fixed interval and posts
+/// the messages of each destination as a single event, so LabVIEW's event queue receives at most one event per destination and interval.
+/// When the buffer is full a message is dropped rather than waiting, the number of dropped messages is added to the next batch.
+/// A run started with a cancellation token (or a job) whose log event is set logs to that event, tagged with the handle of the token or job (LVLogEvent),
+/// so concurrent runs can be told apart. Every other run logs to the global logging event of the library (string data, as before).
+/// Every library has its own logger (the wrapper libraries are separate binaries). The flusher is started by the first message
+/// and stopped by the shutdown function of the library, which is to be called before the library is unloaded (see LVThreadPool.h).
+/// </summary>
+
+#ifndef LVLOGGING_H_
+#define LVLOGGING_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <extcode.h>
+
+#include <lv_prolog.h>
+
+// Data of the log event of a token or job (LabVIEW cluster)
+struct LVLogEvent {
+	uint64_t tag;		// Handle of the token or job
+	LStrHandle text;	// Messages of the interval, one after the other
+};
+
+#include <lv_epilog.h>
+
+// Longer messages are truncated (the messages of libsvm and liblinear are single lines)
+const size_t LVLogMessageSize = 232;
+
+/// <summary> Bounded multi-producer queue of log messages, lock-free (slots with sequence numbers). </summary>
+class LVLogBuffer {
+public:
+	struct Entry {
+		LVUserEventRef event;
+		uint64_t tag;
+		bool tagged;			// Posted as LVLogEvent, otherwise as a string
+		std::string text;
+	};
+
+	/// <summary> The capacity is rounded up to a power of two. </summary>
+	explicit LVLogBuffer(size_t capacity);
+
+	LVLogBuffer(const LVLogBuffer&) = delete;
+	LVLogBuffer& operator=(const LVLogBuffer&) = delete;
+
+	/// <summary> Queues the message, returns false without waiting if the buffer is full. </summary>
+	bool push(LVUserEventRef event, uint64_t tag, bool tagged, const char *message);
+
+	/// <summary> Takes the oldest message, returns false if the buffer is empty. </summary>
+	bool pop(Entry &entry);
+
+private:
+	struct Slot {
+		std::atomic<size_t> sequence;	// Position the slot can be written at (free) or read at plus one (filled)
+		LVUserEventRef event;
+		uint64_t tag;
+		bool tagged;
+		uint32_t length;
+		char text[LVLogMessageSize];
+	};
+
+	std::unique_ptr<Slot[]> m_slots;
+	size_t m_mask;
+	alignas(64) std::atomic<size_t> m_tail;	// Next position to write
+	alignas(64) std::atomic<size_t> m_head;	// Next position to read
+};
+
+class LVLogger {
+public:
+	/// <summary> Logger of the library, created on first use. </summary>
+	static LVLogger & instance();
+
+	/// <summary>
+	/// Stops the flusher without waiting for it, messages that have not been posted yet are discarded.
+	/// The static destruction runs under the loader lock on Windows, where the flusher cannot exit (nor be joined).
+	/// </summary>
+	~LVLogger();
+
+	LVLogger(const LVLogger&) = delete;
+	LVLogger& operator=(const LVLogger&) = delete;
+
+	/// <summary> Queues a message for the event, as LVLogEvent with the tag or as a string. Starts the flusher if it is not running, otherwise never blocks. </summary>
+	void log(LVUserEventRef event, uint64_t tag, bool tagged, const char *message);
+
+	/// <summary> Posts the queued messages now instead of at the end of the interval. </summary>
+	void flush();
+
+	/// <summary> Interval of the flusher (100 ms by default), at most one event per destination is posted per interval. </summary>
+	void setInterval(std::chrono::milliseconds interval);
+
+	std::chrono::milliseconds interval() const;
+
+	/// <summary> Stops the flusher, waits for it to exit and posts the queued messages. The next message starts it again. </summary>
+	void shutdown();
+
+private:
+	struct State;
+
+	LVLogger();
+
+	std::shared_ptr<State> m_state;		// Shared with the flusher, which may outlive the logger
+};
+
+/// <summary>
+/// Logs a message of the solvers: to the log event of the token of the calling thread's run if it has one (see LVCancellation.h),
+/// otherwise to the global event (0 for none). Messages without destination are discarded right away.
+/// </summary>
+void LVLog(const char *message, LVUserEventRef global);
+
+#endif // LVLOGGING_H_
@@ -0,0 +1,223 @@
+#include "LVMemoryMap.h"
+#include "LVException.h"
+#include "LVUtility.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <errno.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+	#ifndef NOMINMAX
+	#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+#if defined(_WIN32) || defined(_WIN64)
+LVMemoryMap::LVMemoryMap() : m_data(nullptr), m_size(0), m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr) {}
+#else
+LVMemoryMap::LVMemoryMap() : m_data(nullptr), m_size(0), m_fd(-1) {}
+#endif
+
+LVMemoryMap::LVMemoryMap(const char *path) : LVMemoryMap() {
+	open(path);
+}
+
+LVMemoryMap::~LVMemoryMap() {
+	close();
+}
+
+LVMemoryMap::LVMemoryMap(LVMemoryMap &&other) : LVMemoryMap() {
+	*this = std::move(other);
+}
+
+LVMemoryMap& LVMemoryMap::operator=(LVMemoryMap &&other) {
+	if (this != &other) {
+		close();
+		std::swap(m_data, other.m_data);
+		std::swap(m_size, other.m_size);
+#if defined(_WIN32) || defined(_WIN64)
+		std::swap(m_file, other.m_file);
+		std::swap(m_mapping, other.m_mapping);
+#else
+		std::swap(m_fd, other.m_fd);
+#endif
+	}
+	return *this;
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+
+void LVMemoryMap::open(const char *path) {
+	close();
+
+	if (path == nullptr)
+		throw LVException(__FILE__, __LINE__, "Memory map: no path specified.");
+
+	m_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE)
+		throw LVException(__FILE__, __LINE__, "Memory map: unable to open file (error " + std::to_string(GetLastError()) + ").");
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(m_file, &fileSize)) {
+		DWORD err = GetLastError();
+		close();
+		throw LVException(__FILE__, __LINE__, "Memory map: unable to read file size (error " + std::to_string(err) + ").");
+	}
+
+	if (fileSize.QuadPart == 0) {
+		close();
+		throw LVException(__FILE__, __LINE__, "Memory map: the file is empty.");
+	}
+
+	if (static_cast<unsigned long long>(fileSize.QuadPart) > static_cast<unsigned long long>(SIZE_MAX)) {
+		close();
+		throw LVException(__FILE__, __LINE__, "Memory map: the file is too large to be mapped in a 32-bit process.");
+	}
+
+	m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_mapping == nullptr) {
+		DWORD err = GetLastError();
+		close();
+		throw LVException(__FILE__, __LINE__, "Memory map: unable to create file mapping (error " + std::to_string(err) + ").");
+	}
+
+	m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (m_data == nullptr) {
+		DWORD err = GetLastError();
+		close();
+		throw LVException(__FILE__, __LINE__, "Memory map: unable to map view of file (error " + std::to_string(err) + ").");
+	}
+
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+}
+
+void LVMemoryMap::close() {
+	if (m_data != nullptr)
+		UnmapViewOfFile(m_data);
+	if (m_mapping != nullptr)
+		CloseHandle(m_mapping);
+	if (m_file != INVALID_HANDLE_VALUE)
+		CloseHandle(m_file);
+
+	m_data = nullptr;
+	m_size = 0;
+	m_mapping = nullptr;
+	m_file = INVALID_HANDLE_VALUE;
+}
+
+void LVMemoryMap::adviseSequential() const {
+	// Windows only supports access hints when opening the file
+}
+
+void LVMemoryMap::adviseWillNeed(size_t offset, size_t length) const {
+#if defined(_WIN32_WINNT) && (_WIN32_WINNT >= 0x0602)
+	if (m_data == nullptr || offset >= m_size)
+		return;
+
+	WIN32_MEMORY_RANGE_ENTRY range;
+	range.VirtualAddress = const_cast<char*>(m_data + offset);
+	range.NumberOfBytes = (length > m_size - offset) ? m_size - offset : length;
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+	(void)offset;
+	(void)length;
+#endif
+}
+
+void LVMemoryMap::adviseDontNeed(size_t offset, size_t length) const {
+	if (m_data == nullptr || offset >= m_size)
+		return;
+
+	// Unlocking pages that are not locked removes them from the working set of the process
+	size_t end = (length > m_size - offset) ? m_size : offset + length;
+	VirtualUnlock(const_cast<char*>(m_data + offset), end - offset);
+}
+
+#else
+
+void LVMemoryMap::open(const char *path) {
+	close();
+
+	if (path == nullptr)
+		throw LVException(__FILE__, __LINE__, "Memory map: no path specified.");
+
+	errno = 0;
+	m_fd = ::open(path, O_RDONLY);
+	if (m_fd < 0)
+		throw LVException(__FILE__, __LINE__, "Memory map: unable to open file (" + LVErrnoString(errno) + ").");
+
+	struct stat st;
+	if (fstat(m_fd, &st) != 0) {
+		int err = errno;
+		close();
+		throw LVException(__FILE__, __LINE__, "Memory map: unable to read file size (" + LVErrnoString(err) + ").");
+	}
+
+	if (st.st_size == 0) {
+		close();
+		throw LVException(__FILE__, __LINE__, "Memory map: the file is empty.");
+	}
+
+	if (static_cast<unsigned long long>(st.st_size) > static_cast<unsigned long long>(SIZE_MAX)) {
+		close();
+		throw LVException(__FILE__, __LINE__, "Memory map: the file is too large to be mapped in a 32-bit process.");
+	}
+
+	size_t size = static_cast<size_t>(st.st_size);
+	void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, m_fd, 0);
+	if (addr == MAP_FAILED) {
+		int err = errno;
+		close();
+		throw LVException(__FILE__, __LINE__, "Memory map: mmap failed (" + LVErrnoString(err) + ").");
+	}
+
+	m_data = static_cast<const char*>(addr);
+	m_size = size;
+}
+
+void LVMemoryMap::close() {
+	if (m_data != nullptr)
+		munmap(const_cast<char*>(m_data), m_size);
+	if (m_fd >= 0)
+		::close(m_fd);
+
+	m_data = nullptr;
+	m_size = 0;
+	m_fd = -1;
+}
+
+void LVMemoryMap::adviseSequential() const {
+	if (m_data != nullptr)
+		madvise(const_cast<char*>(m_data), m_size, MADV_SEQUENTIAL);
+}
+
+void LVMemoryMap::adviseWillNeed(size_t offset, size_t length) const {
+	if (m_data == nullptr || offset >= m_size)
+		return;
+
+	// madvise requires a page aligned start address
+	size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	size_t alignedOffset = offset - (offset % pageSize);
+	size_t end = (length > m_size - offset) ? m_size : offset + length;
+	madvise(const_cast<char*>(m_data + alignedOffset), end - alignedOffset, MADV_WILLNEED);
+}
+
+void LVMemoryMap::adviseDontNeed(size_t offset, size_t length) const {
+	if (m_data == nullptr || offset >= m_size)
+		return;
+
+	// The mapping is read-only, dropped pages are read from the file again when touched
+	size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	size_t alignedOffset = offset - (offset % pageSize);
+	size_t end = (length > m_size - offset) ? m_size : offset + length;
+	madvise(const_cast<char*>(m_data + alignedOffset), end - alignedOffset, MADV_DONTNEED);
+}
+
+#endif
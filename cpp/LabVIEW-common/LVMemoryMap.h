@@ -0,0 +1,61 @@
+/// <summary>
+/// Read-only memory mapping of files.
+/// The operating system shares the physical pages of a mapped file between all processes that map it,
+/// and pages are only read from disk when they are first touched.
+/// </summary>
+
+#ifndef LVMEMORYMAP_H_
+#define LVMEMORYMAP_H_
+
+#include <cstddef>
+
+/// <summary>
+/// RAII wrapper around a read-only file mapping (mmap on POSIX, file mapping objects on Windows).
+/// The mapping is released when the object is destroyed or closed.
+/// </summary>
+class LVMemoryMap {
+public:
+	LVMemoryMap();
+
+	/// <summary> Maps the entire file at path read-only. Throws LVException on failure. </summary>
+	explicit LVMemoryMap(const char *path);
+
+	~LVMemoryMap();
+
+	// Mappings are owned exclusively
+	LVMemoryMap(const LVMemoryMap&) = delete;
+	LVMemoryMap& operator=(const LVMemoryMap&) = delete;
+	LVMemoryMap(LVMemoryMap &&other);
+	LVMemoryMap& operator=(LVMemoryMap &&other);
+
+	/// <summary> Maps the entire file at path read-only, releasing any previous mapping. </summary>
+	void open(const char *path);
+
+	/// <summary> Releases the mapping (no-op if nothing is mapped). </summary>
+	void close();
+
+	/// <summary> Hints the operating system that the mapping will be read front to back. </summary>
+	void adviseSequential() const;
+
+	/// <summary> Hints the operating system to start paging in the given range in the background. </summary>
+	void adviseWillNeed(size_t offset, size_t length) const;
+
+	/// <summary> Hints the operating system that the given range is no longer needed, its pages are read from the file again when touched. </summary>
+	void adviseDontNeed(size_t offset, size_t length) const;
+
+	const char * data() const { return m_data; }
+	size_t size() const { return m_size; }
+	bool isOpen() const { return m_data != nullptr; }
+
+private:
+	const char *m_data;	//!< Start of the mapped view.
+	size_t m_size;		//!< Size of the mapped view in bytes.
+#if defined(_WIN32) || defined(_WIN64)
+	void *m_file;		//!< HANDLE to the file.
+	void *m_mapping;	//!< HANDLE to the file mapping object.
+#else
+	int m_fd;			//!< File descriptor.
+#endif
+};
+
+#endif // LVMEMORYMAP_H_
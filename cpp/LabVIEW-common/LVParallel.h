@@ -0,0 +1,40 @@
+/// <summary>
+/// Fork-join helpers for the data parallel parts of the wrappers (parsing, formatting, conversion).
+/// Work is split into a number of independent tasks that are executed by the workers of the thread pool (see LVThreadPool.h),
+/// the calling thread takes part in the execution and waits for the remaining tasks to complete.
+/// No thread is created per call, the tasks are throughput work unless stated otherwise and keep off the reserved cores.
+/// </summary>
+
+#ifndef LVPARALLEL_H_
+#define LVPARALLEL_H_
+
+#include <cstddef>
+#include <thread>
+
+#include "LVThreadPool.h"
+
+/// <summary> Returns the number of threads to use for nItems work items, so that each thread receives at least minItemsPerThread items. </summary>
+inline size_t LVThreadCount(size_t nItems, size_t minItemsPerThread = 1) {
+	size_t hw = std::thread::hardware_concurrency();
+	if (hw == 0)
+		hw = 1;
+
+	if (minItemsPerThread == 0)
+		minItemsPerThread = 1;
+
+	size_t n = nItems / minItemsPerThread;
+	if (n > hw)
+		n = hw;
+	return (n > 0) ? n : 1;
+}
+
+/// <summary>
+/// Executes task(i) for i in [0, nTasks) concurrently and waits for all of them to complete.
+/// If any task throws, the exception of the lowest numbered failing task is rethrown on the calling thread.
+/// </summary>
+template<class F>
+void LVParallelFor(size_t nTasks, F task, LVWorkPriority priority = LVWorkPriority::Throughput) {
+	LVThreadPool::instance().parallelFor(nTasks, task, priority);
+}
+
+#endif // LVPARALLEL_H_
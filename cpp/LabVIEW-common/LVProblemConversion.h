@@ -0,0 +1,239 @@
+/// <summary>
+/// Conversion of problems between the feature vector layouts of the three libraries:
+///		sparse		-1 terminated (index, value) nodes per vector (libsvm)
+///		linear		sparse, followed by the bias feature if bias >= 0 (liblinear)
+///		dense		one value per column, column j is feature index j+1 (libsvm-dense)
+///
+/// The output sizes are computed in a first pass, the output handles are allocated on the calling thread
+/// and the vectors are filled in parallel. No intermediate copy of the problem is made.
+/// The node types are template parameters, since each library declares its own (layout compatible) node struct.
+/// </summary>
+
+#ifndef LVPROBLEMCONVERSION_H_
+#define LVPROBLEMCONVERSION_H_
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "LVTypeDecl.h"
+#include "LVUtility.h"
+#include "LVException.h"
+#include "LVParallel.h"
+
+/// <summary> Number of vectors of a problem. Throws LVException if empty or if the number of labels differs. </summary>
+template<class X>
+size_t LVCheckProblemSize(const LVArray_Hdl<double> y, const LVArray_Hdl<X> x) {
+	if (x == nullptr || (*x)->dimSize == 0)
+		throw LVException(__FILE__, __LINE__, "Empty problem passed to the problem conversion.");
+
+	if (y == nullptr || (*y)->dimSize != (*x)->dimSize)
+		throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and feature vectors (x and y).");
+
+	if ((*x)->dimSize > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Number of feature vectors too large (greater than " + std::to_string(INT_MAX) + ")");
+
+	return (*x)->dimSize;
+}
+
+/// <summary> Copies the labels of a problem. </summary>
+inline void LVCopyLabels(const LVArray_Hdl<double> y_in, LVArray_Hdl<double> &y_out) {
+	size_t l = (*y_in)->dimSize;
+	LVResizeNumericArrayHandle(y_out, l);
+	std::memcpy((*y_out)->elt, (*y_in)->elt, l * sizeof(double));
+	(*y_out)->dimSize = static_cast<uint32_t>(l);
+}
+
+/// <summary>
+/// Validates the sparse vectors (-1 terminated, preceded by the bias feature if hasBias) and returns the largest feature index, bias excluded.
+/// Feature indices must be positive.
+/// </summary>
+template<class Node>
+int32_t LVSparseMaxIndex(const LVArray_Hdl<LVArray_Hdl<Node>> x_in, bool hasBias) {
+	size_t l = (*x_in)->dimSize;
+	const LVArray_Hdl<Node> *x = (*x_in)->elt;
+	size_t nExcluded = hasBias ? 2 : 1;
+
+	size_t nThreads = LVThreadCount(l, 1024);
+	std::vector<int32_t> maxIndex(nThreads, 0);
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			if (x[i] == nullptr || (*x[i])->dimSize < nExcluded || (*x[i])->elt[(*x[i])->dimSize - 1].index != -1)
+				throw LVException(__FILE__, __LINE__, "The index of the last element of each feature vector needs to be -1" + std::string(hasBias ? ", preceded by the bias feature" : "") + " (vector " + std::to_string(i) + ").");
+
+			const Node *xi = (*x[i])->elt;
+			size_t n = (*x[i])->dimSize - nExcluded;
+			for (size_t k = 0; k < n; k++) {
+				if (xi[k].index < 1)
+					throw LVException(__FILE__, __LINE__, "Feature indices must be positive (vector " + std::to_string(i) + ", index " + std::to_string(xi[k].index) + ").");
+				maxIndex[t] = std::max(maxIndex[t], xi[k].index);
+			}
+		}
+	});
+
+	return *std::max_element(maxIndex.begin(), maxIndex.end());
+}
+
+/// <summary>
+/// Expands sparse vectors (the bias feature is dropped if hasBias) into dense vectors of nFeatures columns.
+/// The vectors must have been validated by LVSparseMaxIndex. Throws LVException if a feature index exceeds nFeatures.
+/// </summary>
+template<class Node>
+void LVSparseToDense(const LVArray_Hdl<LVArray_Hdl<Node>> x_in, bool hasBias, size_t nFeatures, LVArray_Hdl<LVArray_Hdl<double>> &x_out) {
+	size_t l = (*x_in)->dimSize;
+	size_t nExcluded = hasBias ? 2 : 1;
+
+	if (nFeatures == 0 || nFeatures > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Invalid number of features for dense vectors (" + std::to_string(nFeatures) + ").");
+
+	// Handles are allocated on the calling thread, the values are scattered in parallel
+	LVResizeHandleArrayHandle(x_out, l);
+	for (size_t i = 0; i < l; i++) {
+		LVResizeNumericArrayHandle((*x_out)->elt[i], nFeatures);
+		(*(*x_out)->elt[i])->dimSize = static_cast<uint32_t>(nFeatures);
+	}
+	(*x_out)->dimSize = static_cast<uint32_t>(l);
+
+	const LVArray_Hdl<Node> *x = (*x_in)->elt;
+	LVArray_Hdl<double> *dense = (*x_out)->elt;
+	size_t nThreads = LVThreadCount(l * nFeatures, 1 << 16);
+
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			double *values = (*dense[i])->elt;
+			std::fill(values, values + nFeatures, 0.0);
+
+			const Node *xi = (*x[i])->elt;
+			size_t n = (*x[i])->dimSize - nExcluded;
+			for (size_t k = 0; k < n; k++) {
+				if (xi[k].index < 1 || static_cast<size_t>(xi[k].index) > nFeatures)
+					throw LVException(__FILE__, __LINE__, "Feature index " + std::to_string(xi[k].index) + " of vector " + std::to_string(i) + " exceeds the number of features (" + std::to_string(nFeatures) + ").");
+				values[xi[k].index - 1] = xi[k].value;
+			}
+		}
+	});
+}
+
+/// <summary> Validates the dense vectors (nonempty) and returns the length of the longest. </summary>
+inline size_t LVDenseMaxLength(const LVArray_Hdl<LVArray_Hdl<double>> x_in) {
+	size_t l = (*x_in)->dimSize;
+	size_t maxLength = 0;
+	for (size_t i = 0; i < l; i++) {
+		LVArray_Hdl<double> xi = (*x_in)->elt[i];
+		if (xi == nullptr || (*xi)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, "Empty feature vector (vector " + std::to_string(i) + ").");
+		maxLength = std::max(maxLength, static_cast<size_t>((*xi)->dimSize));
+	}
+
+	if (maxLength >= INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Feature vector too large (greater than " + std::to_string(INT_MAX - 1) + ")");
+
+	return maxLength;
+}
+
+/// <summary>
+/// Compresses dense vectors into sparse vectors (column j is feature index j+1, zeros are not stored).
+/// If bias >= 0, the bias feature (index biasIndex) is appended to every vector before the terminator.
+/// </summary>
+template<class Node>
+void LVDenseToSparse(const LVArray_Hdl<LVArray_Hdl<double>> x_in, double bias, int32_t biasIndex, LVArray_Hdl<LVArray_Hdl<Node>> &x_out) {
+	size_t l = (*x_in)->dimSize;
+	const LVArray_Hdl<double> *dense = (*x_in)->elt;
+	size_t nExtra = (bias >= 0) ? 2 : 1;
+
+	// First pass: number of nonzeros of every vector
+	std::vector<size_t> size(l);
+	size_t nThreads = LVThreadCount(l, 256);
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			const double *values = (*dense[i])->elt;
+			size_t n = (*dense[i])->dimSize;
+			size[i] = nExtra + (n - static_cast<size_t>(std::count(values, values + n, 0.0)));
+		}
+	});
+
+	// Handles are allocated on the calling thread, the nodes are filled in parallel
+	LVResizeHandleArrayHandle(x_out, l);
+	for (size_t i = 0; i < l; i++) {
+		LVResizeCompositeArrayHandle((*x_out)->elt[i], size[i]);
+		(*(*x_out)->elt[i])->dimSize = static_cast<uint32_t>(size[i]);
+	}
+	(*x_out)->dimSize = static_cast<uint32_t>(l);
+
+	LVArray_Hdl<Node> *x = (*x_out)->elt;
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			const double *values = (*dense[i])->elt;
+			size_t n = (*dense[i])->dimSize;
+			Node *node = (*x[i])->elt;
+			for (size_t j = 0; j < n; j++) {
+				if (values[j] != 0) {
+					node->index = static_cast<int32_t>(j + 1);
+					node->value = values[j];
+					node++;
+				}
+			}
+
+			if (bias >= 0) {
+				node->index = biasIndex;
+				node->value = bias;
+				node++;
+			}
+
+			node->index = -1;
+			node->value = 0;
+		}
+	});
+}
+
+/// <summary>
+/// Copies sparse vectors between node types, dropping the bias feature of the input if hasBias,
+/// and appending the bias feature (index biasIndex) to the output if bias >= 0.
+/// The vectors must have been validated by LVSparseMaxIndex.
+/// </summary>
+template<class NodeIn, class NodeOut>
+void LVSparseToSparse(const LVArray_Hdl<LVArray_Hdl<NodeIn>> x_in, bool hasBias, double bias, int32_t biasIndex, LVArray_Hdl<LVArray_Hdl<NodeOut>> &x_out) {
+	size_t l = (*x_in)->dimSize;
+	const LVArray_Hdl<NodeIn> *x = (*x_in)->elt;
+	size_t nExcluded = hasBias ? 2 : 1;
+	size_t nExtra = (bias >= 0) ? 2 : 1;
+
+	// Handles are allocated on the calling thread, the nodes are copied in parallel
+	LVResizeHandleArrayHandle(x_out, l);
+	size_t nNodes = 0;
+	for (size_t i = 0; i < l; i++) {
+		size_t n = (*x[i])->dimSize - nExcluded + nExtra;
+		LVResizeCompositeArrayHandle((*x_out)->elt[i], n);
+		(*(*x_out)->elt[i])->dimSize = static_cast<uint32_t>(n);
+		nNodes += n;
+	}
+	(*x_out)->dimSize = static_cast<uint32_t>(l);
+
+	LVArray_Hdl<NodeOut> *out = (*x_out)->elt;
+	size_t nThreads = LVThreadCount(nNodes, 1 << 16);
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			const NodeIn *xi = (*x[i])->elt;
+			size_t n = (*x[i])->dimSize - nExcluded;
+			NodeOut *node = (*out[i])->elt;
+			for (size_t k = 0; k < n; k++, node++) {
+				node->index = xi[k].index;
+				node->value = xi[k].value;
+			}
+
+			if (bias >= 0) {
+				node->index = biasIndex;
+				node->value = bias;
+				node++;
+			}
+
+			node->index = -1;
+			node->value = 0;
+		}
+	});
+}
+
+#endif // LVPROBLEMCONVERSION_H_
@@ -0,0 +1,140 @@
+#include "LVScaling.h"
+#include "LVException.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+
+//
+//-- Scaling
+//
+
+LVScaling::LVScaling(std::vector<double> scale, std::vector<double> shift) : m_scale(std::move(scale)), m_shift(std::move(shift)) {
+	if (m_scale.size() != m_shift.size())
+		throw LVException(__FILE__, __LINE__, "The scale and shift arrays of the scaling must have the same length.");
+
+	if (m_scale.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+		throw LVException(__FILE__, __LINE__, "The scaling has too many features.");
+
+	for (size_t i = 0; i < m_scale.size(); i++) {
+		if (!std::isfinite(m_scale[i]) || !std::isfinite(m_shift[i]))
+			throw LVException(__FILE__, __LINE__, "The scaling of feature " + std::to_string(i) + " is not finite.");
+
+		if (m_shift[i] != 0)
+			m_shifted.push_back(static_cast<int32_t>(i));
+	}
+}
+
+void LVScaling::applyDense(double *values, size_t n) const {
+	size_t m = std::min(n, m_scale.size());
+	for (size_t j = 0; j < m; j++)
+		values[j] = values[j] * m_scale[j] + m_shift[j];
+}
+
+//
+//-- Statistics
+//
+
+LVFeatureStatistics::LVFeatureStatistics(size_t nFeatures)
+	: m_count(nFeatures, 0), m_mean(nFeatures, 0), m_m2(nFeatures, 0),
+	m_min(nFeatures, std::numeric_limits<double>::infinity()), m_max(nFeatures, -std::numeric_limits<double>::infinity()) {}
+
+void LVFeatureStatistics::merge(const LVFeatureStatistics &other) {
+	for (size_t i = 0; i < m_count.size(); i++) {
+		LVMergeMoments(m_count[i], m_mean[i], m_m2[i], other.m_count[i], other.m_mean[i], other.m_m2[i]);
+		m_min[i] = std::min(m_min[i], other.m_min[i]);
+		m_max[i] = std::max(m_max[i], other.m_max[i]);
+	}
+}
+
+LVScaling LVFeatureStatistics::finish(size_t nSamples, size_t firstIndex, LVScalingMethod method, double lower, double upper) const {
+	size_t n = m_count.size();
+	std::vector<double> scale(n, 1.0);
+	std::vector<double> shift(n, 0.0);
+
+	for (size_t i = firstIndex; i < n; i++) {
+		uint64_t count = m_count[i];
+		double mean = m_mean[i];
+		double m2 = m_m2[i];
+		double minValue = m_min[i];
+		double maxValue = m_max[i];
+
+		// Rows without a stored value are zero for this feature
+		if (count < nSamples) {
+			LVMergeMoments(count, mean, m2, nSamples - count, 0.0, 0.0);
+			minValue = std::min(minValue, 0.0);
+			maxValue = std::max(maxValue, 0.0);
+		}
+
+		if (count == 0) {
+			scale[i] = 0;
+			continue;
+		}
+
+		if (method == LVScalingMethod::MinMax) {
+			if (maxValue > minValue) {
+				scale[i] = (upper - lower) / (maxValue - minValue);
+				shift[i] = lower - minValue * scale[i];
+			}
+			else {
+				scale[i] = 0;
+			}
+		}
+		else {
+			double sd = std::sqrt(m2 / static_cast<double>(count));
+			if (sd > 0) {
+				scale[i] = 1.0 / sd;
+				shift[i] = -mean / sd;
+			}
+			else {
+				scale[i] = 0;
+			}
+		}
+	}
+
+	return LVScaling(std::move(scale), std::move(shift));
+}
+
+LVScalingMethod LVCheckScalingMethod(int32_t method, double lower, double upper) {
+	if (method == static_cast<int32_t>(LVScalingMethod::MinMax)) {
+		if (!(lower < upper) || !std::isfinite(lower) || !std::isfinite(upper))
+			throw LVException(__FILE__, __LINE__, "The lower bound of the scaling must be less than the upper bound.");
+		return LVScalingMethod::MinMax;
+	}
+
+	if (method == static_cast<int32_t>(LVScalingMethod::Standardize))
+		return LVScalingMethod::Standardize;
+
+	throw LVException(__FILE__, __LINE__, "Invalid scaling method (0: min/max, 1: standardize).");
+}
+
+//
+//-- Binary model sections
+//
+
+void LVWriteBinaryScaling(const LVScaling &scaling, LVBinaryWriter &writer) {
+	if (scaling.empty())
+		return;
+
+	writer.addSection(LVBinarySectionScalingScale, scaling.scale().data(), scaling.size());
+	writer.addSection(LVBinarySectionScalingShift, scaling.shift().data(), scaling.size());
+}
+
+std::shared_ptr<const LVScaling> LVReadBinaryScaling(const LVBinaryReader &reader) {
+	if (!reader.hasSection(LVBinarySectionScalingScale))
+		return nullptr;
+
+	size_t nScale = 0;
+	size_t nShift = 0;
+	const double *scale = reader.section<double>(LVBinarySectionScalingScale, nScale);
+	const double *shift = reader.section<double>(LVBinarySectionScalingShift, nShift);
+	if (nScale == 0)
+		return nullptr;
+
+	if (nScale != nShift)
+		throw LVException(__FILE__, __LINE__, "Invalid binary model: the scaling sections differ in length.");
+
+	return std::make_shared<const LVScaling>(std::vector<double>(scale, scale + nScale), std::vector<double>(shift, shift + nShift));
+}
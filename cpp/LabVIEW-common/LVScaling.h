@@ -0,0 +1,200 @@
+/// <summary>
+/// Native feature scaling shared by the three wrappers.
+/// The statistics of all features are gathered in a single parallel pass over the problem, and the resulting
+/// affine transform is either applied to a problem in place or stored with a model, so that prediction
+/// applies it to every input on the fly.
+/// </summary>
+
+#ifndef LVSCALING_H_
+#define LVSCALING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "LVBinaryModel.h"
+#include "LVParallel.h"
+
+/// <summary> Scaling methods (values passed from LabVIEW). </summary>
+enum class LVScalingMethod : int32_t {
+	MinMax = 0,			//!< Maps [min, max] of every feature to [lower, upper] (same as svm-scale).
+	Standardize = 1		//!< Zero mean and unit variance of every feature.
+};
+
+/// <summary>
+/// Affine transform of every feature, x' = x * scale[i] + shift[i] for feature index i.
+/// Features outside of [0, size()) are left unchanged (e.g. the bias feature of liblinear).
+/// Constant features are mapped to zero, as svm-scale does.
+/// </summary>
+class LVScaling {
+public:
+	LVScaling() {}
+
+	/// <summary> Throws LVException if the sizes differ or a value is not finite. </summary>
+	LVScaling(std::vector<double> scale, std::vector<double> shift);
+
+	size_t size() const { return m_scale.size(); }
+	bool empty() const { return m_scale.empty(); }
+	const std::vector<double> & scale() const { return m_scale; }
+	const std::vector<double> & shift() const { return m_shift; }
+
+	/// <summary> Features with a nonzero shift (ascending), implicit zeros of sparse vectors become nonzero for these. </summary>
+	const std::vector<int32_t> & shifted() const { return m_shifted; }
+
+	double apply(int32_t index, double value) const {
+		if (index < 0 || static_cast<size_t>(index) >= m_scale.size())
+			return value;
+		return value * m_scale[index] + m_shift[index];
+	}
+
+	/// <summary>
+	/// Length of a dense vector of n values after scaling, vectors are extended up to the last feature with a nonzero shift.
+	/// The values of the extension are zero before scaling.
+	/// </summary>
+	size_t scaledDenseSize(size_t n) const {
+		if (m_shifted.empty() || static_cast<size_t>(m_shifted.back()) < n)
+			return n;
+		return static_cast<size_t>(m_shifted.back()) + 1;
+	}
+
+	/// <summary> Scales the first n values of a dense vector in place (value j is feature j). </summary>
+	void applyDense(double *values, size_t n) const;
+
+	/// <summary> Number of nodes of a sparse vector (terminated by index -1) after scaling, excluding the terminator. </summary>
+	template<class Node>
+	size_t scaledSize(const Node *x) const {
+		size_t n = 0;
+		size_t shiftedStored = 0;
+		for (const Node *p = x; p->index != -1; p++) {
+			n++;
+			if (p->index >= 0 && static_cast<size_t>(p->index) < m_shift.size() && m_shift[p->index] != 0)
+				shiftedStored++;
+		}
+		return n + m_shifted.size() - shiftedStored;
+	}
+
+	/// <summary>
+	/// Writes the scaled sparse vector x (terminated by index -1) to out, which must have room for scaledSize(x)+1 nodes.
+	/// Implicit zeros of shifted features are inserted, so the result remains ordered by index.
+	/// </summary>
+	template<class Node>
+	void applySparse(const Node *x, Node *out) const {
+		const Node *p = x;
+		size_t a = 0;
+		size_t nShifted = m_shifted.size();
+
+		while (p->index != -1 || a < nShifted) {
+			if (p->index != -1 && (a == nShifted || p->index <= m_shifted[a])) {
+				if (a < nShifted && p->index == m_shifted[a])
+					a++;
+				out->index = p->index;
+				out->value = apply(p->index, p->value);
+				p++;
+			}
+			else {
+				out->index = m_shifted[a];
+				out->value = m_shift[m_shifted[a]];
+				a++;
+			}
+			out++;
+		}
+
+		out->index = -1;
+		out->value = 0;
+	}
+
+private:
+	std::vector<double> m_scale;
+	std::vector<double> m_shift;
+	std::vector<int32_t> m_shifted;
+};
+
+/// <summary> Combines two partial means/variances (Chan et al.), (n, mean, m2) becomes the statistics of both. </summary>
+inline void LVMergeMoments(uint64_t &n, double &mean, double &m2, uint64_t nB, double meanB, double m2B) {
+	if (nB == 0)
+		return;
+
+	uint64_t nAB = n + nB;
+	double delta = meanB - mean;
+	mean += delta * static_cast<double>(nB) / static_cast<double>(nAB);
+	m2 += m2B + delta * delta * static_cast<double>(n) * static_cast<double>(nB) / static_cast<double>(nAB);
+	n = nAB;
+}
+
+/// <summary>
+/// Running statistics (min, max, mean and variance) of the stored values of every feature.
+/// Each thread accumulates its own rows, the partial results are merged afterwards.
+/// </summary>
+class LVFeatureStatistics {
+public:
+	explicit LVFeatureStatistics(size_t nFeatures);
+
+	/// <summary> Adds a stored value of feature index (indices outside of [0, nFeatures) are ignored). </summary>
+	void add(int32_t index, double value) {
+		if (index < 0 || static_cast<size_t>(index) >= m_count.size())
+			return;
+
+		// Welford's update
+		uint64_t n = ++m_count[index];
+		double delta = value - m_mean[index];
+		m_mean[index] += delta / static_cast<double>(n);
+		m_m2[index] += delta * (value - m_mean[index]);
+
+		if (value < m_min[index])
+			m_min[index] = value;
+		if (value > m_max[index])
+			m_max[index] = value;
+	}
+
+	/// <summary> Merges the statistics of another set of rows. </summary>
+	void merge(const LVFeatureStatistics &other);
+
+	/// <summary>
+	/// Computes the scaling for nSamples rows. Features without stored values in some rows are zero in those rows (sparse layouts).
+	/// Features below firstIndex (e.g. index 0 of precomputed kernels) are left unchanged.
+	/// </summary>
+	LVScaling finish(size_t nSamples, size_t firstIndex, LVScalingMethod method, double lower, double upper) const;
+
+private:
+	std::vector<uint64_t> m_count;
+	std::vector<double> m_mean;
+	std::vector<double> m_m2;
+	std::vector<double> m_min;
+	std::vector<double> m_max;
+};
+
+/// <summary>
+/// Computes the scaling of l rows with features [firstIndex, nFeatures) in parallel.
+/// addRow(i, statistics) must add the stored values of row i, it is called concurrently for different rows.
+/// </summary>
+template<class F>
+LVScaling LVComputeScaling(size_t l, size_t nFeatures, size_t firstIndex, LVScalingMethod method, double lower, double upper, F addRow) {
+	size_t nThreads = LVThreadCount(l, 1024);
+	std::vector<LVFeatureStatistics> statistics(nThreads, LVFeatureStatistics(nFeatures));
+
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++)
+			addRow(i, statistics[t]);
+	});
+
+	for (size_t t = 1; t < nThreads; t++)
+		statistics[0].merge(statistics[t]);
+
+	return statistics[0].finish(l, firstIndex, method, lower, upper);
+}
+
+/// <summary> Validates the method and range passed from LabVIEW. Throws LVException if invalid. </summary>
+LVScalingMethod LVCheckScalingMethod(int32_t method, double lower, double upper);
+
+// Optional sections of binary models holding the scaling (same ids for all wrappers, outside the range used by the wrappers)
+const uint32_t LVBinarySectionScalingScale = 0x1000;	// double (number of features)
+const uint32_t LVBinarySectionScalingShift = 0x1001;	// double (number of features)
+
+/// <summary> Adds the scaling sections to a binary model (nothing is added if the scaling is empty). </summary>
+void LVWriteBinaryScaling(const LVScaling &scaling, LVBinaryWriter &writer);
+
+/// <summary> Returns the scaling stored in a binary model, or nullptr if there is none. </summary>
+std::shared_ptr<const LVScaling> LVReadBinaryScaling(const LVBinaryReader &reader);
+
+#endif // LVSCALING_H_
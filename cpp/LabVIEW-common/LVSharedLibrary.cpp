@@ -0,0 +1,105 @@
+#include "LVSharedLibrary.h"
+#include "LVException.h"
+
+#include <string>
+
+#include <extcode.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+	#ifndef NOMINMAX
+	#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <dlfcn.h>
+#endif
+
+#if defined(_WIN32) || defined(_WIN64)
+
+std::string LVModuleDirectory() {
+	HMODULE module = nullptr;
+	if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+		reinterpret_cast<LPCSTR>(&LVModuleDirectory), &module))
+		throw LVException(__FILE__, __LINE__, "Unable to locate the library (error " + std::to_string(GetLastError()) + ").");
+
+	char path[MAX_PATH];
+	DWORD length = GetModuleFileNameA(module, path, MAX_PATH);
+	if (length == 0 || length >= MAX_PATH)
+		throw LVException(__FILE__, __LINE__, "Unable to locate the library (error " + std::to_string(GetLastError()) + ").");
+
+	std::string directory(path, length);
+	return directory.substr(0, directory.find_last_of("\\/") + 1);
+}
+
+LVSharedLibrary::LVSharedLibrary(const char *baseName) : m_path(LVModuleDirectory() + baseName + ".dll"), m_handle(nullptr) {
+	m_handle = LoadLibraryA(m_path.c_str());
+	if (m_handle == nullptr)
+		throw LVException(__FILE__, __LINE__, "Unable to load " + m_path + " (error " + std::to_string(GetLastError()) + ").");
+}
+
+LVSharedLibrary::~LVSharedLibrary() {
+	if (m_handle != nullptr)
+		FreeLibrary(static_cast<HMODULE>(m_handle));
+}
+
+void * LVSharedLibrary::symbol(const char *name) const {
+	void *address = reinterpret_cast<void*>(GetProcAddress(static_cast<HMODULE>(m_handle), name));
+	if (address == nullptr)
+		throw LVException(__FILE__, __LINE__, std::string("The function ") + name + " is not exported by " + m_path + ".");
+	return address;
+}
+
+#else
+
+std::string LVModuleDirectory() {
+	Dl_info info;
+	if (dladdr(reinterpret_cast<void*>(&LVModuleDirectory), &info) == 0 || info.dli_fname == nullptr)
+		throw LVException(__FILE__, __LINE__, "Unable to locate the library.");
+
+	std::string path(info.dli_fname);
+	size_t separator = path.find_last_of('/');
+	return (separator == std::string::npos) ? std::string() : path.substr(0, separator + 1);
+}
+
+LVSharedLibrary::LVSharedLibrary(const char *baseName) : m_path(LVModuleDirectory() + baseName + ".so"), m_handle(nullptr) {
+	int flags = RTLD_NOW | RTLD_LOCAL;
+#ifdef RTLD_DEEPBIND
+	flags |= RTLD_DEEPBIND;
+#endif
+
+	m_handle = dlopen(m_path.c_str(), flags);
+	if (m_handle == nullptr) {
+		const char *error = dlerror();
+		throw LVException(__FILE__, __LINE__, "Unable to load " + m_path + " (" + (error ? error : "unknown error") + ").");
+	}
+}
+
+LVSharedLibrary::~LVSharedLibrary() {
+	if (m_handle != nullptr)
+		dlclose(m_handle);
+}
+
+void * LVSharedLibrary::symbol(const char *name) const {
+	dlerror();
+	void *address = dlsym(m_handle, name);
+	if (address == nullptr)
+		throw LVException(__FILE__, __LINE__, std::string("The function ") + name + " is not exported by " + m_path + ".");
+	return address;
+}
+
+#endif
+
+void LVThrowLibraryError(lvError &err) {
+	std::string message;
+	if (err.source != nullptr && DSCheckHandle(err.source) == noErr) {
+		message.assign(reinterpret_cast<const char*>((*err.source)->str), static_cast<size_t>((*err.source)->cnt));
+		DSDisposeHandle(err.source);
+	}
+	err.source = nullptr;
+
+	if (!err.status)
+		return;
+
+	err.status = false;
+	throw LVException(__FILE__, __LINE__, err.code, message);
+}
@@ -0,0 +1,52 @@
+/// <summary>
+/// Run-time loading of the other wrapper libraries (e.g. to dispatch training to another engine).
+/// The wrapper libraries are installed side by side, so a library is located in the directory of the calling library.
+/// </summary>
+
+#ifndef LVSHAREDLIBRARY_H_
+#define LVSHAREDLIBRARY_H_
+
+#include <string>
+
+#include "LVException.h"
+
+/// <summary>
+/// RAII wrapper around a loaded shared library (dlopen on POSIX, LoadLibrary on Windows).
+/// On glibc the library is loaded with RTLD_DEEPBIND, so it uses its own definitions of symbols that several wrappers share
+/// (e.g. svm_train in libsvm and libsvm-dense) even if the calling library exported them globally.
+/// </summary>
+class LVSharedLibrary {
+public:
+	/// <summary> Loads the library baseName (without extension) from the directory of the calling library. Throws LVException on failure. </summary>
+	explicit LVSharedLibrary(const char *baseName);
+
+	~LVSharedLibrary();
+
+	LVSharedLibrary(const LVSharedLibrary&) = delete;
+	LVSharedLibrary& operator=(const LVSharedLibrary&) = delete;
+
+	/// <summary> Returns the exported function name. Throws LVException if it is not exported. </summary>
+	template<class F>
+	F function(const char *name) const {
+		return reinterpret_cast<F>(symbol(name));
+	}
+
+	const std::string & path() const { return m_path; }
+
+private:
+	void * symbol(const char *name) const;
+
+	std::string m_path;
+	void *m_handle;
+};
+
+/// <summary> Directory (with a trailing separator) of the library that contains this function. </summary>
+std::string LVModuleDirectory();
+
+/// <summary>
+/// Throws the error returned by a function of another library (in err) as LVException with the same code and message.
+/// The message handle is disposed. Does nothing if err has no error.
+/// </summary>
+void LVThrowLibraryError(lvError &err);
+
+#endif // LVSHAREDLIBRARY_H_
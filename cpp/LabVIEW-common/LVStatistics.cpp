@@ -0,0 +1,87 @@
+#include "LVStatistics.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+namespace {
+	thread_local LVStats *currentStats = nullptr;
+
+	std::mutex printMutex;			// Guards the members below
+	size_t printScopes = 0;			// _stats calls in progress
+	bool printInstalled = false;	// Installed for good
+}
+
+LVStats::LVStats() : m_iterations(0), m_unshrinks(0), m_solves(0), m_nSV(0) {
+	for (auto &ticks : m_ticks)
+		ticks = 0;
+}
+
+void LVStats::addTime(LVStatsPhase phase, std::chrono::steady_clock::duration duration) {
+	m_ticks[static_cast<int32_t>(phase)] += duration.count();
+}
+
+void LVStats::copyTo(LVSolverStats &stats_out) const {
+	auto seconds = [](int64_t ticks) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::duration(ticks)).count();
+	};
+
+	stats_out.marshal_seconds = seconds(m_ticks[static_cast<int32_t>(LVStatsPhase::Marshal)]);
+	stats_out.solver_seconds = seconds(m_ticks[static_cast<int32_t>(LVStatsPhase::Solver)]);
+	stats_out.copy_seconds = seconds(m_ticks[static_cast<int32_t>(LVStatsPhase::Copy)]);
+	stats_out.iterations = m_iterations;
+	stats_out.unshrinks = m_unshrinks;
+	stats_out.solves = m_solves;
+	stats_out.nSV = m_nSV;
+}
+
+LVStats * LVStats::current() {
+	return currentStats;
+}
+
+LVStatsScope::LVStatsScope(LVStats *stats) : m_previous(currentStats) {
+	currentStats = stats;
+}
+
+LVStatsScope::~LVStatsScope() {
+	currentStats = m_previous;
+}
+
+void LVCountSolverOutput(const char *message) {
+	LVStats *stats = LVStats::current();
+	if (stats == nullptr)
+		return;
+
+	// libsvm: "*" when the gradient is reconstructed, "optimization finished, #iter = N" at the end of every solve (also liblinear's coordinate descent)
+	// liblinear: "iter N ..." for every Newton iteration
+	const char *iter = std::strstr(message, "#iter = ");
+	if (std::strcmp(message, "*") == 0) {
+		stats->addUnshrink();
+	}
+	else if (iter != nullptr) {
+		stats->addIterations(std::strtoll(iter + 8, nullptr, 10));
+		stats->addSolve();
+	}
+	else if (std::strncmp(message, "iter", 4) == 0) {
+		stats->addIterations(1);
+	}
+}
+
+void LVInstallPrintFunction(LVSetPrintFunction set, LVPrintFunction print) {
+	std::lock_guard<std::mutex> lock(printMutex);
+	printInstalled = true;
+	set(print);
+}
+
+LVPrintFunctionScope::LVPrintFunctionScope(LVSetPrintFunction set, LVPrintFunction print) : m_set(set) {
+	std::lock_guard<std::mutex> lock(printMutex);
+	if (printScopes++ == 0)
+		m_set(print);
+}
+
+LVPrintFunctionScope::~LVPrintFunctionScope() {
+	std::lock_guard<std::mutex> lock(printMutex);
+	// nullptr selects the default print function of libsvm and liblinear
+	if (--printScopes == 0 && !printInstalled)
+		m_set(nullptr);
+}
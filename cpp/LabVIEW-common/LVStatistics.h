@@ -0,0 +1,143 @@
+/// <summary>
+/// Counters and timings of train, cross-validation and predict calls, returned by the _stats variants of the entry points.
+/// A call collects into an LVStats made current with LVStatsScope on the calling thread (and on the thread pool tasks of the call, see LVThreadPool.h).
+/// Without a collector, every probe in the plain entry points costs a test of a thread-local pointer.
+/// The time is split where the wrapper hands over: marshalling (LabVIEW data to the library structures, the model conversion of predictions),
+/// solver (the library calls) and copy-back (results to LabVIEW data). Time spent on several threads at once is summed.
+/// The solvers of libsvm and liblinear are not instrumented, their counters are taken from their progress output (see the print functions of the wrappers):
+///		the iterations reported at the end of every libsvm solve and liblinear coordinate descent solve ("#iter = N"), the Newton iterations of liblinear ("iter N"),
+///		and the gradient reconstructions of libsvm when shrinking is undone ("*"). Kernel evaluations and the kernel cache are internal to libsvm and not counted.
+/// </summary>
+
+#ifndef LVSTATISTICS_H_
+#define LVSTATISTICS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <lv_prolog.h>
+
+// Statistics of a call (LabVIEW cluster)
+struct LVSolverStats {
+	double marshal_seconds;
+	double solver_seconds;
+	double copy_seconds;
+	int64_t iterations;		// Solver iterations of all solves
+	int64_t unshrinks;		// Gradient reconstructions of libsvm's shrinking
+	int32_t solves;			// Solves that reported their iterations (libsvm: one per class pair, fold and probability estimate)
+	int32_t nSV;			// Support vectors of the trained model (libsvm), 0 otherwise
+};
+
+#include <lv_epilog.h>
+
+// LabVIEW warning code of a training whose solver output was not received (LVException defaults to 7000, see LVCancellation.h for 7001 and 7002)
+const int32_t LVErrorNoSolverOutput = 7003;
+
+enum class LVStatsPhase : int32_t {
+	Marshal = 0,
+	Solver = 1,
+	Copy = 2
+};
+
+/// <summary> Collector of a call, thread-safe. </summary>
+class LVStats {
+public:
+	LVStats();
+
+	LVStats(const LVStats&) = delete;
+	LVStats& operator=(const LVStats&) = delete;
+
+	void addTime(LVStatsPhase phase, std::chrono::steady_clock::duration duration);
+
+	void addIterations(int64_t iterations) { m_iterations += iterations; }
+
+	void addSolve() { m_solves++; }
+
+	void addUnshrink() { m_unshrinks++; }
+
+	void setSupportVectors(int32_t nSV) { m_nSV = nSV; }
+
+	int64_t iterations() const { return m_iterations; }
+
+	void copyTo(LVSolverStats &stats_out) const;
+
+	/// <summary> Collector of the calling thread (see LVStatsScope), nullptr if none. </summary>
+	static LVStats * current();
+
+private:
+	std::atomic<int64_t> m_ticks[3];	// steady_clock ticks per phase
+	std::atomic<int64_t> m_iterations;
+	std::atomic<int64_t> m_unshrinks;
+	std::atomic<int32_t> m_solves;
+	std::atomic<int32_t> m_nSV;
+};
+
+/// <summary> Makes the collector the collector of the calling thread (nullptr for none), the previous one is restored when the scope ends. </summary>
+class LVStatsScope {
+public:
+	explicit LVStatsScope(LVStats *stats);
+	~LVStatsScope();
+
+	LVStatsScope(const LVStatsScope&) = delete;
+	LVStatsScope& operator=(const LVStatsScope&) = delete;
+
+private:
+	LVStats *m_previous;
+};
+
+/// <summary> Adds the time from the construction to stop() (or the end of the scope) to a phase of the calling thread's collector, if any. </summary>
+class LVStatsTimer {
+public:
+	explicit LVStatsTimer(LVStatsPhase phase) : m_stats(LVStats::current()), m_phase(phase) {
+		if (m_stats != nullptr)
+			m_start = std::chrono::steady_clock::now();
+	}
+
+	~LVStatsTimer() { stop(); }
+
+	LVStatsTimer(const LVStatsTimer&) = delete;
+	LVStatsTimer& operator=(const LVStatsTimer&) = delete;
+
+	void stop() {
+		if (m_stats != nullptr)
+			m_stats->addTime(m_phase, std::chrono::steady_clock::now() - m_start);
+		m_stats = nullptr;
+	}
+
+private:
+	LVStats *m_stats;
+	LVStatsPhase m_phase;
+	std::chrono::steady_clock::time_point m_start;
+};
+
+/// <summary> Counts the iterations and events in a progress message of the solvers (called by the print functions). </summary>
+void LVCountSolverOutput(const char *message);
+
+// Print function of a library and the function of the library that sets it (svm_set_print_string_function or set_print_string_function)
+typedef void (*LVPrintFunction)(const char *);
+typedef void (*LVSetPrintFunction)(LVPrintFunction);
+
+/// <summary>
+/// Installs the print function of the wrapper for good (logging, cancellable runs, jobs and grid searches).
+/// Every wrapper library links a single solver library, so the state is per binary.
+/// </summary>
+void LVInstallPrintFunction(LVSetPrintFunction set, LVPrintFunction print);
+
+/// <summary>
+/// Installs the print function of the wrapper for the duration of a _stats call, the counters are taken from its output.
+/// When the last of the concurrent calls ends, the default of the library (console output) is restored, unless the print function has been installed for good.
+/// </summary>
+class LVPrintFunctionScope {
+public:
+	LVPrintFunctionScope(LVSetPrintFunction set, LVPrintFunction print);
+	~LVPrintFunctionScope();
+
+	LVPrintFunctionScope(const LVPrintFunctionScope&) = delete;
+	LVPrintFunctionScope& operator=(const LVPrintFunctionScope&) = delete;
+
+private:
+	LVSetPrintFunction m_set;
+};
+
+#endif // LVSTATISTICS_H_
@@ -0,0 +1,438 @@
+#include "LVTextFormat.h"
+#include "LVException.h"
+#include "LVUtility.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <errno.h>
+#include <locale.h>
+
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+
+//
+//-- Locale
+//
+
+#if defined(_WIN32) || defined(_WIN64)
+
+LVScopedCLocale::LVScopedCLocale() {
+	// Restrict setlocale to the calling thread
+	m_previousConfig = _configthreadlocale(_ENABLE_PER_THREAD_LOCALE);
+	const char *previous = setlocale(LC_NUMERIC, nullptr);
+	m_previous = (previous != nullptr) ? previous : "";
+	setlocale(LC_NUMERIC, "C");
+}
+
+LVScopedCLocale::~LVScopedCLocale() {
+	if (!m_previous.empty())
+		setlocale(LC_NUMERIC, m_previous.c_str());
+	if (m_previousConfig != -1 && m_previousConfig != _ENABLE_PER_THREAD_LOCALE)
+		_configthreadlocale(m_previousConfig);
+}
+
+#else
+
+// Created once and shared by all threads (never freed, the locale object is immutable)
+static locale_t LVGetCLocale() {
+	static locale_t cLocale = newlocale(LC_ALL_MASK, "C", static_cast<locale_t>(0));
+	return cLocale;
+}
+
+LVScopedCLocale::LVScopedCLocale() : m_previous(nullptr) {
+	locale_t cLocale = LVGetCLocale();
+	if (cLocale != static_cast<locale_t>(0))
+		m_previous = static_cast<void*>(uselocale(cLocale));
+}
+
+LVScopedCLocale::~LVScopedCLocale() {
+	if (m_previous != nullptr)
+		uselocale(static_cast<locale_t>(m_previous));
+}
+
+#endif
+
+//
+//-- Writer
+//
+
+// Largest magnitude where every integral double is written as an integer by the fast path
+static const double LVFastIntegerLimit = 1e15;
+
+// Number of decimal digits of a positive integer
+static inline int LVDigitCount(uint64_t value) {
+	int digits = 1;
+	while (value >= 10) {
+		value /= 10;
+		digits++;
+	}
+	return digits;
+}
+
+// Integral values are common (labels, indices, binary features) and are written without printf
+// Returns false if printf would use exponential notation or the value is not integral
+static inline bool LVTryPutIntegral(LVTextWriter &writer, double value, int precision) {
+	if (!(std::fabs(value) < LVFastIntegerLimit))
+		return false;
+
+	double integral = std::floor(value);
+	if (integral != value)
+		return false;
+
+	if (value == 0) {
+		writer.put(std::signbit(value) ? "-0" : "0");
+		return true;
+	}
+
+	int64_t iv = static_cast<int64_t>(value);
+	uint64_t magnitude = static_cast<uint64_t>(iv < 0 ? -iv : iv);
+	if (LVDigitCount(magnitude) > precision)
+		return false;
+
+	writer.putInt(iv);
+	return true;
+}
+
+void LVTextWriter::put(const char *str) {
+	m_buffer.append(str);
+}
+
+void LVTextWriter::putInt(int64_t value) {
+	char buf[24];
+	char *p = buf + sizeof(buf);
+	uint64_t magnitude = (value < 0) ? static_cast<uint64_t>(0) - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+
+	do {
+		*--p = static_cast<char>('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude != 0);
+
+	if (value < 0)
+		*--p = '-';
+
+	m_buffer.append(p, buf + sizeof(buf) - p);
+}
+
+void LVTextWriter::putDouble(double value, int precision) {
+	if (LVTryPutIntegral(*this, value, precision))
+		return;
+
+	char buf[40];
+	int n = snprintf(buf, sizeof(buf), "%.*g", precision, value);
+	if (n < 0 || static_cast<size_t>(n) >= sizeof(buf))
+		throw LVException(__FILE__, __LINE__, "Number formatting failed.");
+	m_buffer.append(buf, n);
+}
+
+void LVTextWriter::putDoubleShortest(double value) {
+	if (LVTryPutIntegral(*this, value, 17))
+		return;
+
+	// 15 significant digits always round-trip from text to double (DBL_DIG), 17 always round-trip from double to text
+	char buf[40];
+	int n = 0;
+	for (int precision = DBL_DIG; precision <= 17; precision++) {
+		n = snprintf(buf, sizeof(buf), "%.*g", precision, value);
+		if (n < 0 || static_cast<size_t>(n) >= sizeof(buf))
+			throw LVException(__FILE__, __LINE__, "Number formatting failed.");
+		if (precision == 17 || std::strtod(buf, nullptr) == value)
+			break;
+	}
+	m_buffer.append(buf, n);
+}
+
+//
+//-- Cursor
+//
+
+static inline bool LVIsBlank(char c) {
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static inline bool LVIsDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+LVTextCursor::LVTextCursor(const char *begin, const char *end, size_t firstLine) : m_pos(begin), m_end(end), m_line(firstLine) {}
+
+void LVTextCursor::skipBlanks() {
+	while (m_pos < m_end && LVIsBlank(*m_pos))
+		m_pos++;
+}
+
+bool LVTextCursor::skipEmptyLines() {
+	for (;;) {
+		skipBlanks();
+		if (m_pos < m_end && *m_pos == '\n') {
+			m_pos++;
+			m_line++;
+		}
+		else {
+			return m_pos < m_end;
+		}
+	}
+}
+
+bool LVTextCursor::atEndOfLine() {
+	skipBlanks();
+	return m_pos == m_end || *m_pos == '\n';
+}
+
+void LVTextCursor::nextLine() {
+	const char *eol = static_cast<const char*>(std::memchr(m_pos, '\n', m_end - m_pos));
+	if (eol != nullptr) {
+		m_pos = eol + 1;
+		m_line++;
+	}
+	else {
+		m_pos = m_end;
+	}
+}
+
+std::string LVTextCursor::readWord() {
+	skipBlanks();
+	const char *start = m_pos;
+	while (m_pos < m_end && *m_pos != '\n' && !LVIsBlank(*m_pos))
+		m_pos++;
+	return std::string(start, m_pos);
+}
+
+int LVTextCursor::readInt() {
+	skipBlanks();
+
+	bool negative = false;
+	if (m_pos < m_end && (*m_pos == '-' || *m_pos == '+')) {
+		negative = (*m_pos == '-');
+		m_pos++;
+	}
+
+	if (m_pos == m_end || !LVIsDigit(*m_pos))
+		fail("expected an integer");
+
+	int64_t value = 0;
+	while (m_pos < m_end && LVIsDigit(*m_pos)) {
+		value = value * 10 + (*m_pos - '0');
+		if (value > static_cast<int64_t>(INT_MAX) + 1)
+			fail("integer out of range");
+		m_pos++;
+	}
+
+	if (negative)
+		value = -value;
+
+	if (value > INT_MAX)
+		fail("integer out of range");
+
+	return static_cast<int>(value);
+}
+
+bool LVParseDouble(const char *begin, const char *end, double &value) {
+	if (begin == end)
+		return false;
+
+	// Fast path (Clinger): up to 15 significant digits and a power of ten up to 1e22 are exact doubles,
+	// so a single multiplication/division gives the correctly rounded result, identical to strtod.
+	// Requires double arithmetic without excess precision (not the case with x87 FPU code).
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+	{
+		static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+		const char *p = begin;
+		bool negative = false;
+		if (p < end && (*p == '-' || *p == '+')) {
+			negative = (*p == '-');
+			p++;
+		}
+
+		uint64_t mantissa = 0;
+		int digits = 0;		// Significant digits (leading zeros excluded)
+		int exponent = 0;
+		bool any = false;
+
+		while (p < end && LVIsDigit(*p)) {
+			mantissa = mantissa * 10 + (*p - '0');
+			if (mantissa != 0)
+				digits++;
+			any = true;
+			p++;
+			if (digits > 15)
+				break;
+		}
+
+		if (digits <= 15 && p < end && *p == '.') {
+			p++;
+			while (p < end && LVIsDigit(*p) && digits <= 15) {
+				mantissa = mantissa * 10 + (*p - '0');
+				if (mantissa != 0)
+					digits++;
+				exponent--;
+				any = true;
+				p++;
+			}
+		}
+
+		if (any && digits <= 15 && p < end && (*p == 'e' || *p == 'E')) {
+			const char *q = p + 1;
+			bool expNegative = false;
+			if (q < end && (*q == '-' || *q == '+')) {
+				expNegative = (*q == '-');
+				q++;
+			}
+
+			int e = 0;
+			bool expAny = false;
+			while (q < end && LVIsDigit(*q) && e < 1000) {
+				e = e * 10 + (*q - '0');
+				expAny = true;
+				q++;
+			}
+
+			if (expAny) {
+				exponent += expNegative ? -e : e;
+				p = q;
+			}
+			else {
+				any = false;
+			}
+		}
+
+		if (any && p == end && digits <= 15 && exponent >= -22 && exponent <= 22) {
+			double result = static_cast<double>(mantissa);
+			if (exponent < 0)
+				result /= pow10[-exponent];
+			else
+				result *= pow10[exponent];
+
+			value = negative ? -result : result;
+			return true;
+		}
+	}
+#endif
+
+	// Slow path: strtod requires a null-terminated string (the buffer might be a memory map)
+	// Leading blanks are rejected to match the fast path
+	if (LVIsBlank(*begin) || *begin == '\n')
+		return false;
+
+	std::string token(begin, end);
+	char *tokenEnd = nullptr;
+	double result = std::strtod(token.c_str(), &tokenEnd);
+	if (tokenEnd != token.c_str() + token.size())
+		return false;
+
+	value = result;
+	return true;
+}
+
+double LVTextCursor::readDouble() {
+	skipBlanks();
+
+	// The token ends at a blank or line break
+	const char *start = m_pos;
+	const char *p = m_pos;
+	while (p < m_end && *p != '\n' && !LVIsBlank(*p))
+		p++;
+
+	if (p == start)
+		fail("expected a number");
+
+	double value;
+	if (!LVParseDouble(start, p, value))
+		fail("invalid number '" + std::string(start, p) + "'");
+
+	m_pos = p;
+	return value;
+}
+
+void LVTextCursor::expect(char c) {
+	if (m_pos == m_end || *m_pos != c)
+		fail(std::string("expected '") + c + "'");
+	m_pos++;
+}
+
+void LVTextCursor::fail(const std::string &reason) const {
+	throw LVException(__FILE__, __LINE__, "Parse error at line " + std::to_string(m_line) + ": " + reason + ".");
+}
+
+//
+//-- Chunking
+//
+
+std::vector<const char*> LVSplitLines(const char *begin, const char *end, size_t nChunks) {
+	std::vector<const char*> bounds;
+	bounds.push_back(begin);
+
+	size_t total = static_cast<size_t>(end - begin);
+	if (nChunks == 0)
+		nChunks = 1;
+
+	for (size_t i = 1; i < nChunks; i++) {
+		const char *target = begin + total / nChunks * i;
+		if (target <= bounds.back())
+			continue;
+
+		// Move the boundary to the start of the next line
+		const char *eol = static_cast<const char*>(std::memchr(target, '\n', end - target));
+		if (eol == nullptr)
+			break;
+
+		if (eol + 1 > bounds.back() && eol + 1 < end)
+			bounds.push_back(eol + 1);
+	}
+
+	if (end > bounds.back())
+		bounds.push_back(end);
+
+	return bounds;
+}
+
+size_t LVCountNonEmptyLines(const char *begin, const char *end) {
+	size_t count = 0;
+	bool content = false;
+	for (const char *p = begin; p < end; p++) {
+		if (*p == '\n') {
+			if (content)
+				count++;
+			content = false;
+		}
+		else if (!LVIsBlank(*p)) {
+			content = true;
+		}
+	}
+
+	if (content)
+		count++;
+
+	return count;
+}
+
+size_t LVCountLineBreaks(const char *begin, const char *end) {
+	return static_cast<size_t>(std::count(begin, end, '\n'));
+}
+
+//
+//-- Files
+//
+
+void LVWriteTextFile(const char *path, const std::vector<std::string> &parts) {
+	errno = 0;
+	std::unique_ptr<FILE, int(*)(FILE*)> fp(fopen(path, "w"), fclose);
+	if (!fp)
+		throw LVException(__FILE__, __LINE__, "Unable to open file for writing (" + LVErrnoString(errno) + ").");
+
+	for (const std::string &part : parts) {
+		if (!part.empty() && fwrite(part.data(), 1, part.size(), fp.get()) != part.size())
+			throw LVException(__FILE__, __LINE__, "Write failed (" + LVErrnoString(errno) + ").");
+	}
+
+	if (fclose(fp.release()) != 0)
+		throw LVException(__FILE__, __LINE__, "Unable to close file (" + LVErrnoString(errno) + ").");
+}
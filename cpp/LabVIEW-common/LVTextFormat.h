@@ -0,0 +1,150 @@
+/// <summary>
+/// Locale-independent text formatting and parsing used by the native readers/writers of the
+/// libsvm/liblinear text formats.
+///
+/// Numbers are always written and read with '.' as decimal separator, regardless of the locale
+/// LabVIEW (or the user) has set for the process.
+/// Formatting produces the same bytes as printf("%.*g") in the "C" locale, which is what libsvm and liblinear use.
+/// </summary>
+
+#ifndef LVTEXTFORMAT_H_
+#define LVTEXTFORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Selects the "C" locale for numeric formatting on the calling thread while in scope.
+/// Only the calling thread is affected, other threads (e.g. the LabVIEW UI) keep their locale.
+/// </summary>
+class LVScopedCLocale {
+public:
+	LVScopedCLocale();
+	~LVScopedCLocale();
+
+	LVScopedCLocale(const LVScopedCLocale&) = delete;
+	LVScopedCLocale& operator=(const LVScopedCLocale&) = delete;
+
+private:
+#if defined(_WIN32) || defined(_WIN64)
+	int m_previousConfig;		//!< Previous _configthreadlocale setting.
+	std::string m_previous;		//!< Previous LC_NUMERIC locale name.
+#else
+	void *m_previous;			//!< Previous locale_t of the thread.
+#endif
+};
+
+/// <summary>
+/// Appends formatted text to a string buffer.
+/// Each writer selects the "C" locale for the calling thread, writers must not be shared between threads.
+/// </summary>
+class LVTextWriter {
+public:
+	LVTextWriter() {}
+
+	/// <summary> Appends a string. </summary>
+	void put(const char *str);
+	void put(char c) { m_buffer.push_back(c); }
+
+	/// <summary> Appends an integer (printf("%d")). </summary>
+	void putInt(int64_t value);
+
+	/// <summary> Appends a double as printf("%.*g", precision) would in the "C" locale. </summary>
+	void putDouble(double value, int precision);
+
+	/// <summary> Appends the shortest representation (at most 17 significant digits) that parses back to exactly the same double. </summary>
+	void putDoubleShortest(double value);
+
+	/// <summary> Appends a double with the given precision, or as putDoubleShortest if roundTrip is set. </summary>
+	void putDouble(double value, int precision, bool roundTrip) {
+		if (roundTrip)
+			putDoubleShortest(value);
+		else
+			putDouble(value, precision);
+	}
+
+	void reserve(size_t size) { m_buffer.reserve(size); }
+	size_t size() const { return m_buffer.size(); }
+	const std::string & str() const { return m_buffer; }
+	std::string & str() { return m_buffer; }
+
+private:
+	LVScopedCLocale m_locale;
+	std::string m_buffer;
+};
+
+/// <summary>
+/// Reads tokens from a text buffer (not required to be null-terminated, e.g. a memory map).
+/// Blanks (' ', '\t', '\r') separate tokens, '\n' separates lines.
+/// Parse errors are reported as LVException with the line number.
+/// Each cursor selects the "C" locale for the calling thread, cursors must not be shared between threads.
+/// </summary>
+class LVTextCursor {
+public:
+	/// <summary> Cursor over [begin, end), firstLine is the line number of begin (used in error messages). </summary>
+	LVTextCursor(const char *begin, const char *end, size_t firstLine = 1);
+
+	/// <summary> Skips blanks and empty lines, returns false if the end of the buffer was reached. </summary>
+	bool skipEmptyLines();
+
+	/// <summary> Skips blanks, returns true if the cursor is at the end of the line (or the buffer). </summary>
+	bool atEndOfLine();
+
+	/// <summary> Skips the remainder of the current line including the line break. </summary>
+	void nextLine();
+
+	/// <summary> Reads a word delimited by blanks or line breaks. </summary>
+	std::string readWord();
+
+	/// <summary> Reads a decimal integer. Throws if the next token is not a valid integer. </summary>
+	int readInt();
+
+	/// <summary> Reads a floating-point number, the token ends at a blank or line break. Throws if invalid. </summary>
+	double readDouble();
+
+	/// <summary> Consumes the character c (no blanks skipped). Throws if the next character is different. </summary>
+	void expect(char c);
+
+	/// <summary> Throws an LVException describing the error at the current line. </summary>
+	[[noreturn]] void fail(const std::string &reason) const;
+
+	const char * position() const { return m_pos; }
+	const char * end() const { return m_end; }
+	size_t line() const { return m_line; }
+
+private:
+	void skipBlanks();
+
+	LVScopedCLocale m_locale;
+	const char *m_pos;
+	const char *m_end;
+	size_t m_line;
+};
+
+/// <summary>
+/// Parses [begin, end) as a floating-point number (same syntax and result as strtod in the "C" locale).
+/// Returns false if the range is empty or not entirely a number. The caller must have selected the "C" locale.
+/// </summary>
+bool LVParseDouble(const char *begin, const char *end, double &value);
+
+/// <summary>
+/// Splits [begin, end) into at most nChunks ranges of about equal size that start at the beginning of a line.
+/// Returns the boundaries (chunk i is [bounds[i], bounds[i+1])), empty chunks are removed.
+/// </summary>
+std::vector<const char*> LVSplitLines(const char *begin, const char *end, size_t nChunks);
+
+/// <summary> Counts the lines in [begin, end) that contain anything other than blanks. </summary>
+size_t LVCountNonEmptyLines(const char *begin, const char *end);
+
+/// <summary> Counts the line breaks in [begin, end). </summary>
+size_t LVCountLineBreaks(const char *begin, const char *end);
+
+/// <summary>
+/// Writes the concatenation of parts to a file. Throws LVException on failure.
+/// The file is opened in text mode like libsvm/liblinear do, so line breaks follow the platform convention.
+/// </summary>
+void LVWriteTextFile(const char *path, const std::vector<std::string> &parts);
+
+#endif // LVTEXTFORMAT_H_
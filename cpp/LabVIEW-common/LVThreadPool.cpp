@@ -0,0 +1,538 @@
+#include "LVThreadPool.h"
+#include "LVCancellation.h"
+#include "LVStatistics.h"
+#include "LVException.h"
+#include "LVUtility.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#if defined(_WIN32) || defined(_WIN64)
+	#ifndef NOMINMAX
+	#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <errno.h>
+	#include <pthread.h>
+	#include <unistd.h>
+	#include <sys/resource.h>
+	#include <sys/syscall.h>
+#endif
+
+namespace {
+	// Latency work the calling thread takes part in (scopes and tasks of latency loops), a throughput loop started inside runs as latency loop
+	thread_local size_t latencyDepth = 0;
+}
+
+// A parallel loop in progress, shared by the calling thread and the runners posted to the workers
+struct LVThreadPool::Loop {
+	const std::function<void(size_t)> *task;
+	size_t nTasks;
+	LVWorkPriority priority;
+	LVStopCondition *stop;		// Stop condition of the calling thread, installed on the runners
+	LVStats *stats;				// Statistics collector of the calling thread, installed on the runners
+	std::atomic<size_t> next;
+	std::atomic<size_t> done;
+	std::vector<std::exception_ptr> errors;
+	std::mutex mutex;
+	std::condition_variable finished;
+
+	Loop(const std::function<void(size_t)> &task, size_t nTasks, LVWorkPriority priority) : task(&task), nTasks(nTasks), priority(priority), stop(LVStopCondition::current()), stats(LVStats::current()), next(0), done(0), errors(nTasks) {}
+
+	// Claims and executes tasks until all have been claimed (runners that arrive late return immediately)
+	// Before a throughput task is claimed, proceed() is asked whether to go on, a runner returns false to yield to latency work
+	bool run(const std::function<bool()> &proceed) {
+		for (;;) {
+			if (priority == LVWorkPriority::Throughput && !proceed())
+				return false;
+
+			size_t i = next++;
+			if (i >= nTasks)
+				return true;
+
+			if (priority == LVWorkPriority::Latency)
+				latencyDepth++;
+
+			try {
+				// The tasks of a stopped run fail without being executed
+				LVStopScope scope(stop);
+				LVStatsScope statsScope(stats);
+				LVCheckpoint();
+				(*task)(i);
+			}
+			catch (...) {
+				errors[i] = std::current_exception();
+			}
+
+			if (priority == LVWorkPriority::Latency)
+				latencyDepth--;
+
+			if (++done == nTasks) {
+				std::lock_guard<std::mutex> lock(mutex);
+				finished.notify_all();
+			}
+		}
+	}
+
+	void wait() {
+		std::unique_lock<std::mutex> lock(mutex);
+		finished.wait(lock, [this] { return done == nTasks; });
+	}
+};
+
+struct LVThreadPool::Worker {
+	std::mutex mutex;								// Guards the queues
+	std::deque<std::shared_ptr<Loop>> queue[2];	// Runners by LVWorkPriority
+	std::thread thread;
+	bool running;									// Guarded by the mutex of the group
+
+	Worker() : running(false) {}
+};
+
+// Workers sharing one set of settings, replaced as a whole by configure
+// Every running worker holds a reference, so a group that has been replaced lives until its last worker exits
+struct LVThreadPool::Group : std::enable_shared_from_this<LVThreadPool::Group> {
+	LVThreadPoolSettings settings;
+	std::vector<std::unique_ptr<Worker>> workers;
+	size_t nLatencyWorkers;			// Workers [0, nLatencyWorkers) run on the reserved cores and only take latency runners
+	std::vector<int32_t> throughputCpus;	// Affinity of the other workers and of throughput scopes, empty for all cores
+	std::atomic<size_t> nextWorker[2];
+
+	std::mutex mutex;				// Guards pending, stop, running, started, error and changes of latencyActive
+	std::condition_variable wake;	// Runners posted, latency work completed or stopped
+	std::condition_variable ready;
+	size_t pending[2];				// Runners in the queues by LVWorkPriority
+	std::atomic<size_t> latencyActive;	// Latency loops and scopes in progress
+	bool stop;
+	size_t started;					// Workers that have applied the settings
+	std::string error;				// First failure to apply the settings
+
+	Group(const LVThreadPoolSettings &settings, size_t hw) : settings(settings), latencyActive(0), stop(false), started(0) {
+		for (size_t w = 0; w < settings.threads; w++)
+			workers.emplace_back(new Worker());
+
+		nLatencyWorkers = std::min(settings.threads, settings.reserved.size());
+		throughputCpus = settings.cpus;
+		if (!settings.reserved.empty()) {
+			if (throughputCpus.empty()) {
+				for (size_t cpu = 0; cpu < std::min<size_t>(hw, 64); cpu++)
+					throughputCpus.push_back(static_cast<int32_t>(cpu));
+			}
+			throughputCpus.erase(std::remove_if(throughputCpus.begin(), throughputCpus.end(), [&](int32_t cpu) {
+				return std::find(settings.reserved.begin(), settings.reserved.end(), cpu) != settings.reserved.end();
+			}), throughputCpus.end());
+		}
+
+		for (size_t p = 0; p < 2; p++) {
+			nextWorker[p] = 0;
+			pending[p] = 0;
+		}
+	}
+
+	~Group() {
+		// The last reference is released by a worker if the group was stopped without joining, a thread cannot join itself
+		for (auto &worker : workers) {
+			if (worker->thread.get_id() == std::this_thread::get_id())
+				worker->thread.detach();
+			else if (worker->thread.joinable())
+				worker->thread.join();
+		}
+	}
+
+	// Lets the workers exit once the queued runners have been executed without waiting for them, the running workers keep the group alive.
+	// For the static destruction of the library: on Windows it runs under the loader lock, a thread cannot exit (nor be joined) while it is held
+	void detach() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+			for (auto &worker : workers) {
+				if (worker->thread.joinable())
+					worker->thread.detach();
+			}
+		}
+		wake.notify_all();
+	}
+
+	// Lets the workers exit once the queued runners have been executed, and waits for them if join
+	void shutdown(bool join) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		wake.notify_all();
+
+		if (!join)
+			return;
+
+		for (auto &worker : workers) {
+			if (worker->thread.joinable() && worker->thread.get_id() != std::this_thread::get_id())
+				worker->thread.join();
+		}
+	}
+
+	// Starts worker w if it is not running, the mutex must be held
+	void start(size_t w) {
+		Worker &worker = *workers[w];
+		if (worker.running)
+			return;
+
+		// A worker that is not running has left its loop, the join does not wait on the mutex
+		if (worker.thread.joinable())
+			worker.thread.join();
+
+		worker.thread = std::thread(&Group::work, shared_from_this(), w);
+		worker.running = true;
+	}
+
+	void post(const std::shared_ptr<Loop> &loop, size_t nRunners) {
+		// Throughput runners only go to the workers outside of the reserved cores
+		size_t p = static_cast<size_t>(loop->priority);
+		size_t first = (loop->priority == LVWorkPriority::Throughput) ? nLatencyWorkers : 0;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		for (size_t r = 0; r < nRunners; r++) {
+			size_t w = first + nextWorker[p]++ % (workers.size() - first);
+			{
+				std::lock_guard<std::mutex> queueLock(workers[w]->mutex);
+				workers[w]->queue[p].push_back(loop);
+			}
+			pending[p]++;
+			start(w);
+		}
+		wake.notify_all();
+	}
+
+	// Puts back a throughput runner that yielded to latency work
+	void requeue(size_t self, const std::shared_ptr<Loop> &loop) {
+		std::lock_guard<std::mutex> lock(mutex);
+		{
+			std::lock_guard<std::mutex> queueLock(workers[self]->mutex);
+			workers[self]->queue[static_cast<size_t>(LVWorkPriority::Throughput)].push_back(loop);
+		}
+		pending[static_cast<size_t>(LVWorkPriority::Throughput)]++;
+	}
+
+	// Whether worker self may take throughput runners now
+	bool throughputAllowed(size_t self) const {
+		return self >= nLatencyWorkers && latencyActive == 0;
+	}
+
+	// Takes a runner from the back of the own queue, or steals one from the front of another queue, latency runners first
+	std::shared_ptr<Loop> take(size_t self) {
+		std::shared_ptr<Loop> loop = take(self, LVWorkPriority::Latency);
+		if (!loop && throughputAllowed(self))
+			loop = take(self, LVWorkPriority::Throughput);
+		return loop;
+	}
+
+	std::shared_ptr<Loop> take(size_t self, LVWorkPriority priority) {
+		size_t p = static_cast<size_t>(priority);
+		std::shared_ptr<Loop> loop;
+		for (size_t k = 0; k < workers.size() && !loop; k++) {
+			Worker &victim = *workers[(self + k) % workers.size()];
+			std::lock_guard<std::mutex> queueLock(victim.mutex);
+			if (victim.queue[p].empty())
+				continue;
+
+			if (k == 0) {
+				loop = std::move(victim.queue[p].back());
+				victim.queue[p].pop_back();
+			}
+			else {
+				loop = std::move(victim.queue[p].front());
+				victim.queue[p].pop_front();
+			}
+		}
+
+		if (loop) {
+			std::lock_guard<std::mutex> lock(mutex);
+			pending[p]--;
+		}
+		return loop;
+	}
+
+	void enterLatency() {
+		std::lock_guard<std::mutex> lock(mutex);
+		latencyActive++;
+	}
+
+	void leaveLatency() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--latencyActive != 0)
+				return;
+		}
+		wake.notify_all();
+	}
+
+	// Blocks the calling thread of a throughput loop while latency work is in progress
+	void waitLatency() {
+		if (latencyActive == 0)
+			return;
+
+		std::unique_lock<std::mutex> lock(mutex);
+		wake.wait(lock, [this] { return latencyActive == 0; });
+	}
+
+	void work(size_t self) {
+		std::string applyError = apply(self);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!applyError.empty() && error.empty())
+				error = applyError;
+			started++;
+		}
+		ready.notify_all();
+
+		std::function<bool()> proceed = [this, self] { return throughputAllowed(self); };
+		for (;;) {
+			std::shared_ptr<Loop> loop = take(self);
+			if (loop) {
+				if (!loop->run(proceed))
+					requeue(self, loop);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(mutex);
+			auto runnable = [this, self] {
+				return pending[static_cast<size_t>(LVWorkPriority::Latency)] > 0 || (pending[static_cast<size_t>(LVWorkPriority::Throughput)] > 0 && throughputAllowed(self));
+			};
+
+			bool timedOut = false;
+			if (!runnable() && !stop)
+				timedOut = !wake.wait_for(lock, LVThreadPoolIdleTimeout, [&] { return stop || runnable(); });
+
+			if (runnable())
+				continue;
+
+			// Stopped or idle, the worker is started again by the next post
+			// Throughput runners held back by latency work keep an idle worker alive (a stopped worker leaves them to the calling threads of their loops)
+			bool held = self >= nLatencyWorkers && pending[static_cast<size_t>(LVWorkPriority::Throughput)] > 0;
+			if (stop || (timedOut && !held)) {
+				workers[self]->running = false;
+				return;
+			}
+		}
+	}
+
+	// Applies the affinity and priority to the calling worker, returns an error message on failure
+	std::string apply(size_t self) const {
+		const std::vector<int32_t> &cpus = (self < nLatencyWorkers) ? settings.reserved : throughputCpus;
+#if defined(_WIN32) || defined(_WIN64)
+		if (!cpus.empty()) {
+			DWORD_PTR mask = 0;
+			for (int32_t cpu : cpus)
+				mask |= DWORD_PTR(1) << cpu;
+			if (SetThreadAffinityMask(GetCurrentThread(), mask) == 0)
+				return "SetThreadAffinityMask failed (error " + std::to_string(GetLastError()) + ").";
+		}
+
+		if (settings.priority != 0 && !SetThreadPriority(GetCurrentThread(), settings.priority))
+			return "SetThreadPriority failed (error " + std::to_string(GetLastError()) + ").";
+#elif defined(__linux__)
+		if (!cpus.empty()) {
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			for (int32_t cpu : cpus)
+				CPU_SET(cpu, &set);
+			int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+			if (err != 0)
+				return "pthread_setaffinity_np failed (" + LVErrnoString(err) + ").";
+		}
+
+		// Linux schedules threads by their nice value, 5 steps per priority level (raising it needs CAP_SYS_NICE)
+		if (settings.priority != 0) {
+			pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+			if (setpriority(PRIO_PROCESS, static_cast<id_t>(tid), -5 * settings.priority) != 0)
+				return "setpriority failed (" + LVErrnoString(errno) + ").";
+		}
+#else
+		if (!cpus.empty() || settings.priority != 0)
+			return "Thread affinity and priority are not supported on this platform.";
+#endif
+		return std::string();
+	}
+};
+
+LVThreadPool & LVThreadPool::instance() {
+	static LVThreadPool pool;
+	return pool;
+}
+
+LVThreadPool::LVThreadPool() {
+	LVThreadPoolSettings defaults;
+	defaults.threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+	m_group = std::make_shared<Group>(defaults, defaults.threads);
+}
+
+LVThreadPool::~LVThreadPool() {
+	std::atomic_load(&m_group)->detach();
+}
+
+void LVThreadPool::shutdown() {
+	// The replacement keeps the settings, its workers are started by the next loop
+	std::shared_ptr<Group> current = std::atomic_load(&m_group);
+	std::shared_ptr<Group> previous = std::atomic_exchange(&m_group, std::make_shared<Group>(current->settings, std::max<size_t>(1, std::thread::hardware_concurrency())));
+	previous->shutdown(true);
+}
+
+void LVThreadPool::configure(const LVThreadPoolSettings &settings) {
+	size_t hw = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+	LVThreadPoolSettings checked = settings;
+	if (checked.threads == 0)
+		checked.threads = hw;
+
+	if (checked.threads > 64 * hw)
+		throw LVException(__FILE__, __LINE__, "The number of pool threads is too large (" + std::to_string(checked.threads) + ").");
+
+	for (int32_t cpu : checked.cpus) {
+		if (cpu < 0 || static_cast<size_t>(cpu) >= hw || cpu >= 64)
+			throw LVException(__FILE__, __LINE__, "Invalid core " + std::to_string(cpu) + " in the pool affinity (the machine has " + std::to_string(hw) + " cores).");
+	}
+
+	if (checked.priority < -2 || checked.priority > 2)
+		throw LVException(__FILE__, __LINE__, "The pool priority must be between -2 and 2 (" + std::to_string(checked.priority) + ").");
+
+	for (int32_t cpu : checked.reserved) {
+		if (cpu < 0 || static_cast<size_t>(cpu) >= hw || cpu >= 64)
+			throw LVException(__FILE__, __LINE__, "Invalid reserved core " + std::to_string(cpu) + " (the machine has " + std::to_string(hw) + " cores).");
+		if (!checked.cpus.empty() && std::find(checked.cpus.begin(), checked.cpus.end(), cpu) == checked.cpus.end())
+			throw LVException(__FILE__, __LINE__, "The reserved core " + std::to_string(cpu) + " is not one of the pool cores.");
+	}
+
+	std::sort(checked.reserved.begin(), checked.reserved.end());
+	checked.reserved.erase(std::unique(checked.reserved.begin(), checked.reserved.end()), checked.reserved.end());
+
+	// The workers are started right away, so that settings that cannot be applied are reported here
+	auto group = std::make_shared<Group>(checked, hw);
+	if (!checked.reserved.empty() && group->throughputCpus.empty())
+		throw LVException(__FILE__, __LINE__, "At least one pool core must remain outside of the reserved cores.");
+
+	{
+		std::unique_lock<std::mutex> lock(group->mutex);
+		for (size_t w = 0; w < group->workers.size(); w++)
+			group->start(w);
+		group->ready.wait(lock, [&] { return group->started == group->workers.size(); });
+	}
+
+	if (!group->error.empty()) {
+		group->shutdown(true);
+		throw LVException(__FILE__, __LINE__, "Unable to apply the thread pool settings: " + group->error);
+	}
+
+	// The previous workers finish the runners in their queues and exit
+	std::shared_ptr<Group> previous = std::atomic_exchange(&m_group, group);
+	previous->shutdown(false);
+}
+
+LVThreadPoolSettings LVThreadPool::settings() const {
+	return std::atomic_load(&m_group)->settings;
+}
+
+void LVThreadPool::parallelFor(size_t nTasks, const std::function<void(size_t)> &task, LVWorkPriority priority, size_t maxThreads) {
+	if (nTasks == 0)
+		return;
+
+	// A throughput loop started by latency work would wait for itself
+	if (latencyDepth > 0)
+		priority = LVWorkPriority::Latency;
+
+	std::unique_ptr<LVLatencyScope> latency;
+	if (priority == LVWorkPriority::Latency)
+		latency.reset(new LVLatencyScope());
+
+	if (nTasks == 1) {
+		LVCheckpoint();
+		task(0);
+		return;
+	}
+
+	std::shared_ptr<Group> group = std::atomic_load(&m_group);
+	size_t nWorkers = group->workers.size();
+	if (priority == LVWorkPriority::Throughput)
+		nWorkers -= group->nLatencyWorkers;
+	if (maxThreads > 0)
+		nWorkers = std::min(nWorkers, maxThreads - 1);
+
+	auto loop = std::make_shared<Loop>(task, nTasks, priority);
+	if (nWorkers > 0)
+		group->post(loop, std::min(nTasks - 1, nWorkers));
+
+	// The calling thread does not yield, it waits for the latency work to complete before claiming its next task
+	loop->run([&group] { group->waitLatency(); return true; });
+	loop->wait();
+
+	for (std::exception_ptr &e : loop->errors) {
+		if (e)
+			std::rethrow_exception(e);
+	}
+}
+
+LVLatencyScope::LVLatencyScope() : m_group(std::atomic_load(&LVThreadPool::instance().m_group)) {
+	m_group->enterLatency();
+	latencyDepth++;
+}
+
+LVLatencyScope::~LVLatencyScope() {
+	latencyDepth--;
+	m_group->leaveLatency();
+}
+
+LVThroughputScope::LVThroughputScope() {
+	std::shared_ptr<LVThreadPool::Group> group = std::atomic_load(&LVThreadPool::instance().m_group);
+	if (group->settings.reserved.empty())
+		return;
+
+	const std::vector<int32_t> &cpus = group->throughputCpus;
+#if defined(_WIN32) || defined(_WIN64)
+	DWORD_PTR mask = 0;
+	for (int32_t cpu : cpus)
+		mask |= DWORD_PTR(1) << cpu;
+
+	DWORD_PTR previous = SetThreadAffinityMask(GetCurrentThread(), mask);
+	if (previous != 0) {
+		m_previous.resize(sizeof(previous));
+		std::memcpy(m_previous.data(), &previous, sizeof(previous));
+	}
+#elif defined(__linux__)
+	cpu_set_t previous;
+	if (pthread_getaffinity_np(pthread_self(), sizeof(previous), &previous) != 0)
+		return;
+
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (int32_t cpu : cpus)
+		CPU_SET(cpu, &set);
+
+	if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+		m_previous.resize(sizeof(previous));
+		std::memcpy(m_previous.data(), &previous, sizeof(previous));
+	}
+#else
+	(void)cpus;
+#endif
+}
+
+LVThroughputScope::~LVThroughputScope() {
+	if (m_previous.empty())
+		return;
+
+#if defined(_WIN32) || defined(_WIN64)
+	DWORD_PTR previous;
+	std::memcpy(&previous, m_previous.data(), sizeof(previous));
+	SetThreadAffinityMask(GetCurrentThread(), previous);
+#elif defined(__linux__)
+	cpu_set_t previous;
+	std::memcpy(&previous, m_previous.data(), sizeof(previous));
+	pthread_setaffinity_np(pthread_self(), sizeof(previous), &previous);
+#endif
+}
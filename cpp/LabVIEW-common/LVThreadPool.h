@@ -0,0 +1,126 @@
+/// <summary>
+/// Process-wide pool of worker threads for the parallel parts of the wrappers (batch prediction, training, parsing and conversions, see also LVParallelFor).
+/// No thread is created per call: the pool is sized once for the machine, so concurrent calls from
+/// many reentrant VIs share the cores instead of oversubscribing them.
+/// Work stealing: a parallel loop posts runners to the queues of the workers, idle workers take runners from the queues of
+/// busy ones, and every runner (and the calling thread) claims the tasks of its loop one at a time until none are left.
+/// The calling thread always takes part in its own loop, so loops complete even if all workers are busy (or if a loop is started from a worker).
+/// Workers exit after LVThreadPoolIdleTimeout without work and are started again by the next loop.
+/// Priority classes: latency loops (predictions) are taken before throughput loops (training, cross-validation).
+/// While latency work is in progress (a latency loop or an LVLatencyScope), throughput loops stop claiming tasks,
+/// so a prediction waits at most for the tasks that are already executing. Cores can be reserved for latency work:
+/// the workers on them never take throughput loops, and calling threads of training functions in an LVThroughputScope are kept off them.
+/// Every library has its own pool (the wrapper libraries are separate binaries), configured through its set_thread_pool function.
+/// The workers are stopped and joined by the shutdown function of the library, which is to be called before the library is unloaded:
+/// the static destruction of the pool only detaches them, since it runs under the loader lock on Windows (a join would deadlock).
+/// </summary>
+
+#ifndef LVTHREADPOOL_H_
+#define LVTHREADPOOL_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Time an idle worker waits for work before it exits
+const std::chrono::seconds LVThreadPoolIdleTimeout(10);
+
+struct LVThreadPoolSettings {
+	size_t threads;				// Number of worker threads (0 for one per core)
+	std::vector<int32_t> cpus;	// Cores (zero-based) the workers may run on, empty for all cores
+	int32_t priority;			// Priority of the workers, -2 (lowest) to 2 (highest), 0 is normal
+	std::vector<int32_t> reserved;	// Cores (zero-based) reserved for latency work, one latency-only worker runs on each of them
+
+	LVThreadPoolSettings() : threads(0), priority(0) {}
+};
+
+enum class LVWorkPriority {
+	Latency,		// Predictions, taken first
+	Throughput		// Training and cross-validation, paused while latency work is in progress
+};
+
+class LVThreadPool {
+public:
+	/// <summary> Pool of the library, created with the default settings on first use. </summary>
+	static LVThreadPool & instance();
+
+	/// <summary> Stops the workers without waiting for them (see above). </summary>
+	~LVThreadPool();
+
+	LVThreadPool(const LVThreadPool&) = delete;
+	LVThreadPool& operator=(const LVThreadPool&) = delete;
+
+	/// <summary>
+	/// Replaces the workers by workers with the given settings, loops in progress complete on the previous workers.
+	/// Throws LVException (and keeps the previous settings) if the settings are invalid or cannot be applied, e.g. a priority above normal without the required privileges.
+	/// </summary>
+	void configure(const LVThreadPoolSettings &settings);
+
+	/// <summary> Current settings, threads is the actual number of workers. </summary>
+	LVThreadPoolSettings settings() const;
+
+	/// <summary>
+	/// Stops the workers and waits for them to exit, once the loops in progress have completed. Keeps the settings,
+	/// the pool starts new workers on the next loop. Must not be called from a task of the pool.
+	/// </summary>
+	void shutdown();
+
+	/// <summary>
+	/// Executes task(i) for i in [0, nTasks) on the calling thread and the workers and waits for all of them to complete.
+	/// If any task throws, the exception of the lowest numbered failing task is rethrown on the calling thread.
+	/// Throughput loops should consist of many short tasks, the tasks are the points at which they yield to latency work.
+	/// At most maxThreads threads (the calling thread included) work on the loop, 0 for no limit.
+	/// The tasks run under the stop condition of the calling thread (see LVCancellation.h), a checkpoint precedes every task.
+	/// They also count into the statistics collector of the calling thread (see LVStatistics.h).
+	/// A throughput loop started by latency work (an LVLatencyScope or a task of a latency loop) runs as latency loop.
+	/// </summary>
+	void parallelFor(size_t nTasks, const std::function<void(size_t)> &task, LVWorkPriority priority = LVWorkPriority::Latency, size_t maxThreads = 0);
+
+private:
+	friend class LVLatencyScope;
+	friend class LVThroughputScope;
+	struct Group;
+	struct Loop;
+	struct Worker;
+
+	LVThreadPool();
+
+	std::shared_ptr<Group> m_group;		// Accessed atomically
+};
+
+/// <summary> Marks latency-critical work on the calling thread (e.g. a single prediction), throughput loops pause until the scope ends. </summary>
+class LVLatencyScope {
+public:
+	LVLatencyScope();
+	~LVLatencyScope();
+
+	LVLatencyScope(const LVLatencyScope&) = delete;
+	LVLatencyScope& operator=(const LVLatencyScope&) = delete;
+
+private:
+	std::shared_ptr<LVThreadPool::Group> m_group;
+};
+
+/// <summary>
+/// Restricts the calling thread to the cores that are not reserved for latency work, for work that cannot be split into
+/// throughput loops (e.g. a libsvm solver). The previous affinity is restored when the scope ends.
+/// Only the calling thread is restricted: threads it creates do not inherit the affinity on Windows, parallel work must run as
+/// throughput loops of the pool (e.g. LVParallelFor), whose workers apply the core reservation and priority themselves.
+/// Does nothing if no cores are reserved. Best effort: a failure to change the affinity is ignored.
+/// </summary>
+class LVThroughputScope {
+public:
+	LVThroughputScope();
+	~LVThroughputScope();
+
+	LVThroughputScope(const LVThroughputScope&) = delete;
+	LVThroughputScope& operator=(const LVThroughputScope&) = delete;
+
+private:
+	std::vector<unsigned char> m_previous;	// Previous affinity of the thread, empty if unchanged
+};
+
+#endif // LVTHREADPOOL_H_
@@ -2,7 +2,9 @@
 #include "LVTypeDecl.h"
 #include "LVException.h"
 #include "extcode.h"
+#include <cstdint>
 #include <cstring>
+#include <string>
 
 #if defined(_WIN32) || defined(_WIN64)
 #include <codecvt>
@@ -28,6 +30,36 @@ void LVWriteStringHandle(LStrHandle &strHandle, const char* c_str, size_t length
 	}
 }
 
+void LVWriteStringHandle(LStrHandle &strHandle, const std::vector<std::string> &parts) {
+	size_t length = 0;
+	for (const std::string &part : parts)
+		length += part.size();
+
+	LVResizeStringHandle(strHandle, length);
+
+	size_t pos = 0;
+	for (const std::string &part : parts) {
+		MoveBlock(part.data(), (*strHandle)->str + pos, part.size());
+		pos += part.size();
+	}
+}
+
+void LVResizeStringHandle(LStrHandle &strHandle, size_t length) {
+	// LabVIEW strings are limited by the signed 32-bit length prefix
+	if (length > static_cast<size_t>(INT32_MAX - sizeof(int32_t)))
+		throw LVException(__FILE__, __LINE__, "The string is too large for a LabVIEW string (2 GB limit).");
+
+	if (DSCheckHandle(strHandle) != noErr)
+		throw LVException(__FILE__, __LINE__, "The string handle passed to LVResizeStringHandle is not valid (out of zone/deleted?)");
+
+	// The contents are overwritten by the caller, so there is no need to clear the memory
+	MgErr err = DSSetHandleSize(strHandle, (sizeof(int32_t) + length));
+	if (err)
+		throw LVException(__FILE__, __LINE__, "LabVIEW Memory Manager: Failed to allocate memory for string (Out of memory?)");
+
+	(*strHandle)->cnt = static_cast<int32>(length);
+}
+
 void LVWriteStringHandle(LStrHandle &strHandle, const char* c_str) {
 	// Don't want to pass a nullpointer to strlen, behaviour is undefined.
 	size_t length;
@@ -63,3 +95,24 @@ void LVWriteStringHandle(LStrHandle &strHandle, std::wstring wstr){
 }
 
 
+
+
+std::string LVErrnoString(int errnum){
+	// Allocate room for output error message (truncated if buffer is too small)
+	const size_t bufSz = 256;
+	char buf[bufSz] = "";
+
+#if defined(_WIN32) || defined(_WIN64)
+	if (strerror_s(buf, bufSz, errnum) == 0)
+		return std::string(buf);
+#elif (_POSIX_C_SOURCE >= 200112L || _XOPEN_SOURCE >= 600) && ! _GNU_SOURCE
+	if (strerror_r(errnum, buf, bufSz) == 0)
+		return std::string(buf);
+#else
+	char* gnuerr = strerror_r(errnum, buf, bufSz);
+	if (gnuerr != nullptr)
+		return std::string(gnuerr);
+#endif
+
+	return std::string("Unknown error");
+}
@@ -10,7 +10,9 @@
 	#define i386 1
 #endif
 
+#include <cstdint>
 #include <string>
+#include <vector>
 #include <extcode.h>
 
 #include "LVTypeDecl.h"
@@ -92,6 +94,16 @@ void LVWriteStringHandle(LStrHandle &strHandle, const char* c_str);
 /// <param name='str'>The string to copy to LabVIEW.</param>
 void LVWriteStringHandle(LStrHandle &strHandle, std::string str);
 
+/// <summary> Allocates room for the concatenation of parts in the handle and copies data over. </summary>
+/// <param name='strHandle'>A valid string handle.</param>
+/// <param name='parts'>The strings to copy to LabVIEW (in order).</param>
+void LVWriteStringHandle(LStrHandle &strHandle, const std::vector<std::string> &parts);
+
+/// <summary> Resizes the string handle to length bytes and updates the length, leaving the contents to be written by the caller. </summary>
+/// <param name='strHandle'>A valid string handle.</param>
+/// <param name='length'>The new length of the string.</param>
+void LVResizeStringHandle(LStrHandle &strHandle, size_t length);
+
 /// <summary>
 ///		Converts the string to utf8.
 ///		Then allocates room for the string in the handle and copies data over.
@@ -100,6 +112,10 @@ void LVWriteStringHandle(LStrHandle &strHandle, std::string str);
 /// <param name='wstr'>The string to copy to LabVIEW.</param>
 void LVWriteStringHandle(LStrHandle &strHandle, std::wstring wstr);
 
+/// <summary> Returns the system error message corresponding to an errno value (thread-safe). </summary>
+/// <param name='errnum'>The error number (usually errno).</param>
+std::string LVErrnoString(int errnum);
+
 /// <summary>
 /// Changes the size of an array of numeric.
 /// Does not update the dimSize parameter.
@@ -126,6 +142,22 @@ void LVResizeNumericArrayHandle(LVArray_Hdl<T, dim> &handle, size_t newSize) {
 		throw LVException(__FILE__, __LINE__, "Failed to resize numeric array (out of memory?).");
 }
 
+/// <summary>
+/// Resizes a 1D array of numeric to the size of the vector, copies the elements and updates the dimSize parameter.
+///	</summary>
+/// <param name='handle'>The array handle.</param>
+/// <param name='values'>The elements to copy to LabVIEW.</param>
+template<class T>
+void LVCopyToArrayHandle(LVArray_Hdl<T> &handle, const std::vector<T> &values) {
+	if (values.size() > INT32_MAX)
+		throw LVException(__FILE__, __LINE__, "The array is too large for a LabVIEW array.");
+
+	LVResizeNumericArrayHandle(handle, values.size());
+	if (!values.empty())
+		MoveBlock(values.data(), (*handle)->elt, values.size() * sizeof(T));
+	(*handle)->dimSize = static_cast<uint32_t>(values.size());
+}
+
 /// <summary>
 /// Allocates room for an array of complex types (clusters) in LabVIEW.
 /// Does not update the dimSize parameter.
@@ -203,4 +235,45 @@ void LVResizeHandleArrayHandle(LVArray_Hdl<LVArray_Hdl<T, dim2>, dim1> &handle,
 	}
 }
 
+/// <summary>
+/// Disposes of an array handle created in the library and sets it to nullptr.
+/// Only use on temporary handles that are not passed back to LabVIEW.
+///	</summary>
+/// <param name='handle'>The array handle (nullptr is ignored).</param>
+template<class T, int dim>
+void LVDisposeArrayHandle(LVArray_Hdl<T, dim> &handle){
+	if (handle != nullptr && DSCheckHandle(handle) == noErr)
+		DSDisposeHandle(handle);
+	handle = nullptr;
+}
+
+/// <summary>
+/// Disposes of an array of array handles created in the library (the inner handles first) and sets it to nullptr.
+/// Only use on temporary handles that are not passed back to LabVIEW.
+///	</summary>
+/// <param name='handle'>The outer array handle (nullptr is ignored).</param>
+template<class T, int dim1, int dim2>
+void LVDisposeArrayHandle(LVArray_Hdl<LVArray_Hdl<T, dim2>, dim1> &handle){
+	if (handle != nullptr && DSCheckHandle(handle) == noErr){
+		for (size_t i = 0; i < (*handle)->dimSize; i++)
+			LVDisposeArrayHandle((*handle)->elt[i]);
+		DSDisposeHandle(handle);
+	}
+	handle = nullptr;
+}
+
+/// <summary>
+/// Temporary array handle created in the library (e.g. to call another library), disposed when it goes out of scope.
+///	</summary>
+template<class H>
+struct LVTemporaryArrayHandle {
+	LVTemporaryArrayHandle() : handle(nullptr) {}
+	~LVTemporaryArrayHandle() { LVDisposeArrayHandle(handle); }
+
+	LVTemporaryArrayHandle(const LVTemporaryArrayHandle&) = delete;
+	LVTemporaryArrayHandle& operator=(const LVTemporaryArrayHandle&) = delete;
+
+	H handle;
+};
+
 #endif // LVUTILITY_H_
@@ -7,6 +7,10 @@
 #include <memory>
 #include <cmath>
 #include <climits>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <random>
 #include <errno.h>
 
 #include <extcode.h>
@@ -15,6 +19,19 @@
 #include <LVTypeDecl.h>
 #include <LVUtility.h>
 #include <LVException.h>
+#include <LVMemoryMap.h>
+#include <LVBinaryModel.h>
+#include <LVTextFormat.h>
+#include <LVDataset.h>
+#include <LVDelimited.h>
+#include <LVScaling.h>
+#include <LVProblemConversion.h>
+#include <LVParallel.h>
+#include <LVBackendSelection.h>
+#include <LVFeatureSelection.h>
+#include <LVFeatureHashing.h>
+#include <LVDatasetBlocks.h>
+#include <LVThreadPool.h>
 
 // C++14 feature: std::make_unique
 // GNU g++-4.9 or later with -std=c++14 enabled is needed on unix (VS2013 has native support)
@@ -24,6 +41,9 @@
 
 void LVlinear_train(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, LVlinear_model * model_out){
 	try{
+		LVThroughputScope throughput;
+		LVStatsTimer marshal(LVStatsPhase::Marshal);
+
 		// Input verification: Nonempty problem
 		if (prob_in->x == nullptr || (*(prob_in->x))->dimSize == 0)
 			throw LVException(__FILE__, __LINE__, "Empty problem passed to liblinear_train.");
@@ -77,8 +97,14 @@ void LVlinear_train(lvError *lvErr, const LVlinear_problem *prob_in, const LVlin
 		if (param_check != nullptr)
 			throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check));
 
+		marshal.stop();
+
 		// Train model
-		model *result = train(prob.get(), param.get());
+		LVStatsTimer solver(LVStatsPhase::Solver);
+		model *result = LVTrain(*prob, *param);
+		solver.stop();
+
+		LVStatsTimer copy(LVStatsPhase::Copy);
 
 		// Copy model to LabVIEW memory
 		LVConvertModel(*result, *model_out);
@@ -114,8 +140,84 @@ void LVlinear_train(lvError *lvErr, const LVlinear_problem *prob_in, const LVlin
 	}
 }
 
+void LVlinear_train_parallel(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, int32_t n_threads, LVlinear_model * model_out){
+	try{
+		LVThroughputScope throughput;
+
+		size_t threads = (n_threads > 0) ? static_cast<size_t>(n_threads) : LVThreadCount(SIZE_MAX);
+		auto native = LVTrainNativeModel(*prob_in, *param_in, nullptr, threads);
+
+		// Copy model to LabVIEW memory
+		LVConvertModel(*(native->trained), *model_out);
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_train_warm_start(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, const LVlinear_model *init_model_in, LVlinear_model * model_out){
+	try{
+		LVThroughputScope throughput;
+
+		auto native = LVTrainNativeModel(*prob_in, *param_in, init_model_in);
+
+		// Copy model to LabVIEW memory
+		LVConvertModel(*(native->trained), *model_out);
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
 void LVlinear_cross_validation(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, const int32_t nr_fold, LVArray_Hdl<double> target_out){
 	try{
+		LVThroughputScope throughput;
+		LVStatsTimer marshal(LVStatsPhase::Marshal);
+
 		// Input verification: Nonempty problem
 		if (prob_in->x == nullptr || (*(prob_in->x))->dimSize == 0)
 			throw LVException(__FILE__, __LINE__, "Empty problem passed to liblinear_crossvalidation.");
@@ -175,8 +277,12 @@ void LVlinear_cross_validation(lvError *lvErr, const LVlinear_problem *prob_in,
 		// Allocate room in target_out
 		LVResizeNumericArrayHandle(target_out, nr_nodes);
 
+		marshal.stop();
+
 		// Run cross validation
-		cross_validation(prob.get(), param.get(), nr_fold, (*target_out)->elt);
+		LVStatsTimer solver(LVStatsPhase::Solver);
+		LVCrossValidate(*prob, *param, nr_fold, (*target_out)->elt);
+		solver.stop();
 		
 		(*target_out)->dimSize = nr_nodes;
 	}
@@ -195,8 +301,45 @@ void LVlinear_cross_validation(lvError *lvErr, const LVlinear_problem *prob_in,
 	}
 }
 
+void LVlinear_find_parameter_C(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, int32_t nr_fold, double start_C, double max_C, LVArray_Hdl<double> C_out, LVArray_Hdl<double> score_out, double *best_C_out, double *best_score_out){
+	try{
+		LVThroughputScope throughput;
+
+		std::vector<double> C;
+		std::vector<double> score;
+		std::unique_ptr<LVStopped> stopped;
+		size_t best = LVFindParameterC(*prob_in, *param_in, nr_fold, start_C, max_C, nullptr, C, score, stopped);
+
+		LVCopyToArrayHandle(C_out, C);
+		LVCopyToArrayHandle(score_out, score);
+		*best_C_out = C[best];
+		*best_score_out = score[best];
+	}
+	catch (LVException &ex) {
+		(*C_out)->dimSize = 0;
+		(*score_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*C_out)->dimSize = 0;
+		(*score_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*C_out)->dimSize = 0;
+		(*score_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
 double LVlinear_predict(lvError *lvErr, const struct LVlinear_model *model_in, const LVArray_Hdl<LVlinear_node> x_in){
 	try{
+		LVStatsTimer marshal(LVStatsPhase::Marshal);
+
 		// Input validation: Uninitialized model
 		if (model_in == nullptr || model_in->w == nullptr || (*model_in->w)->dimSize == 0)
 			throw LVException(__FILE__, __LINE__, "Uninitialized model passed to liblinear_predict.");
@@ -213,7 +356,11 @@ double LVlinear_predict(lvError *lvErr, const struct LVlinear_model *model_in, c
 		auto mdl = std::make_unique<model>();
 		LVConvertModel(*model_in, *mdl);
 
+		marshal.stop();
+
+		LVStatsTimer solver(LVStatsPhase::Solver);
 		double label = predict(mdl.get(), reinterpret_cast<feature_node*>((*x_in)->elt));
+		solver.stop();
 
 		return label;
 	}
@@ -342,81 +489,67 @@ double LVlinear_predict_probability(lvError *lvErr, const LVlinear_model  *model
 	}
 }
 
-//-- Print functions
-
-void LVlinear_print_function(const char * message){
-	LVUserEventRef *usrEv = loggingUsrEv;
-	if (usrEv != nullptr && message != nullptr){
-		// Filter out the progress messages (.....)
-		if (strcmp(message, ".") != 0){
-			// Move the string to a handle
-			size_t length = strlen(message);
-			LStrHandle lvmsg = (LStrHandle)DSNewHandle(sizeof(int32_t) + length);
-			MoveBlock(message, (*lvmsg)->str, length);
-			(*lvmsg)->cnt = static_cast<int32>(length);
-
-			// Post the string to the user event
-			PostLVUserEvent(*usrEv, &lvmsg);
-		}
+//-- Asynchronous jobs
+void LVlinear_train_async(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, LVUserEventRef *completion_in, uint64_t *job_out){
+	try{
+		*job_out = 0;
+		auto job = std::make_shared<LVlinear_job>(*prob_in, *param_in, 0);
+		*job_out = LVJobQueue::instance().submit(job, (completion_in != nullptr) ? *completion_in : 0);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
 	}
 }
 
-void LVlinear_set_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_in) {
-	loggingUsrEv = loggingUserEvent_in;
-	set_print_string_function(LVlinear_print_function);
-}
+void LVlinear_cross_validation_async(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, int32_t nr_fold, LVUserEventRef *completion_in, uint64_t *job_out){
+	try{
+		*job_out = 0;
+		if (nr_fold < 2)
+			throw LVException(__FILE__, __LINE__, "The number of folds must be at least 2 (" + std::to_string(nr_fold) + ").");
 
-void LVlinear_get_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out) {
-	loggingUserEvent_out = loggingUsrEv;
+		auto job = std::make_shared<LVlinear_job>(*prob_in, *param_in, nr_fold);
+		*job_out = LVJobQueue::instance().submit(job, (completion_in != nullptr) ? *completion_in : 0);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
 }
 
-void LVlinear_delete_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out) {
-	loggingUserEvent_out = loggingUsrEv;
-	loggingUsrEv = nullptr;
+void LVlinear_job_state(lvError *lvErr, uint64_t job, int32_t *state_out){
+	try{
+		*state_out = static_cast<int32_t>(LVJobQueue::instance().get(job)->state());
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
 }
 
-//
-//-- File operations
-//
-
-void LVlinear_save_model(lvError *lvErr, const char *path_in, const LVlinear_model *model_in){
+void LVlinear_wait_job(lvError *lvErr, uint64_t job, int32_t timeout_ms, int32_t *state_out){
 	try{
-		errno = 0;
-
-		// Convert LVsvm_model to svm_model
-		auto mdl = std::make_unique<model>();
-		LVConvertModel(*model_in, *mdl);
-
-		int err = save_model(path_in, mdl.get());
-
-		if (err == -1){
-			// Allocate room for output error message (truncated if buffer is too small)
-			const size_t bufSz = 256;
-			char buf[bufSz] = "";
-			std::string errstr;
-
-#if defined(_WIN32) || defined(_WIN64)
-			if (strerror_s(buf, bufSz, errno) != 0)
-				errstr = buf;
-			else
-				errstr = "Unknown error";
-#elif (_POSIX_C_SOURCE >= 200112L || _XOPEN_SOURCE >= 600) && ! _GNU_SOURCE
-			if (strerror_r(errno, buf, bufSz) != 0)
-				errstr = buf;
-			else
-				errstr = "Unknown error";
-#else
-			char* gnuerr = strerror_r(errno, buf, bufSz);
-			if (gnuerr != nullptr)
-				errstr = gnuerr;
-			else
-				errstr = "Unknown error";
-#endif
-
-			errno = 0;
-
-			throw LVException(__FILE__, __LINE__, "Model load operation failed (" + errstr + ").");
-		}
+		auto queued = LVJobQueue::instance().get(job);
+		queued->wait(timeout_ms);
+		*state_out = static_cast<int32_t>(queued->state());
 	}
 	catch (LVException &ex) {
 		ex.returnError(lvErr);
@@ -430,53 +563,10 @@ void LVlinear_save_model(lvError *lvErr, const char *path_in, const LVlinear_mod
 	}
 }
 
-void LVlinear_load_model(lvError *lvErr, const char *path_in, LVlinear_model *model_out){
+void LVlinear_collect_train(lvError *lvErr, uint64_t job, LVlinear_model *model_out){
 	try{
-		errno = 0;
-
-		model *mdl = load_model(path_in);
-
-		if (mdl == nullptr){
-			// Allocate room for output error message (truncated if buffer is too small)
-			const size_t bufSz = 256;
-			char buf[bufSz] = "";
-			std::string errstr;
-
-#if defined(_WIN32) || defined(_WIN64)
-			if (strerror_s(buf, bufSz, errno) != 0)
-				errstr = buf;
-			else
-				errstr = "Unknown error";
-#elif (_POSIX_C_SOURCE >= 200112L || _XOPEN_SOURCE >= 600) && ! _GNU_SOURCE
-			if (strerror_r(errno, buf, bufSz) != 0)
-				errstr = buf;
-			else
-				errstr = "Unknown error";
-#else
-			char* gnuerr = strerror_r(errno, buf, bufSz);
-			if (gnuerr != nullptr)
-				errstr = gnuerr;
-			else
-				errstr = "Unknown error";
-#endif
-
-			errno = 0;
-
-			throw LVException(__FILE__, __LINE__, "Model load operation failed (" + errstr + ").");
-		}
-		else{
-			// liblinear returns uninitialized values for the parameters (except solver type)
-			(mdl->param).C = 0;
-			(mdl->param).eps = 0;
-			(mdl->param).init_sol = nullptr;
-			(mdl->param).nr_weight = 0;
-			(mdl->param).p = 0;
-			(mdl->param).weight = nullptr;
-			(mdl->param).weight_label = nullptr;
-
-			LVConvertModel(*mdl, *model_out);
-			free_model_content(mdl);
-		}
+		auto collected = LVCollectJob(job, false);
+		LVConvertModel(*(collected->model->trained), *model_out);
 	}
 	catch (LVException &ex) {
 		(*(model_out->label))->dimSize = 0;
@@ -505,97 +595,3688 @@ void LVlinear_load_model(lvError *lvErr, const char *path_in, LVlinear_model *mo
 	}
 }
 
-//
-//-- Helper functions
-//
-
-void LVConvertParameter(const LVlinear_parameter &param_in, parameter &param_out){
-	param_out.solver_type = param_in.solver_type;
-	param_out.eps = param_in.eps;
-	param_out.C = param_in.C;
-	param_out.p = param_in.p;
-	param_out.init_sol = nullptr; // TODO: add support for warm-start
-
-	// Weight label
-	if (param_in.weight_label != nullptr && param_in.weight != nullptr){
-		if ((*(param_in.weight))->dimSize != (*(param_in.weight_label))->dimSize)
-			throw LVException(__FILE__, __LINE__, "Parameter error: Number of elements in weight_label and weight does not match.");
-
-		if ((*(param_in.weight_label))->dimSize > 0)
-			param_out.weight_label = (*(param_in.weight_label))->elt;
-		else
-			param_out.weight_label = nullptr;
-
-		// Weight
-		if ((*(param_in.weight))->dimSize > 0){
-			param_out.weight = (*(param_in.weight))->elt;
-			param_out.nr_weight = (*(param_in.weight))->dimSize;
-		}
-		else{
-			param_out.weight = nullptr;
-			param_out.nr_weight = 0;
-		}
+void LVlinear_collect_train_handle(lvError *lvErr, uint64_t job, uint64_t *handle_out){
+	try{
+		*handle_out = 0;
+		auto collected = LVCollectJob(job, false);
+		LVSparsifyModel(*(collected->model));
+		*handle_out = modelHandles.add(collected->model);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
 	}
 }
 
-void LVConvertModel(const LVlinear_model &model_in, model &model_out){
-	// Assign the parameters
-	LVConvertParameter(model_in.param, model_out.param);
+void LVlinear_collect_cross_validation(lvError *lvErr, uint64_t job, LVArray_Hdl<double> target_out){
+	try{
+		auto collected = LVCollectJob(job, true);
+		LVCopyToArrayHandle(target_out, collected->target);
+	}
+	catch (LVException &ex) {
+		(*target_out)->dimSize = 0;
 
-	// Copy assignments
-	model_out.nr_class = model_in.nr_class;
-	model_out.nr_feature = model_in.nr_feature;
-	model_out.bias = model_in.bias;
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*target_out)->dimSize = 0;
 
-	// w
-	if ((*(model_in.w))->dimSize > 0)
-		model_out.w = (*(model_in.w))->elt;
-	else
-		model_out.w = nullptr;
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*target_out)->dimSize = 0;
 
-	// label
-	if ((*(model_in.label))->dimSize > 0)
-		model_out.label = (*(model_in.label))->elt;
-	else
-		model_out.label = nullptr;
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
 }
 
-void LVConvertModel(const model &model_in, LVlinear_model &model_out){
-	// Convert svm_model to LVsvm_model
-	model_out.nr_class = model_in.nr_class;
-	model_out.nr_feature = model_in.nr_feature;
-	model_out.bias = model_in.bias;
-	int nr_class = model_in.nr_class;
-	int nr_feature = model_in.nr_feature;
-
-	// Label
-	if (model_in.label != nullptr){
-		LVResizeNumericArrayHandle(model_out.label, nr_class);
+void LVlinear_free_job(lvError *lvErr, uint64_t job){
+	try{
+		LVJobQueue::instance().release(job);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_cancel_job(lvError *lvErr, uint64_t job){
+	try{
+		LVJobQueue::instance().get(job)->cancel();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_set_job_log_userevent(lvError *lvErr, uint64_t job, LVUserEventRef *log_in){
+	try{
+		LVJobQueue::instance().get(job)->setLogEvent((log_in != nullptr) ? *log_in : 0);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_set_max_running_jobs(lvError *lvErr, int32_t max_jobs){
+	try{
+		if (max_jobs < 0)
+			throw LVException(__FILE__, __LINE__, "The number of running jobs must not be negative.");
+
+		LVJobQueue::instance().setMaxRunning(static_cast<size_t>(max_jobs));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//-- Cancellation
+void LVlinear_create_cancellation_token(lvError *lvErr, double max_seconds, int64_t max_iterations, uint64_t *token_out){
+	try{
+		*token_out = 0;
+		*token_out = tokenHandles.add(std::make_shared<LVCancellationToken>(max_seconds, max_iterations));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_cancel(lvError *lvErr, uint64_t token){
+	try{
+		tokenHandles.get(token)->cancel();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_reset_cancellation_token(lvError *lvErr, uint64_t token){
+	try{
+		tokenHandles.get(token)->reset();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_free_cancellation_token(lvError *lvErr, uint64_t token){
+	try{
+		tokenHandles.remove(token);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_set_progress_userevent(lvError *lvErr, uint64_t token, LVUserEventRef *progress_in){
+	try{
+		tokenHandles.get(token)->setProgressEvent((progress_in != nullptr) ? *progress_in : 0);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_set_log_userevent(lvError *lvErr, uint64_t token, LVUserEventRef *log_in){
+	try{
+		tokenHandles.get(token)->setLogEvent((log_in != nullptr) ? *log_in : 0, token);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_train_cancellable(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, uint64_t token, LVlinear_model *model_out){
+	try{
+		// The print function counts the iterations of the library solvers into the budgets
+		LVInstallPrintFunction(set_print_string_function, LVlinear_print_function);
+
+		std::shared_ptr<const LVCancellationToken> stop_token = LVGetCancellationToken(token);
+		if (!stop_token){
+			LVlinear_train(lvErr, prob_in, param_in, model_out);
+			return;
+		}
+
+		// The library solver cannot be stopped: the model is trained by a job on copies of the inputs, which is abandoned when the run stops
+		auto job = std::make_shared<LVlinear_job>(*prob_in, *param_in, 0);
+		LVStopCondition stop(stop_token);
+		LVStopScope scope(&stop);
+		LVJobQueue::instance().runAbandonable(job);
+
+		LVConvertModel(*(job->model->trained), *model_out);
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_cross_validation_cancellable(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, int32_t nr_fold, uint64_t token, LVArray_Hdl<double> target_out){
+	try{
+		// The print function counts the iterations of the library solvers into the budgets
+		LVInstallPrintFunction(set_print_string_function, LVlinear_print_function);
+
+		LVStopCondition stop(LVGetCancellationToken(token));
+		LVStopScope scope(&stop);
+		LVlinear_cross_validation(lvErr, prob_in, param_in, nr_fold, target_out);
+	}
+	catch (LVException &ex) {
+		(*target_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*target_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*target_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_find_parameter_C_cancellable(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, int32_t nr_fold, double start_C, double max_C, uint64_t token, LVArray_Hdl<double> C_out, LVArray_Hdl<double> score_out, double *best_C_out, double *best_score_out){
+	try{
+		LVThroughputScope throughput;
+		// The print function counts the iterations of the library solvers into the budgets
+		LVInstallPrintFunction(set_print_string_function, LVlinear_print_function);
+
+		std::vector<double> C;
+		std::vector<double> score;
+		std::unique_ptr<LVStopped> stopped;
+		size_t best = LVFindParameterC(*prob_in, *param_in, nr_fold, start_C, max_C, LVGetCancellationToken(token), C, score, stopped);
+
+		LVCopyToArrayHandle(C_out, C);
+		LVCopyToArrayHandle(score_out, score);
+		*best_C_out = C[best];
+		*best_score_out = score[best];
+
+		// The search was cut short, the results so far are valid
+		if (stopped)
+			stopped->returnWarning(lvErr);
+	}
+	catch (LVException &ex) {
+		(*C_out)->dimSize = 0;
+		(*score_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*C_out)->dimSize = 0;
+		(*score_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*C_out)->dimSize = 0;
+		(*score_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//-- Statistics
+void LVlinear_train_stats(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, LVlinear_model *model_out, LVSolverStats *stats_out){
+	LVStats stats;
+	{
+		// The counters are taken from the output of the solver
+		LVPrintFunctionScope print(set_print_string_function, LVlinear_print_function);
+		LVStatsScope scope(&stats);
+		LVlinear_train(lvErr, prob_in, param_in, model_out);
+	}
+
+	if (!lvErr->status){
+		// Every solver reports its iterations, none means that the output did not reach the print function (replaced by another library of the process)
+		if (stats.iterations() == 0)
+			LVException(__FILE__, __LINE__, LVErrorNoSolverOutput, "The solver output was not received, the iteration counters of the statistics are incomplete.").returnWarning(lvErr);
+	}
+
+	if (stats_out != nullptr)
+		stats.copyTo(*stats_out);
+}
+
+void LVlinear_cross_validation_stats(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, const int32_t nr_fold, LVArray_Hdl<double> target_out, LVSolverStats *stats_out){
+	LVStats stats;
+	{
+		LVPrintFunctionScope print(set_print_string_function, LVlinear_print_function);
+		LVStatsScope scope(&stats);
+		LVlinear_cross_validation(lvErr, prob_in, param_in, nr_fold, target_out);
+	}
+
+	if (stats_out != nullptr)
+		stats.copyTo(*stats_out);
+}
+
+double LVlinear_predict_stats(lvError *lvErr, const struct LVlinear_model *model_in, const LVArray_Hdl<LVlinear_node> x_in, LVSolverStats *stats_out){
+	LVStats stats;
+	double result;
+	{
+		LVPrintFunctionScope print(set_print_string_function, LVlinear_print_function);
+		LVStatsScope scope(&stats);
+		result = LVlinear_predict(lvErr, model_in, x_in);
+	}
+
+	if (stats_out != nullptr)
+		stats.copyTo(*stats_out);
+	return result;
+}
+
+//-- Thread pool
+void LVlinear_set_thread_pool(lvError *lvErr, int32_t n_threads, const LVArray_Hdl<int32_t> cpus_in, int32_t priority){
+	try{
+		if (n_threads < 0)
+			throw LVException(__FILE__, __LINE__, "The number of pool threads must not be negative.");
+
+		LVThreadPoolSettings settings = LVThreadPool::instance().settings();
+		settings.threads = static_cast<size_t>(n_threads);
+		settings.cpus.clear();
+		if (cpus_in != nullptr)
+			settings.cpus.assign((*cpus_in)->elt, (*cpus_in)->elt + (*cpus_in)->dimSize);
+		settings.priority = priority;
+
+		LVThreadPool::instance().configure(settings);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_get_thread_pool(lvError *lvErr, int32_t *n_threads_out, LVArray_Hdl<int32_t> cpus_out, int32_t *priority_out){
+	try{
+		LVThreadPoolSettings settings = LVThreadPool::instance().settings();
+		*n_threads_out = static_cast<int32_t>(settings.threads);
+		*priority_out = settings.priority;
+		LVCopyToArrayHandle(cpus_out, settings.cpus);
+	}
+	catch (LVException &ex) {
+		(*cpus_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*cpus_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*cpus_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_set_core_reservation(lvError *lvErr, const LVArray_Hdl<int32_t> cpus_in){
+	try{
+		LVThreadPoolSettings settings = LVThreadPool::instance().settings();
+		settings.reserved.clear();
+		if (cpus_in != nullptr)
+			settings.reserved.assign((*cpus_in)->elt, (*cpus_in)->elt + (*cpus_in)->dimSize);
+
+		LVThreadPool::instance().configure(settings);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_get_core_reservation(lvError *lvErr, LVArray_Hdl<int32_t> cpus_out){
+	try{
+		LVCopyToArrayHandle(cpus_out, LVThreadPool::instance().settings().reserved);
+	}
+	catch (LVException &ex) {
+		(*cpus_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*cpus_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*cpus_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_shutdown(lvError *lvErr){
+	try{
+		LVJobQueue::instance().shutdown();
+		LVThreadPool::instance().shutdown();
+		LVLogger::instance().shutdown();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//-- Print functions
+
+void LVlinear_print_function(const char * message){
+	if (message == nullptr)
+		return;
+
+	// Called from inside the liblinear solvers, nothing may be thrown through them (see LVCancellation.h)
+	try{
+		// Filter out the progress messages (.....), the others are queued for the next batch of the logger
+		if (strcmp(message, ".") != 0){
+			LVUserEventRef *usrEv = loggingUsrEv;
+			LVLog(message, (usrEv != nullptr) ? *usrEv : 0);
+		}
+
+		// Iterations and shrinking events of the statistics collector of the run, if any (see LVStatistics.h)
+		LVCountSolverOutput(message);
+
+		// The progress messages count into the iteration budget of the run:
+		// "." every 10 iterations of the coordinate descent solvers, "iter ..." every Newton iteration
+		LVCountIterations((strcmp(message, ".") == 0) ? 10 : (strncmp(message, "iter", 4) == 0) ? 1 : 0);
+	}
+	catch (...) {
+		// A message that cannot be logged is dropped
+	}
+}
+
+void LVlinear_set_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_in) {
+	loggingUsrEv = loggingUserEvent_in;
+	LVInstallPrintFunction(set_print_string_function, LVlinear_print_function);
+}
+
+void LVlinear_get_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out) {
+	loggingUserEvent_out = loggingUsrEv;
+}
+
+void LVlinear_delete_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out) {
+	loggingUserEvent_out = loggingUsrEv;
+	loggingUsrEv = nullptr;
+}
+
+void LVlinear_set_logging_interval(lvError *lvErr, int32_t interval_ms){
+	try{
+		if (interval_ms <= 0)
+			throw LVException(__FILE__, __LINE__, "The logging interval must be positive (" + std::to_string(interval_ms) + " ms).");
+
+		LVLogger::instance().setInterval(std::chrono::milliseconds(interval_ms));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_flush_log(lvError *lvErr){
+	try{
+		LVLogger::instance().flush();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- File operations
+//
+
+void LVlinear_save_model(lvError *lvErr, const char *path_in, const LVlinear_model *model_in){
+	try{
+		// Convert LVlinear_model to model
+		auto mdl = std::make_unique<model>();
+		LVConvertModel(*model_in, *mdl);
+
+		// Same output as save_model
+		LVWriteTextFile(path_in, LVFormatTextModel(*mdl, false));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_load_model(lvError *lvErr, const char *path_in, LVlinear_model *model_out){
+	try{
+		LVMemoryMap map(path_in);
+		map.adviseSequential();
+
+		auto mdl = std::make_unique<model>();
+		LVlinear_text_storage storage;
+		LVReadTextModel(map.data(), map.size(), *mdl, storage);
+
+		LVConvertModel(*mdl, *model_out);
+
+		// LVConvertModel does not assign the scalar parameters, the solver type determines the layout of w
+		model_out->param.solver_type = mdl->param.solver_type;
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_save_model_round_trip(lvError *lvErr, const char *path_in, const LVlinear_model *model_in){
+	try{
+		// Convert LVlinear_model to model
+		auto mdl = std::make_unique<model>();
+		LVConvertModel(*model_in, *mdl);
+
+		LVWriteTextFile(path_in, LVFormatTextModel(*mdl, true));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_save_model_binary(lvError *lvErr, const char *path_in, const LVlinear_model *model_in){
+	try{
+		// Convert LVlinear_model to model
+		auto mdl = std::make_unique<model>();
+		LVConvertModel(*model_in, *mdl);
+
+		LVBinaryWriter writer(LVBinaryKind::Linear);
+		LVlinear_binary_parameter param_storage;
+		LVWriteBinaryModel(*mdl, writer, param_storage);
+		writer.writeFile(path_in);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_load_model_binary(lvError *lvErr, const char *path_in, LVlinear_model *model_out){
+	try{
+		// The file is only read as it is copied into LabVIEW memory
+		LVMemoryMap map(path_in);
+		map.adviseSequential();
+
+		LVBinaryReader reader(map.data(), map.size(), LVBinaryKind::Linear);
+
+		auto mdl = std::make_unique<model>();
+		LVReadBinaryModel(reader, *mdl);
+
+		LVConvertModel(*mdl, *model_out);
+
+		// LVConvertModel does not assign the scalar parameters
+		model_out->param.solver_type = mdl->param.solver_type;
+		model_out->param.eps = mdl->param.eps;
+		model_out->param.C = mdl->param.C;
+		model_out->param.p = mdl->param.p;
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_save_model_binary_scaled(lvError *lvErr, const char *path_in, const LVlinear_model *model_in, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in){
+	try{
+		std::shared_ptr<const LVScaling> scaling = LVConvertScaling(scale_in, shift_in);
+
+		// Convert LVlinear_model to model
+		auto mdl = std::make_unique<model>();
+		LVConvertModel(*model_in, *mdl);
+
+		LVBinaryWriter writer(LVBinaryKind::Linear);
+		LVlinear_binary_parameter param_storage;
+		LVWriteBinaryModel(*mdl, writer, param_storage);
+		if (scaling)
+			LVWriteBinaryScaling(*scaling, writer);
+		writer.writeFile(path_in);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_save_model_binary_hashed(lvError *lvErr, const char *path_in, const LVlinear_model *model_in, int32_t hash_bits, uint32_t hash_seed, LVBoolean hash_sign, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in){
+	try{
+		if (hash_bits <= 0)
+			throw LVException(__FILE__, __LINE__, "The number of hash bits must be positive (use LVlinear_save_model_binary_scaled for models without hashing).");
+
+		std::shared_ptr<const LVFeatureHashing> hashing = LVConvertHashing(hash_bits, hash_seed, hash_sign);
+		std::shared_ptr<const LVScaling> scaling = LVConvertScaling(scale_in, shift_in);
+
+		// Convert LVlinear_model to model
+		auto mdl = std::make_unique<model>();
+		LVConvertModel(*model_in, *mdl);
+
+		LVBinaryWriter writer(LVBinaryKind::Linear);
+		LVlinear_binary_parameter param_storage;
+		LVWriteBinaryModel(*mdl, writer, param_storage);
+		LVBinaryHashingSettings hashing_storage;
+		LVWriteBinaryHashing(*hashing, writer, hashing_storage);
+		if (scaling)
+			LVWriteBinaryScaling(*scaling, writer);
+		writer.writeFile(path_in);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_serialize_model(lvError *lvErr, const LVlinear_model *model_in, LStrHandle model_out){
+	try{
+		// Convert LVlinear_model to model
+		auto mdl = std::make_unique<model>();
+		LVConvertModel(*model_in, *mdl);
+
+		LVBinaryWriter writer(LVBinaryKind::Linear);
+		LVlinear_binary_parameter param_storage;
+		LVWriteBinaryModel(*mdl, writer, param_storage);
+		LVResizeStringHandle(model_out, writer.size());
+		writer.writeBuffer(reinterpret_cast<char*>((*model_out)->str));
+	}
+	catch (LVException &ex) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_serialize_model_text(lvError *lvErr, const LVlinear_model *model_in, LVBoolean round_trip, LStrHandle model_out){
+	try{
+		// Convert LVlinear_model to model
+		auto mdl = std::make_unique<model>();
+		LVConvertModel(*model_in, *mdl);
+
+		LVWriteStringHandle(model_out, LVFormatTextModel(*mdl, round_trip != 0));
+	}
+	catch (LVException &ex) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_deserialize_model(lvError *lvErr, const LStrHandle model_in, LVlinear_model *model_out){
+	try{
+		// Input validation: Empty string
+		if (model_in == nullptr || (*model_in)->cnt <= 0)
+			throw LVException(__FILE__, __LINE__, "Empty string passed to LVlinear_deserialize_model.");
+
+		const char *data = reinterpret_cast<const char*>((*model_in)->str);
+		size_t size = static_cast<size_t>((*model_in)->cnt);
+
+		auto mdl = std::make_unique<model>();
+		if (LVIsBinaryModel(data, size)){
+			// The sections are accessed in place, which requires aligned memory
+			std::unique_ptr<uint64_t[]> buffer = LVBinaryCopyAligned(data, size);
+			LVBinaryReader reader(reinterpret_cast<const char*>(buffer.get()), size, LVBinaryKind::Linear);
+			LVReadBinaryModel(reader, *mdl);
+
+			LVConvertModel(*mdl, *model_out);
+		}
+		else{
+			LVlinear_text_storage storage;
+			LVReadTextModel(data, size, *mdl, storage);
+
+			LVConvertModel(*mdl, *model_out);
+		}
+
+		// LVConvertModel does not assign the scalar parameters
+		model_out->param.solver_type = mdl->param.solver_type;
+		model_out->param.eps = mdl->param.eps;
+		model_out->param.C = mdl->param.C;
+		model_out->param.p = mdl->param.p;
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Native model handles
+//
+
+void LVlinear_load_model_handle(lvError *lvErr, const char *path_in, LVBoolean pack, uint64_t *handle_out){
+	try{
+		*handle_out = 0;
+		*handle_out = modelHandles.add(LVLoadNativeModel(path_in, pack != 0));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_free_model_handle(lvError *lvErr, uint64_t handle){
+	try{
+		modelHandles.remove(handle);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+double LVlinear_predict_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<LVlinear_node> x_in){
+	try{
+		LVLatencyScope latency;
+
+		// Input validation: Empty feature vector
+		if (x_in == nullptr || (*x_in)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, "Empty feature vector passed to liblinear_predict.");
+
+		// Input validation: Final index -1?
+		if ((*x_in)->elt[(*x_in)->dimSize - 1].index != -1)
+			throw LVException(__FILE__, __LINE__, "The index of the last element of the feature vector needs to be -1 (liblinear_predict).");
+
+		auto native = modelHandles.get(handle);
+
+		std::vector<feature_node> hashed, scaled;
+		const feature_node *x = LVHashInput(*native, reinterpret_cast<feature_node*>((*x_in)->elt), hashed);
+		x = LVScaleInput(*native, x, scaled);
+
+		return LVPredict(*native, x);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+		return std::nan("");
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+		return std::nan("");
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+		return std::nan("");
+	}
+}
+
+double LVlinear_predict_values_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<LVlinear_node> x_in, LVArray_Hdl<double> dec_values_out){
+	try{
+		LVLatencyScope latency;
+
+		// Input validation: Empty feature vector
+		if (x_in == nullptr || (*x_in)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, "Empty feature vector passed to liblinear_predict_values.");
+
+		// Input validation: Final index -1?
+		if ((*x_in)->elt[(*x_in)->dimSize - 1].index != -1)
+			throw LVException(__FILE__, __LINE__, "The index of the last element of the feature vector needs to be -1 (liblinear_predict_values).");
+
+		auto native = modelHandles.get(handle);
+
+		int nr_dec = LVGetNrDecisionValues(native->view);
+		LVResizeNumericArrayHandle(dec_values_out, nr_dec);
+		(*dec_values_out)->dimSize = nr_dec;
+
+		std::vector<feature_node> hashed, scaled;
+		const feature_node *x = LVHashInput(*native, reinterpret_cast<feature_node*>((*x_in)->elt), hashed);
+		x = LVScaleInput(*native, x, scaled);
+
+		return LVPredictValues(*native, x, (*dec_values_out)->elt);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+		(*dec_values_out)->dimSize = 0;
+		return std::nan("");
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+		(*dec_values_out)->dimSize = 0;
+		return std::nan("");
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+		(*dec_values_out)->dimSize = 0;
+		return std::nan("");
+	}
+}
+
+double LVlinear_predict_probability_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<LVlinear_node> x_in, LVArray_Hdl<double> prob_estimates_out){
+	try{
+		LVLatencyScope latency;
+
+		// Input validation: Empty feature vector
+		if (x_in == nullptr || (*x_in)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, "Empty feature vector passed to liblinear_predict_probability.");
+
+		// Input validation: Final index -1?
+		if ((*x_in)->elt[(*x_in)->dimSize - 1].index != -1)
+			throw LVException(__FILE__, __LINE__, "The index of the last element of the feature vector needs to be -1 (liblinear_predict_probability).");
+
+		auto native = modelHandles.get(handle);
+
+		// Check probability model
+		if (!check_probability_model(&native->view))
+			throw LVException(__FILE__, __LINE__, "The selected solver type does not support probability output.");
+
+		// Allocate room for probability estimates
+		LVResizeNumericArrayHandle(prob_estimates_out, native->view.nr_class);
+		(*prob_estimates_out)->dimSize = native->view.nr_class;
+
+		std::vector<feature_node> hashed, scaled;
+		const feature_node *x = LVHashInput(*native, reinterpret_cast<feature_node*>((*x_in)->elt), hashed);
+		x = LVScaleInput(*native, x, scaled);
+
+		return LVPredictProbability(*native, x, (*prob_estimates_out)->elt);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+		(*prob_estimates_out)->dimSize = 0;
+		return std::nan("");
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+		(*prob_estimates_out)->dimSize = 0;
+		return std::nan("");
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+		(*prob_estimates_out)->dimSize = 0;
+		return std::nan("");
+	}
+}
+
+void LVlinear_set_model_handle_scaling(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in){
+	try{
+		auto native = modelHandles.get(handle);
+		std::shared_ptr<const LVScaling> scaling = LVConvertScaling(scale_in, shift_in);
+
+		// Predictions in progress keep using the previous scaling
+		std::atomic_store(&native->scaling, scaling);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_get_model_handle_scaling(lvError *lvErr, uint64_t handle, LVArray_Hdl<double> scale_out, LVArray_Hdl<double> shift_out){
+	try{
+		auto native = modelHandles.get(handle);
+		std::shared_ptr<const LVScaling> scaling = std::atomic_load(&native->scaling);
+
+		LVCopyToArrayHandle(scale_out, scaling ? scaling->scale() : std::vector<double>());
+		LVCopyToArrayHandle(shift_out, scaling ? scaling->shift() : std::vector<double>());
+	}
+	catch (LVException &ex) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_set_model_handle_hashing(lvError *lvErr, uint64_t handle, int32_t hash_bits, uint32_t hash_seed, LVBoolean hash_sign){
+	try{
+		auto native = modelHandles.get(handle);
+		std::shared_ptr<const LVFeatureHashing> hashing = LVConvertHashing(hash_bits, hash_seed, hash_sign);
+
+		// Predictions in progress keep using the previous hashing
+		std::atomic_store(&native->hashing, hashing);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_get_model_handle_hashing(lvError *lvErr, uint64_t handle, int32_t *hash_bits_out, uint32_t *hash_seed_out, LVBoolean *hash_sign_out){
+	try{
+		auto native = modelHandles.get(handle);
+		std::shared_ptr<const LVFeatureHashing> hashing = std::atomic_load(&native->hashing);
+
+		*hash_bits_out = hashing ? hashing->bits() : 0;
+		*hash_seed_out = hashing ? hashing->seed() : 0;
+		*hash_sign_out = (hashing && hashing->sign()) ? 1 : 0;
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_train_handle(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, uint64_t *handle_out){
+	try{
+		LVThroughputScope throughput;
+
+		*handle_out = 0;
+		auto native = LVTrainNativeModel(*prob_in, *param_in);
+		LVSparsifyModel(*native);
+		*handle_out = modelHandles.add(native);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Data files
+//
+
+void LVlinear_read_problem(lvError *lvErr, const char *path_in, double bias, LVBoolean skip_malformed, LVlinear_problem *prob_out, LVArray_Hdl<uint64_t> malformed_lines_out){
+	try{
+		// Feature indices start at 1 in liblinear
+		LVDataset dataset;
+		LVReadDatasetFile(path_in, 1, skip_malformed != 0, dataset);
+
+		LVConvertDataset(dataset, bias, *prob_out);
+		LVCopyToArrayHandle(malformed_lines_out, dataset.malformedLines);
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*malformed_lines_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*malformed_lines_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*malformed_lines_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_write_problem(lvError *lvErr, const char *path_in, const LVlinear_problem *prob_in){
+	try{
+		// Input verification: Problem dimensions
+		if (prob_in->x == nullptr || prob_in->y == nullptr || (*(prob_in->x))->dimSize != (*(prob_in->y))->dimSize)
+			throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and feature vectors (x and y).");
+
+		size_t l = (*(prob_in->y))->dimSize;
+		const double *y = (*(prob_in->y))->elt;
+		const LVArray_Hdl<LVlinear_node> *x = (*(prob_in->x))->elt;
+		bool hasBias = prob_in->bias >= 0;
+
+		// Nodes are written up to the terminating -1 index
+		LVWriteTextFile(path_in, LVFormatDataset(l, [&](size_t i, LVTextWriter &writer){
+			LVPutDatasetLabel(writer, y[i]);
+
+			LVArray_Hdl<LVlinear_node> xi = x[i];
+			if (xi != nullptr){
+				uint32_t n = 0;
+				while (n < (*xi)->dimSize && (*xi)->elt[n].index != -1)
+					n++;
+
+				if (hasBias && n > 0)
+					n--;
+
+				for (uint32_t k = 0; k < n; k++)
+					LVPutDatasetNode(writer, (*xi)->elt[k].index, (*xi)->elt[k].value);
+			}
+
+			writer.put('\n');
+		}));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_write_problem_binary(lvError *lvErr, const char *path_in, const LVlinear_problem *prob_in){
+	try{
+		LVDataset dataset;
+		LVConvertProblemToDataset(*prob_in, dataset);
+		LVWriteBinaryDataset(path_in, dataset);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_train_file(lvError *lvErr, const char *path_in, double bias, const LVlinear_parameter *param_in, double block_mb, int32_t block_passes, LVlinear_model *model_out){
+	try{
+		LVThroughputScope throughput;
+
+		auto param = std::make_unique<parameter>();
+		LVConvertParameter(*param_in, *param);
+
+		if (param->solver_type != L2R_L2LOSS_SVC_DUAL && param->solver_type != L2R_L1LOSS_SVC_DUAL && param->solver_type != L2R_LR_DUAL)
+			throw LVException(__FILE__, __LINE__, "Training from a file requires a dual solver (L2R_L2LOSS_SVC_DUAL, L2R_L1LOSS_SVC_DUAL or L2R_LR_DUAL).");
+
+		if (!(block_mb > 0) || block_passes < 1)
+			throw LVException(__FILE__, __LINE__, "The block size and the number of passes per block must be positive.");
+
+		// Verify parameters (the problem itself is only known once the file has been scanned)
+		auto prob = std::make_unique<problem>();
+		prob->bias = bias;
+		const char * param_check = check_parameter(prob.get(), param.get());
+		if (param_check != nullptr)
+			throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check));
+
+		// The labels are collected while the file is scanned, a regression target would have too many
+		LVDatasetBlocks blocks(path_in, static_cast<size_t>(block_mb * 1024 * 1024), 65536);
+		if (blocks.rows() == 0)
+			throw LVException(__FILE__, __LINE__, "The data file contains no feature vectors.");
+
+		std::unique_ptr<model, LVlinear_model_deleter> result(LVTrainBlocks(blocks, bias, *param, static_cast<size_t>(block_passes)));
+
+		// Copy model to LabVIEW memory
+		LVConvertModel(*result, *model_out);
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_read_delimited(lvError *lvErr, const char *path_in, uint8_t delimiter, int32_t header_rows, int32_t label_column, int32_t missing_policy, double missing_value, double bias, LVlinear_problem *prob_out, LVArray_Hdl<uint64_t> skipped_lines_out){
+	try{
+		LVDelimitedOptions options = LVMakeDelimitedOptions(delimiter, header_rows, label_column, missing_policy, missing_value);
+
+		LVDataset dataset;
+		{
+			LVDenseTable table;
+			LVReadDelimitedFile(path_in, options, table);
+			LVConvertTable(table, dataset);
+		}
+
+		LVConvertDataset(dataset, bias, *prob_out);
+		LVCopyToArrayHandle(skipped_lines_out, dataset.malformedLines);
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*skipped_lines_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*skipped_lines_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*skipped_lines_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Feature scaling
+//
+
+void LVlinear_compute_scaling(lvError *lvErr, const LVlinear_problem *prob_in, int32_t method, double lower, double upper, LVArray_Hdl<double> scale_out, LVArray_Hdl<double> shift_out){
+	try{
+		LVScalingMethod scaling_method = LVCheckScalingMethod(method, lower, upper);
+		LVScaling scaling = LVComputeProblemScaling(*prob_in, scaling_method, lower, upper);
+
+		LVCopyToArrayHandle(scale_out, scaling.scale());
+		LVCopyToArrayHandle(shift_out, scaling.shift());
+	}
+	catch (LVException &ex) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_scale_problem(lvError *lvErr, LVlinear_problem *prob_inout, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in){
+	try{
+		std::shared_ptr<const LVScaling> scaling = LVConvertScaling(scale_in, shift_in);
+		if (scaling)
+			LVScaleProblem(*scaling, *prob_inout);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Feature hashing
+//
+
+void LVlinear_hash_problem(lvError *lvErr, const LVlinear_problem *prob_in, int32_t hash_bits, uint32_t hash_seed, LVBoolean hash_sign, LVlinear_problem *prob_out){
+	try{
+		LVCheckProblemSize(prob_in->y, prob_in->x);
+		LVFeatureHashing hashing(hash_bits, hash_seed, hash_sign != 0);
+
+		LVHashSparse(prob_in->x, prob_in->bias >= 0, hashing, 1, prob_out->x);
+		LVCopyLabels(prob_in->y, prob_out->y);
+		prob_out->bias = prob_in->bias;
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_hash_vector(lvError *lvErr, const LVArray_Hdl<LVlinear_node> x_in, int32_t hash_bits, uint32_t hash_seed, LVBoolean hash_sign, LVBoolean has_bias, LVArray_Hdl<LVlinear_node> x_out){
+	try{
+		size_t n_excluded = has_bias ? 2 : 1;
+		if (x_in == nullptr || (*x_in)->dimSize < n_excluded || (*x_in)->elt[(*x_in)->dimSize - 1].index != -1)
+			throw LVException(__FILE__, __LINE__, "The index of the last element of the feature vector needs to be -1" + std::string(has_bias ? ", preceded by the bias feature" : "") + " (liblinear_hash_vector).");
+
+		LVFeatureHashing hashing(hash_bits, hash_seed, hash_sign != 0);
+
+		std::vector<LVlinear_node> hashed;
+		LVHashVector(hashing, (*x_in)->elt, (*x_in)->dimSize, has_bias != 0, 1, hashed);
+
+		LVResizeCompositeArrayHandle(x_out, hashed.size());
+		std::copy(hashed.begin(), hashed.end(), (*x_out)->elt);
+		(*x_out)->dimSize = static_cast<uint32_t>(hashed.size());
+	}
+	catch (LVException &ex) {
+		(*x_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*x_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*x_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Problem conversion
+//
+
+void LVlinear_problem_from_sparse(lvError *lvErr, const LVlinear_sparse_problem *prob_in, double bias, LVlinear_problem *prob_out){
+	try{
+		LVCheckProblemSize(prob_in->y, prob_in->x);
+		int32_t max_index = LVSparseMaxIndex(prob_in->x, false);
+
+		LVSparseToSparse(prob_in->x, false, bias, max_index + 1, prob_out->x);
+		LVCopyLabels(prob_in->y, prob_out->y);
+		prob_out->bias = bias;
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_problem_from_dense(lvError *lvErr, const LVlinear_dense_problem *prob_in, double bias, LVlinear_problem *prob_out){
+	try{
+		LVCheckProblemSize(prob_in->y, prob_in->x);
+		size_t n_features = LVDenseMaxLength(prob_in->x);
+
+		LVDenseToSparse(prob_in->x, bias, static_cast<int32_t>(n_features + 1), prob_out->x);
+		LVCopyLabels(prob_in->y, prob_out->y);
+		prob_out->bias = bias;
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Dense input
+//
+
+void LVlinear_train_dense(lvError *lvErr, const LVArray_Hdl<double> y_in, const LVArray_Hdl<double, 2> x_in, double bias, const LVlinear_parameter *param_in, LVlinear_model *model_out){
+	try{
+		LVThroughputScope throughput;
+
+		auto prob = std::make_unique<problem>();
+		std::vector<feature_node> nodes;
+		std::vector<feature_node*> rows;
+		LVConvertDenseProblem(y_in, x_in, bias, *prob, nodes, rows);
+
+		auto param = std::make_unique<parameter>();
+		LVConvertParameter(*param_in, *param);
+
+		// Verify parameters
+		const char * param_check = check_parameter(prob.get(), param.get());
+		if (param_check != nullptr)
+			throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check));
+
+		std::unique_ptr<model, LVlinear_model_deleter> result(LVTrain(*prob, *param));
+
+		// Copy model to LabVIEW memory
+		LVConvertModel(*result, *model_out);
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->w))->dimSize = 0;
+		(*(model_out->param).weight)->dimSize = 0;
+		(*(model_out->param).weight_label)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_cross_validation_dense(lvError *lvErr, const LVArray_Hdl<double> y_in, const LVArray_Hdl<double, 2> x_in, double bias, const LVlinear_parameter *param_in, int32_t nr_fold, LVArray_Hdl<double> target_out){
+	try{
+		LVThroughputScope throughput;
+
+		auto prob = std::make_unique<problem>();
+		std::vector<feature_node> nodes;
+		std::vector<feature_node*> rows;
+		LVConvertDenseProblem(y_in, x_in, bias, *prob, nodes, rows);
+
+		auto param = std::make_unique<parameter>();
+		LVConvertParameter(*param_in, *param);
+
+		// Verify parameters
+		const char * param_check = check_parameter(prob.get(), param.get());
+		if (param_check != nullptr)
+			throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check));
+
+		LVResizeNumericArrayHandle(target_out, prob->l);
+		LVCrossValidate(*prob, *param, nr_fold, (*target_out)->elt);
+		(*target_out)->dimSize = prob->l;
+	}
+	catch (LVException &ex) {
+		(*target_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*target_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*target_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_predict_dense(lvError *lvErr, const LVlinear_model *model_in, const LVArray_Hdl<double, 2> x_in, LVArray_Hdl<double> labels_out){
+	try{
+		// Input validation: Uninitialized model
+		if (model_in == nullptr || model_in->w == nullptr || (*model_in->w)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, "Uninitialized model passed to liblinear_predict_dense.");
+
+		auto mdl = std::make_unique<model>();
+		LVConvertModel(*model_in, *mdl);
+
+		size_t l = (x_in != nullptr) ? (*x_in)->dimSize[0] : 0;
+		size_t n_columns = (x_in != nullptr) ? (*x_in)->dimSize[1] : 0;
+
+		LVResizeNumericArrayHandle(labels_out, l);
+		(*labels_out)->dimSize = static_cast<uint32_t>(l);
+
+		LVPredictDense(*mdl, (l > 0) ? (*x_in)->elt : nullptr, l, n_columns, false, (*labels_out)->elt, nullptr, 0);
+	}
+	catch (LVException &ex) {
+		(*labels_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*labels_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*labels_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_predict_values_dense(lvError *lvErr, const LVlinear_model *model_in, const LVArray_Hdl<double, 2> x_in, LVArray_Hdl<double> labels_out, LVArray_Hdl<double, 2> dec_values_out){
+	try{
+		// Input validation: Uninitialized model
+		if (model_in == nullptr || model_in->w == nullptr || (*model_in->w)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, "Uninitialized model passed to liblinear_predict_values_dense.");
+
+		auto mdl = std::make_unique<model>();
+		LVConvertModel(*model_in, *mdl);
+
+		size_t l = (x_in != nullptr) ? (*x_in)->dimSize[0] : 0;
+		size_t n_columns = (x_in != nullptr) ? (*x_in)->dimSize[1] : 0;
+		size_t nr_dec = static_cast<size_t>(LVGetNrDecisionValues(*mdl));
+
+		LVResizeNumericArrayHandle(labels_out, l);
+		(*labels_out)->dimSize = static_cast<uint32_t>(l);
+		LVResizeNumericArrayHandle(dec_values_out, l * nr_dec);
+		(*dec_values_out)->dimSize[0] = static_cast<uint32_t>(l);
+		(*dec_values_out)->dimSize[1] = static_cast<uint32_t>(nr_dec);
+
+		LVPredictDense(*mdl, (l > 0) ? (*x_in)->elt : nullptr, l, n_columns, false, (*labels_out)->elt, (*dec_values_out)->elt, nr_dec);
+	}
+	catch (LVException &ex) {
+		(*labels_out)->dimSize = 0;
+		(*dec_values_out)->dimSize[0] = 0;
+		(*dec_values_out)->dimSize[1] = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*labels_out)->dimSize = 0;
+		(*dec_values_out)->dimSize[0] = 0;
+		(*dec_values_out)->dimSize[1] = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*labels_out)->dimSize = 0;
+		(*dec_values_out)->dimSize[0] = 0;
+		(*dec_values_out)->dimSize[1] = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_predict_probability_dense(lvError *lvErr, const LVlinear_model *model_in, const LVArray_Hdl<double, 2> x_in, LVArray_Hdl<double> labels_out, LVArray_Hdl<double, 2> prob_estimates_out){
+	try{
+		// Input validation: Uninitialized model
+		if (model_in == nullptr || model_in->w == nullptr || (*model_in->w)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, "Uninitialized model passed to liblinear_predict_probability_dense.");
+
+		auto mdl = std::make_unique<model>();
+		LVConvertModel(*model_in, *mdl);
+
+		// Check probability model
+		if (!check_probability_model(mdl.get()))
+			throw LVException(__FILE__, __LINE__, "The selected solver type does not support probability output.");
+
+		size_t l = (x_in != nullptr) ? (*x_in)->dimSize[0] : 0;
+		size_t n_columns = (x_in != nullptr) ? (*x_in)->dimSize[1] : 0;
+		size_t nr_class = static_cast<size_t>(mdl->nr_class);
+
+		LVResizeNumericArrayHandle(labels_out, l);
+		(*labels_out)->dimSize = static_cast<uint32_t>(l);
+		LVResizeNumericArrayHandle(prob_estimates_out, l * nr_class);
+		(*prob_estimates_out)->dimSize[0] = static_cast<uint32_t>(l);
+		(*prob_estimates_out)->dimSize[1] = static_cast<uint32_t>(nr_class);
+
+		LVPredictDense(*mdl, (l > 0) ? (*x_in)->elt : nullptr, l, n_columns, true, (*labels_out)->elt, (*prob_estimates_out)->elt, nr_class);
+	}
+	catch (LVException &ex) {
+		(*labels_out)->dimSize = 0;
+		(*prob_estimates_out)->dimSize[0] = 0;
+		(*prob_estimates_out)->dimSize[1] = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*labels_out)->dimSize = 0;
+		(*prob_estimates_out)->dimSize[0] = 0;
+		(*prob_estimates_out)->dimSize[1] = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*labels_out)->dimSize = 0;
+		(*prob_estimates_out)->dimSize[0] = 0;
+		(*prob_estimates_out)->dimSize[1] = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Feature selection
+//
+
+void LVlinear_fscore(lvError *lvErr, const LVlinear_problem *prob_in, int32_t n_select, LVArray_Hdl<double> fscore_out, LVArray_Hdl<int32_t> ranking_out, LVlinear_problem *prob_out){
+	try{
+		size_t l = LVCheckProblemSize(prob_in->y, prob_in->x);
+		bool has_bias = prob_in->bias >= 0;
+		size_t n_features = static_cast<size_t>(LVSparseMaxIndex(prob_in->x, has_bias)) + 1;
+		size_t n_excluded = has_bias ? 2 : 1;
+		LVArray_Hdl<LVlinear_node> *x = (*(prob_in->x))->elt;
+
+		// The bias feature (last node before the terminator) is excluded
+		std::vector<double> fscore = LVComputeFScores((*(prob_in->y))->elt, l, n_features, [&](size_t i, LVClassStatistics &statistics){
+			const LVlinear_node *xi = (*x[i])->elt;
+			size_t n = (*x[i])->dimSize - n_excluded;
+			for (size_t k = 0; k < n; k++)
+				statistics.add(xi[k].index, xi[k].value);
+		});
+		std::vector<int32_t> ranking = LVRankFeatures(fscore, 1);
+
+		size_t n = (n_select > 0) ? std::min(ranking.size(), static_cast<size_t>(n_select)) : ranking.size();
+		std::vector<char> mask = LVSelectionMask(ranking.data(), n, 1, 0);
+		LVSelectSparse(prob_in->x, has_bias, mask, prob_out->x);
+		LVCopyLabels(prob_in->y, prob_out->y);
+		prob_out->bias = prob_in->bias;
+
+		LVCopyToArrayHandle(fscore_out, fscore);
+		LVCopyToArrayHandle(ranking_out, ranking);
+	}
+	catch (LVException &ex) {
+		(*fscore_out)->dimSize = 0;
+		(*ranking_out)->dimSize = 0;
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*fscore_out)->dimSize = 0;
+		(*ranking_out)->dimSize = 0;
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*fscore_out)->dimSize = 0;
+		(*ranking_out)->dimSize = 0;
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_rfe(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, int32_t n_select, double step, LVArray_Hdl<int32_t> ranking_out, LVlinear_problem *prob_out){
+	try{
+		LVThroughputScope throughput;
+
+		if (n_select < 1)
+			throw LVException(__FILE__, __LINE__, "The number of features to select must be at least 1 (LVlinear_rfe).");
+
+		if (!(step > 0))
+			throw LVException(__FILE__, __LINE__, "The elimination step must be positive (LVlinear_rfe).");
+
+		std::vector<int32_t> ranking = LVRecursiveFeatureElimination(*prob_in, *param_in, static_cast<size_t>(n_select), step);
+
+		size_t n = std::min(ranking.size(), static_cast<size_t>(n_select));
+		std::vector<char> mask = LVSelectionMask(ranking.data(), n, 1, 0);
+		LVSelectSparse(prob_in->x, prob_in->bias >= 0, mask, prob_out->x);
+		LVCopyLabels(prob_in->y, prob_out->y);
+		prob_out->bias = prob_in->bias;
+
+		LVCopyToArrayHandle(ranking_out, ranking);
+	}
+	catch (LVException &ex) {
+		(*ranking_out)->dimSize = 0;
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*ranking_out)->dimSize = 0;
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*ranking_out)->dimSize = 0;
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVlinear_select_features(lvError *lvErr, const LVlinear_problem *prob_in, const LVArray_Hdl<int32_t> features_in, LVlinear_problem *prob_out){
+	try{
+		LVCheckProblemSize(prob_in->y, prob_in->x);
+
+		size_t n = (features_in != nullptr) ? (*features_in)->dimSize : 0;
+		std::vector<char> mask = LVSelectionMask((n > 0) ? (*features_in)->elt : nullptr, n, 1, 0);
+		LVSelectSparse(prob_in->x, prob_in->bias >= 0, mask, prob_out->x);
+		LVCopyLabels(prob_in->y, prob_out->y);
+		prob_out->bias = prob_in->bias;
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Engine selection
+//
+
+void LVlinear_analyze_problem(lvError *lvErr, const LVlinear_problem *prob_in, int32_t svm_type, int32_t kernel_type, LVProblemProfile *profile_out, int32_t *backend_out, LStrHandle reason_out){
+	try{
+		*profile_out = LVProblemProfile();
+		*backend_out = -1;
+
+		LVCheckProblemSize(prob_in->y, prob_in->x);
+		*profile_out = LVProfileSparse(prob_in->x, prob_in->bias >= 0);
+		LVBackendChoice choice = LVSelectBackend(*profile_out, svm_type, kernel_type);
+
+		*backend_out = static_cast<int32_t>(choice.backend);
+		LVWriteStringHandle(reason_out, choice.reason);
+	}
+	catch (LVException &ex) {
+		if (DSCheckHandle(reason_out) == noErr)
+			(*reason_out)->cnt = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		if (DSCheckHandle(reason_out) == noErr)
+			(*reason_out)->cnt = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		if (DSCheckHandle(reason_out) == noErr)
+			(*reason_out)->cnt = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Helper functions
+//
+
+void LVConvertParameter(const LVlinear_parameter &param_in, parameter &param_out){
+	param_out.solver_type = param_in.solver_type;
+	param_out.eps = param_in.eps;
+	param_out.C = param_in.C;
+	param_out.p = param_in.p;
+	param_out.init_sol = nullptr; // Assigned by LVTrainNativeModel (see LVWarmStartSolution)
+
+	// Weight label
+	if (param_in.weight_label != nullptr && param_in.weight != nullptr){
+		if ((*(param_in.weight))->dimSize != (*(param_in.weight_label))->dimSize)
+			throw LVException(__FILE__, __LINE__, "Parameter error: Number of elements in weight_label and weight does not match.");
+
+		if ((*(param_in.weight_label))->dimSize > 0)
+			param_out.weight_label = (*(param_in.weight_label))->elt;
+		else
+			param_out.weight_label = nullptr;
+
+		// Weight
+		if ((*(param_in.weight))->dimSize > 0){
+			param_out.weight = (*(param_in.weight))->elt;
+			param_out.nr_weight = (*(param_in.weight))->dimSize;
+		}
+		else{
+			param_out.weight = nullptr;
+			param_out.nr_weight = 0;
+		}
+	}
+}
+
+void LVConvertModel(const LVlinear_model &model_in, model &model_out){
+	// Assign the parameters
+	LVConvertParameter(model_in.param, model_out.param);
+
+	// Copy assignments
+	model_out.nr_class = model_in.nr_class;
+	model_out.nr_feature = model_in.nr_feature;
+	model_out.bias = model_in.bias;
+
+	// w
+	if ((*(model_in.w))->dimSize > 0)
+		model_out.w = (*(model_in.w))->elt;
+	else
+		model_out.w = nullptr;
+
+	// label
+	if ((*(model_in.label))->dimSize > 0)
+		model_out.label = (*(model_in.label))->elt;
+	else
+		model_out.label = nullptr;
+}
+
+void LVConvertModel(const model &model_in, LVlinear_model &model_out){
+	// Convert svm_model to LVsvm_model
+	model_out.nr_class = model_in.nr_class;
+	model_out.nr_feature = model_in.nr_feature;
+	model_out.bias = model_in.bias;
+	int nr_class = model_in.nr_class;
+	int nr_feature = model_in.nr_feature;
+
+	// Label
+	if (model_in.label != nullptr){
+		LVResizeNumericArrayHandle(model_out.label, nr_class);
 		MoveBlock(model_in.label, (*(model_out.label))->elt, nr_class * sizeof(int32_t));
 		(*model_out.label)->dimSize = model_in.nr_class;
 	}
-	else{
-		(*model_out.label)->dimSize = 0;
+	else{
+		(*model_out.label)->dimSize = 0;
+	}
+
+	// n is equal to nr_feature, incremented if bias is present
+	int n = nr_feature;
+	if (model_in.bias >= 0)
+		n++;
+
+	// nr_w is equal to nr_class with one exception
+	int nr_w;
+	if (model_in.nr_class == 2 && model_in.param.solver_type != MCSVM_CS)
+		nr_w = 1;
+	else
+		nr_w = model_in.nr_class;
+
+	if (model_in.w != nullptr){
+		LVResizeNumericArrayHandle(model_out.w, n*nr_w);
+		MoveBlock(model_in.w, (*(model_out.w))->elt, nr_w * n * sizeof(double));
+		(*model_out.w)->dimSize = nr_w*n;
+	}
+	else{
+		(*model_out.w)->dimSize = 0;
+	}
+}
+
+//
+//-- Binary model helpers
+//
+
+int LVGetNrWeightVectors(const model &model_in){
+	// nr_w is equal to nr_class with one exception
+	if (model_in.nr_class == 2 && model_in.param.solver_type != MCSVM_CS)
+		return 1;
+	else
+		return model_in.nr_class;
+}
+
+void LVWriteBinaryModel(const model &model_in, LVBinaryWriter &writer, LVlinear_binary_parameter &param_storage){
+	if (model_in.w == nullptr || model_in.nr_feature < 0 || model_in.nr_class < 1)
+		throw LVException(__FILE__, __LINE__, "Uninitialized model passed to binary model writer.");
+
+	param_storage = LVlinear_binary_parameter();
+	param_storage.eps = model_in.param.eps;
+	param_storage.C = model_in.param.C;
+	param_storage.p = model_in.param.p;
+	param_storage.bias = model_in.bias;
+	param_storage.solver_type = model_in.param.solver_type;
+	param_storage.nr_class = model_in.nr_class;
+	param_storage.nr_feature = model_in.nr_feature;
+	writer.addSection(LVLINEAR_SECTION_PARAMETER, &param_storage, 1);
+
+	const parameter &param = model_in.param;
+	int nr_weight = (param.weight != nullptr && param.weight_label != nullptr) ? param.nr_weight : 0;
+	writer.addSection<int32_t>(LVLINEAR_SECTION_WEIGHT_LABEL, param.weight_label, nr_weight);
+	writer.addSection<double>(LVLINEAR_SECTION_WEIGHT, param.weight, nr_weight);
+
+	writer.addSection<int32_t>(LVLINEAR_SECTION_LABEL, model_in.label, model_in.label ? model_in.nr_class : 0);
+
+	// n is equal to nr_feature, incremented if bias is present
+	size_t n = static_cast<size_t>(model_in.nr_feature) + (model_in.bias >= 0 ? 1 : 0);
+	writer.addSection<double>(LVLINEAR_SECTION_W, model_in.w, n * LVGetNrWeightVectors(model_in));
+}
+
+void LVReadBinaryModel(const LVBinaryReader &reader, model &model_out){
+	const LVlinear_binary_parameter &bparam = reader.scalar<LVlinear_binary_parameter>(LVLINEAR_SECTION_PARAMETER);
+
+	if (bparam.nr_class < 1 || bparam.nr_feature < 0)
+		throw LVException(__FILE__, __LINE__, "Invalid binary model: number of classes or features is invalid.");
+
+	model_out.param.solver_type = bparam.solver_type;
+	model_out.param.eps = bparam.eps;
+	model_out.param.C = bparam.C;
+	model_out.param.p = bparam.p;
+	model_out.param.init_sol = nullptr;
+	model_out.nr_class = bparam.nr_class;
+	model_out.nr_feature = bparam.nr_feature;
+	model_out.bias = bparam.bias;
+
+	size_t nr_weight = 0, nr_weight_label = 0;
+	model_out.param.weight = const_cast<double*>(reader.section<double>(LVLINEAR_SECTION_WEIGHT, nr_weight));
+	model_out.param.weight_label = const_cast<int*>(reader.section<int32_t>(LVLINEAR_SECTION_WEIGHT_LABEL, nr_weight_label));
+	if (nr_weight != nr_weight_label)
+		throw LVException(__FILE__, __LINE__, "Invalid binary model: the number of elements in weight and weight_label does not match.");
+	model_out.param.nr_weight = static_cast<int>(nr_weight);
+
+	size_t count = 0;
+	model_out.label = const_cast<int*>(reader.section<int32_t>(LVLINEAR_SECTION_LABEL, count));
+	if (count != 0 && count != static_cast<size_t>(bparam.nr_class))
+		throw LVException(__FILE__, __LINE__, "Invalid binary model: unexpected number of elements in label.");
+
+	size_t n = static_cast<size_t>(bparam.nr_feature) + (bparam.bias >= 0 ? 1 : 0);
+	model_out.w = const_cast<double*>(reader.section<double>(LVLINEAR_SECTION_W, count));
+	if (model_out.w == nullptr || count != n * LVGetNrWeightVectors(model_out))
+		throw LVException(__FILE__, __LINE__, "Invalid binary model: unexpected number of elements in w.");
+}
+
+//
+//-- Native model helpers
+//
+
+std::shared_ptr<LVlinear_native_model> LVLoadNativeModel(const char *path_in, bool pack){
+	auto native = std::make_shared<LVlinear_native_model>();
+
+	// Binary models are used directly from the mapping, the pages are shared between processes
+	native->map.open(path_in);
+	if (LVIsBinaryModel(native->map.data(), native->map.size())){
+		LVBinaryReader reader(native->map.data(), native->map.size(), LVBinaryKind::Linear);
+		LVReadBinaryModel(reader, native->view);
+		native->hashing = LVReadBinaryHashing(reader);
+		native->scaling = LVReadBinaryScaling(reader);
+	}
+	else{
+		// Text models are parsed into owned storage, the mapping is only needed while parsing
+		native->map.adviseSequential();
+		LVReadTextModel(native->map.data(), native->map.size(), native->view, native->text);
+		native->map.close();
+	}
+
+	LVSparsifyModel(*native);
+
+	// Copy w into memory owned by the handle (text models already own their weights, sparse models their nonzero weights)
+	if (pack && native->map.isOpen() && native->sparse == nullptr){
+		size_t n = static_cast<size_t>(native->view.nr_feature) + (native->view.bias >= 0 ? 1 : 0);
+		size_t nr_w = LVGetNrWeightVectors(native->view);
+
+		native->w = std::make_unique<double[]>(n * nr_w);
+		std::memcpy(native->w.get(), native->view.w, n * nr_w * sizeof(double));
+		native->view.w = native->w.get();
+	}
+
+	return native;
+}
+
+std::shared_ptr<LVlinear_native_model> LVTrainNativeModel(const LVlinear_problem &prob_in, const LVlinear_parameter &param_in, const LVlinear_model *init_model, size_t n_threads){
+	size_t l = LVCheckProblem(prob_in, "liblinear_train");
+
+	// Input verification: Problem dimensions
+	if (prob_in.y == nullptr || (*(prob_in.y))->dimSize != l)
+		throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and feature vectors (x and y).");
+
+	// Input validation: Number of feature vectors too large (exceeds max signed int)
+	if (l > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Number of feature vectors too large (greater than " + std::to_string(INT_MAX) + ")");
+
+	problem prob;
+	prob.l = static_cast<int>(l);
+	prob.y = (*(prob_in.y))->elt;
+	prob.n = 0;
+	prob.bias = prob_in.bias;
+
+	// The largest index (including the bias feature) is the number of features
+	auto x = std::make_unique<feature_node*[]>(l);
+	prob.x = x.get();
+	for (size_t i = 0; i < l; i++){
+		x[i] = reinterpret_cast<feature_node*>((*(*(prob_in.x))->elt[i])->elt);
+		for (const feature_node *node = x[i]; node->index != -1; node++)
+			prob.n = std::max(prob.n, node->index);
+	}
+
+	parameter param = parameter();
+	LVConvertParameter(param_in, param);
+
+	std::vector<double> init_sol;
+	if (init_model != nullptr)
+		init_sol = LVWarmStartSolution(prob, param, *init_model);
+	if (!init_sol.empty())
+		param.init_sol = init_sol.data();
+
+	return LVTrainNativeModel(prob, param, n_threads);
+}
+
+std::shared_ptr<LVlinear_native_model> LVTrainNativeModel(const problem &prob, const parameter &param, size_t n_threads){
+	const char * param_check = check_parameter(&prob, &param);
+	if (param_check != nullptr)
+		throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check));
+
+	auto native = std::make_shared<LVlinear_native_model>();
+	native->trained.reset((n_threads > 1) ? LVTrainParallel(prob, param, n_threads) : LVTrain(prob, param));
+
+	// The weights and the initial solution reference memory which does not outlive this call
+	native->trained->param.nr_weight = 0;
+	native->trained->param.weight_label = nullptr;
+	native->trained->param.weight = nullptr;
+	native->trained->param.init_sol = nullptr;
+
+	// The weights stay dense, they are converted to LabVIEW from trained->w (models kept behind a handle are sparsified by the caller)
+	native->view = *native->trained;
+	return native;
+}
+
+LVlinear_job::LVlinear_job(const LVlinear_problem &prob_in, const LVlinear_parameter &param_in, int32_t nr_fold) : nr_fold(nr_fold), prob(), param(){
+	size_t l = LVCheckProblem(prob_in, (nr_fold == 0) ? "liblinear_train_async" : "liblinear_cross_validation_async");
+
+	// Input verification: Problem dimensions
+	if (prob_in.y == nullptr || (*(prob_in.y))->dimSize != l)
+		throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and feature vectors (x and y).");
+
+	// Input validation: Number of feature vectors too large (exceeds max signed int)
+	if (l > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Number of feature vectors too large (greater than " + std::to_string(INT_MAX) + ")");
+
+	y.assign((*(prob_in.y))->elt, (*(prob_in.y))->elt + l);
+
+	// The vectors (including the bias feature and the terminators) are copied into a single block
+	size_t n_nodes = 0;
+	for (size_t i = 0; i < l; i++)
+		n_nodes += (*(*(prob_in.x))->elt[i])->dimSize;
+
+	nodes.resize(n_nodes);
+	x.resize(l);
+	feature_node *next = nodes.data();
+	for (size_t i = 0; i < l; i++){
+		auto xi_in_Hdl = (*(prob_in.x))->elt[i];
+		const feature_node *xi = reinterpret_cast<const feature_node*>((*xi_in_Hdl)->elt);
+		x[i] = next;
+		next = std::copy(xi, xi + (*xi_in_Hdl)->dimSize, next);
+	}
+
+	// The largest index (including the bias feature) is the number of features
+	prob.l = static_cast<int>(l);
+	prob.y = y.data();
+	prob.x = x.data();
+	prob.n = 0;
+	prob.bias = prob_in.bias;
+	for (const feature_node &node : nodes)
+		prob.n = std::max(prob.n, node.index);
+
+	LVConvertParameter(param_in, param);
+	if (param.nr_weight > 0){
+		weight_label.assign(param.weight_label, param.weight_label + param.nr_weight);
+		weight.assign(param.weight, param.weight + param.nr_weight);
+		param.weight_label = weight_label.data();
+		param.weight = weight.data();
+	}
+
+	const char * param_check = check_parameter(&prob, &param);
+	if (param_check != nullptr)
+		throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check));
+}
+
+void LVlinear_job::run(){
+	// The print function counts the iterations of the library solvers into the budgets (the job runs under the stop condition of its token)
+	LVInstallPrintFunction(set_print_string_function, LVlinear_print_function);
+
+	if (nr_fold == 0){
+		model = LVTrainNativeModel(prob, param, 1);
+	}
+	else{
+		target.resize(y.size());
+		LVCrossValidate(prob, param, nr_fold, target.data());
+	}
+}
+
+std::shared_ptr<LVlinear_job> LVCollectJob(uint64_t job, bool crossValidation){
+	auto collected = std::dynamic_pointer_cast<LVlinear_job>(LVJobQueue::instance().get(job));
+	if (!collected || (collected->nr_fold != 0) != crossValidation)
+		throw LVException(__FILE__, __LINE__, std::string("The job is not a ") + (crossValidation ? "cross-validation" : "training") + " job.");
+
+	// The job is released whether it succeeded or not
+	LVJobQueue::instance().release(job);
+	collected->join();
+	return collected;
+}
+
+std::shared_ptr<const LVCancellationToken> LVGetCancellationToken(uint64_t token){
+	if (token == 0)
+		return nullptr;
+
+	return tokenHandles.get(token);
+}
+
+void LVSparsifyModel(LVlinear_native_model &native){
+	const model &view = native.view;
+	if (view.w == nullptr)
+		return;
+
+	size_t n = static_cast<size_t>(view.nr_feature) + (view.bias >= 0 ? 1 : 0);
+	size_t nr_w = LVGetNrWeightVectors(view);
+	const double *w = view.w;
+
+	std::vector<size_t> nnz(nr_w, 0);
+	for (size_t j = 0; j < n; j++){
+		for (size_t k = 0; k < nr_w; k++){
+			if (w[j * nr_w + k] != 0)
+				nnz[k]++;
+		}
+	}
+
+	size_t total = std::accumulate(nnz.begin(), nnz.end(), size_t(0));
+	if (static_cast<double>(total) > LVLinearSparseMaxDensity * static_cast<double>(n * nr_w))
+		return;
+
+	// Compressed by weight vector, the features of every vector are visited in ascending order
+	auto sparse = std::make_unique<LVlinear_sparse_weights>();
+	sparse->start.assign(nr_w + 1, 0);
+	for (size_t k = 0; k < nr_w; k++)
+		sparse->start[k + 1] = sparse->start[k] + nnz[k];
+	sparse->index.resize(total);
+	sparse->value.resize(total);
+
+	std::vector<size_t> position(sparse->start.begin(), sparse->start.end() - 1);
+	for (size_t j = 0; j < n; j++){
+		for (size_t k = 0; k < nr_w; k++){
+			double value = w[j * nr_w + k];
+			if (value != 0){
+				sparse->index[position[k]] = static_cast<int32_t>(j + 1);
+				sparse->value[position[k]] = value;
+				position[k]++;
+			}
+		}
+	}
+
+	// The dense weights are no longer used (the pages of a mapped binary model are left to the file cache)
+	native.sparse = std::move(sparse);
+	native.view.w = nullptr;
+	native.w.reset();
+	std::vector<double>().swap(native.text.w);
+	if (native.trained != nullptr){
+		free(native.trained->w);
+		native.trained->w = nullptr;
+	}
+}
+
+double LVPredictValues(const LVlinear_native_model &native, const feature_node *x, double *dec_values){
+	if (native.sparse == nullptr)
+		return predict_values(&native.view, x, dec_values);
+
+	// As liblinear's predict_values, with one lookup in the nonzero weights of every vector per input feature
+	const model &view = native.view;
+	const LVlinear_sparse_weights &sparse = *native.sparse;
+	int n = view.nr_feature + (view.bias >= 0 ? 1 : 0);
+	int nr_w = LVGetNrWeightVectors(view);
+
+	for (int k = 0; k < nr_w; k++){
+		const int32_t *begin = sparse.index.data() + sparse.start[k];
+		const int32_t *end = sparse.index.data() + sparse.start[k + 1];
+		const int32_t *pos = begin;
+		int previous = 0;
+		double sum = 0;
+
+		for (const feature_node *node = x; node->index != -1; node++){
+			// The dimension of testing data may exceed that of training
+			if (node->index > n)
+				continue;
+
+			// Inputs are expected in ascending order, the search restarts otherwise
+			if (node->index <= previous)
+				pos = begin;
+			previous = node->index;
+
+			pos = std::lower_bound(pos, end, node->index);
+			if (pos != end && *pos == node->index)
+				sum += sparse.value[pos - sparse.index.data()] * node->value;
+		}
+
+		dec_values[k] = sum;
+	}
+
+	return LVDecisionLabel(view, dec_values);
+}
+
+double LVPredict(const LVlinear_native_model &native, const feature_node *x){
+	if (native.sparse == nullptr)
+		return predict(&native.view, x);
+
+	std::vector<double> dec_values(static_cast<size_t>(std::max(native.view.nr_class, 1)));
+	return LVPredictValues(native, x, dec_values.data());
+}
+
+double LVPredictProbability(const LVlinear_native_model &native, const feature_node *x, double *prob_estimates){
+	if (native.sparse == nullptr)
+		return predict_probability(&native.view, x, prob_estimates);
+
+	// As liblinear's predict_probability
+	if (!check_probability_model(&native.view))
+		return 0;
+
+	double label = LVPredictValues(native, x, prob_estimates);
+	LVProbabilityEstimates(native.view, prob_estimates);
+	return label;
+}
+
+double LVDecisionLabel(const model &model_in, const double *dec_values){
+	if (model_in.nr_class == 2){
+		if (check_regression_model(&model_in))
+			return dec_values[0];
+		else
+			return (dec_values[0] > 0) ? model_in.label[0] : model_in.label[1];
+	}
+	else{
+		int dec_max_idx = 0;
+		for (int k = 1; k < model_in.nr_class; k++){
+			if (dec_values[k] > dec_values[dec_max_idx])
+				dec_max_idx = k;
+		}
+		return model_in.label[dec_max_idx];
+	}
+}
+
+void LVProbabilityEstimates(const model &model_in, double *prob_estimates){
+	int nr_class = model_in.nr_class;
+	int nr_w = (nr_class == 2) ? 1 : nr_class;
+
+	for (int k = 0; k < nr_w; k++)
+		prob_estimates[k] = 1 / (1 + std::exp(-prob_estimates[k]));
+
+	if (nr_class == 2)
+		prob_estimates[1] = 1. - prob_estimates[0];
+	else{
+		double sum = 0;
+		for (int k = 0; k < nr_class; k++)
+			sum += prob_estimates[k];
+		for (int k = 0; k < nr_class; k++)
+			prob_estimates[k] = prob_estimates[k] / sum;
+	}
+}
+
+model * LVTrainOneVsRest(const problem &prob, const parameter &param, size_t n_threads){
+	if (LVIsRegressionSolver(param.solver_type) || param.solver_type == MCSVM_CS)
+		return train(&prob, &param);
+
+	size_t l = static_cast<size_t>(prob.l);
+	std::vector<size_t> class_index;
+	std::vector<int> labels = LVClassLabels(prob, class_index);
+
+	size_t nr_class = labels.size();
+	if (nr_class <= 2)
+		return train(&prob, &param);
+
+	// Cost of the positive class of every binary problem (the negative vectors keep C)
+	std::vector<double> weight(nr_class, 1.0);
+	for (int k = 0; k < param.nr_weight; k++){
+		auto match = std::find(labels.begin(), labels.end(), param.weight_label[k]);
+		if (match != labels.end())
+			weight[match - labels.begin()] = param.weight[k];
+	}
+
+	// The vectors grouped by class in order of first occurrence, as train() passes them to the binary solvers
+	std::vector<size_t> start(nr_class + 1, 0);
+	for (size_t i = 0; i < l; i++)
+		start[class_index[i] + 1]++;
+	for (size_t c = 0; c < nr_class; c++)
+		start[c + 1] += start[c];
+
+	std::vector<feature_node*> grouped_x(l);
+	std::vector<size_t> position(start.begin(), start.end() - 1);
+	for (size_t i = 0; i < l; i++)
+		grouped_x[position[class_index[i]]++] = prob.x[i];
+
+	size_t n = static_cast<size_t>(prob.n);
+	std::unique_ptr<model, LVlinear_model_deleter> result(LVAllocateModel(prob, param, labels, nr_class));
+	double *w = result->w;
+
+	// One pool task per class (the classes are claimed one at a time, as their solve times differ), training yields to predictions between classes
+	LVThreadPool::instance().parallelFor(nr_class, [&](size_t c){
+		std::vector<double> y(l, -1.0);
+		std::fill(y.begin() + start[c], y.begin() + start[c + 1], +1.0);
+
+		problem sub_prob = prob;
+		sub_prob.x = grouped_x.data();
+		sub_prob.y = y.data();
+
+		int positive_label = +1;
+		double positive_weight = weight[c];
+		parameter sub_param = param;
+		sub_param.nr_weight = 1;
+		sub_param.weight_label = &positive_label;
+		sub_param.weight = &positive_weight;
+
+		std::vector<double> init_sol;
+		if (param.init_sol != nullptr){
+			init_sol.resize(n);
+			for (size_t j = 0; j < n; j++)
+				init_sol[j] = param.init_sol[j * nr_class + c];
+			sub_param.init_sol = init_sol.data();
+		}
+
+		std::unique_ptr<model, LVlinear_model_deleter> binary(train(&sub_prob, &sub_param));
+
+		// The weight vector belongs to the first class of the binary model, which is +1
+		double sign = (binary->label[0] == +1) ? 1.0 : -1.0;
+		for (size_t j = 0; j < n; j++)
+			w[j * nr_class + c] = sign * binary->w[j];
+	}, LVWorkPriority::Throughput, n_threads);
+
+	return result.release();
+}
+
+model * LVTrainParallel(const problem &prob, const parameter &param, size_t n_threads){
+	// The primal solvers (TRON) are serial, their problems have the same optimum as those of the corresponding dual solvers.
+	// Without warm start (the dual solvers cannot start from given weights) their binary problems are solved by the dual coordinate descent as well
+	int dual_solver = param.solver_type;
+	if (param.init_sol == nullptr && param.solver_type == L2R_LR)
+		dual_solver = L2R_LR_DUAL;
+	else if (param.init_sol == nullptr && param.solver_type == L2R_L2LOSS_SVC)
+		dual_solver = L2R_L2LOSS_SVC_DUAL;
+
+	if (dual_solver == L2R_L2LOSS_SVC_DUAL || dual_solver == L2R_L1LOSS_SVC_DUAL || dual_solver == L2R_LR_DUAL){
+		std::vector<size_t> class_index;
+		std::vector<int> labels = LVClassLabels(prob, class_index);
+
+		if (labels.size() == 2){
+			// The positive class is +1 if the labels are -1 and +1 (as train)
+			if (labels[0] == -1 && labels[1] == +1)
+				std::swap(labels[0], labels[1]);
+
+			parameter dual_param = param;
+			dual_param.solver_type = dual_solver;
+			model *result = LVTrainDual(prob, dual_param, labels, n_threads);
+
+			// The model keeps the solver it was trained for
+			result->param.solver_type = param.solver_type;
+			return result;
+		}
+	}
+
+	return LVTrainOneVsRest(prob, param, n_threads);
+}
+
+model * LVTrainDual(const problem &prob, const parameter &param, const std::vector<int> &labels, size_t n_threads){
+	size_t l = static_cast<size_t>(prob.l);
+
+	// Cost of both classes
+	double weight[2] = { 1.0, 1.0 };
+	for (int k = 0; k < param.nr_weight; k++){
+		for (size_t c = 0; c < 2; c++){
+			if (param.weight_label[k] == labels[c])
+				weight[c] = param.weight[k];
+		}
+	}
+
+	std::vector<double> y(l);
+	for (size_t i = 0; i < l; i++)
+		y[i] = (static_cast<int>(prob.y[i]) == labels[0]) ? +1.0 : -1.0;
+
+	LVDualParameter dual_param;
+	dual_param.loss = (param.solver_type == L2R_LR_DUAL) ? LVDualLoss::Logistic : (param.solver_type == L2R_L1LOSS_SVC_DUAL) ? LVDualLoss::L1Hinge : LVDualLoss::L2Hinge;
+	dual_param.Cp = param.C * weight[0];
+	dual_param.Cn = param.C * weight[1];
+	dual_param.eps = param.eps;
+	dual_param.maxIter = 1000;
+	dual_param.nThreads = n_threads;
+
+	std::unique_ptr<model, LVlinear_model_deleter> result(LVAllocateModel(prob, param, labels, 1));
+	size_t iter = LVSolveDual(prob.x, y.data(), l, static_cast<size_t>(prob.n), dual_param, result->w);
+
+	if (iter >= dual_param.maxIter)
+		LVlinear_print_function("\nWARNING: reaching max number of iterations\nUsing -s 2 may be faster (also see FAQ)\n\n");
+
+	return result.release();
+}
+
+std::vector<int> LVClassLabels(const problem &prob, std::vector<size_t> &class_index){
+	size_t l = static_cast<size_t>(prob.l);
+	std::vector<int> labels;
+	class_index.resize(l);
+	for (size_t i = 0; i < l; i++){
+		int label = static_cast<int>(prob.y[i]);
+		size_t c = static_cast<size_t>(std::find(labels.begin(), labels.end(), label) - labels.begin());
+		if (c == labels.size())
+			labels.push_back(label);
+		class_index[i] = c;
+	}
+
+	return labels;
+}
+
+model * LVAllocateModel(const problem &prob, const parameter &param, const std::vector<int> &labels, size_t nr_w){
+	size_t n = static_cast<size_t>(prob.n);
+	double *w = static_cast<double*>(malloc(n * nr_w * sizeof(double)));
+	int *label = static_cast<int*>(malloc(labels.size() * sizeof(int)));
+	model *result = static_cast<model*>(malloc(sizeof(model)));
+	if (w == nullptr || label == nullptr || result == nullptr){
+		free(w);
+		free(label);
+		free(result);
+		throw std::bad_alloc();
+	}
+
+	std::copy(labels.begin(), labels.end(), label);
+	result->param = param;
+	result->nr_class = static_cast<int>(labels.size());
+	result->nr_feature = (prob.bias >= 0) ? prob.n - 1 : prob.n;
+	result->bias = prob.bias;
+	result->label = label;
+	result->w = w;
+	return result;
+}
+
+bool LVIsRegressionSolver(int solver_type){
+	return solver_type == L2R_L2LOSS_SVR || solver_type == L2R_L2LOSS_SVR_DUAL || solver_type == L2R_L1LOSS_SVR_DUAL;
+}
+
+model * LVTrain(const problem &prob, const parameter &param){
+	// The library trains the classes in one call, which cannot be stopped
+	if (LVStopCondition::current() == nullptr)
+		return train(&prob, &param);
+
+	return LVTrainOneVsRest(prob, param, 1);
+}
+
+void LVCrossValidate(const problem &prob, const parameter &param, int nr_fold, double *target){
+	// The library's cross-validation cannot be stopped between its folds
+	if (LVStopCondition::current() == nullptr){
+		cross_validation(&prob, &param, nr_fold, target);
+		return;
+	}
+
+	if (nr_fold < 2)
+		throw LVException(__FILE__, __LINE__, "The number of folds must be at least 2.");
+
+	size_t l = static_cast<size_t>(prob.l);
+	size_t n_folds = std::min(static_cast<size_t>(nr_fold), l);
+
+	// Random folds, as liblinear's cross validation
+	std::vector<int> perm(l);
+	for (size_t i = 0; i < l; i++)
+		perm[i] = static_cast<int>(i);
+	for (size_t i = 0; i < l; i++){
+		size_t j = i + static_cast<size_t>(rand()) % (l - i);
+		std::swap(perm[i], perm[j]);
+	}
+
+	std::vector<size_t> fold_start(n_folds + 1);
+	for (size_t f = 0; f <= n_folds; f++)
+		fold_start[f] = f * l / n_folds;
+
+	// One pool task per fold, the checkpoints of the tasks stop the run between folds.
+	// At most half the folds run at once, so that every thread tests the stop condition between two of its folds
+	size_t max_threads = std::max<size_t>(1, n_folds / 2);
+	LVThreadPool::instance().parallelFor(n_folds, [&](size_t f){
+		// Training problem of the other folds, referencing the input vectors
+		std::vector<feature_node*> sub_x;
+		std::vector<double> sub_y;
+		for (size_t k = 0; k < l; k++){
+			if (k < fold_start[f] || k >= fold_start[f + 1]){
+				sub_x.push_back(prob.x[perm[k]]);
+				sub_y.push_back(prob.y[perm[k]]);
+			}
+		}
+
+		problem sub_prob = prob;
+		sub_prob.l = static_cast<int>(sub_x.size());
+		sub_prob.x = sub_x.data();
+		sub_prob.y = sub_y.data();
+
+		std::unique_ptr<model, LVlinear_model_deleter> submodel(LVTrain(sub_prob, param));
+		for (size_t k = fold_start[f]; k < fold_start[f + 1]; k++)
+			target[perm[k]] = predict(submodel.get(), prob.x[perm[k]]);
+	}, LVWorkPriority::Throughput, max_threads);
+
+	// The last folds may have exceeded the budgets
+	LVCheckpoint();
+}
+
+size_t LVFindParameterC(const LVlinear_problem &prob_in, const LVlinear_parameter &param_in, int nr_fold, double start_C, double max_C, std::shared_ptr<const LVCancellationToken> token, std::vector<double> &C_out, std::vector<double> &score_out, std::unique_ptr<LVStopped> &stopped_out){
+	size_t l = LVCheckProblem(prob_in, "LVlinear_find_parameter_C");
+
+	if (prob_in.y == nullptr || (*(prob_in.y))->dimSize != l)
+		throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and feature vectors (x and y).");
+
+	if (l > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Number of feature vectors too large (greater than " + std::to_string(INT_MAX) + ")");
+
+	if (nr_fold < 2)
+		throw LVException(__FILE__, __LINE__, "The number of folds must be at least 2.");
+
+	// As liblinear, leave-one-out if there are more folds than vectors
+	size_t n_folds = std::min(static_cast<size_t>(nr_fold), l);
+
+	problem prob;
+	prob.l = static_cast<int>(l);
+	prob.y = (*(prob_in.y))->elt;
+	prob.n = 0;
+	prob.bias = prob_in.bias;
+
+	// The largest index (including the bias feature) is the number of features, the largest squared norm determines the smallest useful C
+	auto x = std::make_unique<feature_node*[]>(l);
+	prob.x = x.get();
+	double max_xTx = 0;
+	for (size_t i = 0; i < l; i++){
+		x[i] = reinterpret_cast<feature_node*>((*(*(prob_in.x))->elt[i])->elt);
+		double xTx = 0;
+		for (const feature_node *node = x[i]; node->index != -1; node++){
+			prob.n = std::max(prob.n, node->index);
+			xTx += node->value * node->value;
+		}
+		max_xTx = std::max(max_xTx, xTx);
+	}
+
+	parameter param = parameter();
+	LVConvertParameter(param_in, param);
+
+	const char * param_check = check_parameter(&prob, &param);
+	if (param_check != nullptr)
+		throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check));
+
+	bool warm_start = param.solver_type == L2R_LR || param.solver_type == L2R_L2LOSS_SVC;
+	bool regression = LVIsRegressionSolver(param.solver_type);
+
+	// Start of the path as liblinear's calc_start_C, rounded down to a power of two
+	if (!(start_C > 0)){
+		double min_C = 1.0;
+		if (max_xTx > 0 && param.solver_type == L2R_LR)
+			min_C = 1.0 / (static_cast<double>(l) * max_xTx);
+		else if (max_xTx > 0 && param.solver_type == L2R_L2LOSS_SVC)
+			min_C = 1.0 / (2 * static_cast<double>(l) * max_xTx);
+		start_C = std::pow(2.0, std::floor(std::log2(min_C)));
+	}
+
+	if (!(max_C > 0))
+		max_C = 1024;
+
+	if (start_C > max_C)
+		throw LVException(__FILE__, __LINE__, "The start of the C path (" + std::to_string(start_C) + ") exceeds its end (" + std::to_string(max_C) + ").");
+
+	// Random folds, as liblinear's cross validation
+	std::vector<int> perm(l);
+	for (size_t i = 0; i < l; i++)
+		perm[i] = static_cast<int>(i);
+	for (size_t i = 0; i < l; i++){
+		size_t j = i + static_cast<size_t>(rand()) % (l - i);
+		std::swap(perm[i], perm[j]);
+	}
+
+	std::vector<size_t> fold_start(n_folds + 1);
+	for (size_t f = 0; f <= n_folds; f++)
+		fold_start[f] = f * l / n_folds;
+
+	// Training problem of every fold (the vectors outside the fold), referencing the input vectors
+	std::vector<std::vector<feature_node*>> sub_x(n_folds);
+	std::vector<std::vector<double>> sub_y(n_folds);
+	std::vector<problem> sub_prob(n_folds);
+	for (size_t f = 0; f < n_folds; f++){
+		for (size_t k = 0; k < l; k++){
+			if (k < fold_start[f] || k >= fold_start[f + 1]){
+				sub_x[f].push_back(x[perm[k]]);
+				sub_y[f].push_back(prob.y[perm[k]]);
+			}
+		}
+		sub_prob[f] = prob;
+		sub_prob[f].l = static_cast<int>(sub_x[f].size());
+		sub_prob[f].x = sub_x[f].data();
+		sub_prob[f].y = sub_y[f].data();
+	}
+
+	// Weights of every fold at the previous C
+	std::vector<std::vector<double>> prev_w(n_folds);
+	std::vector<char> changed(n_folds);
+	std::vector<double> target(l);
+	size_t n_unchanged = 0;
+	size_t best = 0;
+
+	// Every fold and C value is posted to the progress event of the token, gamma does not apply
+	LVProgressReporter progress(token);
+	const double no_gamma = std::numeric_limits<double>::quiet_NaN();
+
+	C_out.clear();
+	score_out.clear();
+	for (double C = start_C; C <= max_C; C *= 2){
+		// Every C value has the budgets of the token, the search ends with the results so far when one is stopped (the first C value is required)
+		LVStopCondition stop(token);
+		LVStopScope scope(&stop);
+
+		// One pool task per fold, the search yields to predictions between folds
+		try{
+			LVThreadPool::instance().parallelFor(n_folds, [&](size_t f){
+				parameter fold_param = param;
+				fold_param.C = C;
+				if (warm_start && !prev_w[f].empty())
+					fold_param.init_sol = prev_w[f].data();
+
+				std::unique_ptr<model, LVlinear_model_deleter> submodel(train(&sub_prob[f], &fold_param));
+
+				size_t w_size = static_cast<size_t>(submodel->nr_feature) + ((submodel->bias >= 0) ? 1 : 0);
+				size_t total_w_size = w_size * static_cast<size_t>(LVGetNrWeightVectors(*submodel));
+				std::vector<double> w(submodel->w, submodel->w + total_w_size);
+
+				// The first C is compared against zero weights
+				if (prev_w[f].empty())
+					prev_w[f].assign(total_w_size, 0.0);
+
+				double norm_w_diff = 0;
+				if (prev_w[f].size() == total_w_size){
+					for (size_t j = 0; j < total_w_size; j++)
+						norm_w_diff += (w[j] - prev_w[f][j]) * (w[j] - prev_w[f][j]);
+				}
+				changed[f] = prev_w[f].size() != total_w_size || std::sqrt(norm_w_diff) > 1e-15;
+				prev_w[f].swap(w);
+
+				double fold_score = 0;
+				for (size_t k = fold_start[f]; k < fold_start[f + 1]; k++){
+					double predicted = predict(submodel.get(), x[perm[k]]);
+					target[perm[k]] = predicted;
+					if (regression)
+						fold_score += (predicted - prob.y[perm[k]]) * (predicted - prob.y[perm[k]]);
+					else if (predicted == prob.y[perm[k]])
+						fold_score++;
+				}
+				progress.fold(C_out.size(), f, C, no_gamma, fold_score / static_cast<double>(fold_start[f + 1] - fold_start[f]));
+			}, LVWorkPriority::Throughput);
+		}
+		catch (LVStopped &ex){
+			if (C_out.empty())
+				throw;
+
+			stopped_out.reset(new LVStopped(ex));
+			break;
+		}
+
+		// Accuracy (classification) or mean squared error (regression) of all folds
+		double score = 0;
+		for (size_t i = 0; i < l; i++){
+			if (regression)
+				score += (target[i] - prob.y[i]) * (target[i] - prob.y[i]);
+			else if (target[i] == prob.y[i])
+				score++;
+		}
+		score /= static_cast<double>(l);
+
+		// Ties keep the smaller C
+		if (score_out.empty() || (regression ? score < score_out[best] : score > score_out[best]))
+			best = score_out.size();
+		C_out.push_back(C);
+		score_out.push_back(score);
+		progress.point(C_out.size() - 1, C, no_gamma, score);
+
+		// Stop when the weights of no fold changed for three consecutive C, as liblinear
+		if (std::find(changed.begin(), changed.end(), 1) != changed.end())
+			n_unchanged = 0;
+		else if (++n_unchanged == 3)
+			break;
+	}
+
+	return best;
+}
+
+std::vector<double> LVWarmStartSolution(const problem &prob, const parameter &param, const LVlinear_model &init_model){
+	std::vector<double> init_sol;
+	if (init_model.w == nullptr || (*(init_model.w))->dimSize == 0)
+		return init_sol;
+
+	bool regression = LVIsRegressionSolver(param.solver_type);
+
+	if (regression != LVIsRegressionSolver(init_model.param.solver_type))
+		throw LVException(__FILE__, __LINE__, "The initial model of the warm start must be " + std::string(regression ? "a regression" : "a classification") + " model, as the solver.");
+
+	if ((init_model.bias >= 0) != (prob.bias >= 0))
+		throw LVException(__FILE__, __LINE__, "The initial model of the warm start and the problem must either both have a bias feature or neither.");
+
+	// Classes in the order train() assigns them: by first occurrence, with +1 first if the labels are -1 and +1
+	std::vector<int32_t> labels;
+	if (!regression){
+		for (int i = 0; i < prob.l; i++){
+			int32_t label = static_cast<int32_t>(prob.y[i]);
+			if (std::find(labels.begin(), labels.end(), label) == labels.end())
+				labels.push_back(label);
+		}
+
+		if (labels.size() == 2 && labels[0] == -1 && labels[1] == +1)
+			std::swap(labels[0], labels[1]);
 	}
 
-	// n is equal to nr_feature, incremented if bias is present
-	int n = nr_feature;
-	if (model_in.bias >= 0)
+	size_t nr_class = regression ? 2 : labels.size();
+	size_t nr_w = (regression || (nr_class == 2 && param.solver_type != MCSVM_CS)) ? 1 : nr_class;
+
+	if (init_model.nr_class < 1 || init_model.nr_feature < 0)
+		throw LVException(__FILE__, __LINE__, "Invalid initial model passed to the warm start.");
+
+	size_t init_nr_class = static_cast<size_t>(init_model.nr_class);
+	size_t init_nr_w = (LVIsRegressionSolver(init_model.param.solver_type) || (init_nr_class == 2 && init_model.param.solver_type != MCSVM_CS)) ? 1 : init_nr_class;
+	size_t init_n = static_cast<size_t>(init_model.nr_feature) + ((init_model.bias >= 0) ? 1 : 0);
+
+	if ((*(init_model.w))->dimSize != init_n * init_nr_w)
+		throw LVException(__FILE__, __LINE__, "The number of weights of the initial model (" + std::to_string((*(init_model.w))->dimSize) + ") does not match its number of features and classes (" + std::to_string(init_n * init_nr_w) + ").");
+
+	// Weight vector of init_model used for every weight vector of the new model, and its sign
+	// (a binary model has a single weight vector for the first class, which is negated if the class order is reversed)
+	std::vector<size_t> source(nr_w, 0);
+	std::vector<double> sign(nr_w, 1.0);
+	if (!regression){
+		if (init_model.label == nullptr || (*(init_model.label))->dimSize != init_nr_class || init_nr_class != nr_class || init_nr_w != nr_w)
+			throw LVException(__FILE__, __LINE__, "The initial model of the warm start has " + std::to_string(init_nr_class) + " classes, the problem has " + std::to_string(nr_class) + ".");
+
+		const int32_t *init_labels = (*(init_model.label))->elt;
+		std::vector<size_t> position(nr_class);
+		for (size_t c = 0; c < nr_class; c++){
+			const int32_t *match = std::find(init_labels, init_labels + nr_class, labels[c]);
+			if (match == init_labels + nr_class)
+				throw LVException(__FILE__, __LINE__, "The problem has the class " + std::to_string(labels[c]) + ", which is not a class of the initial model of the warm start.");
+			position[c] = static_cast<size_t>(match - init_labels);
+		}
+
+		if (nr_w == 1)
+			sign[0] = (position[0] == 0) ? 1.0 : -1.0;
+		else
+			source = position;
+	}
+
+	// Features present in both are copied, new features start at zero and the bias weight is the last row of both
+	size_t n = static_cast<size_t>(prob.n);
+	size_t nr_feature = (prob.bias >= 0) ? n - 1 : n;
+	size_t n_common = std::min(nr_feature, static_cast<size_t>(init_model.nr_feature));
+	const double *w = (*(init_model.w))->elt;
+
+	init_sol.assign(n * nr_w, 0.0);
+	for (size_t j = 0; j < n_common; j++){
+		for (size_t k = 0; k < nr_w; k++)
+			init_sol[j * nr_w + k] = sign[k] * w[j * init_nr_w + source[k]];
+	}
+
+	if (prob.bias >= 0){
+		for (size_t k = 0; k < nr_w; k++)
+			init_sol[nr_feature * nr_w + k] = sign[k] * w[static_cast<size_t>(init_model.nr_feature) * init_nr_w + source[k]];
+	}
+
+	return init_sol;
+}
+
+std::vector<int32_t> LVRecursiveFeatureElimination(const LVlinear_problem &prob_in, const LVlinear_parameter &param_in, size_t n_select, double step){
+	size_t l = LVCheckProblemSize(prob_in.y, prob_in.x);
+	bool has_bias = prob_in.bias >= 0;
+	size_t n_excluded = has_bias ? 2 : 1;
+	int32_t max_index = LVSparseMaxIndex(prob_in.x, has_bias);
+	LVArray_Hdl<LVlinear_node> *x_in = (*(prob_in.x))->elt;
+
+	// The bias feature keeps its index, the number of features is the largest index including it
+	problem prob;
+	prob.l = static_cast<int>(l);
+	prob.y = (*(prob_in.y))->elt;
+	prob.bias = prob_in.bias;
+	prob.n = max_index;
+	if (has_bias){
+		for (size_t i = 0; i < l; i++)
+			prob.n = std::max(prob.n, (*x_in[i])->elt[(*x_in[i])->dimSize - 2].index);
+	}
+
+	parameter param = parameter();
+	LVConvertParameter(param_in, param);
+
+	// Remaining features (all indices up to the largest) and the eliminated ones (worst first)
+	std::vector<int32_t> active;
+	for (int32_t j = 1; j <= max_index; j++)
+		active.push_back(j);
+	std::vector<int32_t> eliminated;
+
+	std::vector<char> mask(static_cast<size_t>(max_index) + 1, 1);
+	std::vector<size_t> offset(l + 1);
+	std::vector<feature_node> nodes;
+	auto x = std::make_unique<feature_node*[]>(l);
+	prob.x = x.get();
+	size_t nThreads = LVThreadCount(l, 1024);
+
+	while (true){
+		// Restricted problem: the nodes of the remaining features, the bias feature and the terminator
+		LVParallelFor(nThreads, [&](size_t t){
+			for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++){
+				const LVlinear_node *xi = (*x_in[i])->elt;
+				size_t n = (*x_in[i])->dimSize - n_excluded;
+				offset[i + 1] = n_excluded + static_cast<size_t>(std::count_if(xi, xi + n, [&](const LVlinear_node &node){ return mask[node.index] != 0; }));
+			}
+		});
+		for (size_t i = 0; i < l; i++)
+			offset[i + 1] += offset[i];
+
+		nodes.resize(offset[l]);
+		LVParallelFor(nThreads, [&](size_t t){
+			for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++){
+				const LVlinear_node *xi = (*x_in[i])->elt;
+				size_t n = (*x_in[i])->dimSize - n_excluded;
+				feature_node *node = &nodes[offset[i]];
+				x[i] = node;
+				for (size_t k = 0; k < n + n_excluded; k++){
+					if (k >= n || mask[xi[k].index] != 0){
+						node->index = xi[k].index;
+						node->value = xi[k].value;
+						node++;
+					}
+				}
+			}
+		});
+
+		if (active.size() == static_cast<size_t>(max_index)){
+			const char * param_check = check_parameter(&prob, &param);
+			if (param_check != nullptr)
+				throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check));
+		}
+
+		std::unique_ptr<model, LVlinear_model_deleter> trained(train(&prob, &param));
+
+		// Importance of a feature is the sum of its squared weights over all weight vectors
+		int nr_w = LVGetNrWeightVectors(*trained);
+		std::vector<double> score(static_cast<size_t>(max_index) + 1, 0.0);
+		for (int32_t j : active){
+			for (int k = 0; k < nr_w; k++){
+				double w = trained->w[static_cast<size_t>(j - 1) * nr_w + k];
+				score[j] += w * w;
+			}
+		}
+
+		// Worst first, ties in descending index order so that the ranking stays stable
+		std::sort(active.begin(), active.end(), [&score](int32_t a, int32_t b){
+			return (score[a] != score[b]) ? score[a] < score[b] : a > b;
+		});
+
+		if (active.size() <= n_select)
+			break;
+
+		size_t n_remove = (step >= 1) ? static_cast<size_t>(step) : static_cast<size_t>(step * static_cast<double>(active.size()));
+		n_remove = std::min(std::max<size_t>(n_remove, 1), active.size() - n_select);
+
+		for (size_t k = 0; k < n_remove; k++){
+			mask[active[k]] = 0;
+			eliminated.push_back(active[k]);
+		}
+		active.erase(active.begin(), active.begin() + n_remove);
+	}
+
+	// Best first: the remaining features by their last weights, then the eliminated ones in reverse order of elimination
+	std::vector<int32_t> ranking(active.rbegin(), active.rend());
+	ranking.insert(ranking.end(), eliminated.rbegin(), eliminated.rend());
+	return ranking;
+}
+
+int LVGetNrDecisionValues(const model &model_in){
+	if (model_in.nr_class <= 2){
+		if (model_in.param.solver_type == MCSVM_CS)
+			return 2;
+		else
+			return 1;
+	}
+	else {
+		return model_in.nr_class;
+	}
+}
+
+//
+//-- Text model helpers
+//
+
+// Keywords of the liblinear text format (indexed by solver_type)
+static const char *LVlinear_solver_type_table[] = {
+	"L2R_LR", "L2R_L2LOSS_SVC_DUAL", "L2R_L2LOSS_SVC", "L2R_L1LOSS_SVC_DUAL", "MCSVM_CS",
+	"L1R_L2LOSS_SVC", "L1R_LR", "L2R_LR_DUAL",
+	"", "", "",
+	"L2R_L2LOSS_SVR", "L2R_L2LOSS_SVR_DUAL", "L2R_L1LOSS_SVR_DUAL", nullptr
+};
+
+static const int LVlinear_solver_type_count = sizeof(LVlinear_solver_type_table) / sizeof(LVlinear_solver_type_table[0]) - 1;
+
+std::vector<std::string> LVFormatTextModel(const model &model_in, bool roundTrip){
+	int solver_type = model_in.param.solver_type;
+	if (solver_type < 0 || solver_type >= LVlinear_solver_type_count || LVlinear_solver_type_table[solver_type][0] == '\0')
+		throw LVException(__FILE__, __LINE__, "The model has an invalid solver_type.");
+
+	if (model_in.w == nullptr || model_in.nr_feature < 0 || model_in.nr_class < 1)
+		throw LVException(__FILE__, __LINE__, "Uninitialized model passed to LVFormatTextModel.");
+
+	int nr_class = model_in.nr_class;
+	size_t n = static_cast<size_t>(model_in.nr_feature) + (model_in.bias >= 0 ? 1 : 0);
+	size_t nr_w = LVGetNrWeightVectors(model_in);
+
+	std::vector<std::string> parts;
+
+	// Header (the formats match save_model in liblinear 2.11)
+	LVTextWriter header;
+	header.put("solver_type ");
+	header.put(LVlinear_solver_type_table[solver_type]);
+	header.put("\nnr_class ");
+	header.putInt(nr_class);
+	header.put('\n');
+
+	if (model_in.label != nullptr){
+		header.put("label");
+		for (int i = 0; i < nr_class; i++){
+			header.put(' ');
+			header.putInt(model_in.label[i]);
+		}
+		header.put('\n');
+	}
+
+	header.put("nr_feature ");
+	header.putInt(model_in.nr_feature);
+	header.put("\nbias ");
+	header.putDouble(model_in.bias, 16, roundTrip);
+	header.put("\nw\n");
+	parts.push_back(std::move(header.str()));
+
+	// Weights (one line per feature), each thread formats a contiguous range of lines into its own part
+	size_t nThreads = LVThreadCount(n * nr_w, 4096);
+	size_t firstPart = parts.size();
+	parts.resize(firstPart + nThreads);
+
+	LVParallelFor(nThreads, [&](size_t t){
+		size_t begin = n * t / nThreads;
+		size_t end = n * (t + 1) / nThreads;
+
+		LVTextWriter writer;
+		for (size_t i = begin; i < end; i++){
+			for (size_t j = 0; j < nr_w; j++){
+				writer.putDouble(model_in.w[i*nr_w + j], 16, roundTrip);
+				writer.put(' ');
+			}
+			writer.put('\n');
+		}
+
+		parts[firstPart + t] = std::move(writer.str());
+	});
+
+	return parts;
+}
+
+void LVReadTextModel(const char *data, size_t size, model &model_out, LVlinear_text_storage &storage){
+	const char *end = data + size;
+	LVTextCursor cursor(data, end);
+
+	model_out = model();
+	storage = LVlinear_text_storage();
+
+	int nr_class = 0;
+	int nr_feature = -1;
+	bool solver_found = false;
+	bool bias_found = false;
+	bool w_section = false;
+
+	// Header (same keywords as load_model)
+	while (cursor.skipEmptyLines()){
+		std::string key = cursor.readWord();
+
+		if (key == "solver_type"){
+			std::string value = cursor.readWord();
+			int solver_type = -1;
+			for (int i = 0; i < LVlinear_solver_type_count; i++){
+				if (LVlinear_solver_type_table[i][0] != '\0' && value == LVlinear_solver_type_table[i])
+					solver_type = i;
+			}
+			if (solver_type < 0)
+				cursor.fail("unknown solver type '" + value + "'");
+			model_out.param.solver_type = solver_type;
+			solver_found = true;
+		}
+		else if (key == "nr_class"){
+			nr_class = cursor.readInt();
+			if (nr_class < 1)
+				cursor.fail("nr_class must be positive");
+		}
+		else if (key == "nr_feature"){
+			nr_feature = cursor.readInt();
+			if (nr_feature < 0)
+				cursor.fail("nr_feature must be non-negative");
+		}
+		else if (key == "bias"){
+			model_out.bias = cursor.readDouble();
+			bias_found = true;
+		}
+		else if (key == "label"){
+			if (nr_class < 1)
+				cursor.fail("nr_class must precede label");
+			storage.label.resize(nr_class);
+			for (int i = 0; i < nr_class; i++)
+				storage.label[i] = cursor.readInt();
+		}
+		else if (key == "w"){
+			cursor.nextLine();
+			w_section = true;
+			break;
+		}
+		else{
+			cursor.fail("unknown text in model file '" + key + "'");
+		}
+
+		if (!cursor.atEndOfLine())
+			cursor.fail("unexpected text after " + key);
+		cursor.nextLine();
+	}
+
+	if (!w_section || !solver_found || !bias_found || nr_class < 1 || nr_feature < 0)
+		throw LVException(__FILE__, __LINE__, "Invalid model file: solver_type, nr_class, nr_feature, bias or the w section is missing.");
+
+	model_out.nr_class = nr_class;
+	model_out.nr_feature = nr_feature;
+
+	size_t n = static_cast<size_t>(nr_feature) + (model_out.bias >= 0 ? 1 : 0);
+	size_t nr_w = LVGetNrWeightVectors(model_out);
+
+	// Weights
+	// First pass counts the lines of each chunk, so that the second pass knows the row each chunk starts at
+	const char *body = cursor.position();
+	size_t bodyLine = cursor.line();
+
+	std::vector<const char*> bounds = LVSplitLines(body, end, LVThreadCount(static_cast<size_t>(end - body), 1 << 18));
+	size_t nChunks = bounds.size() - 1;
+
+	std::vector<size_t> rowOffset(nChunks + 1, 0);
+	std::vector<size_t> lineOffset(nChunks + 1, 0);
+
+	LVParallelFor(nChunks, [&](size_t c){
+		rowOffset[c + 1] = LVCountNonEmptyLines(bounds[c], bounds[c + 1]);
+		lineOffset[c + 1] = LVCountLineBreaks(bounds[c], bounds[c + 1]);
+	});
+
+	for (size_t c = 0; c < nChunks; c++){
+		rowOffset[c + 1] += rowOffset[c];
+		lineOffset[c + 1] += lineOffset[c];
+	}
+
+	if (rowOffset[nChunks] != n)
+		throw LVException(__FILE__, __LINE__, "Invalid model file: expected " + std::to_string(n) + " lines of weights, found " + std::to_string(rowOffset[nChunks]) + ".");
+
+	storage.w.resize(n * nr_w);
+
+	LVParallelFor(nChunks, [&](size_t c){
+		LVTextCursor chunk(bounds[c], bounds[c + 1], bodyLine + lineOffset[c]);
+		size_t row = rowOffset[c];
+
+		while (chunk.skipEmptyLines()){
+			for (size_t j = 0; j < nr_w; j++)
+				storage.w[row*nr_w + j] = chunk.readDouble();
+
+			if (!chunk.atEndOfLine())
+				chunk.fail("expected " + std::to_string(nr_w) + " weights per line");
+
+			row++;
+			chunk.nextLine();
+		}
+	});
+
+	model_out.w = storage.w.empty() ? nullptr : storage.w.data();
+	model_out.label = storage.label.empty() ? nullptr : storage.label.data();
+}
+
+//
+//-- Data file helpers
+//
+
+void LVConvertDataset(const LVDataset &dataset_in, double bias, LVlinear_problem &prob_out){
+	size_t l = dataset_in.rows();
+	bool hasBias = bias >= 0;
+
+	// The bias feature follows the largest index in the file (same as read_problem in liblinear's train)
+	if (hasBias && dataset_in.maxIndex == INT_MAX)
+		throw LVException(__FILE__, __LINE__, "The largest feature index leaves no room for the bias feature.");
+	int32_t biasIndex = dataset_in.maxIndex + 1;
+
+	LVCopyToArrayHandle(prob_out.y, dataset_in.y);
+	prob_out.bias = hasBias ? bias : -1;
+
+	// Handles are allocated on the calling thread, the nodes are copied in parallel
+	LVResizeHandleArrayHandle(prob_out.x, l);
+	for (size_t i = 0; i < l; i++){
+		size_t n_nodes = dataset_in.nodes(i) + (hasBias ? 2 : 1);
+		LVResizeCompositeArrayHandle((*prob_out.x)->elt[i], n_nodes);
+		(*(*prob_out.x)->elt[i])->dimSize = static_cast<uint32_t>(n_nodes);
+	}
+	(*prob_out.x)->dimSize = static_cast<uint32_t>(l);
+
+	LVArray_Hdl<LVlinear_node> *x = (*prob_out.x)->elt;
+	size_t nThreads = LVThreadCount(dataset_in.nodes(), 1 << 16);
+
+	LVParallelFor(nThreads, [&](size_t t){
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++){
+			LVlinear_node *node = (*x[i])->elt;
+			for (size_t k = dataset_in.rowStart[i]; k < dataset_in.rowStart[i + 1]; k++, node++){
+				node->index = dataset_in.index[k];
+				node->value = dataset_in.value[k];
+			}
+
+			if (hasBias){
+				node->index = biasIndex;
+				node->value = bias;
+				node++;
+			}
+
+			node->index = -1;
+			node->value = 0;
+		}
+	});
+}
+
+void LVConvertProblemToDataset(const LVlinear_problem &prob_in, LVDataset &dataset_out){
+	// Input verification: Problem dimensions
+	if (prob_in.x == nullptr || prob_in.y == nullptr || (*(prob_in.x))->dimSize != (*(prob_in.y))->dimSize)
+		throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and feature vectors (x and y).");
+
+	size_t l = (*(prob_in.y))->dimSize;
+	const LVArray_Hdl<LVlinear_node> *x = (*(prob_in.x))->elt;
+	bool hasBias = prob_in.bias >= 0;
+
+	dataset_out = LVDataset();
+	dataset_out.y.assign((*(prob_in.y))->elt, (*(prob_in.y))->elt + l);
+	dataset_out.rowStart.reserve(l + 1);
+	dataset_out.rowStart.push_back(0);
+
+	// Nodes are copied up to the terminating -1 index
+	for (size_t i = 0; i < l; i++){
+		LVArray_Hdl<LVlinear_node> xi = x[i];
+		if (xi != nullptr){
+			uint32_t n = 0;
+			while (n < (*xi)->dimSize && (*xi)->elt[n].index != -1)
+				n++;
+
+			if (hasBias && n > 0)
+				n--;
+
+			for (uint32_t k = 0; k < n; k++){
+				dataset_out.index.push_back((*xi)->elt[k].index);
+				dataset_out.value.push_back((*xi)->elt[k].value);
+				dataset_out.maxIndex = std::max(dataset_out.maxIndex, (*xi)->elt[k].index);
+			}
+		}
+
+		dataset_out.rowStart.push_back(dataset_out.index.size());
+	}
+}
+
+model * LVTrainBlocks(const LVDatasetBlocks &blocks, double bias, const parameter &param, size_t block_passes){
+	// Classes in order of first occurrence, with the -1/+1 swap of binary problems (as train)
+	std::vector<int> labels;
+	for (double y : blocks.labels()){
+		int label = static_cast<int>(y);
+		if (std::find(labels.begin(), labels.end(), label) == labels.end())
+			labels.push_back(label);
+	}
+
+	size_t nr_class = labels.size();
+	if (nr_class == 2 && labels[0] == -1 && labels[1] == +1)
+		std::swap(labels[0], labels[1]);
+
+	std::vector<double> weight(nr_class, 1.0);
+	for (int k = 0; k < param.nr_weight; k++){
+		auto match = std::find(labels.begin(), labels.end(), param.weight_label[k]);
+		if (match != labels.end())
+			weight[match - labels.begin()] = param.weight[k];
+	}
+
+	if (bias >= 0 && blocks.maxIndex() == INT_MAX)
+		throw LVException(__FILE__, __LINE__, "The largest feature index leaves no room for the bias feature.");
+
+	// Binary problems have a single weight vector (positive class first), others one per class (one-vs-rest)
+	size_t nr_w = (nr_class == 2) ? 1 : nr_class;
+	size_t l = blocks.rows();
+	size_t n = static_cast<size_t>(blocks.maxIndex());
+
+	std::vector<std::unique_ptr<LVDualBlockSolver>> solvers;
+	for (size_t c = 0; c < nr_w; c++){
+		LVDualParameter dual_param;
+		dual_param.loss = (param.solver_type == L2R_LR_DUAL) ? LVDualLoss::Logistic : (param.solver_type == L2R_L1LOSS_SVC_DUAL) ? LVDualLoss::L1Hinge : LVDualLoss::L2Hinge;
+		dual_param.Cp = param.C * weight[c];
+		dual_param.Cn = (nr_class == 2) ? param.C * weight[1] : param.C;
+		dual_param.eps = param.eps;
+		dual_param.maxIter = 1000;
+		dual_param.nThreads = 1;
+		solvers.push_back(std::make_unique<LVDualBlockSolver>(dual_param, l, n, bias));
+	}
+
+	// Every outer iteration reads the file once, the binary problems share each block and are solved concurrently
+	size_t n_threads = LVThreadCount(nr_w);
+	std::vector<char> converged(nr_w, 0);
+	std::vector<size_t> class_index;
+	LVDatasetBlock block;
+
+	// The blocks are visited in a new random order every outer iteration, a fixed order converges markedly slower
+	std::vector<size_t> order(blocks.blocks());
+	std::iota(order.begin(), order.end(), size_t(0));
+	std::mt19937 random(0);
+
+	bool done = false;
+	for (size_t iter = 0; !done && iter < 1000; iter++){
+		std::shuffle(order.begin(), order.end(), random);
+
+		for (size_t s = 0; s < order.size(); s++){
+			size_t b = order[s];
+			if (s + 1 < order.size())
+				blocks.prefetch(order[s + 1]);
+			blocks.read(b, block);
+
+			class_index.resize(block.rows);
+			for (size_t i = 0; i < block.rows; i++)
+				class_index[i] = static_cast<size_t>(std::find(labels.begin(), labels.end(), static_cast<int>(block.y[i])) - labels.begin());
+
+			LVParallelFor(n_threads, [&](size_t t){
+				std::vector<double> y(block.rows);
+				for (size_t c = nr_w * t / n_threads; c < nr_w * (t + 1) / n_threads; c++){
+					if (converged[c])
+						continue;
+
+					for (size_t i = 0; i < block.rows; i++)
+						y[i] = (class_index[i] == c) ? +1.0 : -1.0;
+					solvers[c]->solveBlock(block.firstRow, block.rows, block.rowStart, block.index, block.value, y.data(), block_passes);
+				}
+			});
+
+			blocks.release(b);
+		}
+
+		done = true;
+		for (size_t c = 0; c < nr_w; c++){
+			if (!converged[c])
+				converged[c] = solvers[c]->endIteration() ? 1 : 0;
+			done = done && converged[c];
+		}
+	}
+
+	if (!done)
+		LVlinear_print_function("\nWARNING: reaching max number of iterations\nUsing -s 2 may be faster (also see FAQ)\n\n");
+
+	problem prob = problem();
+	prob.n = static_cast<int>(n + (bias >= 0 ? 1 : 0));
+	prob.bias = bias;
+
+	std::unique_ptr<model, LVlinear_model_deleter> result(LVAllocateModel(prob, param, labels, nr_w));
+	for (size_t c = 0; c < nr_w; c++){
+		const std::vector<double> &w = solvers[c]->w();
+		for (size_t j = 0; j < w.size(); j++)
+			result->w[j * nr_w + c] = w[j];
+	}
+
+	return result.release();
+}
+
+//
+//-- Scaling helpers
+//
+
+size_t LVCheckProblem(const LVlinear_problem &prob_in, const char *caller){
+	if (prob_in.x == nullptr || (*(prob_in.x))->dimSize == 0)
+		throw LVException(__FILE__, __LINE__, std::string("Empty problem passed to ") + caller + ".");
+
+	size_t l = (*(prob_in.x))->dimSize;
+	size_t min_nodes = (prob_in.bias >= 0) ? 2 : 1;
+	for (size_t i = 0; i < l; i++){
+		auto xi_in_Hdl = (*(prob_in.x))->elt[i];
+		// Input validation: Final index -1?
+		if (xi_in_Hdl == nullptr || (*xi_in_Hdl)->dimSize < min_nodes || (*xi_in_Hdl)->elt[(*xi_in_Hdl)->dimSize - 1].index != -1)
+			throw LVException(__FILE__, __LINE__, std::string("The index of the last element of each feature vector needs to be -1, preceded by the bias feature if bias >= 0 (") + caller + ").");
+	}
+
+	return l;
+}
+
+LVScaling LVComputeProblemScaling(const LVlinear_problem &prob_in, LVScalingMethod method, double lower, double upper){
+	size_t l = LVCheckProblem(prob_in, "LVlinear_compute_scaling");
+	LVArray_Hdl<LVlinear_node> *x = (*prob_in.x)->elt;
+
+	// The bias feature (last node before the terminator) is excluded
+	size_t n_excluded = (prob_in.bias >= 0) ? 2 : 1;
+
+	// The largest index determines the number of features
+	size_t nThreads = LVThreadCount(l, 1024);
+	std::vector<int32_t> maxIndex(nThreads, 0);
+	LVParallelFor(nThreads, [&](size_t t){
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++){
+			const LVlinear_node *xi = (*x[i])->elt;
+			size_t n = (*x[i])->dimSize - n_excluded;
+			for (size_t k = 0; k < n; k++)
+				maxIndex[t] = std::max(maxIndex[t], xi[k].index);
+		}
+	});
+	size_t nFeatures = static_cast<size_t>(*std::max_element(maxIndex.begin(), maxIndex.end())) + 1;
+
+	// Feature indices start at 1
+	return LVComputeScaling(l, nFeatures, 1, method, lower, upper, [&](size_t i, LVFeatureStatistics &statistics){
+		const LVlinear_node *xi = (*x[i])->elt;
+		size_t n = (*x[i])->dimSize - n_excluded;
+		for (size_t k = 0; k < n; k++)
+			statistics.add(xi[k].index, xi[k].value);
+	});
+}
+
+void LVScaleProblem(const LVScaling &scaling, LVlinear_problem &prob_inout){
+	size_t l = LVCheckProblem(prob_inout, "LVlinear_scale_problem");
+	LVArray_Hdl<LVlinear_node> *x = (*prob_inout.x)->elt;
+	bool has_bias = (prob_inout.bias >= 0);
+
+	// Features with a nonzero shift are inserted where missing, so vectors can only grow
+	std::vector<size_t> size(l);
+	size_t nThreads = LVThreadCount(l, 1024);
+	LVParallelFor(nThreads, [&](size_t t){
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++){
+			const LVlinear_node *xi = (*x[i])->elt;
+			size_t n = (*x[i])->dimSize;
+
+			// The bias feature must not be scaled, inserted features must precede it
+			if (has_bias && static_cast<size_t>(xi[n - 2].index) < scaling.size())
+				throw LVException(__FILE__, __LINE__, "The scaling includes the bias feature (index " + std::to_string(xi[n - 2].index) + "), compute it with the same bias setting as the problem.");
+
+			size[i] = scaling.scaledSize(xi) + 1;
+		}
+	});
+
+	// Handles are resized on the calling thread (the stored nodes are preserved), the nodes are scaled in parallel
+	for (size_t i = 0; i < l; i++){
+		if (size[i] != (*x[i])->dimSize)
+			LVResizeCompositeArrayHandle(x[i], size[i]);
+	}
+
+	LVParallelFor(nThreads, [&](size_t t){
+		std::vector<LVlinear_node> original;
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++){
+			LVlinear_node *xi = (*x[i])->elt;
+			size_t n = (*x[i])->dimSize;
+			if (size[i] == n){
+				// Same nodes, scaled in place
+				for (LVlinear_node *node = xi; node->index != -1; node++)
+					node->value = scaling.apply(node->index, node->value);
+			}
+			else{
+				original.assign(xi, xi + n);
+				scaling.applySparse(original.data(), xi);
+				(*x[i])->dimSize = static_cast<uint32_t>(size[i]);
+			}
+		}
+	});
+}
+
+std::shared_ptr<const LVScaling> LVConvertScaling(const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in){
+	size_t n_scale = (scale_in != nullptr) ? (*scale_in)->dimSize : 0;
+	size_t n_shift = (shift_in != nullptr) ? (*shift_in)->dimSize : 0;
+	if (n_scale == 0 && n_shift == 0)
+		return nullptr;
+
+	if (n_scale != n_shift)
+		throw LVException(__FILE__, __LINE__, "The scale and shift arrays of the scaling must have the same length.");
+
+	const double *scale = (*scale_in)->elt;
+	const double *shift = (*shift_in)->elt;
+	return std::make_shared<const LVScaling>(std::vector<double>(scale, scale + n_scale), std::vector<double>(shift, shift + n_shift));
+}
+
+const feature_node * LVScaleInput(const LVlinear_native_model &native, const feature_node *x, std::vector<feature_node> &buffer){
+	std::shared_ptr<const LVScaling> scaling = std::atomic_load(&native.scaling);
+	if (!scaling)
+		return x;
+
+	// The bias feature of the model (index nr_feature+1) is outside of the scaling, it keeps its value and position
+	buffer.resize(scaling->scaledSize(x) + 1);
+	scaling->applySparse(x, buffer.data());
+	return buffer.data();
+}
+
+std::shared_ptr<const LVFeatureHashing> LVConvertHashing(int32_t hash_bits, uint32_t hash_seed, LVBoolean hash_sign){
+	if (hash_bits <= 0)
+		return nullptr;
+
+	return std::make_shared<const LVFeatureHashing>(hash_bits, hash_seed, hash_sign != 0);
+}
+
+const feature_node * LVHashInput(const LVlinear_native_model &native, const feature_node *x, std::vector<feature_node> &buffer){
+	std::shared_ptr<const LVFeatureHashing> hashing = std::atomic_load(&native.hashing);
+	if (!hashing)
+		return x;
+
+	// The bias feature of the model (index 2^bits+1) is the last node before the terminator, it is moved rather than hashed
+	bool has_bias = native.view.bias >= 0;
+	size_t n = 1;
+	for (const feature_node *node = x; node->index != -1; node++)
 		n++;
+	if (has_bias && n < 2)
+		throw LVException(__FILE__, __LINE__, "The feature vector of a model with a bias must end with the bias feature.");
 
-	// nr_w is equal to nr_class with one exception
-	int nr_w;
-	if (model_in.nr_class == 2 && model_in.param.solver_type != MCSVM_CS)
-		nr_w = 1;
-	else
-		nr_w = model_in.nr_class;
+	LVHashVector(*hashing, x, n, has_bias, 1, buffer);
+	return buffer.data();
+}
 
-	if (model_in.w != nullptr){
-		LVResizeNumericArrayHandle(model_out.w, n*nr_w);
-		MoveBlock(model_in.w, (*(model_out.w))->elt, nr_w * n * sizeof(double));
-		(*model_out.w)->dimSize = nr_w*n;
+void LVConvertDenseProblem(const LVArray_Hdl<double> y_in, const LVArray_Hdl<double, 2> x_in, double bias, problem &prob_out, std::vector<feature_node> &nodes, std::vector<feature_node*> &rows){
+	size_t l = (x_in != nullptr) ? (*x_in)->dimSize[0] : 0;
+	size_t n_columns = (x_in != nullptr) ? (*x_in)->dimSize[1] : 0;
+
+	// Input validation: Nonempty problem
+	if (l == 0 || n_columns == 0)
+		throw LVException(__FILE__, __LINE__, "Empty problem passed to liblinear (dense input).");
+
+	// Input validation: Problem dimensions
+	if (y_in == nullptr || (*y_in)->dimSize != l)
+		throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and rows (y and x).");
+
+	// Input validation: Number of feature vectors and features too large (exceeds max signed int)
+	if (l > INT_MAX || n_columns >= INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Number of rows or columns too large (greater than " + std::to_string(INT_MAX - 1) + ").");
+
+	const double *x = (*x_in)->elt;
+	bool has_bias = bias >= 0;
+	size_t n_excluded = has_bias ? 2 : 1;
+
+	// First pass: number of nonzero values of every row
+	std::vector<size_t> start(l + 1, 0);
+	size_t nThreads = LVThreadCount(l * n_columns, 1 << 16);
+	LVParallelFor(nThreads, [&](size_t t){
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++){
+			const double *row = x + i * n_columns;
+			start[i + 1] = n_excluded + static_cast<size_t>(std::count_if(row, row + n_columns, [](double value){ return value != 0; }));
+		}
+	});
+	std::partial_sum(start.begin(), start.end(), start.begin());
+
+	nodes.resize(start[l]);
+	rows.resize(l);
+	LVParallelFor(nThreads, [&](size_t t){
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++){
+			const double *row = x + i * n_columns;
+			feature_node *node = nodes.data() + start[i];
+			rows[i] = node;
+
+			for (size_t j = 0; j < n_columns; j++){
+				if (row[j] != 0){
+					node->index = static_cast<int>(j + 1);
+					node->value = row[j];
+					node++;
+				}
+			}
+
+			if (has_bias){
+				node->index = static_cast<int>(n_columns + 1);
+				node->value = bias;
+				node++;
+			}
+
+			node->index = -1;
+			node->value = 0;
+		}
+	});
+
+	prob_out.l = static_cast<int>(l);
+	prob_out.n = static_cast<int>(n_columns) + (has_bias ? 1 : 0);
+	prob_out.y = (*y_in)->elt;
+	prob_out.x = rows.data();
+	prob_out.bias = bias;
+}
+
+double LVDenseDot(const double *w, const double *x, size_t n){
+	double sum[4] = { 0, 0, 0, 0 };
+	size_t j = 0;
+	for (; j + 4 <= n; j += 4){
+		sum[0] += w[j] * x[j];
+		sum[1] += w[j + 1] * x[j + 1];
+		sum[2] += w[j + 2] * x[j + 2];
+		sum[3] += w[j + 3] * x[j + 3];
+	}
+	for (; j < n; j++)
+		sum[0] += w[j] * x[j];
+
+	return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+double LVPredictValuesDense(const model &model_in, const double *x, size_t n_columns, double *dec_values){
+	int nr_w = LVGetNrWeightVectors(model_in);
+	size_t n = std::min(n_columns, static_cast<size_t>(model_in.nr_feature));
+	const double *w = model_in.w;
+
+	if (nr_w == 1){
+		dec_values[0] = LVDenseDot(w, x, n);
 	}
 	else{
-		(*model_out.w)->dimSize = 0;
+		// w is stored feature by feature (nr_w weights per feature), every row of w is added to the decision values
+		std::fill(dec_values, dec_values + nr_w, 0.0);
+		for (size_t j = 0; j < n; j++){
+			double value = x[j];
+			const double *wj = w + j * nr_w;
+			for (int k = 0; k < nr_w; k++)
+				dec_values[k] += wj[k] * value;
+		}
 	}
+
+	// The bias feature is the last row of w
+	if (model_in.bias >= 0){
+		const double *wb = w + static_cast<size_t>(model_in.nr_feature) * nr_w;
+		for (int k = 0; k < nr_w; k++)
+			dec_values[k] += wb[k] * model_in.bias;
+	}
+
+	return LVDecisionLabel(model_in, dec_values);
+}
+
+void LVPredictDense(const model &model_in, const double *x, size_t l, size_t n_columns, bool probability, double *labels, double *values, size_t nr_values){
+	size_t nr_dec = static_cast<size_t>(std::max(model_in.nr_class, 1));
+	size_t nThreads = LVThreadCount(l * std::max<size_t>(n_columns, 1), 1 << 16);
+
+	LVParallelFor(nThreads, [&](size_t t){
+		std::vector<double> dec_values(std::max(nr_dec, nr_values));
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++){
+			labels[i] = LVPredictValuesDense(model_in, x + i * n_columns, n_columns, dec_values.data());
+			if (probability)
+				LVProbabilityEstimates(model_in, dec_values.data());
+
+			if (values != nullptr)
+				std::copy(dec_values.begin(), dec_values.begin() + nr_values, values + i * nr_values);
+		}
+	}, LVWorkPriority::Latency);
 }
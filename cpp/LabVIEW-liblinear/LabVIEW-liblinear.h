@@ -12,10 +12,32 @@
 #endif
 
 #include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
 #include <linear.h>
 
 #include "LVException.h"
 #include "LVTypeDecl.h"
+#include "LVBinaryModel.h"
+#include "LVMemoryMap.h"
+#include "LVHandleRegistry.h"
+#include "LVTextFormat.h"
+#include "LVDataset.h"
+#include "LVDelimited.h"
+#include "LVScaling.h"
+#include "LVProblemConversion.h"
+#include "LVBackendSelection.h"
+#include "LVFeatureSelection.h"
+#include "LVFeatureHashing.h"
+#include "LVDualCoordinateDescent.h"
+#include "LVDatasetBlocks.h"
+#include "LVCancellation.h"
+#include "LVGridSearch.h"
+#include "LVLogging.h"
+#include "LVStatistics.h"
+#include "LVThreadPool.h"
+#include "LVJobQueue.h"
 
 #ifndef LIBLINEAR_VERSION
 #define LIBLINEAR_VERSION 210
@@ -43,6 +65,19 @@ struct LVlinear_problem
 	double bias;
 };
 
+// Problem layouts of libsvm, used for conversion (LVsvm_problem of libsvm and libsvm-dense)
+struct LVlinear_sparse_problem
+{
+	LVArray_Hdl<float64> y;
+	LVArray_Hdl<LVArray_Hdl<LVlinear_node>> x; // -1 terminated sparse vectors
+};
+
+struct LVlinear_dense_problem
+{
+	LVArray_Hdl<float64> y;
+	LVArray_Hdl<LVArray_Hdl<float64>> x; // Column j is feature index j+1
+};
+
 struct LVlinear_parameter
 {
 	uint32_t solver_type;
@@ -77,9 +112,101 @@ struct _LVlinear_one_element_cluster {
 };
 static_assert (sizeof(LVArray_Hdl<LVlinear_node>) == sizeof(_LVlinear_one_element_cluster), "Byte packing in one-element cluster present");
 
+// Binary model format (sections of the LVBinaryModel container)
+#pragma region BinaryFormat
+
+enum LVlinear_binary_section : uint32_t {
+	LVLINEAR_SECTION_PARAMETER = 1,	// LVlinear_binary_parameter (1)
+	LVLINEAR_SECTION_WEIGHT_LABEL,	// int32 (nr_weight)
+	LVLINEAR_SECTION_WEIGHT,		// double (nr_weight)
+	LVLINEAR_SECTION_LABEL,			// int32 (nr_class or empty)
+	LVLINEAR_SECTION_W				// double (n x nr_w, n = nr_feature (+1 if bias >= 0))
+};
+
+// Fixed-width representation of the model scalars and parameters (doubles first to avoid padding)
+struct LVlinear_binary_parameter {
+	double eps;
+	double C;
+	double p;
+	double bias;
+	int32_t solver_type;
+	int32_t nr_class;
+	int32_t nr_feature;
+	int32_t padding;
+};
+
+static_assert (sizeof(LVlinear_binary_parameter) == 48, "Size of LVlinear_binary_parameter must be 48 bytes.");
+
+#pragma endregion
+
+// Arrays of a model parsed from the text format (referenced by the model)
+struct LVlinear_text_storage {
+	std::vector<int> label;
+	std::vector<double> w;				// n x nr_w, row-major (same layout as model.w)
+};
+
+// Nonzero weights of every weight vector of a native model, used for prediction instead of w by sparse (e.g. L1-regularized) models
+struct LVlinear_sparse_weights {
+	std::vector<size_t> start;			// Weights of vector k are [start[k], start[k+1])
+	std::vector<int32_t> index;			// Feature index (ascending within each vector)
+	std::vector<double> value;
+};
+
+// Native models with at most this fraction of nonzero weights are stored as LVlinear_sparse_weights
+const double LVLinearSparseMaxDensity = 0.25;
+
+// Releases a model allocated by train
+struct LVlinear_model_deleter {
+	void operator()(model *model_ptr) const { free_and_destroy_model(&model_ptr); }
+};
+
+// Native model referenced from LabVIEW through an opaque handle (see LVlinear_load_model_handle)
+struct LVlinear_native_model {
+	LVlinear_native_model() : view() {}
+
+	LVlinear_text_storage text;			// Text model files
+	LVMemoryMap map;					// Mapping of binary model files
+	model view;							// Model used for prediction (references text, map or w below)
+	std::unique_ptr<double[]> w;		// Packed weights
+	std::unique_ptr<model, LVlinear_model_deleter> trained;	// Model trained by LVlinear_train_handle (the view references its arrays)
+	std::unique_ptr<LVlinear_sparse_weights> sparse;	// Nonzero weights of sparse models (nullptr if view.w is used), see LVSparsifyModel
+	std::shared_ptr<const LVFeatureHashing> hashing;	// Applied to every input before the scaling (nullptr if none), accessed atomically
+	std::shared_ptr<const LVScaling> scaling;	// Applied to every input before prediction (nullptr if none), accessed atomically
+};
+
+// Training or cross-validation queued by LVlinear_train_async/LVlinear_cross_validation_async (see LVJobQueue.h)
+// The problem and the parameters are copied when the job is queued, as the LabVIEW data may be released before the job runs
+class LVlinear_job : public LVJob {
+public:
+	// Validates and copies the inputs, nr_fold is zero for training
+	LVlinear_job(const LVlinear_problem &prob_in, const LVlinear_parameter &param_in, int32_t nr_fold);
+
+	const int32_t nr_fold;
+	std::shared_ptr<LVlinear_native_model> model;	// Result of training
+	std::vector<double> target;				// Result of cross-validation
+
+protected:
+	void run() override;
+
+private:
+	std::vector<double> y;
+	std::vector<feature_node> nodes;		// Feature vectors, one after the other
+	std::vector<feature_node*> x;
+	std::vector<int> weight_label;
+	std::vector<double> weight;
+	problem prob;							// References the copies above
+	parameter param;
+};
+
 //-- Static variables
 static std::atomic<LVUserEventRef *> loggingUsrEv(nullptr);
 
+// Models loaded with LVlinear_load_model_handle
+static LVHandleRegistry<LVlinear_native_model> modelHandles(LVHandleTagLinear);
+
+// Tokens created with LVlinear_create_cancellation_token
+static LVHandleRegistry<LVCancellationToken> tokenHandles(LVHandleTagToken);
+
 //
 //-- LIBLINEAR API
 //
@@ -98,21 +225,154 @@ LVLIBLINEAR_API int32_t	CALLCONV GetLibLinearVersion() { return LIBLINEAR_VERSIO
 
 LVLIBLINEAR_API void	CALLCONV LVlinear_train(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, LVlinear_model * model_out);
 
+// Trains starting from the weights of init_model_in (warm start, e.g. when retraining on a sliding window), supported by the L2R_LR and L2R_L2LOSS_SVC solvers
+// init_model_in must have the same classes and bias setting as the problem, features not in init_model_in start at zero (trains from zero if its w is empty)
+// Trains on at most n_threads threads (all cores if n_threads <= 0)
+// The classes of a one-vs-rest multiclass problem (every solver except MCSVM_CS) are trained concurrently,
+// binary problems of the dual solvers (L2R_L2LOSS_SVC_DUAL, L2R_L1LOSS_SVC_DUAL, L2R_LR_DUAL) by a multi-threaded dual coordinate descent (see LVDualCoordinateDescent.h).
+// Binary problems of the primal solvers L2R_LR and L2R_L2LOSS_SVC are solved by the dual coordinate descent of L2R_LR_DUAL and L2R_L2LOSS_SVC_DUAL
+// (same optimum, eps is the tolerance of the dual solver), unless they start from the weights of a model (warm start)
+// The weights agree with LVlinear_train up to the solver tolerance, not bitwise, and vary from run to run within it (the solvers share the C library's rand())
+// Other problems are trained as by LVlinear_train
+LVLIBLINEAR_API void	CALLCONV LVlinear_train_parallel(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, int32_t n_threads, LVlinear_model * model_out);
+
+LVLIBLINEAR_API void	CALLCONV LVlinear_train_warm_start(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, const LVlinear_model *init_model_in, LVlinear_model * model_out);
+
 LVLIBLINEAR_API void	CALLCONV LVlinear_cross_validation(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, const int32_t nr_fold, LVArray_Hdl<double> target_out);
 
+// Cross-validates C = start_C, 2 start_C, ... up to max_C (as liblinear's find_parameter_C), the folds of every C are trained concurrently
+// The L2R_LR and L2R_L2LOSS_SVC solvers start every C from the weights of the previous C. As liblinear, the search stops early when the weights of no fold
+// changed for three consecutive C (the weights of the first C are compared against zero)
+// start_C <= 0 selects the smallest useful C of the problem, max_C <= 0 selects 1024
+// score_out is the accuracy (classification) or mean squared error (regression) of every C visited, best_C_out the C with the best score
+LVLIBLINEAR_API void	CALLCONV LVlinear_find_parameter_C(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, int32_t nr_fold, double start_C, double max_C, LVArray_Hdl<double> C_out, LVArray_Hdl<double> score_out, double *best_C_out, double *best_score_out);
+
 LVLIBLINEAR_API double	CALLCONV LVlinear_predict(lvError *lvErr, const struct LVlinear_model *model_in, const LVArray_Hdl<LVlinear_node> x_in);
 
 LVLIBLINEAR_API double	CALLCONV LVlinear_predict_values(lvError *lvErr, const LVlinear_model  *model_in, const LVArray_Hdl<LVlinear_node> x_in, LVArray_Hdl<double> dec_values_out);
 
 LVLIBLINEAR_API double	CALLCONV LVlinear_predict_probability(lvError *lvErr, const LVlinear_model  *model_in, const LVArray_Hdl<LVlinear_node> x_in, LVArray_Hdl<double> prob_estimates_out);
 
+//
+//-- Asynchronous jobs (see LVJobQueue.h)
+//
+
+// Queues training or cross-validation and returns a job handle right away (the problem and the parameters are copied first)
+// If completion_in is not null and not zero, the job handle is posted to that user event (U64 data) when the job has finished
+LVLIBLINEAR_API void	CALLCONV LVlinear_train_async(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, LVUserEventRef *completion_in, uint64_t *job_out);
+
+LVLIBLINEAR_API void	CALLCONV LVlinear_cross_validation_async(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, int32_t nr_fold, LVUserEventRef *completion_in, uint64_t *job_out);
+
+// State of a job: 0 queued, 1 running, 2 completed, 3 failed
+LVLIBLINEAR_API void	CALLCONV LVlinear_job_state(lvError *lvErr, uint64_t job, int32_t *state_out);
+
+// Waits up to timeout_ms (negative to wait indefinitely) for a job to finish and returns its state
+LVLIBLINEAR_API void	CALLCONV LVlinear_wait_job(lvError *lvErr, uint64_t job, int32_t timeout_ms, int32_t *state_out);
+
+// Waits for a job and returns its result (or the error of a failed job), the job handle is released
+LVLIBLINEAR_API void	CALLCONV LVlinear_collect_train(lvError *lvErr, uint64_t job, LVlinear_model *model_out);
+
+// As LVlinear_collect_train, the model is returned as a model handle (released with LVlinear_free_model_handle)
+LVLIBLINEAR_API void	CALLCONV LVlinear_collect_train_handle(lvError *lvErr, uint64_t job, uint64_t *handle_out);
+
+LVLIBLINEAR_API void	CALLCONV LVlinear_collect_cross_validation(lvError *lvErr, uint64_t job, LVArray_Hdl<double> target_out);
+
+// Releases a job without collecting it, a job that has not finished runs to completion (without posting its completion event)
+LVLIBLINEAR_API void	CALLCONV LVlinear_free_job(lvError *lvErr, uint64_t job);
+
+// Cancels a job: a running job stops at its next checkpoint (see LVCancellation.h) and fails with error 7001, a queued job fails without running
+LVLIBLINEAR_API void	CALLCONV LVlinear_cancel_job(lvError *lvErr, uint64_t job);
+
+// Sets the user event that receives the solver output of a job (0 or not connected for the global logging event), batched as LVLogEvent tagged with the job handle
+LVLIBLINEAR_API void	CALLCONV LVlinear_set_job_log_userevent(lvError *lvErr, uint64_t job, LVUserEventRef *log_in);
+
+// Limits the number of jobs running at the same time (0 for one per core), further jobs wait in the queue
+LVLIBLINEAR_API void	CALLCONV LVlinear_set_max_running_jobs(lvError *lvErr, int32_t max_jobs);
+
+//
+//-- Cancellation (see LVCancellation.h)
+//
+
+// Creates a token for the cancellable functions, with the budgets of every run started with it: max_seconds of wall-clock time and max_iterations solver iterations
+// (zero or negative for no limit, iterations are counted from the progress output of the solvers). A cancelled run returns error 7001, a run that exceeds a budget error 7002
+LVLIBLINEAR_API void	CALLCONV LVlinear_create_cancellation_token(lvError *lvErr, double max_seconds, int64_t max_iterations, uint64_t *token_out);
+
+// Stops the runs of the token at their next checkpoint (called from another VI), and the runs started with it until the token is reset
+LVLIBLINEAR_API void	CALLCONV LVlinear_cancel(lvError *lvErr, uint64_t token);
+
+LVLIBLINEAR_API void	CALLCONV LVlinear_reset_cancellation_token(lvError *lvErr, uint64_t token);
+
+LVLIBLINEAR_API void	CALLCONV LVlinear_free_cancellation_token(lvError *lvErr, uint64_t token);
+
+// Sets the user event that receives the progress of the searches started with the token (0 or not connected to stop posting), see LVGridSearch.h for the event data
+LVLIBLINEAR_API void	CALLCONV LVlinear_set_progress_userevent(lvError *lvErr, uint64_t token, LVUserEventRef *progress_in);
+
+// Sets the user event that receives the solver output of the runs started with the token (0 or not connected for the global logging event),
+// batched as LVLogEvent tagged with the token handle (see LVLogging.h)
+LVLIBLINEAR_API void	CALLCONV LVlinear_set_log_userevent(lvError *lvErr, uint64_t token, LVUserEventRef *log_in);
+
+// As LVlinear_train and LVlinear_cross_validation, the run is stopped by the token (0 for none) between the folds and the one-vs-rest classes
+// (see LVCancellation.h), the liblinear solvers always complete the binary problem they have started.
+// Under a token the training runs as a job on copies of the inputs that is abandoned when the run stops, so the call returns while the solver completes in the background
+LVLIBLINEAR_API void	CALLCONV LVlinear_train_cancellable(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, uint64_t token, LVlinear_model *model_out);
+
+LVLIBLINEAR_API void	CALLCONV LVlinear_cross_validation_cancellable(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, int32_t nr_fold, uint64_t token, LVArray_Hdl<double> target_out);
+
+// As LVlinear_find_parameter_C, every C value has the budgets of the token. The search ends at the first C value that exceeds them (larger C values take longer)
+// or when the token is cancelled, the results of the C values finished before are returned with a warning (code 7001 or 7002)
+// Every fold and C value is posted to the progress event of the token as it finishes (see LVlinear_set_progress_userevent)
+LVLIBLINEAR_API void	CALLCONV LVlinear_find_parameter_C_cancellable(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, int32_t nr_fold, double start_C, double max_C, uint64_t token, LVArray_Hdl<double> C_out, LVArray_Hdl<double> score_out, double *best_C_out, double *best_score_out);
+
+//
+//-- Statistics (see LVStatistics.h)
+//
+
+// Train, cross-validation and predict with the statistics of the call in stats_out (LVSolverStats): the time spent marshalling the LabVIEW data,
+// in the solver and copying the results back, and the iterations counted from the solver output.
+// The print function of the library is installed for the call (the counters are taken from the solver output), a training whose output was not received returns warning 7003.
+// The statistics are returned on errors too (up to the error). The plain functions collect nothing and stay as fast as before
+LVLIBLINEAR_API void	CALLCONV LVlinear_train_stats(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, LVlinear_model *model_out, LVSolverStats *stats_out);
+
+LVLIBLINEAR_API void	CALLCONV LVlinear_cross_validation_stats(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, const int32_t nr_fold, LVArray_Hdl<double> target_out, LVSolverStats *stats_out);
+
+LVLIBLINEAR_API double	CALLCONV LVlinear_predict_stats(lvError *lvErr, const struct LVlinear_model *model_in, const LVArray_Hdl<LVlinear_node> x_in, LVSolverStats *stats_out);
+
+//
+//-- Thread pool (see LVThreadPool.h)
+//
+
+// Configures the workers of the library's parallel functions: n_threads workers (0 for one per core), restricted to the zero-based cores in cpus_in (empty for all cores),
+// running at priority -2 (lowest) to 2 (highest), 0 is normal. Raising the priority above normal may require elevated privileges
+LVLIBLINEAR_API void	CALLCONV LVlinear_set_thread_pool(lvError *lvErr, int32_t n_threads, const LVArray_Hdl<int32_t> cpus_in, int32_t priority);
+
+LVLIBLINEAR_API void	CALLCONV LVlinear_get_thread_pool(lvError *lvErr, int32_t *n_threads_out, LVArray_Hdl<int32_t> cpus_out, int32_t *priority_out);
+
+// Reserves the zero-based cores in cpus_in for predictions on model handles (empty to remove the reservation), at least one pool core must remain unreserved.
+// Pool workers on the reserved cores only run predictions, training and cross-validation run on the remaining cores,
+// and the parallel training loops pause while predictions run (at task granularity). Keeps the other thread pool settings
+LVLIBLINEAR_API void	CALLCONV LVlinear_set_core_reservation(lvError *lvErr, const LVArray_Hdl<int32_t> cpus_in);
+
+LVLIBLINEAR_API void	CALLCONV LVlinear_get_core_reservation(lvError *lvErr, LVArray_Hdl<int32_t> cpus_out);
+
+// Cancels the jobs (the queued ones fail), then stops the job threads, the pool workers and the log flusher and waits for them to exit,
+// the queued log messages are posted. A running job stops once its library solver in progress has completed (see LVCancellation.h).
+// To be called before the library is unloaded (e.g. when the application closes): the static destruction of the library
+// does not wait for the threads (it would deadlock on Windows). The threads restart on demand
+LVLIBLINEAR_API void	CALLCONV LVlinear_shutdown(lvError *lvErr);
+
 //-- Print function (used for console output redirection to LabVIEW)
-// Logging is global for now
-void LVsvm_print_function(const char * message);
+// The messages are batched by the logger of the library (see LVLogging.h), the global logging event receives them as strings
+void LVlinear_print_function(const char * message);
 LVLIBLINEAR_API void CALLCONV LVlinear_set_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_in);
 LVLIBLINEAR_API void CALLCONV LVlinear_get_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out);
 LVLIBLINEAR_API void CALLCONV LVlinear_delete_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out);
 
+// Interval of the logger (100 ms by default), at most one log event per destination is posted per interval
+LVLIBLINEAR_API void	CALLCONV LVlinear_set_logging_interval(lvError *lvErr, int32_t interval_ms);
+
+// Posts the messages queued by the logger right away
+LVLIBLINEAR_API void	CALLCONV LVlinear_flush_log(lvError *lvErr);
+
 //
 //-- File operations
 //
@@ -121,6 +381,177 @@ LVLIBLINEAR_API void CALLCONV LVlinear_save_model(lvError *lvErr, const char *pa
 
 LVLIBLINEAR_API void CALLCONV LVlinear_load_model(lvError *lvErr, const char *path_in, LVlinear_model *model_out);
 
+// Text model file with the shortest round-trip representation of every number (lossless, still readable by load_model)
+LVLIBLINEAR_API void CALLCONV LVlinear_save_model_round_trip(lvError *lvErr, const char *path_in, const LVlinear_model *model_in);
+
+// Binary model files (memory mapped on load, see LVBinaryModel.h)
+LVLIBLINEAR_API void CALLCONV LVlinear_save_model_binary(lvError *lvErr, const char *path_in, const LVlinear_model *model_in);
+
+LVLIBLINEAR_API void CALLCONV LVlinear_load_model_binary(lvError *lvErr, const char *path_in, LVlinear_model *model_out);
+
+// Binary model file that also stores the feature scaling (see LVlinear_compute_scaling), applied by the model handles loaded from it
+LVLIBLINEAR_API void CALLCONV LVlinear_save_model_binary_scaled(lvError *lvErr, const char *path_in, const LVlinear_model *model_in, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in);
+
+// Binary model file that also stores the feature hashing of a model trained on a hashed problem (see LVlinear_hash_problem) and optionally the scaling of the hashed features
+// The model handles loaded from it hash and then scale every input, so raw feature vectors can be passed for prediction
+LVLIBLINEAR_API void CALLCONV LVlinear_save_model_binary_hashed(lvError *lvErr, const char *path_in, const LVlinear_model *model_in, int32_t hash_bits, uint32_t hash_seed, LVBoolean hash_sign, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in);
+
+// In-memory serialization to/from a LabVIEW string (no file system access)
+LVLIBLINEAR_API void CALLCONV LVlinear_serialize_model(lvError *lvErr, const LVlinear_model *model_in, LStrHandle model_out);
+
+LVLIBLINEAR_API void CALLCONV LVlinear_serialize_model_text(lvError *lvErr, const LVlinear_model *model_in, LVBoolean round_trip, LStrHandle model_out);
+
+// Accepts both the binary and the text format (detected automatically)
+LVLIBLINEAR_API void CALLCONV LVlinear_deserialize_model(lvError *lvErr, const LStrHandle model_in, LVlinear_model *model_out);
+
+//
+//-- Data files (libsvm format, "label index:value index:value ...")
+//
+
+// If bias >= 0, a bias feature (index max_index+1) is appended to every feature vector, as done by liblinear's train
+// The file is memory mapped and parsed in parallel
+// Malformed lines are reported as an error with the line number, or skipped and returned in malformed_lines_out if skip_malformed is true
+LVLIBLINEAR_API void CALLCONV LVlinear_read_problem(lvError *lvErr, const char *path_in, double bias, LVBoolean skip_malformed, LVlinear_problem *prob_out, LVArray_Hdl<uint64_t> malformed_lines_out);
+
+// The bias feature (last node of each feature vector if prob_in->bias >= 0) is not written
+// Numbers are written with the shortest round-trip representation (lossless)
+LVLIBLINEAR_API void CALLCONV LVlinear_write_problem(lvError *lvErr, const char *path_in, const LVlinear_problem *prob_in);
+
+// Writes the problem as a binary dataset (see LVDataset.h), which LVlinear_read_problem and LVlinear_train_file read without parsing
+// The bias feature (last node of each feature vector if prob_in->bias >= 0) is not written
+LVLIBLINEAR_API void CALLCONV LVlinear_write_problem_binary(lvError *lvErr, const char *path_in, const LVlinear_problem *prob_in);
+
+// Trains from a data file (libsvm text or binary dataset) without loading the problem into memory, for files larger than the available memory
+// The file is memory mapped and visited in blocks of about block_mb megabytes, block_passes coordinate descent passes are run on every block (block minimization, see LVDualBlockSolver)
+// Text files are parsed again on every pass over the file, binary datasets (LVlinear_write_problem_binary) are used as mapped and train much faster
+// Only the dual solvers (L2R_L2LOSS_SVC_DUAL, L2R_L1LOSS_SVC_DUAL, L2R_LR_DUAL) are supported, multiclass problems are trained one-vs-rest in the same pass over the file
+// If bias >= 0, a bias feature (index max_index+1) is added to every feature vector, as by LVlinear_read_problem
+LVLIBLINEAR_API void CALLCONV LVlinear_train_file(lvError *lvErr, const char *path_in, double bias, const LVlinear_parameter *param_in, double block_mb, int32_t block_passes, LVlinear_model *model_out);
+
+// Delimited text files (CSV, TSV, ...) with numeric columns, memory mapped and parsed in parallel (see LVDelimited.h)
+// delimiter: 0 detects tab, comma, semicolon or blanks (' ' means runs of blanks)
+// label_column: zero-based column of the label, -1 for the last column, -2 if there is no label (labels are set to zero)
+// missing_policy: 0 reports missing values as an error, 1 skips rows with missing values or malformed rows, 2 replaces missing features by missing_value
+// The line numbers of skipped rows are returned in skipped_lines_out
+// Column j (label excluded) is feature index j+1, zeros are not stored, the bias feature is appended if bias >= 0
+LVLIBLINEAR_API void CALLCONV LVlinear_read_delimited(lvError *lvErr, const char *path_in, uint8_t delimiter, int32_t header_rows, int32_t label_column, int32_t missing_policy, double missing_value, double bias, LVlinear_problem *prob_out, LVArray_Hdl<uint64_t> skipped_lines_out);
+
+//
+//-- Feature scaling (x' = x * scale[index] + shift[index], see LVScaling.h)
+//
+
+// Computes the scaling of every feature in a single parallel pass, element i of scale/shift applies to feature index i
+// method: 0 maps [min, max] of every feature to [lower, upper] (as svm-scale), 1 standardizes to zero mean and unit variance
+// The bias feature (last node of each feature vector if prob_in->bias >= 0) is excluded and never scaled, constant features are mapped to zero
+LVLIBLINEAR_API void CALLCONV LVlinear_compute_scaling(lvError *lvErr, const LVlinear_problem *prob_in, int32_t method, double lower, double upper, LVArray_Hdl<double> scale_out, LVArray_Hdl<double> shift_out);
+
+// Scales the problem in place (no copy of the problem is made in LabVIEW)
+// Features with a nonzero shift become nonzero in every vector, they are inserted in the vectors that do not store them
+LVLIBLINEAR_API void CALLCONV LVlinear_scale_problem(lvError *lvErr, LVlinear_problem *prob_inout, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in);
+
+//
+//-- Feature hashing (see LVFeatureHashing.h)
+//
+
+// Maps the feature indices of any range into 2^hash_bits features (indices 1 to 2^hash_bits), colliding features are summed
+// If hash_sign is true, every raw feature is also given a pseudo-random sign so that collisions cancel out on average
+// The bias feature (last node of each feature vector if prob_in->bias >= 0) is not hashed, it becomes index 2^hash_bits+1
+// The model size no longer depends on the largest raw index, predict with the same settings (LVlinear_hash_vector or a hashed model handle)
+LVLIBLINEAR_API void CALLCONV LVlinear_hash_problem(lvError *lvErr, const LVlinear_problem *prob_in, int32_t hash_bits, uint32_t hash_seed, LVBoolean hash_sign, LVlinear_problem *prob_out);
+
+// Hashes a single feature vector as LVlinear_hash_problem, has_bias tells whether its last node before the terminator is the bias feature
+LVLIBLINEAR_API void CALLCONV LVlinear_hash_vector(lvError *lvErr, const LVArray_Hdl<LVlinear_node> x_in, int32_t hash_bits, uint32_t hash_seed, LVBoolean hash_sign, LVBoolean has_bias, LVArray_Hdl<LVlinear_node> x_out);
+
+//
+//-- Problem conversion (see LVProblemConversion.h)
+//
+
+// If bias >= 0, a bias feature (index max_index+1) is appended to every feature vector, as done by liblinear's train
+LVLIBLINEAR_API void CALLCONV LVlinear_problem_from_sparse(lvError *lvErr, const LVlinear_sparse_problem *prob_in, double bias, LVlinear_problem *prob_out);
+
+// Column j of the dense feature vectors is feature index j+1, zeros are not stored
+// If bias >= 0, a bias feature (index n+1 for n columns of the longest vector) is appended to every feature vector
+LVLIBLINEAR_API void CALLCONV LVlinear_problem_from_dense(lvError *lvErr, const LVlinear_dense_problem *prob_in, double bias, LVlinear_problem *prob_out);
+
+//
+//-- Dense input (row i of x_in is feature vector i, column j is feature index j+1)
+//
+
+// Trains on the rows of a 2D array without building LVlinear_node vectors in LabVIEW
+// liblinear's solvers need sparse vectors, the rows are compressed into native memory for the duration of the call (zeros are not stored)
+// If bias >= 0, a bias feature (index n+1 for n columns) is appended to every row, as done by liblinear's train
+LVLIBLINEAR_API void CALLCONV LVlinear_train_dense(lvError *lvErr, const LVArray_Hdl<double> y_in, const LVArray_Hdl<double, 2> x_in, double bias, const LVlinear_parameter *param_in, LVlinear_model *model_out);
+
+LVLIBLINEAR_API void CALLCONV LVlinear_cross_validation_dense(lvError *lvErr, const LVArray_Hdl<double> y_in, const LVArray_Hdl<double, 2> x_in, double bias, const LVlinear_parameter *param_in, int32_t nr_fold, LVArray_Hdl<double> target_out);
+
+// Predicts every row of x_in (rows in parallel) with contiguous dot products against w, no sparse vectors are built
+// Columns beyond the features of the model are ignored, the bias feature is added according to the bias of the model
+LVLIBLINEAR_API void CALLCONV LVlinear_predict_dense(lvError *lvErr, const LVlinear_model *model_in, const LVArray_Hdl<double, 2> x_in, LVArray_Hdl<double> labels_out);
+
+// Row i of dec_values_out holds the decision values of row i of x_in (as LVlinear_predict_values)
+LVLIBLINEAR_API void CALLCONV LVlinear_predict_values_dense(lvError *lvErr, const LVlinear_model *model_in, const LVArray_Hdl<double, 2> x_in, LVArray_Hdl<double> labels_out, LVArray_Hdl<double, 2> dec_values_out);
+
+// Row i of prob_estimates_out holds the probability estimates of row i of x_in (as LVlinear_predict_probability)
+LVLIBLINEAR_API void CALLCONV LVlinear_predict_probability_dense(lvError *lvErr, const LVlinear_model *model_in, const LVArray_Hdl<double, 2> x_in, LVArray_Hdl<double> labels_out, LVArray_Hdl<double, 2> prob_estimates_out);
+
+//
+//-- Feature selection (see LVFeatureSelection.h)
+//
+
+// F-score of every feature index (fscore_out[0] is unused, the bias feature is excluded) and the indices from the best to the worst score
+// prob_out holds the n_select best features (all if n_select <= 0) and the bias feature, the feature indices are kept
+LVLIBLINEAR_API void	CALLCONV LVlinear_fscore(lvError *lvErr, const LVlinear_problem *prob_in, int32_t n_select, LVArray_Hdl<double> fscore_out, LVArray_Hdl<int32_t> ranking_out, LVlinear_problem *prob_out);
+
+// Recursive feature elimination: trains with param_in, removes the features with the smallest squared weights and repeats until n_select features remain
+// step >= 1 is the number of features removed per iteration, 0 < step < 1 the fraction of the remaining features
+// ranking_out holds all feature indices from the best to the worst (the n_select selected first, ordered by the weights of the last model)
+// prob_out holds the n_select selected features and the bias feature, the feature indices are kept
+LVLIBLINEAR_API void	CALLCONV LVlinear_rfe(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, int32_t n_select, double step, LVArray_Hdl<int32_t> ranking_out, LVlinear_problem *prob_out);
+
+// Copies the problem keeping only the given feature indices and the bias feature (indices are kept), e.g. to reduce a test set the same way as the training set
+LVLIBLINEAR_API void	CALLCONV LVlinear_select_features(lvError *lvErr, const LVlinear_problem *prob_in, const LVArray_Hdl<int32_t> features_in, LVlinear_problem *prob_out);
+
+//
+//-- Native model handles (the model stays in native memory, for deployment)
+//
+
+// Loads a text or binary model file (detected automatically), binary files are used directly from the memory map
+// If pack is true, w is copied into memory owned by the handle instead of being read from the mapping (text models always own w)
+// Models with mostly zero weights (e.g. L1-regularized) keep only their nonzero weights, prediction then costs one lookup per nonzero feature of the input
+LVLIBLINEAR_API void	CALLCONV LVlinear_load_model_handle(lvError *lvErr, const char *path_in, LVBoolean pack, uint64_t *handle_out);
+
+LVLIBLINEAR_API void	CALLCONV LVlinear_free_model_handle(lvError *lvErr, uint64_t handle);
+
+LVLIBLINEAR_API double	CALLCONV LVlinear_predict_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<LVlinear_node> x_in);
+
+LVLIBLINEAR_API double	CALLCONV LVlinear_predict_values_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<LVlinear_node> x_in, LVArray_Hdl<double> dec_values_out);
+
+LVLIBLINEAR_API double	CALLCONV LVlinear_predict_probability_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<LVlinear_node> x_in, LVArray_Hdl<double> prob_estimates_out);
+
+// Sets the scaling applied to every input of the predict functions above (empty arrays remove it)
+// Models loaded from files written by LVlinear_save_model_binary_scaled have their scaling set on load
+LVLIBLINEAR_API void	CALLCONV LVlinear_set_model_handle_scaling(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in);
+
+LVLIBLINEAR_API void	CALLCONV LVlinear_get_model_handle_scaling(lvError *lvErr, uint64_t handle, LVArray_Hdl<double> scale_out, LVArray_Hdl<double> shift_out);
+
+// Sets the feature hashing applied to every input of the predict functions (before the scaling), hash_bits <= 0 removes it
+// Models loaded from files written by LVlinear_save_model_binary_hashed have their hashing set on load
+LVLIBLINEAR_API void	CALLCONV LVlinear_set_model_handle_hashing(lvError *lvErr, uint64_t handle, int32_t hash_bits, uint32_t hash_seed, LVBoolean hash_sign);
+
+// hash_bits_out is 0 if the model has no hashing
+LVLIBLINEAR_API void	CALLCONV LVlinear_get_model_handle_hashing(lvError *lvErr, uint64_t handle, int32_t *hash_bits_out, uint32_t *hash_seed_out, LVBoolean *hash_sign_out);
+
+// Trains a model that stays in native memory (released with LVlinear_free_model_handle), also called by LVsvm_train_auto of libsvm
+LVLIBLINEAR_API void	CALLCONV LVlinear_train_handle(lvError *lvErr, const LVlinear_problem *prob_in, const LVlinear_parameter *param_in, uint64_t *handle_out);
+
+//
+//-- Engine selection (see LVBackendSelection.h, training is dispatched by LVsvm_train_auto of libsvm)
+//
+
+// Profiles the problem (bias feature excluded) and returns the engine recommended for it (0: libsvm, 1: libsvm-dense, 2: liblinear) and why
+// svm_type and kernel_type are the libsvm values of the problem to solve (e.g. 0 and 0 for a linear C-SVC)
+LVLIBLINEAR_API void	CALLCONV LVlinear_analyze_problem(lvError *lvErr, const LVlinear_problem *prob_in, int32_t svm_type, int32_t kernel_type, LVProblemProfile *profile_out, int32_t *backend_out, LStrHandle reason_out);
+
 //-- Helper functions
 
 // Assigns the cluster from LabVIEW to a svm_parameter struct
@@ -132,3 +563,138 @@ void LVConvertParameter(const LVlinear_parameter &param_in, parameter &param_out
 void LVConvertModel(const LVlinear_model &model_in, model &model_out);
 
 void LVConvertModel(const model &model_in, LVlinear_model &model_out);
+
+// Returns the number of weight vectors (columns of w) of a model
+int LVGetNrWeightVectors(const model &model_in);
+
+// Adds the sections of a model to a binary writer (arrays are referenced, not copied)
+void LVWriteBinaryModel(const model &model_in, LVBinaryWriter &writer, LVlinear_binary_parameter &param_storage);
+
+// Assigns a model referencing the data of a binary model (arrays are not copied)
+void LVReadBinaryModel(const LVBinaryReader &reader, model &model_out);
+
+// Formats a model in the liblinear text format, byte-compatible with save_model unless roundTrip is set
+// The weights are formatted in parallel, the concatenation of the returned parts is the model file
+std::vector<std::string> LVFormatTextModel(const model &model_in, bool roundTrip);
+
+// Parses a model in the liblinear text format (the weights are parsed in parallel)
+// The model references the arrays in storage
+void LVReadTextModel(const char *data, size_t size, model &model_out, LVlinear_text_storage &storage);
+
+// Copies a parsed data file into the LabVIEW problem layout, appending the bias feature if bias >= 0 (nodes are copied in parallel)
+void LVConvertDataset(const LVDataset &dataset_in, double bias, LVlinear_problem &prob_out);
+
+// Copies a problem into a dataset, without the bias feature
+void LVConvertProblemToDataset(const LVlinear_problem &prob_in, LVDataset &dataset_out);
+
+// Trains the model of a dual solver by block minimization over the blocks of a data file (see LVlinear_train_file)
+model * LVTrainBlocks(const LVDatasetBlocks &blocks, double bias, const parameter &param, size_t block_passes);
+
+// Loads a text or binary model file into a native model
+std::shared_ptr<LVlinear_native_model> LVLoadNativeModel(const char *path_in, bool pack);
+
+// Trains a native model (the weights are owned by the model), starting from the weights of init_model if not nullptr
+// Trains by LVTrainParallel on n_threads threads if n_threads > 1. The weights are dense, see LVSparsifyModel for models kept behind a handle
+std::shared_ptr<LVlinear_native_model> LVTrainNativeModel(const LVlinear_problem &prob_in, const LVlinear_parameter &param_in, const LVlinear_model *init_model = nullptr, size_t n_threads = 1);
+
+// Trains a native model from a problem in native memory on n_threads threads
+std::shared_ptr<LVlinear_native_model> LVTrainNativeModel(const problem &prob, const parameter &param, size_t n_threads);
+
+// Waits for a job and releases its handle, throws LVException if the job failed or is not a training (crossValidation false) or cross-validation job
+std::shared_ptr<LVlinear_job> LVCollectJob(uint64_t job, bool crossValidation);
+
+// Returns the token referenced by the handle, nullptr for 0. Throws LVException if the handle is invalid
+std::shared_ptr<const LVCancellationToken> LVGetCancellationToken(uint64_t token);
+
+// Trains as train() on n_threads threads: binary problems of the dual solvers by LVTrainDual, binary problems of L2R_LR and L2R_L2LOSS_SVC
+// by LVTrainDual with the corresponding dual solver (except for warm starts), all others by LVTrainOneVsRest
+model * LVTrainParallel(const problem &prob, const parameter &param, size_t n_threads);
+
+// Trains a binary problem of a dual solver with the multi-threaded dual coordinate descent, labels are the two classes in the order of train()
+model * LVTrainDual(const problem &prob, const parameter &param, const std::vector<int> &labels, size_t n_threads);
+
+// Returns the classes in order of first occurrence (as train(), without the -1/+1 swap of binary problems) and the class of every vector
+std::vector<int> LVClassLabels(const problem &prob, std::vector<size_t> &class_index);
+
+// Allocates a model for the weights of train() (released by free_and_destroy_model)
+model * LVAllocateModel(const problem &prob, const parameter &param, const std::vector<int> &labels, size_t nr_w);
+
+// Trains as train(), except that the binary problems of a one-vs-rest multiclass model are solved concurrently as throughput work of the thread pool, on at most n_threads threads
+// The binary problems are those of train() (vectors grouped by class, same class order, class weights and initial solution), but they are solved by train()
+// on a -1/+1 problem, which moves the vectors of the positive class first: only the first class is solved on the vectors in the order of train().
+// The dual coordinate descent solvers visit the vectors in an order drawn from the C library's rand(), so the weights agree with train() up to the solver tolerance,
+// not bitwise. On n_threads > 1 the concurrent solvers also interleave their draws, and the weights differ (within the tolerance) from run to run
+model * LVTrainOneVsRest(const problem &prob, const parameter &param, size_t n_threads);
+
+// Returns true for the regression (SVR) solvers
+bool LVIsRegressionSolver(int solver_type);
+
+// Trains as train(), under a stop condition (see LVCancellation.h) the classes of a one-vs-rest model one after the other by LVTrainOneVsRest,
+// so that the run can be stopped between classes
+model * LVTrain(const problem &prob, const parameter &param);
+
+// Cross-validates as cross_validation() into target (the predicted value of every vector), on the same folds
+// Under a stop condition the folds are trained one pool task each instead, so that the run can be stopped between folds
+void LVCrossValidate(const problem &prob, const parameter &param, int nr_fold, double *target);
+
+// Cross-validates the C path of LVlinear_find_parameter_C into C_out and score_out, returns the position of the best score
+// Every C value is stopped by the token (nullptr for none), a stop after the first C value ends the path and is returned in stopped_out
+size_t LVFindParameterC(const LVlinear_problem &prob_in, const LVlinear_parameter &param_in, int nr_fold, double start_C, double max_C, std::shared_ptr<const LVCancellationToken> token, std::vector<double> &C_out, std::vector<double> &score_out, std::unique_ptr<LVStopped> &stopped_out);
+
+// Maps the weights of init_model onto the weight layout train() uses for prob (class order, features and bias), returns an empty vector if init_model has no weights
+std::vector<double> LVWarmStartSolution(const problem &prob, const parameter &param, const LVlinear_model &init_model);
+
+// Ranks the features by recursive feature elimination (see LVlinear_rfe), the restricted problems are built in parallel
+std::vector<int32_t> LVRecursiveFeatureElimination(const LVlinear_problem &prob_in, const LVlinear_parameter &param_in, size_t n_select, double step);
+
+// Returns the number of decision values produced by predict_values
+int LVGetNrDecisionValues(const model &model_in);
+
+// Validates the feature vectors of a problem (nonempty and -1 terminated), returns the number of vectors
+size_t LVCheckProblem(const LVlinear_problem &prob_in, const char *caller);
+
+// Computes the scaling of a problem, excluding the bias feature (statistics are gathered in parallel)
+LVScaling LVComputeProblemScaling(const LVlinear_problem &prob_in, LVScalingMethod method, double lower, double upper);
+
+// Scales a problem in place, vectors that need room for inserted features are resized on the calling thread
+void LVScaleProblem(const LVScaling &scaling, LVlinear_problem &prob_inout);
+
+// Assigns the scaling from the LabVIEW arrays (nullptr if both are empty)
+std::shared_ptr<const LVScaling> LVConvertScaling(const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in);
+
+// Stores the weights of a native model as LVlinear_sparse_weights if at most LVLinearSparseMaxDensity of them are nonzero, the dense w owned by the model is released
+// (including trained->w, so a sparsified model can no longer be converted by LVConvertModel)
+void LVSparsifyModel(LVlinear_native_model &native);
+
+// predict_values, predict and predict_probability of liblinear for native models (using the sparse weights if present)
+double LVPredictValues(const LVlinear_native_model &native, const feature_node *x, double *dec_values);
+double LVPredict(const LVlinear_native_model &native, const feature_node *x);
+double LVPredictProbability(const LVlinear_native_model &native, const feature_node *x, double *prob_estimates);
+
+// Returns the label of the decision values as liblinear's predict_values
+double LVDecisionLabel(const model &model_in, const double *dec_values);
+
+// Converts the decision values into probability estimates in place as liblinear's predict_probability (prob_estimates holds nr_class values)
+void LVProbabilityEstimates(const model &model_in, double *prob_estimates);
+
+// Compresses the rows of a dense 2D array into a liblinear problem (zeros are not stored, the bias feature is appended if bias >= 0)
+// The problem references the labels of y_in and the vectors stored in nodes and rows
+void LVConvertDenseProblem(const LVArray_Hdl<double> y_in, const LVArray_Hdl<double, 2> x_in, double bias, problem &prob_out, std::vector<feature_node> &nodes, std::vector<feature_node*> &rows);
+
+// Dot product of two contiguous arrays (independent partial sums, so that the loop vectorizes)
+double LVDenseDot(const double *w, const double *x, size_t n);
+
+// Decision values of a dense row (column j is feature index j+1) as liblinear's predict_values, columns beyond the features of the model are ignored
+double LVPredictValuesDense(const model &model_in, const double *x, size_t n_columns, double *dec_values);
+
+// Predicts the l rows of x (n_columns each) in parallel into labels, and the nr_values decision values (or probability estimates) of row i into values + i * nr_values if values is not nullptr
+void LVPredictDense(const model &model_in, const double *x, size_t l, size_t n_columns, bool probability, double *labels, double *values, size_t nr_values);
+
+// Returns x scaled by the scaling of the native model (the copy is stored in buffer), or x itself if the model has no scaling
+const feature_node * LVScaleInput(const LVlinear_native_model &native, const feature_node *x, std::vector<feature_node> &buffer);
+
+// Assigns the hashing from the LabVIEW settings (nullptr if hash_bits <= 0)
+std::shared_ptr<const LVFeatureHashing> LVConvertHashing(int32_t hash_bits, uint32_t hash_seed, LVBoolean hash_sign);
+
+// Returns x hashed by the hashing of the native model (the copy is stored in buffer), or x itself if the model has no hashing
+const feature_node * LVHashInput(const LVlinear_native_model &native, const feature_node *x, std::vector<feature_node> &buffer);
@@ -8,6 +8,7 @@
 #include <errno.h>
 #include <cmath>
 #include <climits>
+#include <algorithm>
 
 #include <extcode.h>
 #include <svm.h>
@@ -15,6 +16,17 @@
 #include "LVTypeDecl.h"
 #include "LVUtility.h"
 #include "LVException.h"
+#include "LVMemoryMap.h"
+#include "LVBinaryModel.h"
+#include "LVTextFormat.h"
+#include "LVDataset.h"
+#include "LVDelimited.h"
+#include "LVScaling.h"
+#include "LVProblemConversion.h"
+#include "LVParallel.h"
+#include "LVBackendSelection.h"
+#include "LVFeatureSelection.h"
+#include "LVThreadPool.h"
 
 // C++14 feature: std::make_unique
 // GNU g++-4.9 or later with -std=c++14 enabled is needed on unix (VS2013 has native support)
@@ -24,6 +36,8 @@
 
 void LVsvm_train(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, LVsvm_model * model_out) {
 	try {
+		LVThroughputScope throughput;
+		LVStatsTimer marshal(LVStatsPhase::Marshal);
 
 		// Input verification: Nonempty problem
 		if ((*prob_in->x)->dimSize == 0)
@@ -75,8 +89,14 @@ void LVsvm_train(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_param
 		if (param_check != nullptr)
 			throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check));
 
+		marshal.stop();
+
 		// Train model
+		LVStatsTimer solver(LVStatsPhase::Solver);
 		svm_model *model = svm_train(prob.get(), param.get());
+		solver.stop();
+
+		LVStatsTimer copy(LVStatsPhase::Copy);
 
 		// Copy the data into LabVIEW memory (hardcopy)
 		LVConvertModel(*model, *model_out);
@@ -129,6 +149,8 @@ void LVsvm_train(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_param
 
 void LVsvm_cross_validation(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t nr_fold, LVArray_Hdl<double> target_out) {
 	try {
+		LVThroughputScope throughput;
+		LVStatsTimer marshal(LVStatsPhase::Marshal);
 
 		// Input verification: Nonempty problem
 		if ((*prob_in->x)->dimSize == 0)
@@ -183,7 +205,11 @@ void LVsvm_cross_validation(lvError *lvErr, const LVsvm_problem *prob_in, const
 		// Allocate room in target_out
 		LVResizeNumericArrayHandle(target_out, n_vectors);
 
-		svm_cross_validation(prob.get(), param.get(), nr_fold, (*target_out)->elt);
+		marshal.stop();
+
+		LVStatsTimer solver(LVStatsPhase::Solver);
+		LVCrossValidate(*prob, *param, nr_fold, (*target_out)->elt);
+		solver.stop();
 
 		(*target_out)->dimSize = n_vectors;
 	}
@@ -204,6 +230,8 @@ void LVsvm_cross_validation(lvError *lvErr, const LVsvm_problem *prob_in, const
 
 double	LVsvm_predict(lvError *lvErr, const struct LVsvm_model *model_in, const LVArray_Hdl<double> x_in) {
 	try {
+		LVStatsTimer marshal(LVStatsPhase::Marshal);
+
 		// Input validation: Uninitialized model
 		if (model_in == nullptr || model_in->SV == nullptr || (*model_in->SV)->dimSize == 0)
 			throw LVException(__FILE__, __LINE__, "Uninitialized model passed to libsvmdense_predict.");
@@ -223,7 +251,11 @@ double	LVsvm_predict(lvError *lvErr, const struct LVsvm_model *model_in, const L
 		LVConvertModel(*model_in, *model, SV, sv_coef);
 
 		svm_node node = { static_cast<int>((*x_in)->dimSize), (*x_in)->elt };
+		marshal.stop();
+
+		LVStatsTimer solver(LVStatsPhase::Solver);
 		double label = svm_predict(model.get(), &node);
+		solver.stop();
 
 		return label;
 	}
@@ -619,83 +651,67 @@ void LVConvertModel(const svm_model &model_in, LVsvm_model &model_out) {
 	}
 }
 
-//-- Print function (console logging)
-void LVsvm_print_function(const char * message) {
-	LVUserEventRef *usrEv = loggingUsrEv;
-	if (usrEv != nullptr && message != nullptr) {
-		// Filter out the progress messages (..... and *)
-		if (strcmp(message, ".") != 0 && strcmp(message, "*") != 0) {
-			// Move the string to a handle
-			size_t length = strlen(message);
-			LStrHandle lvmsg = (LStrHandle)DSNewHandle(sizeof(int32_t) + length);
-			MoveBlock(message, (*lvmsg)->str, length);
-			(*lvmsg)->cnt = static_cast<int32>(length);
-
-			// Post the string to the user event
-			PostLVUserEvent(*usrEv, &lvmsg);
-		}
+//-- Asynchronous jobs
+void LVsvm_train_async(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, LVUserEventRef *completion_in, uint64_t *job_out) {
+	try {
+		*job_out = 0;
+		auto job = std::make_shared<LVsvm_job>(*prob_in, *param_in, 0);
+		*job_out = LVJobQueue::instance().submit(job, (completion_in != nullptr) ? *completion_in : 0);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
 	}
 }
 
-void LVsvm_set_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_in) {
-	loggingUsrEv = loggingUserEvent_in;
-	svm_set_print_string_function(LVsvm_print_function);
-}
+void LVsvm_cross_validation_async(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t nr_fold, LVUserEventRef *completion_in, uint64_t *job_out) {
+	try {
+		*job_out = 0;
+		if (nr_fold < 2)
+			throw LVException(__FILE__, __LINE__, "The number of folds must be at least 2 (" + std::to_string(nr_fold) + ").");
 
-void LVsvm_get_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out) {
-	loggingUserEvent_out = loggingUsrEv;
+		auto job = std::make_shared<LVsvm_job>(*prob_in, *param_in, nr_fold);
+		*job_out = LVJobQueue::instance().submit(job, (completion_in != nullptr) ? *completion_in : 0);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
 }
 
-void LVsvm_delete_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out) {
-	loggingUserEvent_out = loggingUsrEv;
-	loggingUsrEv = nullptr;
+void LVsvm_job_state(lvError *lvErr, uint64_t job, int32_t *state_out) {
+	try {
+		*state_out = static_cast<int32_t>(LVJobQueue::instance().get(job)->state());
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
 }
 
-
-//
-//-- File saving/loading
-//
-
-void LVsvm_save_model(lvError *lvErr, const char *path_in, const LVsvm_model *model_in){
-	try{
-        errno = 0;
-
-		// Convert LVsvm_model to svm_model
-		auto model = std::make_unique<svm_model>();
-		std::unique_ptr<svm_node[]> SV;
-		std::unique_ptr<double*[]> sv_coef;
-		LVConvertModel(*model_in, *model, SV, sv_coef);
-
-		int err = svm_save_model(path_in, model.get());
-
-		if (err == -1){
-            // Allocate room for output error message (truncated if buffer is too small)
-            const size_t bufSz = 256;
-            char buf[bufSz] = "";
-            std::string errstr;
-
-		#if defined(_WIN32) || defined(_WIN64)
-			if(strerror_s(buf, bufSz, errno) != 0)
-                errstr = buf;
-            else
-                errstr = "Unknown error";
-        #elif (_POSIX_C_SOURCE >= 200112L || _XOPEN_SOURCE >= 600) && ! _GNU_SOURCE
-            if(strerror_r(errno, buf, bufSz) != 0)
-                errstr = buf;
-            else
-                errstr = "Unknown error";
-        #else
-            char* gnuerr = strerror_r(errno, buf, bufSz);
-            if(gnuerr != nullptr)
-                errstr = gnuerr;
-            else
-                errstr = "Unknown error";
-        #endif
-
-        errno = 0;
-
-        throw LVException(__FILE__, __LINE__, "Model load operation failed (" + errstr + ").");
-		}
+void LVsvm_wait_job(lvError *lvErr, uint64_t job, int32_t timeout_ms, int32_t *state_out) {
+	try {
+		auto queued = LVJobQueue::instance().get(job);
+		queued->wait(timeout_ms);
+		*state_out = static_cast<int32_t>(queued->state());
 	}
 	catch (LVException &ex) {
 		ex.returnError(lvErr);
@@ -709,47 +725,10 @@ void LVsvm_save_model(lvError *lvErr, const char *path_in, const LVsvm_model *mo
 	}
 }
 
-void LVsvm_load_model(lvError *lvErr, const char *path_in, LVsvm_model *model_out){
-	try{
-        errno = 0;
-
-		svm_model *model = svm_load_model(path_in);
-
-		if (model == nullptr){
-            // Allocate room for output error message (truncated if buffer is too small)
-            const size_t bufSz = 256;
-            char buf[bufSz] = "";
-            std::string errstr;
-
-		#if defined(_WIN32) || defined(_WIN64)
-			if(strerror_s(buf, bufSz, errno) != 0)
-                errstr = buf;
-            else
-                errstr = "Unknown error";
-        #elif (_POSIX_C_SOURCE >= 200112L || _XOPEN_SOURCE >= 600) && ! _GNU_SOURCE
-            if(strerror_r(errno, buf, bufSz) != 0)
-                errstr = buf;
-            else
-                errstr = "Unknown error";
-        #else
-            char* gnuerr = strerror_r(errno, buf, bufSz);
-            if(gnuerr != nullptr)
-                errstr = gnuerr;
-            else
-                errstr = "Unknown error";
-        #endif
-
-        errno = 0;
-
-        throw LVException(__FILE__, __LINE__, "Model load operation failed (" + errstr + ").");
-		}
-		else{
-            // libsvm returns uninitialized values for the parameters
-            (model->param) = { 0 };
-
-			LVConvertModel(*model, *model_out);
-			svm_free_model_content(model);
-		}
+void LVsvm_collect_train(lvError *lvErr, uint64_t job, LVsvm_model *model_out) {
+	try {
+		auto collected = LVCollectJob(job, false);
+		LVConvertModel(collected->model->view, *model_out);
 	}
 	catch (LVException &ex) {
 		(*(model_out->label))->dimSize = 0;
@@ -792,3 +771,2641 @@ void LVsvm_load_model(lvError *lvErr, const char *path_in, LVsvm_model *model_ou
 		ex.returnError(lvErr);
 	}
 }
+
+void LVsvm_collect_train_handle(lvError *lvErr, uint64_t job, uint64_t *handle_out) {
+	try {
+		*handle_out = 0;
+		auto collected = LVCollectJob(job, false);
+		*handle_out = modelHandles.add(collected->model);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_collect_cross_validation(lvError *lvErr, uint64_t job, LVArray_Hdl<double> target_out) {
+	try {
+		auto collected = LVCollectJob(job, true);
+		LVCopyToArrayHandle(target_out, collected->target);
+	}
+	catch (LVException &ex) {
+		(*target_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*target_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*target_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_free_job(lvError *lvErr, uint64_t job) {
+	try {
+		LVJobQueue::instance().release(job);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_cancel_job(lvError *lvErr, uint64_t job) {
+	try {
+		LVJobQueue::instance().get(job)->cancel();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_set_job_log_userevent(lvError *lvErr, uint64_t job, LVUserEventRef *log_in) {
+	try {
+		LVJobQueue::instance().get(job)->setLogEvent((log_in != nullptr) ? *log_in : 0);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_set_max_running_jobs(lvError *lvErr, int32_t max_jobs) {
+	try {
+		if (max_jobs < 0)
+			throw LVException(__FILE__, __LINE__, "The number of running jobs must not be negative.");
+
+		LVJobQueue::instance().setMaxRunning(static_cast<size_t>(max_jobs));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//-- Cancellation
+void LVsvm_create_cancellation_token(lvError *lvErr, double max_seconds, int64_t max_iterations, uint64_t *token_out) {
+	try {
+		*token_out = 0;
+		*token_out = tokenHandles.add(std::make_shared<LVCancellationToken>(max_seconds, max_iterations));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_cancel(lvError *lvErr, uint64_t token) {
+	try {
+		tokenHandles.get(token)->cancel();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_reset_cancellation_token(lvError *lvErr, uint64_t token) {
+	try {
+		tokenHandles.get(token)->reset();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_free_cancellation_token(lvError *lvErr, uint64_t token) {
+	try {
+		tokenHandles.remove(token);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_set_progress_userevent(lvError *lvErr, uint64_t token, LVUserEventRef *progress_in) {
+	try {
+		tokenHandles.get(token)->setProgressEvent((progress_in != nullptr) ? *progress_in : 0);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_set_log_userevent(lvError *lvErr, uint64_t token, LVUserEventRef *log_in) {
+	try {
+		tokenHandles.get(token)->setLogEvent((log_in != nullptr) ? *log_in : 0, token);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_train_cancellable(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, uint64_t token, LVsvm_model *model_out) {
+	try {
+		// The print function counts the iterations of the library solvers into the budgets
+		LVInstallPrintFunction(svm_set_print_string_function, LVsvm_print_function);
+
+		std::shared_ptr<const LVCancellationToken> stop_token = LVGetCancellationToken(token);
+		if (!stop_token) {
+			LVsvm_train(lvErr, prob_in, param_in, model_out);
+			return;
+		}
+
+		// The library solver cannot be stopped: the model is trained by a job on copies of the inputs, which is abandoned when the run stops
+		auto job = std::make_shared<LVsvm_job>(*prob_in, *param_in, 0);
+		LVStopCondition stop(stop_token);
+		LVStopScope scope(&stop);
+		LVJobQueue::instance().runAbandonable(job);
+
+		LVConvertModel(job->model->view, *model_out);
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_cross_validation_cancellable(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t nr_fold, uint64_t token, LVArray_Hdl<double> target_out) {
+	try {
+		// The print function counts the iterations of the library solvers into the budgets
+		LVInstallPrintFunction(svm_set_print_string_function, LVsvm_print_function);
+
+		LVStopCondition stop(LVGetCancellationToken(token));
+		LVStopScope scope(&stop);
+		LVsvm_cross_validation(lvErr, prob_in, param_in, nr_fold, target_out);
+	}
+	catch (LVException &ex) {
+		(*target_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*target_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*target_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//-- Grid search
+void LVsvm_grid_search(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t nr_fold, const LVArray_Hdl<double> C_in, const LVArray_Hdl<double> gamma_in, uint64_t token, LVArray_Hdl<double, 2> score_out, double *best_C_out, double *best_gamma_out, double *best_score_out) {
+	try {
+		LVThroughputScope throughput;
+
+		// The print function counts the iterations of the library solvers into the budgets
+		LVInstallPrintFunction(svm_set_print_string_function, LVsvm_print_function);
+
+		size_t l = LVCheckProblem(*prob_in, "LVsvm_grid_search");
+
+		// Input verification: Problem dimensions
+		if (prob_in->y == nullptr || (*(prob_in->y))->dimSize != l)
+			throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and feature vectors (x and y).");
+
+		// Input validation: Number of vectors too large (exceeds max signed int)
+		if (l > INT_MAX)
+			throw LVException(__FILE__, __LINE__, "Number of vectors too large (greater than " + std::to_string(INT_MAX) + ")");
+
+		svm_problem prob;
+		prob.l = static_cast<int>(l);
+		prob.y = (*(prob_in->y))->elt;
+
+		uint32_t n_features = (*(*(prob_in->x))->elt[0])->dimSize;
+		auto x = std::make_unique<svm_node[]>(l);
+		prob.x = x.get();
+		for (size_t i = 0; i < l; i++) {
+			// Disallow feature vectors of different size, they are truncated in the dot-product anyway.
+			if ((*(*(prob_in->x))->elt[i])->dimSize != n_features)
+				throw LVException(__FILE__, __LINE__, "Feature vector #" + std::to_string(i) + " differs in length from the rest.");
+
+			x[i].dim = n_features;
+			x[i].values = (*(*(prob_in->x))->elt[i])->elt;
+		}
+
+		svm_parameter param;
+		LVConvertParameter(*param_in, param);
+
+		// An empty list keeps the value of the parameters
+		std::vector<double> C(1, param.C);
+		if (C_in != nullptr && (*C_in)->dimSize > 0)
+			C.assign((*C_in)->elt, (*C_in)->elt + (*C_in)->dimSize);
+
+		std::vector<double> gamma(1, param.gamma);
+		if (gamma_in != nullptr && (*gamma_in)->dimSize > 0)
+			gamma.assign((*gamma_in)->elt, (*gamma_in)->elt + (*gamma_in)->dimSize);
+
+		std::vector<double> score;
+		std::unique_ptr<LVStopped> stopped;
+		size_t best = LVGridSearch(prob, param, nr_fold, C, gamma, LVGetCancellationToken(token), score, stopped);
+
+		LVResizeNumericArrayHandle(score_out, score.size());
+		MoveBlock(score.data(), (*score_out)->elt, score.size() * sizeof(double));
+		(*score_out)->dimSize[0] = static_cast<uint32_t>(C.size());
+		(*score_out)->dimSize[1] = static_cast<uint32_t>(gamma.size());
+
+		*best_C_out = C[best / gamma.size()];
+		*best_gamma_out = gamma[best % gamma.size()];
+		*best_score_out = score[best];
+
+		// Partial results of a stopped search
+		if (stopped)
+			stopped->returnWarning(lvErr);
+	}
+	catch (LVException &ex) {
+		(*score_out)->dimSize[0] = 0;
+		(*score_out)->dimSize[1] = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*score_out)->dimSize[0] = 0;
+		(*score_out)->dimSize[1] = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*score_out)->dimSize[0] = 0;
+		(*score_out)->dimSize[1] = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//-- Statistics
+void LVsvm_train_stats(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, LVsvm_model *model_out, LVSolverStats *stats_out) {
+	LVStats stats;
+	{
+		// The counters are taken from the output of the solver
+		LVPrintFunctionScope print(svm_set_print_string_function, LVsvm_print_function);
+		LVStatsScope scope(&stats);
+		LVsvm_train(lvErr, prob_in, param_in, model_out);
+	}
+
+	if (!lvErr->status) {
+		// Support vectors of the trained model
+		stats.setSupportVectors(model_out->l);
+
+		// Every solver reports its iterations, none means that the output did not reach the print function (replaced by another library of the process)
+		if (stats.iterations() == 0)
+			LVException(__FILE__, __LINE__, LVErrorNoSolverOutput, "The solver output was not received, the iteration counters of the statistics are incomplete.").returnWarning(lvErr);
+	}
+
+	if (stats_out != nullptr)
+		stats.copyTo(*stats_out);
+}
+
+void LVsvm_cross_validation_stats(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t nr_fold, LVArray_Hdl<double> target_out, LVSolverStats *stats_out) {
+	LVStats stats;
+	{
+		LVPrintFunctionScope print(svm_set_print_string_function, LVsvm_print_function);
+		LVStatsScope scope(&stats);
+		LVsvm_cross_validation(lvErr, prob_in, param_in, nr_fold, target_out);
+	}
+
+	if (stats_out != nullptr)
+		stats.copyTo(*stats_out);
+}
+
+double LVsvm_predict_stats(lvError *lvErr, const struct LVsvm_model *model_in, const LVArray_Hdl<double> x_in, LVSolverStats *stats_out) {
+	LVStats stats;
+	double result;
+	{
+		LVPrintFunctionScope print(svm_set_print_string_function, LVsvm_print_function);
+		LVStatsScope scope(&stats);
+		result = LVsvm_predict(lvErr, model_in, x_in);
+	}
+
+	if (stats_out != nullptr)
+		stats.copyTo(*stats_out);
+	return result;
+}
+
+//-- Thread pool
+void LVsvm_set_thread_pool(lvError *lvErr, int32_t n_threads, const LVArray_Hdl<int32_t> cpus_in, int32_t priority) {
+	try {
+		if (n_threads < 0)
+			throw LVException(__FILE__, __LINE__, "The number of pool threads must not be negative.");
+
+		LVThreadPoolSettings settings = LVThreadPool::instance().settings();
+		settings.threads = static_cast<size_t>(n_threads);
+		settings.cpus.clear();
+		if (cpus_in != nullptr)
+			settings.cpus.assign((*cpus_in)->elt, (*cpus_in)->elt + (*cpus_in)->dimSize);
+		settings.priority = priority;
+
+		LVThreadPool::instance().configure(settings);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_get_thread_pool(lvError *lvErr, int32_t *n_threads_out, LVArray_Hdl<int32_t> cpus_out, int32_t *priority_out) {
+	try {
+		LVThreadPoolSettings settings = LVThreadPool::instance().settings();
+		*n_threads_out = static_cast<int32_t>(settings.threads);
+		*priority_out = settings.priority;
+		LVCopyToArrayHandle(cpus_out, settings.cpus);
+	}
+	catch (LVException &ex) {
+		(*cpus_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*cpus_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*cpus_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_set_core_reservation(lvError *lvErr, const LVArray_Hdl<int32_t> cpus_in) {
+	try {
+		LVThreadPoolSettings settings = LVThreadPool::instance().settings();
+		settings.reserved.clear();
+		if (cpus_in != nullptr)
+			settings.reserved.assign((*cpus_in)->elt, (*cpus_in)->elt + (*cpus_in)->dimSize);
+
+		LVThreadPool::instance().configure(settings);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_get_core_reservation(lvError *lvErr, LVArray_Hdl<int32_t> cpus_out) {
+	try {
+		LVCopyToArrayHandle(cpus_out, LVThreadPool::instance().settings().reserved);
+	}
+	catch (LVException &ex) {
+		(*cpus_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*cpus_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*cpus_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_shutdown(lvError *lvErr) {
+	try {
+		LVJobQueue::instance().shutdown();
+		LVThreadPool::instance().shutdown();
+		LVLogger::instance().shutdown();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//-- Print function (console logging)
+void LVsvm_print_function(const char * message) {
+	if (message == nullptr)
+		return;
+
+	// Called from inside the libsvm solver, nothing may be thrown through it (see LVCancellation.h)
+	try {
+		// Filter out the progress messages (..... and *), the others are queued for the next batch of the logger
+		if (strcmp(message, ".") != 0 && strcmp(message, "*") != 0) {
+			LVUserEventRef *usrEv = loggingUsrEv;
+			LVLog(message, (usrEv != nullptr) ? *usrEv : 0);
+		}
+
+		// Iterations and shrinking events of the statistics collector of the run, if any (see LVStatistics.h)
+		LVCountSolverOutput(message);
+
+		// The progress messages count into the iteration budget of the run, "." every 1000 iterations
+		LVCountIterations((strcmp(message, ".") == 0) ? 1000 : 0);
+	}
+	catch (...) {
+		// A message that cannot be logged is dropped
+	}
+}
+
+void LVsvm_set_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_in) {
+	loggingUsrEv = loggingUserEvent_in;
+	LVInstallPrintFunction(svm_set_print_string_function, LVsvm_print_function);
+}
+
+void LVsvm_get_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out) {
+	loggingUserEvent_out = loggingUsrEv;
+}
+
+void LVsvm_delete_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out) {
+	loggingUserEvent_out = loggingUsrEv;
+	loggingUsrEv = nullptr;
+}
+
+void LVsvm_set_logging_interval(lvError *lvErr, int32_t interval_ms) {
+	try {
+		if (interval_ms <= 0)
+			throw LVException(__FILE__, __LINE__, "The logging interval must be positive (" + std::to_string(interval_ms) + " ms).");
+
+		LVLogger::instance().setInterval(std::chrono::milliseconds(interval_ms));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_flush_log(lvError *lvErr) {
+	try {
+		LVLogger::instance().flush();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+
+//
+//-- File saving/loading
+//
+
+void LVsvm_save_model(lvError *lvErr, const char *path_in, const LVsvm_model *model_in) {
+	try {
+		// Convert LVsvm_model to svm_model
+		auto model = std::make_unique<svm_model>();
+		std::unique_ptr<svm_node[]> SV;
+		std::unique_ptr<double*[]> sv_coef;
+		LVConvertModel(*model_in, *model, SV, sv_coef);
+
+		// Same output as svm_save_model
+		LVWriteTextFile(path_in, LVFormatTextModel(*model, false));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_load_model(lvError *lvErr, const char *path_in, LVsvm_model *model_out) {
+	try {
+		LVMemoryMap map(path_in);
+		map.adviseSequential();
+
+		auto model = std::make_unique<svm_model>();
+		LVsvm_text_storage storage;
+		LVReadTextModel(map.data(), map.size(), *model, storage);
+
+		LVConvertModel(*model, *model_out);
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_save_model_round_trip(lvError *lvErr, const char *path_in, const LVsvm_model *model_in) {
+	try {
+		// Convert LVsvm_model to svm_model
+		auto model = std::make_unique<svm_model>();
+		std::unique_ptr<svm_node[]> SV;
+		std::unique_ptr<double*[]> sv_coef;
+		LVConvertModel(*model_in, *model, SV, sv_coef);
+
+		LVWriteTextFile(path_in, LVFormatTextModel(*model, true));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_save_model_binary(lvError *lvErr, const char *path_in, const LVsvm_model *model_in) {
+	try {
+		// Convert LVsvm_model to svm_model
+		auto model = std::make_unique<svm_model>();
+		std::unique_ptr<svm_node[]> SV;
+		std::unique_ptr<double*[]> sv_coef;
+		LVConvertModel(*model_in, *model, SV, sv_coef);
+
+		LVBinaryWriter writer(LVBinaryKind::Dense);
+		LVsvm_binary_parameter param_storage;
+		LVWriteBinaryModel(*model, writer, param_storage);
+		writer.writeFile(path_in);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_load_model_binary(lvError *lvErr, const char *path_in, LVsvm_model *model_out) {
+	try {
+		// The file is only read as it is copied into LabVIEW memory
+		LVMemoryMap map(path_in);
+		map.adviseSequential();
+
+		LVBinaryReader reader(map.data(), map.size(), LVBinaryKind::Dense);
+
+		auto model = std::make_unique<svm_model>();
+		std::unique_ptr<svm_node[]> SV;
+		std::unique_ptr<double*[]> sv_coef;
+		LVReadBinaryModel(reader, *model, SV, sv_coef);
+
+		LVConvertModel(*model, *model_out);
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_save_model_binary_scaled(lvError *lvErr, const char *path_in, const LVsvm_model *model_in, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in) {
+	try {
+		std::shared_ptr<const LVScaling> scaling = LVConvertScaling(scale_in, shift_in);
+
+		// Convert LVsvm_model to svm_model
+		auto model = std::make_unique<svm_model>();
+		std::unique_ptr<svm_node[]> SV;
+		std::unique_ptr<double*[]> sv_coef;
+		LVConvertModel(*model_in, *model, SV, sv_coef);
+
+		LVBinaryWriter writer(LVBinaryKind::Dense);
+		LVsvm_binary_parameter param_storage;
+		LVWriteBinaryModel(*model, writer, param_storage);
+		if (scaling)
+			LVWriteBinaryScaling(*scaling, writer);
+		writer.writeFile(path_in);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_serialize_model(lvError *lvErr, const LVsvm_model *model_in, LStrHandle model_out) {
+	try {
+		// Convert LVsvm_model to svm_model
+		auto model = std::make_unique<svm_model>();
+		std::unique_ptr<svm_node[]> SV;
+		std::unique_ptr<double*[]> sv_coef;
+		LVConvertModel(*model_in, *model, SV, sv_coef);
+
+		LVBinaryWriter writer(LVBinaryKind::Dense);
+		LVsvm_binary_parameter param_storage;
+		LVWriteBinaryModel(*model, writer, param_storage);
+		LVResizeStringHandle(model_out, writer.size());
+		writer.writeBuffer(reinterpret_cast<char*>((*model_out)->str));
+	}
+	catch (LVException &ex) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_serialize_model_text(lvError *lvErr, const LVsvm_model *model_in, LVBoolean round_trip, LStrHandle model_out) {
+	try {
+		// Convert LVsvm_model to svm_model
+		auto model = std::make_unique<svm_model>();
+		std::unique_ptr<svm_node[]> SV;
+		std::unique_ptr<double*[]> sv_coef;
+		LVConvertModel(*model_in, *model, SV, sv_coef);
+
+		LVWriteStringHandle(model_out, LVFormatTextModel(*model, round_trip != 0));
+	}
+	catch (LVException &ex) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_deserialize_model(lvError *lvErr, const LStrHandle model_in, LVsvm_model *model_out) {
+	try {
+		// Input validation: Empty string
+		if (model_in == nullptr || (*model_in)->cnt <= 0)
+			throw LVException(__FILE__, __LINE__, "Empty string passed to LVsvm_deserialize_model.");
+
+		const char *data = reinterpret_cast<const char*>((*model_in)->str);
+		size_t size = static_cast<size_t>((*model_in)->cnt);
+
+		auto model = std::make_unique<svm_model>();
+		if (LVIsBinaryModel(data, size)) {
+			// The sections are accessed in place, which requires aligned memory
+			std::unique_ptr<uint64_t[]> buffer = LVBinaryCopyAligned(data, size);
+			LVBinaryReader reader(reinterpret_cast<const char*>(buffer.get()), size, LVBinaryKind::Dense);
+
+			std::unique_ptr<svm_node[]> SV;
+			std::unique_ptr<double*[]> sv_coef;
+			LVReadBinaryModel(reader, *model, SV, sv_coef);
+
+			LVConvertModel(*model, *model_out);
+		}
+		else {
+			LVsvm_text_storage storage;
+			LVReadTextModel(data, size, *model, storage);
+
+			LVConvertModel(*model, *model_out);
+		}
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Native model handles
+//
+
+void LVsvm_load_model_handle(lvError *lvErr, const char *path_in, LVBoolean pack, uint64_t *handle_out) {
+	try {
+		*handle_out = 0;
+		*handle_out = modelHandles.add(LVLoadNativeModel(path_in, pack != 0));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_free_model_handle(lvError *lvErr, uint64_t handle) {
+	try {
+		modelHandles.remove(handle);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+double LVsvm_predict_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double> x_in) {
+	try {
+		LVLatencyScope latency;
+
+		// Input validation: Empty feature vector
+		if (x_in == nullptr || (*x_in)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, "Empty feature vector passed to libsvmdense_predict.");
+
+		// Input validation: Feature vector too large (exceeds max signed int)
+		if ((*x_in)->dimSize > INT_MAX)
+			throw LVException(__FILE__, __LINE__, "Feature vector too large (grater than " + std::to_string(INT_MAX) + ")");
+
+		auto native = modelHandles.get(handle);
+
+		std::vector<double> scaled;
+		svm_node node = LVScaleInput(*native, x_in, scaled);
+		return svm_predict(&native->view, &node);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+		return std::nan("");
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+		return std::nan("");
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+		return std::nan("");
+	}
+}
+
+double LVsvm_predict_values_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double> x_in, LVArray_Hdl<double> dec_values_out) {
+	try {
+		LVLatencyScope latency;
+
+		// Input validation: Empty feature vector
+		if (x_in == nullptr || (*x_in)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, "Empty feature vector passed to libsvmdense_predict_values.");
+
+		// Input validation: Feature vector too large (exceeds max signed int)
+		if ((*x_in)->dimSize > INT_MAX)
+			throw LVException(__FILE__, __LINE__, "Feature vector too large (grater than " + std::to_string(INT_MAX) + ")");
+
+		auto native = modelHandles.get(handle);
+		const svm_model *model = &native->view;
+
+		// Allocate room for dec_values output
+		if (model->param.svm_type == ONE_CLASS ||
+			model->param.svm_type == EPSILON_SVR ||
+			model->param.svm_type == NU_SVR) {
+			LVResizeNumericArrayHandle(dec_values_out, 1);
+			(*dec_values_out)->dimSize = 1;
+		}
+		else {
+			size_t n_pairs = model->nr_class * (model->nr_class - 1) / 2;
+			LVResizeNumericArrayHandle(dec_values_out, n_pairs);
+			(*dec_values_out)->dimSize = static_cast<uint32_t>(n_pairs);
+		}
+
+		std::vector<double> scaled;
+		svm_node node = LVScaleInput(*native, x_in, scaled);
+		return svm_predict_values(model, &node, (*dec_values_out)->elt);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+		(*dec_values_out)->dimSize = 0;
+		return std::nan("");
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+		(*dec_values_out)->dimSize = 0;
+		return std::nan("");
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+		(*dec_values_out)->dimSize = 0;
+		return std::nan("");
+	}
+}
+
+double LVsvm_predict_probability_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double> x_in, LVArray_Hdl<double> prob_estimates_out) {
+	try {
+		LVLatencyScope latency;
+
+		// Input validation: Empty feature vector
+		if (x_in == nullptr || (*x_in)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, "Empty feature vector passed to libsvmdense_predict_probability.");
+
+		// Input validation: Feature vector too large (exceeds max signed int)
+		if ((*x_in)->dimSize > INT_MAX)
+			throw LVException(__FILE__, __LINE__, "Feature vector too large (grater than " + std::to_string(INT_MAX) + ")");
+
+		auto native = modelHandles.get(handle);
+		const svm_model *model = &native->view;
+
+		// Check probability model
+		if (!svm_check_probability_model(model))
+			throw LVException(__FILE__, __LINE__, "The probability model is not valid.");
+
+		// Allocate room for probability estimates
+		// Regression and one-class SVM does not modify this value (returns the same as svm_predict)
+		if (model->param.svm_type == C_SVC || model->param.svm_type == NU_SVC) {
+			LVResizeNumericArrayHandle(prob_estimates_out, model->nr_class);
+			(*prob_estimates_out)->dimSize = model->nr_class;
+		}
+		else {
+			(*prob_estimates_out)->dimSize = 0;
+		}
+
+		std::vector<double> scaled;
+		svm_node node = LVScaleInput(*native, x_in, scaled);
+		return svm_predict_probability(model, &node, (*prob_estimates_out)->elt);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+		(*prob_estimates_out)->dimSize = 0;
+		return std::nan("");
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+		(*prob_estimates_out)->dimSize = 0;
+		return std::nan("");
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+		(*prob_estimates_out)->dimSize = 0;
+		return std::nan("");
+	}
+}
+
+void LVsvm_predict_batch_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double, 2> x_in, LVArray_Hdl<double> labels_out) {
+	try {
+		auto native = modelHandles.get(handle);
+		size_t l = (x_in != nullptr) ? (*x_in)->dimSize[0] : 0;
+
+		LVResizeNumericArrayHandle(labels_out, l);
+		(*labels_out)->dimSize = static_cast<uint32_t>(l);
+		LVPredictBatch(*native, x_in, (*labels_out)->elt, nullptr, 0);
+	}
+	catch (LVException &ex) {
+		(*labels_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*labels_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*labels_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_predict_values_batch_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double, 2> x_in, LVArray_Hdl<double> labels_out, LVArray_Hdl<double, 2> dec_values_out) {
+	try {
+		auto native = modelHandles.get(handle);
+		size_t l = (x_in != nullptr) ? (*x_in)->dimSize[0] : 0;
+		size_t n_dec = LVDecisionValueCount(native->view);
+
+		LVResizeNumericArrayHandle(labels_out, l);
+		(*labels_out)->dimSize = static_cast<uint32_t>(l);
+		LVResizeNumericArrayHandle(dec_values_out, l * n_dec);
+		(*dec_values_out)->dimSize[0] = static_cast<uint32_t>(l);
+		(*dec_values_out)->dimSize[1] = static_cast<uint32_t>(n_dec);
+		LVPredictBatch(*native, x_in, (*labels_out)->elt, (*dec_values_out)->elt, n_dec);
+	}
+	catch (LVException &ex) {
+		(*labels_out)->dimSize = 0;
+		(*dec_values_out)->dimSize[0] = 0;
+		(*dec_values_out)->dimSize[1] = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*labels_out)->dimSize = 0;
+		(*dec_values_out)->dimSize[0] = 0;
+		(*dec_values_out)->dimSize[1] = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*labels_out)->dimSize = 0;
+		(*dec_values_out)->dimSize[0] = 0;
+		(*dec_values_out)->dimSize[1] = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_set_model_handle_scaling(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in) {
+	try {
+		auto native = modelHandles.get(handle);
+		std::shared_ptr<const LVScaling> scaling = LVConvertScaling(scale_in, shift_in);
+
+		// Predictions in progress keep using the previous scaling
+		std::atomic_store(&native->scaling, scaling);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_get_model_handle_scaling(lvError *lvErr, uint64_t handle, LVArray_Hdl<double> scale_out, LVArray_Hdl<double> shift_out) {
+	try {
+		auto native = modelHandles.get(handle);
+		std::shared_ptr<const LVScaling> scaling = std::atomic_load(&native->scaling);
+
+		LVCopyToArrayHandle(scale_out, scaling ? scaling->scale() : std::vector<double>());
+		LVCopyToArrayHandle(shift_out, scaling ? scaling->shift() : std::vector<double>());
+	}
+	catch (LVException &ex) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_train_handle(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, uint64_t *handle_out) {
+	try {
+		LVThroughputScope throughput;
+
+		*handle_out = 0;
+		*handle_out = modelHandles.add(LVTrainNativeModel(*prob_in, *param_in));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Data files
+//
+
+void LVsvm_read_problem(lvError *lvErr, const char *path_in, int32_t n_features, LVBoolean skip_malformed, LVsvm_problem *prob_out, LVArray_Hdl<uint64_t> malformed_lines_out) {
+	try {
+		if (n_features < 0)
+			throw LVException(__FILE__, __LINE__, "The number of features must be non-negative.");
+
+		LVDataset dataset;
+		LVReadDatasetFile(path_in, 1, skip_malformed != 0, dataset);
+
+		if (n_features == 0)
+			n_features = dataset.maxIndex;
+		else if (dataset.maxIndex > n_features)
+			throw LVException(__FILE__, __LINE__, "The file contains feature index " + std::to_string(dataset.maxIndex) + ", which exceeds the number of features (" + std::to_string(n_features) + ").");
+
+		LVConvertDataset(dataset, n_features, *prob_out);
+		LVCopyToArrayHandle(malformed_lines_out, dataset.malformedLines);
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*malformed_lines_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*malformed_lines_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*malformed_lines_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_write_problem(lvError *lvErr, const char *path_in, const LVsvm_problem *prob_in) {
+	try {
+		// Input verification: Problem dimensions
+		if (prob_in->x == nullptr || prob_in->y == nullptr || (*(prob_in->x))->dimSize != (*(prob_in->y))->dimSize)
+			throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and feature vectors (x and y).");
+
+		size_t l = (*(prob_in->y))->dimSize;
+		const double *y = (*(prob_in->y))->elt;
+		const LVArray_Hdl<double> *x = (*(prob_in->x))->elt;
+
+		// Column j is written as feature index j+1
+		LVWriteTextFile(path_in, LVFormatDataset(l, [&](size_t i, LVTextWriter &writer) {
+			LVPutDatasetLabel(writer, y[i]);
+
+			LVArray_Hdl<double> xi = x[i];
+			if (xi != nullptr) {
+				for (uint32_t j = 0; j < (*xi)->dimSize; j++) {
+					if ((*xi)->elt[j] != 0)
+						LVPutDatasetNode(writer, static_cast<int32_t>(j + 1), (*xi)->elt[j]);
+				}
+			}
+
+			writer.put('\n');
+		}));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_read_delimited(lvError *lvErr, const char *path_in, uint8_t delimiter, int32_t header_rows, int32_t label_column, int32_t missing_policy, double missing_value, LVsvm_problem *prob_out, LVArray_Hdl<uint64_t> skipped_lines_out) {
+	try {
+		LVDelimitedOptions options = LVMakeDelimitedOptions(delimiter, header_rows, label_column, missing_policy, missing_value);
+
+		LVDenseTable table;
+		LVReadDelimitedFile(path_in, options, table);
+
+		LVConvertTable(table, *prob_out);
+		LVCopyToArrayHandle(skipped_lines_out, table.skippedLines);
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*skipped_lines_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*skipped_lines_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*skipped_lines_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Feature scaling
+//
+
+void LVsvm_compute_scaling(lvError *lvErr, const LVsvm_problem *prob_in, int32_t method, double lower, double upper, LVArray_Hdl<double> scale_out, LVArray_Hdl<double> shift_out) {
+	try {
+		LVScalingMethod scaling_method = LVCheckScalingMethod(method, lower, upper);
+		LVScaling scaling = LVComputeProblemScaling(*prob_in, scaling_method, lower, upper);
+
+		LVCopyToArrayHandle(scale_out, scaling.scale());
+		LVCopyToArrayHandle(shift_out, scaling.shift());
+	}
+	catch (LVException &ex) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_scale_problem(lvError *lvErr, LVsvm_problem *prob_inout, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in) {
+	try {
+		std::shared_ptr<const LVScaling> scaling = LVConvertScaling(scale_in, shift_in);
+		if (scaling)
+			LVScaleProblem(*scaling, *prob_inout);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Problem conversion
+//
+
+void LVsvm_problem_from_sparse(lvError *lvErr, const LVsvm_sparse_problem *prob_in, int32_t n_features, LVsvm_problem *prob_out) {
+	try {
+		LVCheckProblemSize(prob_in->y, prob_in->x);
+		if (n_features < 0)
+			throw LVException(__FILE__, __LINE__, "The number of features must be positive, or zero to use the largest index of the problem.");
+
+		int32_t max_index = LVSparseMaxIndex(prob_in->x, false);
+		LVSparseToDense(prob_in->x, false, (n_features > 0) ? n_features : max_index, prob_out->x);
+		LVCopyLabels(prob_in->y, prob_out->y);
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_problem_from_linear(lvError *lvErr, const LVsvm_linear_problem *prob_in, int32_t n_features, LVsvm_problem *prob_out) {
+	try {
+		LVCheckProblemSize(prob_in->y, prob_in->x);
+		if (n_features < 0)
+			throw LVException(__FILE__, __LINE__, "The number of features must be positive, or zero to use the largest index of the problem.");
+
+		int32_t max_index = LVSparseMaxIndex(prob_in->x, prob_in->bias >= 0);
+		LVSparseToDense(prob_in->x, prob_in->bias >= 0, (n_features > 0) ? n_features : max_index, prob_out->x);
+		LVCopyLabels(prob_in->y, prob_out->y);
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Feature selection
+//
+
+void LVsvm_fscore(lvError *lvErr, const LVsvm_problem *prob_in, int32_t n_select, LVArray_Hdl<double> fscore_out, LVArray_Hdl<int32_t> ranking_out, LVsvm_problem *prob_out) {
+	try {
+		size_t l = LVCheckProblemSize(prob_in->y, prob_in->x);
+		size_t n_features = LVDenseMaxLength(prob_in->x);
+		LVArray_Hdl<double> *x = (*(prob_in->x))->elt;
+
+		std::vector<double> fscore = LVComputeFScores((*(prob_in->y))->elt, l, n_features, [&](size_t i, LVClassStatistics &statistics) {
+			const double *values = (*x[i])->elt;
+			size_t n = (*x[i])->dimSize;
+			for (size_t j = 0; j < n; j++)
+				statistics.add(static_cast<int32_t>(j), values[j]);
+		});
+		std::vector<int32_t> ranking = LVRankFeatures(fscore, 0);
+
+		// The selected columns keep their order
+		size_t n = (n_select > 0) ? std::min(ranking.size(), static_cast<size_t>(n_select)) : ranking.size();
+		std::vector<int32_t> columns(ranking.begin(), ranking.begin() + n);
+		std::sort(columns.begin(), columns.end());
+		LVSelectDense(prob_in->x, columns, prob_out->x);
+		LVCopyLabels(prob_in->y, prob_out->y);
+
+		LVCopyToArrayHandle(fscore_out, fscore);
+		LVCopyToArrayHandle(ranking_out, ranking);
+	}
+	catch (LVException &ex) {
+		(*fscore_out)->dimSize = 0;
+		(*ranking_out)->dimSize = 0;
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*fscore_out)->dimSize = 0;
+		(*ranking_out)->dimSize = 0;
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*fscore_out)->dimSize = 0;
+		(*ranking_out)->dimSize = 0;
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_select_features(lvError *lvErr, const LVsvm_problem *prob_in, const LVArray_Hdl<int32_t> features_in, LVsvm_problem *prob_out) {
+	try {
+		LVCheckProblemSize(prob_in->y, prob_in->x);
+		size_t n_features = LVDenseMaxLength(prob_in->x);
+
+		size_t n = (features_in != nullptr) ? (*features_in)->dimSize : 0;
+		LVSelectionMask((n > 0) ? (*features_in)->elt : nullptr, n, 0, n_features);
+		std::vector<int32_t> columns((*features_in)->elt, (*features_in)->elt + n);
+		LVSelectDense(prob_in->x, columns, prob_out->x);
+		LVCopyLabels(prob_in->y, prob_out->y);
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Engine selection
+//
+
+void LVsvm_analyze_problem(lvError *lvErr, const LVsvm_problem *prob_in, int32_t svm_type, int32_t kernel_type, LVProblemProfile *profile_out, int32_t *backend_out, LStrHandle reason_out) {
+	try {
+		*profile_out = LVProblemProfile();
+		*backend_out = -1;
+
+		*profile_out = LVProfileProblem(*prob_in, kernel_type);
+		LVBackendChoice choice = LVSelectBackend(*profile_out, svm_type, kernel_type);
+
+		*backend_out = static_cast<int32_t>(choice.backend);
+		LVWriteStringHandle(reason_out, choice.reason);
+	}
+	catch (LVException &ex) {
+		if (DSCheckHandle(reason_out) == noErr)
+			(*reason_out)->cnt = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		if (DSCheckHandle(reason_out) == noErr)
+			(*reason_out)->cnt = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		if (DSCheckHandle(reason_out) == noErr)
+			(*reason_out)->cnt = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Binary model helpers
+//
+
+void LVWriteBinaryModel(const svm_model &model_in, LVBinaryWriter &writer, LVsvm_binary_parameter &param_storage) {
+	const svm_parameter &param = model_in.param;
+	int n_class = model_in.nr_class;
+	int n_pairs = n_class*(n_class - 1) / 2;
+	int n_SV = model_in.l;
+
+	if (n_SV <= 0 || model_in.SV == nullptr || model_in.sv_coef == nullptr || model_in.rho == nullptr)
+		throw LVException(__FILE__, __LINE__, "Uninitialized model passed to binary model writer.");
+
+	int n_features = model_in.SV[0].dim;
+
+	// Parameters
+	param_storage = LVsvm_binary_parameter();
+	param_storage.gamma = param.gamma;
+	param_storage.coef0 = param.coef0;
+	param_storage.cache_size = param.cache_size;
+	param_storage.eps = param.eps;
+	param_storage.C = param.C;
+	param_storage.nu = param.nu;
+	param_storage.p = param.p;
+	param_storage.svm_type = param.svm_type;
+	param_storage.kernel_type = param.kernel_type;
+	param_storage.degree = param.degree;
+	param_storage.shrinking = param.shrinking;
+	param_storage.probability = param.probability;
+	param_storage.nr_class = n_class;
+	param_storage.l = n_SV;
+	param_storage.n_features = n_features;
+	writer.addSection(LVSVM_SECTION_PARAMETER, &param_storage, 1);
+
+	int nr_weight = (param.weight != nullptr && param.weight_label != nullptr) ? param.nr_weight : 0;
+	writer.addSection<int32_t>(LVSVM_SECTION_WEIGHT_LABEL, param.weight_label, nr_weight);
+	writer.addSection<double>(LVSVM_SECTION_WEIGHT, param.weight, nr_weight);
+
+	// Model arrays (missing arrays are stored as empty sections)
+	writer.addSection<int32_t>(LVSVM_SECTION_LABEL, model_in.label, model_in.label ? n_class : 0);
+	writer.addSection<int32_t>(LVSVM_SECTION_NSV, model_in.nSV, model_in.nSV ? n_class : 0);
+	writer.addSection<double>(LVSVM_SECTION_RHO, model_in.rho, n_pairs);
+	writer.addSection<double>(LVSVM_SECTION_PROBA, model_in.probA, (param.probability && model_in.probA) ? n_pairs : 0);
+	writer.addSection<double>(LVSVM_SECTION_PROBB, model_in.probB, (param.probability && model_in.probB) ? n_pairs : 0);
+	writer.addSection<int32_t>(LVSVM_SECTION_SV_INDICES, model_in.sv_indices, model_in.sv_indices ? n_SV : 0);
+
+	// sv_coef is gathered row by row
+	writer.beginSection(LVSVM_SECTION_SV_COEF, sizeof(double));
+	for (int i = 0; i < n_class - 1; i++)
+		writer.appendChunk(model_in.sv_coef[i], n_SV);
+
+	// Support vectors are stored as a single row-major matrix
+	writer.beginSection(LVSVM_SECTION_SV_VALUES, sizeof(double));
+	for (int i = 0; i < n_SV; i++) {
+		if (model_in.SV[i].dim != n_features)
+			throw LVException(__FILE__, __LINE__, "All support vectors in the model must have same length (libsvm-dense only).");
+		if (model_in.SV[i].values == nullptr && n_features > 0)
+			throw LVException(__FILE__, __LINE__, "Model error: A support vector in the model is invalid (null).");
+
+		writer.appendChunk(model_in.SV[i].values, n_features);
+	}
+}
+
+void LVReadBinaryModel(const LVBinaryReader &reader, svm_model &model_out, std::unique_ptr<svm_node[]> &SV, std::unique_ptr<double*[]> &sv_coef) {
+	const LVsvm_binary_parameter &bparam = reader.scalar<LVsvm_binary_parameter>(LVSVM_SECTION_PARAMETER);
+
+	int n_class = bparam.nr_class;
+	int n_SV = bparam.l;
+	int n_features = bparam.n_features;
+	if (n_class < 1 || n_SV <= 0 || n_features < 0)
+		throw LVException(__FILE__, __LINE__, "Invalid binary model: number of classes, support vectors or features is invalid.");
+
+	size_t n_pairs = static_cast<size_t>(n_class)*(n_class - 1) / 2;
+
+	// Parameters
+	svm_parameter &param = model_out.param;
+	param.svm_type = bparam.svm_type;
+	param.kernel_type = bparam.kernel_type;
+	param.degree = bparam.degree;
+	param.gamma = bparam.gamma;
+	param.coef0 = bparam.coef0;
+	param.cache_size = bparam.cache_size;
+	param.eps = bparam.eps;
+	param.C = bparam.C;
+	param.nu = bparam.nu;
+	param.p = bparam.p;
+	param.shrinking = bparam.shrinking;
+	param.probability = bparam.probability;
+
+	size_t n_weight = 0, n_weight_label = 0;
+	param.weight = const_cast<double*>(reader.section<double>(LVSVM_SECTION_WEIGHT, n_weight));
+	param.weight_label = const_cast<int*>(reader.section<int32_t>(LVSVM_SECTION_WEIGHT_LABEL, n_weight_label));
+	if (n_weight != n_weight_label)
+		throw LVException(__FILE__, __LINE__, "Invalid binary model: the number of elements in weight and weight_label does not match.");
+	param.nr_weight = static_cast<int>(n_weight);
+
+	model_out.nr_class = n_class;
+	model_out.l = n_SV;
+	model_out.free_sv = 0;
+
+	// Helper to verify the expected section lengths (count 0 means the array is absent)
+	auto checkCount = [](size_t count, size_t expected, bool optional, const char *name) {
+		if (count != expected && !(optional && count == 0))
+			throw LVException(__FILE__, __LINE__, std::string("Invalid binary model: unexpected number of elements in ") + name + ".");
+	};
+
+	size_t count = 0;
+	model_out.label = const_cast<int*>(reader.section<int32_t>(LVSVM_SECTION_LABEL, count));
+	checkCount(count, n_class, true, "label");
+
+	model_out.nSV = const_cast<int*>(reader.section<int32_t>(LVSVM_SECTION_NSV, count));
+	checkCount(count, n_class, true, "nSV");
+
+	model_out.rho = const_cast<double*>(reader.section<double>(LVSVM_SECTION_RHO, count));
+	checkCount(count, n_pairs, false, "rho");
+	if (model_out.rho == nullptr)
+		throw LVException(__FILE__, __LINE__, "Invalid binary model: rho is missing.");
+
+	model_out.probA = const_cast<double*>(reader.section<double>(LVSVM_SECTION_PROBA, count));
+	checkCount(count, n_pairs, true, "probA");
+
+	model_out.probB = const_cast<double*>(reader.section<double>(LVSVM_SECTION_PROBB, count));
+	checkCount(count, n_pairs, true, "probB");
+
+	model_out.sv_indices = const_cast<int*>(reader.section<int32_t>(LVSVM_SECTION_SV_INDICES, count));
+	checkCount(count, n_SV, true, "sv_indices");
+
+	// sv_coef ((n_class-1) x n_SV)
+	const double *coef = reader.section<double>(LVSVM_SECTION_SV_COEF, count);
+	checkCount(count, static_cast<size_t>(n_class - 1) * n_SV, false, "sv_coef");
+	sv_coef = std::make_unique<double*[]>(n_class - 1);
+	for (int i = 0; i < n_class - 1; i++)
+		sv_coef[i] = const_cast<double*>(coef + static_cast<size_t>(i) * n_SV);
+	model_out.sv_coef = sv_coef.get();
+
+	// Support vectors point directly into the values section
+	const double *values = reader.section<double>(LVSVM_SECTION_SV_VALUES, count);
+	checkCount(count, static_cast<size_t>(n_SV) * n_features, false, "SV");
+
+	SV = std::make_unique<svm_node[]>(n_SV);
+	for (int i = 0; i < n_SV; i++) {
+		SV[i].dim = n_features;
+		SV[i].values = const_cast<double*>(values + static_cast<size_t>(i) * n_features);
+	}
+	model_out.SV = SV.get();
+}
+
+//
+//-- Native model helpers
+//
+
+std::shared_ptr<LVsvm_native_model> LVLoadNativeModel(const char *path_in, bool pack) {
+	auto native = std::make_shared<LVsvm_native_model>();
+
+	// Binary models are used directly from the mapping, the pages are shared between processes
+	native->map.open(path_in);
+	if (LVIsBinaryModel(native->map.data(), native->map.size())) {
+		LVBinaryReader reader(native->map.data(), native->map.size(), LVBinaryKind::Dense);
+		LVReadBinaryModel(reader, native->view, native->SV, native->sv_coef);
+		native->scaling = LVReadBinaryScaling(reader);
+	}
+	else {
+		// Text models are parsed into contiguous storage, the mapping is only needed while parsing
+		native->map.adviseSequential();
+		LVReadTextModel(native->map.data(), native->map.size(), native->view, native->text);
+		native->map.close();
+	}
+
+	// Text models are already packed
+	if (pack && native->map.isOpen()) {
+		svm_model packed = native->view;
+		std::unique_ptr<svm_node[]> SV;
+		std::unique_ptr<double[]> values;
+		LVPackSupportVectors(native->view, packed, SV, values);
+
+		native->view = packed;
+		native->SV = std::move(SV);
+		native->values = std::move(values);
+	}
+
+	return native;
+}
+
+std::shared_ptr<LVsvm_native_model> LVTrainNativeModel(const LVsvm_problem &prob_in, const LVsvm_parameter &param_in) {
+	size_t l = LVCheckProblem(prob_in, "svm_train");
+
+	// Input verification: Problem dimensions (n_vectors equals n_labels)
+	if (prob_in.y == nullptr || (*(prob_in.y))->dimSize != l)
+		throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and feature vectors (x and y).");
+
+	// Input validation: Number of vectors too large (exceeds max signed int)
+	if (l > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Number of vectors too large (greater than " + std::to_string(INT_MAX) + ")");
+
+	svm_problem prob;
+	prob.l = static_cast<int>(l);
+	prob.y = (*(prob_in.y))->elt;
+
+	uint32_t n_features = (*(*(prob_in.x))->elt[0])->dimSize;
+	auto x = std::make_unique<svm_node[]>(l);
+	prob.x = x.get();
+	for (size_t i = 0; i < l; i++) {
+		// Disallow feature vectors of different size, they are truncated in the dot-product anyway.
+		if ((*(*(prob_in.x))->elt[i])->dimSize != n_features)
+			throw LVException(__FILE__, __LINE__, "Feature vector #" + std::to_string(i) + " differs in length from the rest.");
+
+		x[i].dim = n_features;
+		x[i].values = (*(*(prob_in.x))->elt[i])->elt;
+	}
+
+	svm_parameter param;
+	LVConvertParameter(param_in, param);
+
+	return LVTrainNativeModel(prob, param);
+}
+
+std::shared_ptr<LVsvm_native_model> LVTrainNativeModel(const svm_problem &prob, const svm_parameter &param) {
+	const char * param_check = svm_check_parameter(&prob, &param);
+	if (param_check != nullptr)
+		throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check));
+
+	auto native = std::make_shared<LVsvm_native_model>();
+	native->trained.reset(svm_train(&prob, &param));
+
+	// The weights reference the parameters and the support vectors the problem, neither outlives this call
+	native->trained->param.nr_weight = 0;
+	native->trained->param.weight_label = nullptr;
+	native->trained->param.weight = nullptr;
+
+	native->view = *native->trained;
+	LVPackSupportVectors(*native->trained, native->view, native->SV, native->values);
+
+	return native;
+}
+
+LVsvm_job::LVsvm_job(const LVsvm_problem &prob_in, const LVsvm_parameter &param_in, int32_t nr_fold) : nr_fold(nr_fold), prob(), param() {
+	size_t l = LVCheckProblem(prob_in, (nr_fold == 0) ? "svm_train_async" : "svm_cross_validation_async");
+
+	// Input verification: Problem dimensions (n_vectors equals n_labels)
+	if (prob_in.y == nullptr || (*(prob_in.y))->dimSize != l)
+		throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and feature vectors (x and y).");
+
+	// Input validation: Number of vectors too large (exceeds max signed int)
+	if (l > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Number of vectors too large (greater than " + std::to_string(INT_MAX) + ")");
+
+	y.assign((*(prob_in.y))->elt, (*(prob_in.y))->elt + l);
+
+	// The vectors are copied into a single block (n_vectors x n_features)
+	uint32_t n_features = (*(*(prob_in.x))->elt[0])->dimSize;
+	values.resize(l * n_features);
+	x.resize(l);
+	for (size_t i = 0; i < l; i++) {
+		auto xi_in_Hdl = (*(prob_in.x))->elt[i];
+		if ((*xi_in_Hdl)->dimSize != n_features)
+			throw LVException(__FILE__, __LINE__, "Feature vector #" + std::to_string(i) + " differs in length from the rest.");
+
+		x[i].dim = n_features;
+		x[i].values = values.data() + i * n_features;
+		std::copy((*xi_in_Hdl)->elt, (*xi_in_Hdl)->elt + n_features, x[i].values);
+	}
+
+	prob.l = static_cast<int>(l);
+	prob.y = y.data();
+	prob.x = x.data();
+
+	LVConvertParameter(param_in, param);
+	if (param.nr_weight > 0) {
+		weight_label.assign(param.weight_label, param.weight_label + param.nr_weight);
+		weight.assign(param.weight, param.weight + param.nr_weight);
+		param.weight_label = weight_label.data();
+		param.weight = weight.data();
+	}
+
+	const char * param_check = svm_check_parameter(&prob, &param);
+	if (param_check != nullptr)
+		throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check));
+}
+
+void LVsvm_job::run() {
+	// The print function counts the iterations of the library solvers into the budgets (the job runs under the stop condition of its token)
+	LVInstallPrintFunction(svm_set_print_string_function, LVsvm_print_function);
+
+	if (nr_fold == 0) {
+		model = LVTrainNativeModel(prob, param);
+	}
+	else {
+		target.resize(y.size());
+		LVCrossValidate(prob, param, nr_fold, target.data());
+	}
+}
+
+std::shared_ptr<LVsvm_job> LVCollectJob(uint64_t job, bool crossValidation) {
+	auto collected = std::dynamic_pointer_cast<LVsvm_job>(LVJobQueue::instance().get(job));
+	if (!collected || (collected->nr_fold != 0) != crossValidation)
+		throw LVException(__FILE__, __LINE__, std::string("The job is not a ") + (crossValidation ? "cross-validation" : "training") + " job.");
+
+	// The job is released whether it succeeded or not
+	LVJobQueue::instance().release(job);
+	collected->join();
+	return collected;
+}
+
+std::shared_ptr<const LVCancellationToken> LVGetCancellationToken(uint64_t token) {
+	if (token == 0)
+		return nullptr;
+
+	return tokenHandles.get(token);
+}
+
+void LVCrossValidate(const svm_problem &prob, const svm_parameter &param, int nr_fold, double *target) {
+	// The library's cross-validation cannot be stopped between its folds
+	if (LVStopCondition::current() == nullptr) {
+		svm_cross_validation(&prob, &param, nr_fold, target);
+		return;
+	}
+
+	if (nr_fold < 2)
+		throw LVException(__FILE__, __LINE__, "The number of folds must be at least 2.");
+
+	bool classification = param.svm_type == C_SVC || param.svm_type == NU_SVC;
+	bool probability = classification && param.probability != 0;
+
+	// Stratified as svm_cross_validation
+	size_t l = static_cast<size_t>(prob.l);
+	LVFolds folds = LVMakeFolds(prob.y, l, static_cast<size_t>(nr_fold), classification);
+
+	// One pool task per fold, the checkpoints of the tasks stop the run between folds.
+	// At most half the folds run at once, so that every thread tests the stop condition between two of its folds
+	size_t max_threads = std::max<size_t>(1, folds.count() / 2);
+	LVThreadPool::instance().parallelFor(folds.count(), [&](size_t f) {
+		size_t begin = folds.start[f];
+		size_t end = folds.start[f + 1];
+
+		// Training problem of the other folds, referencing the input vectors
+		std::vector<svm_node> sub_x;
+		std::vector<double> sub_y;
+		for (size_t k = 0; k < l; k++) {
+			if (k < begin || k >= end) {
+				sub_x.push_back(prob.x[folds.perm[k]]);
+				sub_y.push_back(prob.y[folds.perm[k]]);
+			}
+		}
+
+		svm_problem sub_prob;
+		sub_prob.l = static_cast<int>(sub_y.size());
+		sub_prob.x = sub_x.data();
+		sub_prob.y = sub_y.data();
+
+		std::unique_ptr<svm_model, LVsvm_model_deleter> submodel(svm_train(&sub_prob, &param));
+
+		std::vector<double> prob_estimates(static_cast<size_t>(submodel->nr_class));
+		for (size_t k = begin; k < end; k++)
+			target[folds.perm[k]] = probability ? svm_predict_probability(submodel.get(), &prob.x[folds.perm[k]], prob_estimates.data()) : svm_predict(submodel.get(), &prob.x[folds.perm[k]]);
+	}, LVWorkPriority::Throughput, max_threads);
+
+	// The last folds may have exceeded the budgets
+	LVCheckpoint();
+}
+
+size_t LVGridSearch(const svm_problem &prob, const svm_parameter &param, int nr_fold, const std::vector<double> &C, const std::vector<double> &gamma, std::shared_ptr<const LVCancellationToken> token, std::vector<double> &score_out, std::unique_ptr<LVStopped> &stopped_out) {
+	if (nr_fold < 2)
+		throw LVException(__FILE__, __LINE__, "The number of folds must be at least 2.");
+
+	// Grid points C by C, every one is verified before the search starts
+	std::vector<LVGridPoint> points;
+	for (double point_C : C) {
+		for (double point_gamma : gamma) {
+			svm_parameter point_param = param;
+			point_param.C = point_C;
+			point_param.gamma = point_gamma;
+
+			const char * param_check = svm_check_parameter(&prob, &point_param);
+			if (param_check != nullptr)
+				throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check) + " (C = " + std::to_string(point_C) + ", gamma = " + std::to_string(point_gamma) + ")");
+
+			points.push_back(LVGridPoint{ point_C, point_gamma });
+		}
+	}
+
+	bool classification = param.svm_type == C_SVC || param.svm_type == NU_SVC;
+	bool regression = param.svm_type == EPSILON_SVR || param.svm_type == NU_SVR;
+	bool probability = classification && param.probability != 0;
+
+	// The same folds for every grid point, stratified as svm_cross_validation
+	size_t l = static_cast<size_t>(prob.l);
+	LVFolds folds = LVMakeFolds(prob.y, l, static_cast<size_t>(nr_fold), classification);
+
+	score_out = LVCrossValidateGrid(points, folds, token, [&](size_t point, size_t f) {
+		size_t begin = folds.start[f];
+		size_t end = folds.start[f + 1];
+
+		// Training problem of the other folds, referencing the input vectors
+		std::vector<svm_node> sub_x;
+		std::vector<double> sub_y;
+		for (size_t k = 0; k < l; k++) {
+			if (k < begin || k >= end) {
+				sub_x.push_back(prob.x[folds.perm[k]]);
+				sub_y.push_back(prob.y[folds.perm[k]]);
+			}
+		}
+
+		svm_problem sub_prob;
+		sub_prob.l = static_cast<int>(sub_y.size());
+		sub_prob.x = sub_x.data();
+		sub_prob.y = sub_y.data();
+
+		svm_parameter point_param = param;
+		point_param.C = points[point].C;
+		point_param.gamma = points[point].gamma;
+
+		std::unique_ptr<svm_model, LVsvm_model_deleter> submodel(svm_train(&sub_prob, &point_param));
+
+		// Correct predictions (classification) or squared errors (regression) of the fold, predicted as svm_cross_validation
+		std::vector<double> prob_estimates(static_cast<size_t>(submodel->nr_class));
+		double sum = 0;
+		for (size_t k = begin; k < end; k++) {
+			double y = prob.y[folds.perm[k]];
+			double predicted = probability ? svm_predict_probability(submodel.get(), &prob.x[folds.perm[k]], prob_estimates.data()) : svm_predict(submodel.get(), &prob.x[folds.perm[k]]);
+			if (regression)
+				sum += (predicted - y) * (predicted - y);
+			else if (predicted == y)
+				sum++;
+		}
+		return sum;
+	}, stopped_out);
+
+	return LVBestGridPoint(score_out, regression);
+}
+
+void LVPackSupportVectors(const svm_model &model_in, svm_model &model_out, std::unique_ptr<svm_node[]> &SV, std::unique_ptr<double[]> &values) {
+	int n_SV = model_in.l;
+	if (n_SV <= 0 || model_in.SV == nullptr)
+		throw LVException(__FILE__, __LINE__, "Uninitialized model passed to LVPackSupportVectors.");
+
+	int n_features = model_in.SV[0].dim;
+	for (int i = 0; i < n_SV; i++) {
+		if (model_in.SV[i].dim != n_features)
+			throw LVException(__FILE__, __LINE__, "All support vectors in the model must have same length (libsvm-dense only).");
+	}
+
+	// Row-major matrix in support vector order
+	values = std::make_unique<double[]>(static_cast<size_t>(n_SV) * n_features);
+	SV = std::make_unique<svm_node[]>(n_SV);
+	for (int i = 0; i < n_SV; i++) {
+		double *row = values.get() + static_cast<size_t>(i) * n_features;
+		std::memcpy(row, model_in.SV[i].values, n_features * sizeof(double));
+		SV[i].dim = n_features;
+		SV[i].values = row;
+	}
+
+	model_out.SV = SV.get();
+}
+
+//
+//-- Text model helpers
+//
+
+// Keywords of the libsvm text format (indexed by svm_type/kernel_type)
+static const char *LVsvm_type_table[] = { "c_svc", "nu_svc", "one_class", "epsilon_svr", "nu_svr", nullptr };
+static const char *LVsvm_kernel_type_table[] = { "linear", "polynomial", "rbf", "sigmoid", "precomputed", nullptr };
+
+std::vector<std::string> LVFormatTextModel(const svm_model &model_in, bool roundTrip) {
+	const svm_parameter &param = model_in.param;
+	int nr_class = model_in.nr_class;
+	int nr_pairs = nr_class*(nr_class - 1) / 2;
+	int l = model_in.l;
+
+	if (param.svm_type < C_SVC || param.svm_type > NU_SVR || param.kernel_type < LINEAR || param.kernel_type > PRECOMPUTED)
+		throw LVException(__FILE__, __LINE__, "The model has an invalid svm_type or kernel_type.");
+
+	if (nr_class < 1 || l < 0 || (nr_pairs > 0 && model_in.rho == nullptr) || (l > 0 && (model_in.SV == nullptr || (nr_class > 1 && model_in.sv_coef == nullptr))))
+		throw LVException(__FILE__, __LINE__, "Uninitialized model passed to LVFormatTextModel.");
+
+	std::vector<std::string> parts;
+
+	// Header (the formats match svm_save_model in libsvm 3.22)
+	LVTextWriter header;
+	header.put("svm_type ");
+	header.put(LVsvm_type_table[param.svm_type]);
+	header.put("\nkernel_type ");
+	header.put(LVsvm_kernel_type_table[param.kernel_type]);
+	header.put('\n');
+
+	if (param.kernel_type == POLY) {
+		header.put("degree ");
+		header.putInt(param.degree);
+		header.put('\n');
+	}
+
+	if (param.kernel_type == POLY || param.kernel_type == RBF || param.kernel_type == SIGMOID) {
+		header.put("gamma ");
+		header.putDouble(param.gamma, 6, roundTrip);
+		header.put('\n');
+	}
+
+	if (param.kernel_type == POLY || param.kernel_type == SIGMOID) {
+		header.put("coef0 ");
+		header.putDouble(param.coef0, 6, roundTrip);
+		header.put('\n');
+	}
+
+	header.put("nr_class ");
+	header.putInt(nr_class);
+	header.put("\ntotal_sv ");
+	header.putInt(l);
+	header.put("\nrho");
+	for (int i = 0; i < nr_pairs; i++) {
+		header.put(' ');
+		header.putDouble(model_in.rho[i], 6, roundTrip);
+	}
+	header.put('\n');
+
+	if (model_in.label != nullptr) {
+		header.put("label");
+		for (int i = 0; i < nr_class; i++) {
+			header.put(' ');
+			header.putInt(model_in.label[i]);
+		}
+		header.put('\n');
+	}
+
+	if (model_in.probA != nullptr) {
+		header.put("probA");
+		for (int i = 0; i < nr_pairs; i++) {
+			header.put(' ');
+			header.putDouble(model_in.probA[i], 6, roundTrip);
+		}
+		header.put('\n');
+	}
+
+	if (model_in.probB != nullptr) {
+		header.put("probB");
+		for (int i = 0; i < nr_pairs; i++) {
+			header.put(' ');
+			header.putDouble(model_in.probB[i], 6, roundTrip);
+		}
+		header.put('\n');
+	}
+
+	if (model_in.nSV != nullptr) {
+		header.put("nr_sv");
+		for (int i = 0; i < nr_class; i++) {
+			header.put(' ');
+			header.putInt(model_in.nSV[i]);
+		}
+		header.put('\n');
+	}
+
+	header.put("SV\n");
+	parts.push_back(std::move(header.str()));
+
+	// Support vectors, each thread formats a contiguous range of rows into its own part
+	size_t nThreads = LVThreadCount(l, 256);
+	size_t firstPart = parts.size();
+	parts.resize(firstPart + nThreads);
+
+	LVParallelFor(nThreads, [&](size_t t) {
+		size_t begin = static_cast<size_t>(l) * t / nThreads;
+		size_t end = static_cast<size_t>(l) * (t + 1) / nThreads;
+
+		LVTextWriter writer;
+		for (size_t i = begin; i < end; i++) {
+			for (int j = 0; j < nr_class - 1; j++) {
+				writer.putDouble(model_in.sv_coef[j][i], 16, roundTrip);
+				writer.put(' ');
+			}
+
+			// Zeros are omitted and the indices are zero-based (libsvm-dense)
+			const svm_node &sv = model_in.SV[i];
+			if (param.kernel_type == PRECOMPUTED) {
+				writer.put("0:");
+				writer.putInt(static_cast<int>(sv.values[0]));
+				writer.put(' ');
+			}
+			else {
+				for (int j = 0; j < sv.dim; j++) {
+					if (sv.values[j] != 0.0) {
+						writer.putInt(j);
+						writer.put(':');
+						writer.putDouble(sv.values[j], 8, roundTrip);
+						writer.put(' ');
+					}
+				}
+			}
+			writer.put('\n');
+		}
+
+		parts[firstPart + t] = std::move(writer.str());
+	});
+
+	return parts;
+}
+
+// Returns the index of word in a null-terminated table, or -1
+static int LVFindKeyword(const char *table[], const std::string &word) {
+	for (int i = 0; table[i] != nullptr; i++) {
+		if (word == table[i])
+			return i;
+	}
+	return -1;
+}
+
+void LVReadTextModel(const char *data, size_t size, svm_model &model_out, LVsvm_text_storage &storage) {
+	const char *end = data + size;
+	LVTextCursor cursor(data, end);
+
+	model_out = svm_model();
+	storage = LVsvm_text_storage();
+	svm_parameter &param = model_out.param;
+
+	int nr_class = 0;
+	int l = -1;
+	bool sv_section = false;
+
+	auto requireClasses = [&](const std::string &key) {
+		if (nr_class < 1)
+			cursor.fail("nr_class must precede " + key);
+	};
+
+	auto readDoubles = [&](std::vector<double> &values, int n) {
+		values.resize(n);
+		for (int i = 0; i < n; i++)
+			values[i] = cursor.readDouble();
+	};
+
+	auto readInts = [&](std::vector<int> &values, int n) {
+		values.resize(n);
+		for (int i = 0; i < n; i++)
+			values[i] = cursor.readInt();
+	};
+
+	// Header (same keywords as svm_load_model)
+	while (cursor.skipEmptyLines()) {
+		std::string key = cursor.readWord();
+
+		if (key == "svm_type") {
+			std::string value = cursor.readWord();
+			param.svm_type = LVFindKeyword(LVsvm_type_table, value);
+			if (param.svm_type < 0)
+				cursor.fail("unknown svm type '" + value + "'");
+		}
+		else if (key == "kernel_type") {
+			std::string value = cursor.readWord();
+			param.kernel_type = LVFindKeyword(LVsvm_kernel_type_table, value);
+			if (param.kernel_type < 0)
+				cursor.fail("unknown kernel function '" + value + "'");
+		}
+		else if (key == "degree") {
+			param.degree = cursor.readInt();
+		}
+		else if (key == "gamma") {
+			param.gamma = cursor.readDouble();
+		}
+		else if (key == "coef0") {
+			param.coef0 = cursor.readDouble();
+		}
+		else if (key == "nr_class") {
+			nr_class = cursor.readInt();
+			if (nr_class < 1)
+				cursor.fail("nr_class must be positive");
+		}
+		else if (key == "total_sv") {
+			l = cursor.readInt();
+			if (l < 0)
+				cursor.fail("total_sv must be non-negative");
+		}
+		else if (key == "rho") {
+			requireClasses(key);
+			readDoubles(storage.rho, nr_class*(nr_class - 1) / 2);
+		}
+		else if (key == "label") {
+			requireClasses(key);
+			readInts(storage.label, nr_class);
+		}
+		else if (key == "probA") {
+			requireClasses(key);
+			readDoubles(storage.probA, nr_class*(nr_class - 1) / 2);
+		}
+		else if (key == "probB") {
+			requireClasses(key);
+			readDoubles(storage.probB, nr_class*(nr_class - 1) / 2);
+		}
+		else if (key == "nr_sv") {
+			requireClasses(key);
+			readInts(storage.nSV, nr_class);
+		}
+		else if (key == "SV") {
+			cursor.nextLine();
+			sv_section = true;
+			break;
+		}
+		else {
+			cursor.fail("unknown text in model file '" + key + "'");
+		}
+
+		if (!cursor.atEndOfLine())
+			cursor.fail("unexpected text after " + key);
+		cursor.nextLine();
+	}
+
+	if (!sv_section || nr_class < 1 || l < 0)
+		throw LVException(__FILE__, __LINE__, "Invalid model file: nr_class, total_sv or the SV section is missing.");
+
+	if (static_cast<int>(storage.rho.size()) != nr_class*(nr_class - 1) / 2)
+		throw LVException(__FILE__, __LINE__, "Invalid model file: rho is missing.");
+
+	// Support vectors
+	// First pass counts the rows and finds the largest index of each chunk, so that the second pass can parse directly into the final matrix
+	const char *body = cursor.position();
+	size_t bodyLine = cursor.line();
+	int nr_coef = nr_class - 1;
+
+	std::vector<const char*> bounds = LVSplitLines(body, end, LVThreadCount(static_cast<size_t>(end - body), 1 << 18));
+	size_t nChunks = bounds.size() - 1;
+
+	std::vector<size_t> rowOffset(nChunks + 1, 0);
+	std::vector<size_t> lineOffset(nChunks + 1, 0);
+	std::vector<int> maxIndex(nChunks, -1);
+
+	LVParallelFor(nChunks, [&](size_t c) {
+		rowOffset[c + 1] = LVCountNonEmptyLines(bounds[c], bounds[c + 1]);
+		lineOffset[c + 1] = LVCountLineBreaks(bounds[c], bounds[c + 1]);
+
+		// The index is the integer in front of each ':' (validated in the second pass)
+		for (const char *p = std::find(bounds[c], bounds[c + 1], ':'); p != bounds[c + 1]; p = std::find(p + 1, bounds[c + 1], ':')) {
+			const char *q = p;
+			while (q > bounds[c] && q[-1] >= '0' && q[-1] <= '9')
+				q--;
+
+			int index = 0;
+			for (; q < p && index <= INT_MAX / 10 - 1; q++)
+				index = index * 10 + (*q - '0');
+			maxIndex[c] = std::max(maxIndex[c], index);
+		}
+	});
+
+	int dim = 0;
+	for (size_t c = 0; c < nChunks; c++) {
+		rowOffset[c + 1] += rowOffset[c];
+		lineOffset[c + 1] += lineOffset[c];
+		dim = std::max(dim, maxIndex[c] + 1);
+	}
+
+	if (rowOffset[nChunks] != static_cast<size_t>(l))
+		throw LVException(__FILE__, __LINE__, "Invalid model file: total_sv is " + std::to_string(l) + ", but the SV section contains " + std::to_string(rowOffset[nChunks]) + " support vectors.");
+
+	// All support vectors have the same length (the largest index + 1), omitted values are zero
+	storage.coef.resize(static_cast<size_t>(nr_coef) * l);
+	storage.SV.resize(l);
+	storage.values.assign(static_cast<size_t>(l) * dim, 0.0);
+
+	LVParallelFor(nChunks, [&](size_t c) {
+		LVTextCursor chunk(bounds[c], bounds[c + 1], bodyLine + lineOffset[c]);
+		size_t row = rowOffset[c];
+
+		while (chunk.skipEmptyLines()) {
+			double *values = storage.values.data() + row * dim;
+			storage.SV[row].dim = dim;
+			storage.SV[row].values = values;
+
+			for (int j = 0; j < nr_coef; j++)
+				storage.coef[j * static_cast<size_t>(l) + row] = chunk.readDouble();
+
+			while (!chunk.atEndOfLine()) {
+				int index = chunk.readInt();
+				if (index < 0 || index >= dim)
+					chunk.fail("invalid feature index " + std::to_string(index));
+				chunk.expect(':');
+				values[index] = chunk.readDouble();
+			}
+
+			row++;
+			chunk.nextLine();
+		}
+	});
+
+	storage.sv_coef.resize(nr_coef);
+	for (int j = 0; j < nr_coef; j++)
+		storage.sv_coef[j] = storage.coef.data() + j * static_cast<size_t>(l);
+
+	// Assign the model
+	model_out.nr_class = nr_class;
+	model_out.l = l;
+	model_out.SV = (l > 0) ? storage.SV.data() : nullptr;
+	model_out.sv_coef = (nr_coef > 0) ? storage.sv_coef.data() : nullptr;
+	model_out.rho = storage.rho.empty() ? nullptr : storage.rho.data();
+	model_out.probA = storage.probA.empty() ? nullptr : storage.probA.data();
+	model_out.probB = storage.probB.empty() ? nullptr : storage.probB.data();
+	model_out.label = storage.label.empty() ? nullptr : storage.label.data();
+	model_out.nSV = storage.nSV.empty() ? nullptr : storage.nSV.data();
+	model_out.sv_indices = nullptr;
+	model_out.free_sv = 0;
+
+	// Only the kernel parameters are stored in the file, the LabVIEW model needs the probability flag to return probA/probB
+	param.probability = (model_out.probA != nullptr);
+}
+
+//
+//-- Data file helpers
+//
+
+void LVConvertDataset(const LVDataset &dataset_in, int32_t n_features, LVsvm_problem &prob_out) {
+	size_t l = dataset_in.rows();
+
+	LVCopyToArrayHandle(prob_out.y, dataset_in.y);
+
+	// Handles are allocated on the calling thread, the values are scattered in parallel
+	LVResizeHandleArrayHandle(prob_out.x, l);
+	for (size_t i = 0; i < l; i++) {
+		LVResizeNumericArrayHandle((*prob_out.x)->elt[i], n_features);
+		(*(*prob_out.x)->elt[i])->dimSize = n_features;
+	}
+	(*prob_out.x)->dimSize = static_cast<uint32_t>(l);
+
+	LVArray_Hdl<double> *x = (*prob_out.x)->elt;
+	size_t nThreads = LVThreadCount(l * static_cast<size_t>(n_features), 1 << 16);
+
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			double *values = (*x[i])->elt;
+			std::fill(values, values + n_features, 0.0);
+
+			for (size_t k = dataset_in.rowStart[i]; k < dataset_in.rowStart[i + 1]; k++)
+				values[dataset_in.index[k] - 1] = dataset_in.value[k];
+		}
+	});
+}
+
+void LVConvertTable(const LVDenseTable &table_in, LVsvm_problem &prob_out) {
+	size_t l = table_in.rows();
+	size_t cols = table_in.cols;
+
+	// Input validation: Feature vector too large (exceeds max signed int)
+	if (cols > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Feature vector too large (greater than " + std::to_string(INT_MAX) + ")");
+
+	LVCopyToArrayHandle(prob_out.y, table_in.y);
+
+	// Handles are allocated on the calling thread, the rows are copied in parallel
+	LVResizeHandleArrayHandle(prob_out.x, l);
+	for (size_t i = 0; i < l; i++) {
+		LVResizeNumericArrayHandle((*prob_out.x)->elt[i], cols);
+		(*(*prob_out.x)->elt[i])->dimSize = static_cast<uint32_t>(cols);
+	}
+	(*prob_out.x)->dimSize = static_cast<uint32_t>(l);
+
+	LVArray_Hdl<double> *x = (*prob_out.x)->elt;
+	size_t nThreads = LVThreadCount(l * cols, 1 << 16);
+
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++)
+			std::copy(table_in.row(i), table_in.row(i) + cols, (*x[i])->elt);
+	});
+}
+
+//
+//-- Scaling helpers
+//
+
+size_t LVCheckProblem(const LVsvm_problem &prob_in, const char *caller) {
+	if (prob_in.x == nullptr || (*(prob_in.x))->dimSize == 0)
+		throw LVException(__FILE__, __LINE__, std::string("Empty problem passed to ") + caller + ".");
+
+	size_t l = (*(prob_in.x))->dimSize;
+	for (size_t i = 0; i < l; i++) {
+		auto xi_in_Hdl = (*(prob_in.x))->elt[i];
+		if (xi_in_Hdl == nullptr || (*xi_in_Hdl)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, std::string("Empty feature vector passed to ") + caller + ".");
+
+		// Input validation: Feature vector too large (exceeds max signed int)
+		if ((*xi_in_Hdl)->dimSize > INT_MAX)
+			throw LVException(__FILE__, __LINE__, "Feature vector too large (greater than " + std::to_string(INT_MAX) + ")");
+	}
+
+	return l;
+}
+
+LVScaling LVComputeProblemScaling(const LVsvm_problem &prob_in, LVScalingMethod method, double lower, double upper) {
+	size_t l = LVCheckProblem(prob_in, "LVsvm_compute_scaling");
+	LVArray_Hdl<double> *x = (*prob_in.x)->elt;
+
+	size_t nFeatures = 0;
+	for (size_t i = 0; i < l; i++)
+		nFeatures = std::max(nFeatures, static_cast<size_t>((*x[i])->dimSize));
+
+	return LVComputeScaling(l, nFeatures, 0, method, lower, upper, [&](size_t i, LVFeatureStatistics &statistics) {
+		const double *values = (*x[i])->elt;
+		int32_t n = static_cast<int32_t>((*x[i])->dimSize);
+		for (int32_t j = 0; j < n; j++)
+			statistics.add(j, values[j]);
+	});
+}
+
+void LVScaleProblem(const LVScaling &scaling, LVsvm_problem &prob_inout) {
+	size_t l = LVCheckProblem(prob_inout, "LVsvm_scale_problem");
+	LVArray_Hdl<double> *x = (*prob_inout.x)->elt;
+
+	// Handles are extended on the calling thread (the values are preserved), the values are scaled in parallel
+	std::vector<size_t> size(l);
+	for (size_t i = 0; i < l; i++) {
+		size_t n = (*x[i])->dimSize;
+		size[i] = scaling.scaledDenseSize(n);
+		if (size[i] != n)
+			LVResizeNumericArrayHandle(x[i], size[i]);
+	}
+
+	size_t nThreads = LVThreadCount(l * scaling.size(), 1 << 16);
+	LVParallelFor(nThreads, [&](size_t t) {
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++) {
+			double *values = (*x[i])->elt;
+			size_t n = (*x[i])->dimSize;
+			std::fill(values + n, values + size[i], 0.0);
+
+			scaling.applyDense(values, size[i]);
+			(*x[i])->dimSize = static_cast<uint32_t>(size[i]);
+		}
+	});
+}
+
+std::shared_ptr<const LVScaling> LVConvertScaling(const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in) {
+	size_t n_scale = (scale_in != nullptr) ? (*scale_in)->dimSize : 0;
+	size_t n_shift = (shift_in != nullptr) ? (*shift_in)->dimSize : 0;
+	if (n_scale == 0 && n_shift == 0)
+		return nullptr;
+
+	if (n_scale != n_shift)
+		throw LVException(__FILE__, __LINE__, "The scale and shift arrays of the scaling must have the same length.");
+
+	const double *scale = (*scale_in)->elt;
+	const double *shift = (*shift_in)->elt;
+	return std::make_shared<const LVScaling>(std::vector<double>(scale, scale + n_scale), std::vector<double>(shift, shift + n_shift));
+}
+
+svm_node LVScaleInput(const LVsvm_native_model &native, const LVArray_Hdl<double> x_in, std::vector<double> &buffer) {
+	std::shared_ptr<const LVScaling> scaling = std::atomic_load(&native.scaling);
+	return LVScaleInput(scaling.get(), (*x_in)->elt, (*x_in)->dimSize, buffer);
+}
+
+svm_node LVScaleInput(const LVScaling *scaling, const double *x, size_t n, std::vector<double> &buffer) {
+	if (scaling == nullptr) {
+		svm_node node = { static_cast<int>(n), const_cast<double*>(x) };
+		return node;
+	}
+
+	buffer.assign(scaling->scaledDenseSize(n), 0.0);
+	std::copy(x, x + n, buffer.begin());
+	scaling->applyDense(buffer.data(), buffer.size());
+
+	svm_node node = { static_cast<int>(buffer.size()), buffer.data() };
+	return node;
+}
+
+//
+//-- Batch prediction helpers
+//
+
+size_t LVDecisionValueCount(const svm_model &model) {
+	if (model.param.svm_type == ONE_CLASS || model.param.svm_type == EPSILON_SVR || model.param.svm_type == NU_SVR)
+		return 1;
+
+	return static_cast<size_t>(model.nr_class) * static_cast<size_t>(model.nr_class - 1) / 2;
+}
+
+void LVPredictBatch(const LVsvm_native_model &native, const LVArray_Hdl<double, 2> x_in, double *labels, double *dec_values, size_t n_dec) {
+	size_t l = (x_in != nullptr) ? (*x_in)->dimSize[0] : 0;
+	if (l == 0)
+		return;
+
+	// Input validation: Empty feature vectors
+	size_t n = (*x_in)->dimSize[1];
+	if (n == 0)
+		throw LVException(__FILE__, __LINE__, "Empty feature vectors passed to LVsvm_predict_batch_handle.");
+
+	// Input validation: Feature vectors too large (exceeds max signed int)
+	if (n > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Feature vector too large (grater than " + std::to_string(INT_MAX) + ")");
+
+	const svm_model *model = &native.view;
+	const double *x = (*x_in)->elt;
+
+	// All rows use the same scaling, even if it is replaced during the prediction
+	std::shared_ptr<const LVScaling> scaling = std::atomic_load(&native.scaling);
+
+	// Several ranges of rows per worker, so that workers that finish early take over the remaining ranges
+	LVThreadPool &pool = LVThreadPool::instance();
+	size_t nTasks = std::min(l, 4 * (pool.settings().threads + 1));
+
+	pool.parallelFor(nTasks, [&](size_t t) {
+		std::vector<double> buffer;
+		for (size_t i = l * t / nTasks; i < l * (t + 1) / nTasks; i++) {
+			svm_node node = LVScaleInput(scaling.get(), x + i * n, n, buffer);
+			if (dec_values != nullptr)
+				labels[i] = svm_predict_values(model, &node, dec_values + i * n_dec);
+			else
+				labels[i] = svm_predict(model, &node);
+		}
+	});
+}
+
+//
+//-- Engine selection helpers
+//
+
+LVProblemProfile LVProfileProblem(const LVsvm_problem &prob_in, int32_t kernel_type) {
+	LVCheckProblemSize(prob_in.y, prob_in.x);
+
+	// The vectors of precomputed kernels are kernel values (column 0 is the serial number), only the size is meaningful
+	if (kernel_type == PRECOMPUTED) {
+		LVProblemProfile profile = LVProblemProfile();
+		profile.l = LVCheckProblem(prob_in, "LVsvm_analyze_problem");
+		return profile;
+	}
+
+	return LVProfileDense(prob_in.x);
+}
@@ -18,10 +18,28 @@
 
 #include <atomic>
 #include <memory>
+#include <string>
+#include <vector>
 #include <svm.h>
 
 #include "LVException.h"
 #include "LVTypeDecl.h"
+#include "LVBinaryModel.h"
+#include "LVMemoryMap.h"
+#include "LVHandleRegistry.h"
+#include "LVTextFormat.h"
+#include "LVDataset.h"
+#include "LVDelimited.h"
+#include "LVScaling.h"
+#include "LVProblemConversion.h"
+#include "LVBackendSelection.h"
+#include "LVFeatureSelection.h"
+#include "LVCancellation.h"
+#include "LVGridSearch.h"
+#include "LVLogging.h"
+#include "LVStatistics.h"
+#include "LVThreadPool.h"
+#include "LVJobQueue.h"
 
 // Redefinitions of libsvm type declarations using LabVIEW handles
 #pragma region TypeDefs
@@ -37,6 +55,30 @@ struct LVsvm_problem
 	LVArray_Hdl<LVArray_Hdl<double>> x; // Feature vectors
 };
 
+// Problem layouts of the other libraries, used for conversion (LVsvm_problem of libsvm and LVlinear_problem of liblinear)
+// LabVIEW uses 1-byte padding on 32bit windows, and padding is inserted to match the node of libsvm
+struct LVsvm_sparse_node
+{
+	int32_t index;
+#if defined(_WIN32) && !defined(_WIN64)
+	int32_t padding;
+#endif
+	double value;
+};
+
+struct LVsvm_sparse_problem
+{
+	LVArray_Hdl<double> y;
+	LVArray_Hdl<LVArray_Hdl<LVsvm_sparse_node>> x; // -1 terminated sparse vectors
+};
+
+struct LVsvm_linear_problem
+{
+	LVArray_Hdl<double> y;
+	LVArray_Hdl<LVArray_Hdl<LVsvm_sparse_node>> x; // Sparse array, the bias feature precedes the terminator if bias >= 0
+	double bias;
+};
+
 struct LVsvm_parameter {
 	uint32_t svm_type;
 	uint32_t kernel_type;
@@ -72,6 +114,102 @@ struct LVsvm_model {
 
 #pragma endregion
 
+// Binary model format (sections of the LVBinaryModel container)
+#pragma region BinaryFormat
+
+enum LVsvm_binary_section : uint32_t {
+	LVSVM_SECTION_PARAMETER = 1,	// LVsvm_binary_parameter (1)
+	LVSVM_SECTION_WEIGHT_LABEL,		// int32 (nr_weight)
+	LVSVM_SECTION_WEIGHT,			// double (nr_weight)
+	LVSVM_SECTION_LABEL,			// int32 (nr_class or empty)
+	LVSVM_SECTION_NSV,				// int32 (nr_class or empty)
+	LVSVM_SECTION_RHO,				// double (nr_class*(nr_class-1)/2)
+	LVSVM_SECTION_PROBA,			// double (nr_class*(nr_class-1)/2 or empty)
+	LVSVM_SECTION_PROBB,			// double (nr_class*(nr_class-1)/2 or empty)
+	LVSVM_SECTION_SV_INDICES,		// int32 (l or empty)
+	LVSVM_SECTION_SV_COEF,			// double ((nr_class-1) x l, row-major)
+	LVSVM_SECTION_SV_VALUES			// double (l x n_features, row-major)
+};
+
+// Fixed-width representation of svm_parameter (doubles first to avoid padding)
+struct LVsvm_binary_parameter {
+	double gamma;
+	double coef0;
+	double cache_size;
+	double eps;
+	double C;
+	double nu;
+	double p;
+	int32_t svm_type;
+	int32_t kernel_type;
+	int32_t degree;
+	int32_t shrinking;
+	int32_t probability;
+	int32_t nr_class;
+	int32_t l;
+	int32_t n_features;		// Length of every support vector
+};
+
+static_assert (sizeof(LVsvm_binary_parameter) == 88, "Size of LVsvm_binary_parameter must be 88 bytes.");
+
+#pragma endregion
+
+// Arrays of a model parsed from the text format (referenced by the svm_model)
+struct LVsvm_text_storage {
+	std::vector<int> label;
+	std::vector<int> nSV;
+	std::vector<double> rho;
+	std::vector<double> probA;
+	std::vector<double> probB;
+	std::vector<double> coef;				// sv_coef data ((nr_class-1) x l, row-major)
+	std::vector<double*> sv_coef;
+	std::vector<svm_node> SV;
+	std::vector<double> values;				// Support vectors (l x dim, row-major)
+};
+
+// Releases a model allocated by svm_train
+struct LVsvm_model_deleter {
+	void operator()(svm_model *model) const { svm_free_and_destroy_model(&model); }
+};
+
+// Native model referenced from LabVIEW through an opaque handle (see LVsvm_load_model_handle)
+struct LVsvm_native_model {
+	LVsvm_native_model() : view() {}
+
+	LVsvm_text_storage text;				// Text model files
+	LVMemoryMap map;						// Mapping of binary model files
+	svm_model view;							// Model used for prediction (references text, map or the storage below)
+	std::unique_ptr<svm_node[]> SV;
+	std::unique_ptr<double*[]> sv_coef;
+	std::unique_ptr<double[]> values;		// Packed support vectors (n_SV x n_features)
+	std::unique_ptr<svm_model, LVsvm_model_deleter> trained;	// Model trained by LVsvm_train_handle (the view references its arrays)
+	std::shared_ptr<const LVScaling> scaling;	// Applied to every input before prediction (nullptr if none), accessed atomically
+};
+
+// Training or cross-validation queued by LVsvm_train_async/LVsvm_cross_validation_async (see LVJobQueue.h)
+// The problem and the parameters are copied when the job is queued, as the LabVIEW data may be released before the job runs
+class LVsvm_job : public LVJob {
+public:
+	// Validates and copies the inputs, nr_fold is zero for training
+	LVsvm_job(const LVsvm_problem &prob_in, const LVsvm_parameter &param_in, int32_t nr_fold);
+
+	const int32_t nr_fold;
+	std::shared_ptr<LVsvm_native_model> model;	// Result of training
+	std::vector<double> target;				// Result of cross-validation
+
+protected:
+	void run() override;
+
+private:
+	std::vector<double> y;
+	std::vector<double> values;			// Feature vectors, one after the other
+	std::vector<svm_node> x;
+	std::vector<int> weight_label;
+	std::vector<double> weight;
+	svm_problem prob;						// References the copies above
+	svm_parameter param;
+};
+
 //-- Static variables
 
 // User event reference used to return libsvm console logging to LabVIEW
@@ -79,6 +217,12 @@ struct LVsvm_model {
 // int32 is not atomic in itself across all compilers and architectures
 static std::atomic<LVUserEventRef *> loggingUsrEv(nullptr);
 
+// Models loaded with LVsvm_load_model_handle
+static LVHandleRegistry<LVsvm_native_model> modelHandles(LVHandleTagDense);
+
+// Tokens created with LVsvm_create_cancellation_token
+static LVHandleRegistry<LVCancellationToken> tokenHandles(LVHandleTagToken);
+
 //
 //-- LIBSVM DENSE API
 //
@@ -112,16 +256,247 @@ LVLIBSVM_API void		CALLCONV LVsvm_save_model(lvError *lvErr, const char *path_in
 
 LVLIBSVM_API void		CALLCONV LVsvm_load_model(lvError *lvErr, const char *path_in, LVsvm_model *model_out);
 
+// Text model file with the shortest round-trip representation of every number (lossless, still readable by svm_load_model)
+LVLIBSVM_API void		CALLCONV LVsvm_save_model_round_trip(lvError *lvErr, const char *path_in, const LVsvm_model *model_in);
+
+// Binary model files (memory mapped on load, see LVBinaryModel.h)
+LVLIBSVM_API void		CALLCONV LVsvm_save_model_binary(lvError *lvErr, const char *path_in, const LVsvm_model *model_in);
+
+LVLIBSVM_API void		CALLCONV LVsvm_load_model_binary(lvError *lvErr, const char *path_in, LVsvm_model *model_out);
+
+// Binary model file that also stores the feature scaling (see LVsvm_compute_scaling), applied by the model handles loaded from it
+LVLIBSVM_API void		CALLCONV LVsvm_save_model_binary_scaled(lvError *lvErr, const char *path_in, const LVsvm_model *model_in, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in);
+
+// In-memory serialization to/from a LabVIEW string (no file system access)
+LVLIBSVM_API void		CALLCONV LVsvm_serialize_model(lvError *lvErr, const LVsvm_model *model_in, LStrHandle model_out);
+
+LVLIBSVM_API void		CALLCONV LVsvm_serialize_model_text(lvError *lvErr, const LVsvm_model *model_in, LVBoolean round_trip, LStrHandle model_out);
+
+// Accepts both the binary and the text format (detected automatically)
+LVLIBSVM_API void		CALLCONV LVsvm_deserialize_model(lvError *lvErr, const LStrHandle model_in, LVsvm_model *model_out);
+
+//
+//-- Data files (libsvm format, "label index:value index:value ...")
+//
+
+// Feature index i (one-based, as in libsvm data files) is column i-1 of the feature vectors
+// The number of columns is n_features, or the largest index in the file if n_features is zero
+// The file is memory mapped and parsed in parallel
+// Malformed lines are reported as an error with the line number, or skipped and returned in malformed_lines_out if skip_malformed is true
+LVLIBSVM_API void		CALLCONV LVsvm_read_problem(lvError *lvErr, const char *path_in, int32_t n_features, LVBoolean skip_malformed, LVsvm_problem *prob_out, LVArray_Hdl<uint64_t> malformed_lines_out);
+
+// Only nonzero features are written, with the shortest round-trip representation (lossless)
+LVLIBSVM_API void		CALLCONV LVsvm_write_problem(lvError *lvErr, const char *path_in, const LVsvm_problem *prob_in);
+
+// Delimited text files (CSV, TSV, ...) with numeric columns, memory mapped and parsed in parallel (see LVDelimited.h)
+// delimiter: 0 detects tab, comma, semicolon or blanks (' ' means runs of blanks)
+// label_column: zero-based column of the label, -1 for the last column, -2 if there is no label (labels are set to zero)
+// missing_policy: 0 reports missing values as an error, 1 skips rows with missing values or malformed rows, 2 replaces missing features by missing_value
+// The line numbers of skipped rows are returned in skipped_lines_out
+LVLIBSVM_API void		CALLCONV LVsvm_read_delimited(lvError *lvErr, const char *path_in, uint8_t delimiter, int32_t header_rows, int32_t label_column, int32_t missing_policy, double missing_value, LVsvm_problem *prob_out, LVArray_Hdl<uint64_t> skipped_lines_out);
+
+//
+//-- Feature scaling (x' = x * scale[j] + shift[j] for column j, see LVScaling.h)
+//
+
+// Computes the scaling of every column in a single parallel pass
+// method: 0 maps [min, max] of every column to [lower, upper] (as svm-scale), 1 standardizes to zero mean and unit variance
+// Feature vectors shorter than the longest are zero in the missing columns, constant columns are mapped to zero
+LVLIBSVM_API void		CALLCONV LVsvm_compute_scaling(lvError *lvErr, const LVsvm_problem *prob_in, int32_t method, double lower, double upper, LVArray_Hdl<double> scale_out, LVArray_Hdl<double> shift_out);
+
+// Scales the problem in place (no copy of the problem is made in LabVIEW)
+// Short feature vectors are extended with zeros up to the last column with a nonzero shift
+LVLIBSVM_API void		CALLCONV LVsvm_scale_problem(lvError *lvErr, LVsvm_problem *prob_inout, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in);
+
+//
+//-- Problem conversion (see LVProblemConversion.h)
+//
+
+// Feature index i of the sparse vectors is column i-1
+// The number of columns is n_features, or the largest index of the problem if n_features is zero
+LVLIBSVM_API void		CALLCONV LVsvm_problem_from_sparse(lvError *lvErr, const LVsvm_sparse_problem *prob_in, int32_t n_features, LVsvm_problem *prob_out);
+
+// As LVsvm_problem_from_sparse, the bias feature is removed if prob_in->bias >= 0
+LVLIBSVM_API void		CALLCONV LVsvm_problem_from_linear(lvError *lvErr, const LVsvm_linear_problem *prob_in, int32_t n_features, LVsvm_problem *prob_out);
+
+//
+//-- Feature selection (see LVFeatureSelection.h)
+//
+
+// F-score of every column and the columns from the best to the worst score
+// prob_out holds the n_select best columns (all if n_select <= 0) in their original order
+LVLIBSVM_API void		CALLCONV LVsvm_fscore(lvError *lvErr, const LVsvm_problem *prob_in, int32_t n_select, LVArray_Hdl<double> fscore_out, LVArray_Hdl<int32_t> ranking_out, LVsvm_problem *prob_out);
+
+// Copies the problem keeping only the given columns (in the given order), e.g. to reduce a test set the same way as the training set
+LVLIBSVM_API void		CALLCONV LVsvm_select_features(lvError *lvErr, const LVsvm_problem *prob_in, const LVArray_Hdl<int32_t> features_in, LVsvm_problem *prob_out);
+
+//
+//-- Native model handles (the model stays in native memory, for deployment)
+//
+
+// Loads a text or binary model file (detected automatically), binary files are used directly from the memory map
+// If pack is true, the support vectors are copied into a single contiguous matrix owned by the handle (text models are always packed)
+LVLIBSVM_API void		CALLCONV LVsvm_load_model_handle(lvError *lvErr, const char *path_in, LVBoolean pack, uint64_t *handle_out);
+
+LVLIBSVM_API void		CALLCONV LVsvm_free_model_handle(lvError *lvErr, uint64_t handle);
+
+LVLIBSVM_API double		CALLCONV LVsvm_predict_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double> x_in);
+
+LVLIBSVM_API double		CALLCONV LVsvm_predict_values_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double> x_in, LVArray_Hdl<double> dec_values_out);
+
+LVLIBSVM_API double		CALLCONV LVsvm_predict_probability_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double> x_in, LVArray_Hdl<double> prob_estimates_out);
+
+// Predicts every row of x_in (one feature vector per row) in parallel on the thread pool
+LVLIBSVM_API void		CALLCONV LVsvm_predict_batch_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double, 2> x_in, LVArray_Hdl<double> labels_out);
+
+// As LVsvm_predict_batch_handle, row i of dec_values_out holds the decision values of row i of x_in (see LVsvm_predict_values_handle)
+LVLIBSVM_API void		CALLCONV LVsvm_predict_values_batch_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double, 2> x_in, LVArray_Hdl<double> labels_out, LVArray_Hdl<double, 2> dec_values_out);
+
+// Sets the scaling applied to every input of the predict functions above (empty arrays remove it)
+// Models loaded from files written by LVsvm_save_model_binary_scaled have their scaling set on load
+LVLIBSVM_API void		CALLCONV LVsvm_set_model_handle_scaling(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in);
+
+LVLIBSVM_API void		CALLCONV LVsvm_get_model_handle_scaling(lvError *lvErr, uint64_t handle, LVArray_Hdl<double> scale_out, LVArray_Hdl<double> shift_out);
+
+// Trains a model that stays in native memory (released with LVsvm_free_model_handle), also called by LVsvm_train_auto of libsvm
+LVLIBSVM_API void		CALLCONV LVsvm_train_handle(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, uint64_t *handle_out);
+
+//
+//-- Engine selection (see LVBackendSelection.h, training is dispatched by LVsvm_train_auto of libsvm)
+//
+
+// Profiles the problem and returns the engine recommended for it (0: libsvm, 1: libsvm-dense, 2: liblinear) and why
+LVLIBSVM_API void		CALLCONV LVsvm_analyze_problem(lvError *lvErr, const LVsvm_problem *prob_in, int32_t svm_type, int32_t kernel_type, LVProblemProfile *profile_out, int32_t *backend_out, LStrHandle reason_out);
+
+//
+//-- Asynchronous jobs (see LVJobQueue.h)
+//
+
+// Queues training or cross-validation and returns a job handle right away (the problem and the parameters are copied first)
+// If completion_in is not null and not zero, the job handle is posted to that user event (U64 data) when the job has finished
+LVLIBSVM_API void		CALLCONV LVsvm_train_async(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, LVUserEventRef *completion_in, uint64_t *job_out);
+
+LVLIBSVM_API void		CALLCONV LVsvm_cross_validation_async(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t nr_fold, LVUserEventRef *completion_in, uint64_t *job_out);
+
+// State of a job: 0 queued, 1 running, 2 completed, 3 failed
+LVLIBSVM_API void		CALLCONV LVsvm_job_state(lvError *lvErr, uint64_t job, int32_t *state_out);
+
+// Waits up to timeout_ms (negative to wait indefinitely) for a job to finish and returns its state
+LVLIBSVM_API void		CALLCONV LVsvm_wait_job(lvError *lvErr, uint64_t job, int32_t timeout_ms, int32_t *state_out);
+
+// Waits for a job and returns its result (or the error of a failed job), the job handle is released
+LVLIBSVM_API void		CALLCONV LVsvm_collect_train(lvError *lvErr, uint64_t job, LVsvm_model *model_out);
+
+// As LVsvm_collect_train, the model is returned as a model handle (released with LVsvm_free_model_handle)
+LVLIBSVM_API void		CALLCONV LVsvm_collect_train_handle(lvError *lvErr, uint64_t job, uint64_t *handle_out);
+
+LVLIBSVM_API void		CALLCONV LVsvm_collect_cross_validation(lvError *lvErr, uint64_t job, LVArray_Hdl<double> target_out);
+
+// Releases a job without collecting it, a job that has not finished runs to completion (without posting its completion event)
+LVLIBSVM_API void		CALLCONV LVsvm_free_job(lvError *lvErr, uint64_t job);
+
+// Cancels a job: a running job stops at its next checkpoint (see LVCancellation.h) and fails with error 7001, a queued job fails without running
+LVLIBSVM_API void		CALLCONV LVsvm_cancel_job(lvError *lvErr, uint64_t job);
+
+// Sets the user event that receives the solver output of a job (0 or not connected for the global logging event), batched as LVLogEvent tagged with the job handle
+LVLIBSVM_API void		CALLCONV LVsvm_set_job_log_userevent(lvError *lvErr, uint64_t job, LVUserEventRef *log_in);
+
+// Limits the number of jobs running at the same time (0 for one per core), further jobs wait in the queue
+LVLIBSVM_API void		CALLCONV LVsvm_set_max_running_jobs(lvError *lvErr, int32_t max_jobs);
+
+//
+//-- Cancellation (see LVCancellation.h)
+//
+
+// Creates a token for the cancellable functions, with the budgets of every run started with it: max_seconds of wall-clock time and max_iterations solver iterations
+// (zero or negative for no limit, iterations are counted from the progress output of the solvers). A cancelled run returns error 7001, a run that exceeds a budget error 7002
+LVLIBSVM_API void		CALLCONV LVsvm_create_cancellation_token(lvError *lvErr, double max_seconds, int64_t max_iterations, uint64_t *token_out);
+
+// Stops the runs of the token at their next checkpoint (called from another VI), and the runs started with it until the token is reset
+LVLIBSVM_API void		CALLCONV LVsvm_cancel(lvError *lvErr, uint64_t token);
+
+LVLIBSVM_API void		CALLCONV LVsvm_reset_cancellation_token(lvError *lvErr, uint64_t token);
+
+LVLIBSVM_API void		CALLCONV LVsvm_free_cancellation_token(lvError *lvErr, uint64_t token);
+
+// Sets the user event that receives the progress of the searches started with the token (0 or not connected to stop posting), see LVGridSearch.h for the event data
+LVLIBSVM_API void		CALLCONV LVsvm_set_progress_userevent(lvError *lvErr, uint64_t token, LVUserEventRef *progress_in);
+
+// Sets the user event that receives the solver output of the runs started with the token (0 or not connected for the global logging event),
+// batched as LVLogEvent tagged with the token handle (see LVLogging.h)
+LVLIBSVM_API void		CALLCONV LVsvm_set_log_userevent(lvError *lvErr, uint64_t token, LVUserEventRef *log_in);
+
+// As LVsvm_train and LVsvm_cross_validation, the run is stopped by the token (0 for none) between the folds (see LVCancellation.h).
+// Under a token the training runs as a job on copies of the inputs that is abandoned when the run stops (the libsvm solver completes in the background),
+// so the call returns with code 7001 or 7002 while the solver runs. Under a token the folds are those of the grid search
+LVLIBSVM_API void		CALLCONV LVsvm_train_cancellable(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, uint64_t token, LVsvm_model *model_out);
+
+LVLIBSVM_API void		CALLCONV LVsvm_cross_validation_cancellable(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t nr_fold, uint64_t token, LVArray_Hdl<double> target_out);
+
+//
+//-- Grid search (see LVGridSearch.h)
+//
+
+// Cross-validates every combination of C_in and gamma_in (an empty list keeps the value of param_in) on the same nr_fold folds, stratified for classification.
+// score_out holds the accuracy (classification) or mean squared error (regression) of every combination, C by row and gamma by column.
+// The folds run concurrently on the thread pool and every fold and combination is posted to the progress event of the token as it finishes (0 for no token).
+// Every combination has the budgets of the token: a combination that exceeds them is abandoned (NaN score) while the search goes on,
+// a cancellation ends the search. The results so far are then returned with a warning (code 7001 or 7002), as long as a combination has finished
+LVLIBSVM_API void		CALLCONV LVsvm_grid_search(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t nr_fold, const LVArray_Hdl<double> C_in, const LVArray_Hdl<double> gamma_in, uint64_t token, LVArray_Hdl<double, 2> score_out, double *best_C_out, double *best_gamma_out, double *best_score_out);
+
+//
+//-- Statistics (see LVStatistics.h)
+//
+
+// Train, cross-validation and predict with the statistics of the call in stats_out (LVSolverStats): the time spent marshalling the LabVIEW data,
+// in the solver and copying the results back, and the iterations counted from the solver output, nSV is the number of support vectors of the model.
+// The print function of the library is installed for the call (the counters are taken from the solver output), a training whose output was not received returns warning 7003.
+// The statistics are returned on errors too (up to the error). The plain functions collect nothing and stay as fast as before
+LVLIBSVM_API void		CALLCONV LVsvm_train_stats(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, LVsvm_model *model_out, LVSolverStats *stats_out);
+
+LVLIBSVM_API void		CALLCONV LVsvm_cross_validation_stats(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t nr_fold, LVArray_Hdl<double> target_out, LVSolverStats *stats_out);
+
+LVLIBSVM_API double		CALLCONV LVsvm_predict_stats(lvError *lvErr, const struct LVsvm_model *model_in, const LVArray_Hdl<double> x_in, LVSolverStats *stats_out);
+
+//
+//-- Thread pool (see LVThreadPool.h)
+//
+
+// Configures the workers of the library's parallel functions: n_threads workers (0 for one per core), restricted to the zero-based cores in cpus_in (empty for all cores),
+// running at priority -2 (lowest) to 2 (highest), 0 is normal. Raising the priority above normal may require elevated privileges
+LVLIBSVM_API void		CALLCONV LVsvm_set_thread_pool(lvError *lvErr, int32_t n_threads, const LVArray_Hdl<int32_t> cpus_in, int32_t priority);
+
+LVLIBSVM_API void		CALLCONV LVsvm_get_thread_pool(lvError *lvErr, int32_t *n_threads_out, LVArray_Hdl<int32_t> cpus_out, int32_t *priority_out);
+
+// Reserves the zero-based cores in cpus_in for predictions on model handles (empty to remove the reservation), at least one pool core must remain unreserved.
+// Pool workers on the reserved cores only run predictions, training and cross-validation run on the remaining cores,
+// and the libsvm solvers are not interruptible, so they are kept off the reserved cores. Keeps the other thread pool settings
+LVLIBSVM_API void		CALLCONV LVsvm_set_core_reservation(lvError *lvErr, const LVArray_Hdl<int32_t> cpus_in);
+
+LVLIBSVM_API void		CALLCONV LVsvm_get_core_reservation(lvError *lvErr, LVArray_Hdl<int32_t> cpus_out);
+
+// Cancels the jobs (the queued ones fail), then stops the job threads, the pool workers and the log flusher and waits for them to exit,
+// the queued log messages are posted. A running job stops once its library solver in progress has completed (see LVCancellation.h).
+// To be called before the library is unloaded (e.g. when the application closes): the static destruction of the library
+// does not wait for the threads (it would deadlock on Windows). The threads restart on demand
+LVLIBSVM_API void		CALLCONV LVsvm_shutdown(lvError *lvErr);
+
 //
 //-- Print function (used for console output redirection to LabVIEW)
 //
 
-// Logging is global for now
+// The messages are batched by the logger of the library (see LVLogging.h), the global logging event receives them as strings
 void LVsvm_print_function(const char * message);
 LVLIBSVM_API void CALLCONV LVsvm_set_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_in);
 LVLIBSVM_API void CALLCONV LVsvm_get_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out);
 LVLIBSVM_API void CALLCONV LVsvm_delete_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out);
 
+// Interval of the logger (100 ms by default), at most one log event per destination is posted per interval
+LVLIBSVM_API void		CALLCONV LVsvm_set_logging_interval(lvError *lvErr, int32_t interval_ms);
+
+// Posts the messages queued by the logger right away
+LVLIBSVM_API void		CALLCONV LVsvm_flush_log(lvError *lvErr);
+
 //
 //-- Helper functions
 //
@@ -135,3 +510,76 @@ void LVConvertParameter(const svm_parameter &param_in, LVsvm_parameter &param_ou
 void LVConvertModel(const LVsvm_model &model_in, svm_model &model_out, std::unique_ptr<svm_node[]> &SV, std::unique_ptr<double*[]> &sv_coef);
 
 void LVConvertModel(const svm_model &model_in, LVsvm_model &model_out);
+
+// Adds the sections of a svm_model to a binary writer (arrays are referenced, not copied)
+void LVWriteBinaryModel(const svm_model &model_in, LVBinaryWriter &writer, LVsvm_binary_parameter &param_storage);
+
+// Assigns a svm_model referencing the data of a binary model (support vectors are not copied)
+void LVReadBinaryModel(const LVBinaryReader &reader, svm_model &model_out, std::unique_ptr<svm_node[]> &SV, std::unique_ptr<double*[]> &sv_coef);
+
+// Formats a svm_model in the libsvm-dense text format, byte-compatible with svm_save_model unless roundTrip is set
+// The support vectors are formatted in parallel, the concatenation of the returned parts is the model file
+std::vector<std::string> LVFormatTextModel(const svm_model &model_in, bool roundTrip);
+
+// Parses a model in the libsvm-dense text format (the support vectors are parsed in parallel)
+// The svm_model references the arrays in storage
+void LVReadTextModel(const char *data, size_t size, svm_model &model_out, LVsvm_text_storage &storage);
+
+// Copies a parsed data file into the LabVIEW problem layout with n_features columns (values are scattered in parallel)
+void LVConvertDataset(const LVDataset &dataset_in, int32_t n_features, LVsvm_problem &prob_out);
+
+// Copies an imported table into the LabVIEW problem layout (rows are copied in parallel)
+void LVConvertTable(const LVDenseTable &table_in, LVsvm_problem &prob_out);
+
+// Loads a text or binary model file into a native model
+std::shared_ptr<LVsvm_native_model> LVLoadNativeModel(const char *path_in, bool pack);
+
+// Trains a native model, the support vectors are packed (copied out of the problem)
+std::shared_ptr<LVsvm_native_model> LVTrainNativeModel(const LVsvm_problem &prob_in, const LVsvm_parameter &param_in);
+
+// Trains a native model from a problem in native memory, the support vectors are packed
+std::shared_ptr<LVsvm_native_model> LVTrainNativeModel(const svm_problem &prob, const svm_parameter &param);
+
+// Waits for a job and releases its handle, throws LVException if the job failed or is not a training (crossValidation false) or cross-validation job
+std::shared_ptr<LVsvm_job> LVCollectJob(uint64_t job, bool crossValidation);
+
+// Returns the token referenced by the handle, nullptr for 0. Throws LVException if the handle is invalid
+std::shared_ptr<const LVCancellationToken> LVGetCancellationToken(uint64_t token);
+
+// Cross-validates as svm_cross_validation into target (the predicted value of every vector)
+// Under a stop condition (see LVCancellation.h) the folds of LVMakeFolds are trained one pool task each instead, so that the run can be stopped between folds
+void LVCrossValidate(const svm_problem &prob, const svm_parameter &param, int nr_fold, double *target);
+
+// Cross-validates the combinations of C and gamma into score_out (C by C), returns the position of the best score
+// The search stops as LVCrossValidateGrid, stopped_out then holds the reason
+size_t LVGridSearch(const svm_problem &prob, const svm_parameter &param, int nr_fold, const std::vector<double> &C, const std::vector<double> &gamma, std::shared_ptr<const LVCancellationToken> token, std::vector<double> &score_out, std::unique_ptr<LVStopped> &stopped_out);
+
+// Copies the support vectors of model_in into a single contiguous matrix and assigns model_out to reference it
+void LVPackSupportVectors(const svm_model &model_in, svm_model &model_out, std::unique_ptr<svm_node[]> &SV, std::unique_ptr<double[]> &values);
+
+// Validates the feature vectors of a problem (nonempty), returns the number of vectors
+size_t LVCheckProblem(const LVsvm_problem &prob_in, const char *caller);
+
+// Computes the scaling of a problem (statistics are gathered in parallel)
+LVScaling LVComputeProblemScaling(const LVsvm_problem &prob_in, LVScalingMethod method, double lower, double upper);
+
+// Scales a problem in place, vectors that need to be extended are resized on the calling thread
+void LVScaleProblem(const LVScaling &scaling, LVsvm_problem &prob_inout);
+
+// Assigns the scaling from the LabVIEW arrays (nullptr if both are empty)
+std::shared_ptr<const LVScaling> LVConvertScaling(const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in);
+
+// Returns the node of x scaled by the scaling of the native model (the copy is stored in buffer), or of x itself if the model has no scaling
+svm_node LVScaleInput(const LVsvm_native_model &native, const LVArray_Hdl<double> x_in, std::vector<double> &buffer);
+
+// Returns the node of the n values at x scaled by scaling (the copy is stored in buffer), or of x itself if scaling is nullptr
+svm_node LVScaleInput(const LVScaling *scaling, const double *x, size_t n, std::vector<double> &buffer);
+
+// Number of decision values returned by svm_predict_values for the model
+size_t LVDecisionValueCount(const svm_model &model);
+
+// Predicts the rows of x_in on the thread pool into labels, and their decision values into dec_values (n_dec per row) if not nullptr
+void LVPredictBatch(const LVsvm_native_model &native, const LVArray_Hdl<double, 2> x_in, double *labels, double *dec_values, size_t n_dec);
+
+// Profiles a problem for the engine selection (precomputed kernels are only counted)
+LVProblemProfile LVProfileProblem(const LVsvm_problem &prob_in, int32_t kernel_type);
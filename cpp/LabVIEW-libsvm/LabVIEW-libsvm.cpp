@@ -8,6 +8,10 @@
 #include <errno.h>
 #include <cmath>
 #include <climits>
+#include <cstddef>
+#include <algorithm>
+#include <map>
+#include <mutex>
 
 #include <extcode.h>
 #include <svm.h>
@@ -15,6 +19,18 @@
 #include <LVTypeDecl.h>
 #include <LVUtility.h>
 #include <LVException.h>
+#include <LVMemoryMap.h>
+#include <LVBinaryModel.h>
+#include <LVTextFormat.h>
+#include <LVDataset.h>
+#include <LVDelimited.h>
+#include <LVScaling.h>
+#include <LVProblemConversion.h>
+#include <LVParallel.h>
+#include <LVBackendSelection.h>
+#include <LVFeatureSelection.h>
+#include <LVSharedLibrary.h>
+#include <LVThreadPool.h>
 
 // C++14 feature: std::make_unique
 // GNU g++-4.9 or later with -std=c++14 enabled is needed on unix (VS2013 has native support)
@@ -24,6 +40,9 @@
 
 void LVsvm_train(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, LVsvm_model * model_out){
 	try{
+		LVThroughputScope throughput;
+		LVStatsTimer marshal(LVStatsPhase::Marshal);
+
 		// Input verification: Nonempty problem
 		if (prob_in->x == nullptr || (*(prob_in->x))->dimSize == 0)
 			throw LVException(__FILE__, __LINE__, "Empty problem passed to libsvm-train.");
@@ -67,8 +86,14 @@ void LVsvm_train(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_param
 		if (param_check != nullptr)
 			throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check));
 
+		marshal.stop();
+
 		// Train model
+		LVStatsTimer solver(LVStatsPhase::Solver);
 		svm_model *model = svm_train(prob.get(), param.get());
+		solver.stop();
+
+		LVStatsTimer copy(LVStatsPhase::Copy);
 
 		// Copy the data into LabVIEW memory (hardcopy)
 		LVConvertModel(*model, *model_out);
@@ -122,6 +147,9 @@ void LVsvm_train(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_param
 
 void LVsvm_cross_validation(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t nr_fold, LVArray_Hdl<double> target_out){
 	try{
+		LVThroughputScope throughput;
+		LVStatsTimer marshal(LVStatsPhase::Marshal);
+
 		// Input verification: Nonempty problem
 		if (prob_in->x == nullptr || (*(prob_in->x))->dimSize == 0)
 			throw LVException(__FILE__, __LINE__, "Empty problem passed to libsvm-crossvalidation.");
@@ -168,7 +196,11 @@ void LVsvm_cross_validation(lvError *lvErr, const LVsvm_problem *prob_in, const
 		// Allocate room in target_out
 		LVResizeNumericArrayHandle(target_out, nr_nodes);
 
-		svm_cross_validation(prob.get(), param.get(), nr_fold, (*target_out)->elt);
+		marshal.stop();
+
+		LVStatsTimer solver(LVStatsPhase::Solver);
+		LVCrossValidate(*prob, *param, nr_fold, (*target_out)->elt);
+		solver.stop();
 
 		(*target_out)->dimSize = nr_nodes;
 	}
@@ -189,6 +221,8 @@ void LVsvm_cross_validation(lvError *lvErr, const LVsvm_problem *prob_in, const
 
 double	LVsvm_predict(lvError *lvErr, const struct LVsvm_model *model_in, const LVArray_Hdl<LVsvm_node> x_in){
 	try{
+		LVStatsTimer marshal(LVStatsPhase::Marshal);
+
 		// Input validation: Uninitialized model
 		if (model_in == nullptr || model_in->SV == nullptr || (*model_in->SV)->dimSize == 0)
 			throw LVException(__FILE__, __LINE__, "Uninitialized model passed to libsvm_predict.");
@@ -207,7 +241,11 @@ double	LVsvm_predict(lvError *lvErr, const struct LVsvm_model *model_in, const L
 		std::unique_ptr<double*[]> sv_coef;
 		LVConvertModel(*model_in, *model, SV, sv_coef);
 
+		marshal.stop();
+
+		LVStatsTimer solver(LVStatsPhase::Solver);
 		double label = svm_predict(model.get(), reinterpret_cast<svm_node*>((*x_in)->elt));
+		solver.stop();
 
 		return label;
 	}
@@ -602,83 +640,67 @@ void LVConvertModel(const svm_model &model_in, LVsvm_model &model_out){
 	}
 }
 
-//-- Print function (console logging)
-void LVsvm_print_function(const char * message){
-	LVUserEventRef *usrEv = loggingUsrEv;
-	if (usrEv != nullptr && message != nullptr){
-		// Filter out the progress messages (..... and *)
-		if (strcmp(message, ".") != 0 && strcmp(message, "*") != 0){
-			// Move the string to a handle
-			size_t length = strlen(message);
-			LStrHandle lvmsg = (LStrHandle)DSNewHandle(sizeof(int32_t) + length);
-			MoveBlock(message, (*lvmsg)->str, length);
-			(*lvmsg)->cnt = static_cast<int32>(length);
-
-			// Post the string to the user event
-			PostLVUserEvent(*usrEv, &lvmsg);
-		}
+//-- Asynchronous jobs
+void LVsvm_train_async(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, LVUserEventRef *completion_in, uint64_t *job_out){
+	try{
+		*job_out = 0;
+		auto job = std::make_shared<LVsvm_job>(*prob_in, *param_in, 0);
+		*job_out = LVJobQueue::instance().submit(job, (completion_in != nullptr) ? *completion_in : 0);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
 	}
 }
 
-void LVsvm_set_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_in) {
-	loggingUsrEv = loggingUserEvent_in;
-	svm_set_print_string_function(LVsvm_print_function);
-}
+void LVsvm_cross_validation_async(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t nr_fold, LVUserEventRef *completion_in, uint64_t *job_out){
+	try{
+		*job_out = 0;
+		if (nr_fold < 2)
+			throw LVException(__FILE__, __LINE__, "The number of folds must be at least 2 (" + std::to_string(nr_fold) + ").");
 
-void LVsvm_get_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out) {
-	loggingUserEvent_out = loggingUsrEv;
+		auto job = std::make_shared<LVsvm_job>(*prob_in, *param_in, nr_fold);
+		*job_out = LVJobQueue::instance().submit(job, (completion_in != nullptr) ? *completion_in : 0);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
 }
 
-void LVsvm_delete_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out) {
-	loggingUserEvent_out = loggingUsrEv;
-	loggingUsrEv = nullptr;
+void LVsvm_job_state(lvError *lvErr, uint64_t job, int32_t *state_out){
+	try{
+		*state_out = static_cast<int32_t>(LVJobQueue::instance().get(job)->state());
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
 }
 
-
-//
-//-- File saving/loading
-//
-
-void LVsvm_save_model(lvError *lvErr, const char *path_in, const LVsvm_model *model_in){
+void LVsvm_wait_job(lvError *lvErr, uint64_t job, int32_t timeout_ms, int32_t *state_out){
 	try{
-        errno = 0;
-
-		// Convert LVsvm_model to svm_model
-		auto model = std::make_unique<svm_model>();
-		std::unique_ptr<svm_node*[]> SV;
-		std::unique_ptr<double*[]> sv_coef;
-		LVConvertModel(*model_in, *model, SV, sv_coef);
-
-		int err = svm_save_model(path_in, model.get());
-
-		if (err == -1){
-            // Allocate room for output error message (truncated if buffer is too small)
-            const size_t bufSz = 256;
-            char buf[bufSz] = "";
-            std::string errstr;
-
-		#if defined(_WIN32) || defined(_WIN64)
-			if(strerror_s(buf, bufSz, errno) != 0)
-                errstr = buf;
-            else
-                errstr = "Unknown error";
-        #elif (_POSIX_C_SOURCE >= 200112L || _XOPEN_SOURCE >= 600) && ! _GNU_SOURCE
-            if(strerror_r(errno, buf, bufSz) != 0)
-                errstr = buf;
-            else
-                errstr = "Unknown error";
-        #else
-            char* gnuerr = strerror_r(errno, buf, bufSz);
-            if(gnuerr != nullptr)
-                errstr = gnuerr;
-            else
-                errstr = "Unknown error";
-        #endif
-
-        errno = 0;
-
-        throw LVException(__FILE__, __LINE__, "Model load operation failed (" + errstr + ").");
-		}
+		auto queued = LVJobQueue::instance().get(job);
+		queued->wait(timeout_ms);
+		*state_out = static_cast<int32_t>(queued->state());
 	}
 	catch (LVException &ex) {
 		ex.returnError(lvErr);
@@ -692,47 +714,10 @@ void LVsvm_save_model(lvError *lvErr, const char *path_in, const LVsvm_model *mo
 	}
 }
 
-void LVsvm_load_model(lvError *lvErr, const char *path_in, LVsvm_model *model_out){
+void LVsvm_collect_train(lvError *lvErr, uint64_t job, LVsvm_model *model_out){
 	try{
-        errno = 0;
-
-		svm_model *model = svm_load_model(path_in);
-
-		if (model == nullptr){
-            // Allocate room for output error message (truncated if buffer is too small)
-            const size_t bufSz = 256;
-            char buf[bufSz] = "";
-            std::string errstr;
-
-		#if defined(_WIN32) || defined(_WIN64)
-			if(strerror_s(buf, bufSz, errno) != 0)
-                errstr = buf;
-            else
-                errstr = "Unknown error";
-        #elif (_POSIX_C_SOURCE >= 200112L || _XOPEN_SOURCE >= 600) && ! _GNU_SOURCE
-            if(strerror_r(errno, buf, bufSz) != 0)
-                errstr = buf;
-            else
-                errstr = "Unknown error";
-        #else
-            char* gnuerr = strerror_r(errno, buf, bufSz);
-            if(gnuerr != nullptr)
-                errstr = gnuerr;
-            else
-                errstr = "Unknown error";
-        #endif
-
-        errno = 0;
-
-        throw LVException(__FILE__, __LINE__, "Model load operation failed (" + errstr + ").");
-		}
-		else{
-            // libsvm returns uninitialized values for the parameters
-            (model->param) = { 0 };
-
-			LVConvertModel(*model, *model_out);
-			svm_free_model_content(model);
-		}
+		auto collected = LVCollectJob(job, false);
+		LVConvertModel(collected->model->view, *model_out);
 	}
 	catch (LVException &ex) {
 		(*(model_out->label))->dimSize = 0;
@@ -741,7 +726,6 @@ void LVsvm_load_model(lvError *lvErr, const char *path_in, LVsvm_model *model_ou
 		(*(model_out->probB))->dimSize = 0;
 		(*(model_out->rho))->dimSize = 0;
 		(*(model_out->SV))->dimSize = 0;
-		(*(model_out->SV))->dimSize = 0;
 		(*(model_out->sv_coef))->dimSize[0] = 0;
 		(*(model_out->sv_coef))->dimSize[1] = 0;
 		(*(model_out->sv_indices))->dimSize = 0;
@@ -755,7 +739,6 @@ void LVsvm_load_model(lvError *lvErr, const char *path_in, LVsvm_model *model_ou
 		(*(model_out->probB))->dimSize = 0;
 		(*(model_out->rho))->dimSize = 0;
 		(*(model_out->SV))->dimSize = 0;
-		(*(model_out->SV))->dimSize = 0;
 		(*(model_out->sv_coef))->dimSize[0] = 0;
 		(*(model_out->sv_coef))->dimSize[1] = 0;
 		(*(model_out->sv_indices))->dimSize = 0;
@@ -769,7 +752,6 @@ void LVsvm_load_model(lvError *lvErr, const char *path_in, LVsvm_model *model_ou
 		(*(model_out->probB))->dimSize = 0;
 		(*(model_out->rho))->dimSize = 0;
 		(*(model_out->SV))->dimSize = 0;
-		(*(model_out->SV))->dimSize = 0;
 		(*(model_out->sv_coef))->dimSize[0] = 0;
 		(*(model_out->sv_coef))->dimSize[1] = 0;
 		(*(model_out->sv_indices))->dimSize = 0;
@@ -778,3 +760,2913 @@ void LVsvm_load_model(lvError *lvErr, const char *path_in, LVsvm_model *model_ou
 		ex.returnError(lvErr);
 	}
 }
+
+void LVsvm_collect_train_handle(lvError *lvErr, uint64_t job, uint64_t *handle_out){
+	try{
+		*handle_out = 0;
+		auto collected = LVCollectJob(job, false);
+		*handle_out = modelHandles.add(collected->model);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_collect_cross_validation(lvError *lvErr, uint64_t job, LVArray_Hdl<double> target_out){
+	try{
+		auto collected = LVCollectJob(job, true);
+		LVCopyToArrayHandle(target_out, collected->target);
+	}
+	catch (LVException &ex) {
+		(*target_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*target_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*target_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_free_job(lvError *lvErr, uint64_t job){
+	try{
+		LVJobQueue::instance().release(job);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_cancel_job(lvError *lvErr, uint64_t job){
+	try{
+		LVJobQueue::instance().get(job)->cancel();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_set_job_log_userevent(lvError *lvErr, uint64_t job, LVUserEventRef *log_in){
+	try{
+		LVJobQueue::instance().get(job)->setLogEvent((log_in != nullptr) ? *log_in : 0);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_set_max_running_jobs(lvError *lvErr, int32_t max_jobs){
+	try{
+		if (max_jobs < 0)
+			throw LVException(__FILE__, __LINE__, "The number of running jobs must not be negative.");
+
+		LVJobQueue::instance().setMaxRunning(static_cast<size_t>(max_jobs));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//-- Cancellation
+void LVsvm_create_cancellation_token(lvError *lvErr, double max_seconds, int64_t max_iterations, uint64_t *token_out){
+	try{
+		*token_out = 0;
+		*token_out = tokenHandles.add(std::make_shared<LVCancellationToken>(max_seconds, max_iterations));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_cancel(lvError *lvErr, uint64_t token){
+	try{
+		tokenHandles.get(token)->cancel();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_reset_cancellation_token(lvError *lvErr, uint64_t token){
+	try{
+		tokenHandles.get(token)->reset();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_free_cancellation_token(lvError *lvErr, uint64_t token){
+	try{
+		tokenHandles.remove(token);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_set_progress_userevent(lvError *lvErr, uint64_t token, LVUserEventRef *progress_in){
+	try{
+		tokenHandles.get(token)->setProgressEvent((progress_in != nullptr) ? *progress_in : 0);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_set_log_userevent(lvError *lvErr, uint64_t token, LVUserEventRef *log_in){
+	try{
+		tokenHandles.get(token)->setLogEvent((log_in != nullptr) ? *log_in : 0, token);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_train_cancellable(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, uint64_t token, LVsvm_model *model_out){
+	try{
+		// The print function counts the iterations of the library solvers into the budgets
+		LVInstallPrintFunction(svm_set_print_string_function, LVsvm_print_function);
+
+		std::shared_ptr<const LVCancellationToken> stop_token = LVGetCancellationToken(token);
+		if (!stop_token){
+			LVsvm_train(lvErr, prob_in, param_in, model_out);
+			return;
+		}
+
+		// The library solver cannot be stopped: the model is trained by a job on copies of the inputs, which is abandoned when the run stops
+		auto job = std::make_shared<LVsvm_job>(*prob_in, *param_in, 0);
+		LVStopCondition stop(stop_token);
+		LVStopScope scope(&stop);
+		LVJobQueue::instance().runAbandonable(job);
+
+		LVConvertModel(job->model->view, *model_out);
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_cross_validation_cancellable(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t nr_fold, uint64_t token, LVArray_Hdl<double> target_out){
+	try{
+		// The print function counts the iterations of the library solvers into the budgets
+		LVInstallPrintFunction(svm_set_print_string_function, LVsvm_print_function);
+
+		LVStopCondition stop(LVGetCancellationToken(token));
+		LVStopScope scope(&stop);
+		LVsvm_cross_validation(lvErr, prob_in, param_in, nr_fold, target_out);
+	}
+	catch (LVException &ex) {
+		(*target_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*target_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*target_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//-- Grid search
+void LVsvm_grid_search(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t nr_fold, const LVArray_Hdl<double> C_in, const LVArray_Hdl<double> gamma_in, uint64_t token, LVArray_Hdl<double, 2> score_out, double *best_C_out, double *best_gamma_out, double *best_score_out){
+	try{
+		LVThroughputScope throughput;
+
+		// The print function counts the iterations of the library solvers into the budgets
+		LVInstallPrintFunction(svm_set_print_string_function, LVsvm_print_function);
+
+		size_t l = LVCheckProblem(*prob_in, "LVsvm_grid_search");
+
+		// Input verification: Problem dimensions
+		if (prob_in->y == nullptr || (*(prob_in->y))->dimSize != l)
+			throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and feature vectors (x and y).");
+
+		// Input validation: Number of feature vectors too large (exceeds max signed int)
+		if (l > INT_MAX)
+			throw LVException(__FILE__, __LINE__, "Number of feature vectors too large (greater than " + std::to_string(INT_MAX) + ")");
+
+		svm_problem prob;
+		prob.l = static_cast<int>(l);
+		prob.y = (*(prob_in->y))->elt;
+
+		auto x = std::make_unique<svm_node*[]>(l);
+		prob.x = x.get();
+		for (size_t i = 0; i < l; i++)
+			x[i] = reinterpret_cast<svm_node*>((*(*(prob_in->x))->elt[i])->elt);
+
+		svm_parameter param;
+		LVConvertParameter(*param_in, param);
+
+		// An empty list keeps the value of the parameters
+		std::vector<double> C(1, param.C);
+		if (C_in != nullptr && (*C_in)->dimSize > 0)
+			C.assign((*C_in)->elt, (*C_in)->elt + (*C_in)->dimSize);
+
+		std::vector<double> gamma(1, param.gamma);
+		if (gamma_in != nullptr && (*gamma_in)->dimSize > 0)
+			gamma.assign((*gamma_in)->elt, (*gamma_in)->elt + (*gamma_in)->dimSize);
+
+		std::vector<double> score;
+		std::unique_ptr<LVStopped> stopped;
+		size_t best = LVGridSearch(prob, param, nr_fold, C, gamma, LVGetCancellationToken(token), score, stopped);
+
+		LVResizeNumericArrayHandle(score_out, score.size());
+		MoveBlock(score.data(), (*score_out)->elt, score.size() * sizeof(double));
+		(*score_out)->dimSize[0] = static_cast<uint32_t>(C.size());
+		(*score_out)->dimSize[1] = static_cast<uint32_t>(gamma.size());
+
+		*best_C_out = C[best / gamma.size()];
+		*best_gamma_out = gamma[best % gamma.size()];
+		*best_score_out = score[best];
+
+		// Partial results of a stopped search
+		if (stopped)
+			stopped->returnWarning(lvErr);
+	}
+	catch (LVException &ex) {
+		(*score_out)->dimSize[0] = 0;
+		(*score_out)->dimSize[1] = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*score_out)->dimSize[0] = 0;
+		(*score_out)->dimSize[1] = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*score_out)->dimSize[0] = 0;
+		(*score_out)->dimSize[1] = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//-- Statistics
+void LVsvm_train_stats(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, LVsvm_model *model_out, LVSolverStats *stats_out){
+	LVStats stats;
+	{
+		// The counters are taken from the output of the solver
+		LVPrintFunctionScope print(svm_set_print_string_function, LVsvm_print_function);
+		LVStatsScope scope(&stats);
+		LVsvm_train(lvErr, prob_in, param_in, model_out);
+	}
+
+	if (!lvErr->status){
+		// Support vectors of the trained model
+		stats.setSupportVectors(model_out->l);
+
+		// Every solver reports its iterations, none means that the output did not reach the print function (replaced by another library of the process)
+		if (stats.iterations() == 0)
+			LVException(__FILE__, __LINE__, LVErrorNoSolverOutput, "The solver output was not received, the iteration counters of the statistics are incomplete.").returnWarning(lvErr);
+	}
+
+	if (stats_out != nullptr)
+		stats.copyTo(*stats_out);
+}
+
+void LVsvm_cross_validation_stats(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t nr_fold, LVArray_Hdl<double> target_out, LVSolverStats *stats_out){
+	LVStats stats;
+	{
+		LVPrintFunctionScope print(svm_set_print_string_function, LVsvm_print_function);
+		LVStatsScope scope(&stats);
+		LVsvm_cross_validation(lvErr, prob_in, param_in, nr_fold, target_out);
+	}
+
+	if (stats_out != nullptr)
+		stats.copyTo(*stats_out);
+}
+
+double LVsvm_predict_stats(lvError *lvErr, const struct LVsvm_model *model_in, const LVArray_Hdl<LVsvm_node> x_in, LVSolverStats *stats_out){
+	LVStats stats;
+	double result;
+	{
+		LVPrintFunctionScope print(svm_set_print_string_function, LVsvm_print_function);
+		LVStatsScope scope(&stats);
+		result = LVsvm_predict(lvErr, model_in, x_in);
+	}
+
+	if (stats_out != nullptr)
+		stats.copyTo(*stats_out);
+	return result;
+}
+
+//-- Thread pool
+void LVsvm_set_thread_pool(lvError *lvErr, int32_t n_threads, const LVArray_Hdl<int32_t> cpus_in, int32_t priority){
+	try{
+		if (n_threads < 0)
+			throw LVException(__FILE__, __LINE__, "The number of pool threads must not be negative.");
+
+		LVThreadPoolSettings settings = LVThreadPool::instance().settings();
+		settings.threads = static_cast<size_t>(n_threads);
+		settings.cpus.clear();
+		if (cpus_in != nullptr)
+			settings.cpus.assign((*cpus_in)->elt, (*cpus_in)->elt + (*cpus_in)->dimSize);
+		settings.priority = priority;
+
+		LVThreadPool::instance().configure(settings);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_get_thread_pool(lvError *lvErr, int32_t *n_threads_out, LVArray_Hdl<int32_t> cpus_out, int32_t *priority_out){
+	try{
+		LVThreadPoolSettings settings = LVThreadPool::instance().settings();
+		*n_threads_out = static_cast<int32_t>(settings.threads);
+		*priority_out = settings.priority;
+		LVCopyToArrayHandle(cpus_out, settings.cpus);
+	}
+	catch (LVException &ex) {
+		(*cpus_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*cpus_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*cpus_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_set_core_reservation(lvError *lvErr, const LVArray_Hdl<int32_t> cpus_in){
+	try{
+		LVThreadPoolSettings settings = LVThreadPool::instance().settings();
+		settings.reserved.clear();
+		if (cpus_in != nullptr)
+			settings.reserved.assign((*cpus_in)->elt, (*cpus_in)->elt + (*cpus_in)->dimSize);
+
+		LVThreadPool::instance().configure(settings);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_get_core_reservation(lvError *lvErr, LVArray_Hdl<int32_t> cpus_out){
+	try{
+		LVCopyToArrayHandle(cpus_out, LVThreadPool::instance().settings().reserved);
+	}
+	catch (LVException &ex) {
+		(*cpus_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*cpus_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*cpus_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_shutdown(lvError *lvErr){
+	try{
+		LVJobQueue::instance().shutdown();
+		LVThreadPool::instance().shutdown();
+		LVLogger::instance().shutdown();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//-- Print function (console logging)
+void LVsvm_print_function(const char * message){
+	if (message == nullptr)
+		return;
+
+	// Called from inside the libsvm solver, nothing may be thrown through it (see LVCancellation.h)
+	try{
+		// Filter out the progress messages (..... and *), the others are queued for the next batch of the logger
+		if (strcmp(message, ".") != 0 && strcmp(message, "*") != 0){
+			LVUserEventRef *usrEv = loggingUsrEv;
+			LVLog(message, (usrEv != nullptr) ? *usrEv : 0);
+		}
+
+		// Iterations and shrinking events of the statistics collector of the run, if any (see LVStatistics.h)
+		LVCountSolverOutput(message);
+
+		// The progress messages count into the iteration budget of the run, "." every 1000 iterations
+		LVCountIterations((strcmp(message, ".") == 0) ? 1000 : 0);
+	}
+	catch (...) {
+		// A message that cannot be logged is dropped
+	}
+}
+
+void LVsvm_set_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_in) {
+	loggingUsrEv = loggingUserEvent_in;
+	LVInstallPrintFunction(svm_set_print_string_function, LVsvm_print_function);
+}
+
+void LVsvm_get_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out) {
+	loggingUserEvent_out = loggingUsrEv;
+}
+
+void LVsvm_delete_logging_userevent(lvError *lvErr, LVUserEventRef *loggingUserEvent_out) {
+	loggingUserEvent_out = loggingUsrEv;
+	loggingUsrEv = nullptr;
+}
+
+void LVsvm_set_logging_interval(lvError *lvErr, int32_t interval_ms){
+	try{
+		if (interval_ms <= 0)
+			throw LVException(__FILE__, __LINE__, "The logging interval must be positive (" + std::to_string(interval_ms) + " ms).");
+
+		LVLogger::instance().setInterval(std::chrono::milliseconds(interval_ms));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_flush_log(lvError *lvErr){
+	try{
+		LVLogger::instance().flush();
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+
+//
+//-- File saving/loading
+//
+
+void LVsvm_save_model(lvError *lvErr, const char *path_in, const LVsvm_model *model_in){
+	try{
+		// Convert LVsvm_model to svm_model
+		auto model = std::make_unique<svm_model>();
+		std::unique_ptr<svm_node*[]> SV;
+		std::unique_ptr<double*[]> sv_coef;
+		LVConvertModel(*model_in, *model, SV, sv_coef);
+
+		// Same output as svm_save_model
+		LVWriteTextFile(path_in, LVFormatTextModel(*model, false));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_load_model(lvError *lvErr, const char *path_in, LVsvm_model *model_out){
+	try{
+		LVMemoryMap map(path_in);
+		map.adviseSequential();
+
+		auto model = std::make_unique<svm_model>();
+		LVsvm_text_storage storage;
+		LVReadTextModel(map.data(), map.size(), *model, storage);
+
+		LVConvertModel(*model, *model_out);
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_save_model_round_trip(lvError *lvErr, const char *path_in, const LVsvm_model *model_in){
+	try{
+		// Convert LVsvm_model to svm_model
+		auto model = std::make_unique<svm_model>();
+		std::unique_ptr<svm_node*[]> SV;
+		std::unique_ptr<double*[]> sv_coef;
+		LVConvertModel(*model_in, *model, SV, sv_coef);
+
+		LVWriteTextFile(path_in, LVFormatTextModel(*model, true));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_save_model_binary(lvError *lvErr, const char *path_in, const LVsvm_model *model_in){
+	try{
+		// Convert LVsvm_model to svm_model
+		auto model = std::make_unique<svm_model>();
+		std::unique_ptr<svm_node*[]> SV;
+		std::unique_ptr<double*[]> sv_coef;
+		LVConvertModel(*model_in, *model, SV, sv_coef);
+
+		LVBinaryWriter writer(LVBinaryKind::Sparse);
+		LVsvm_binary_storage storage;
+		LVWriteBinaryModel(*model, writer, storage);
+		writer.writeFile(path_in);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_load_model_binary(lvError *lvErr, const char *path_in, LVsvm_model *model_out){
+	try{
+		// The file is only read as it is copied into LabVIEW memory
+		LVMemoryMap map(path_in);
+		map.adviseSequential();
+
+		LVBinaryReader reader(map.data(), map.size(), LVBinaryKind::Sparse);
+
+		auto model = std::make_unique<svm_model>();
+		std::unique_ptr<svm_node*[]> SV;
+		std::unique_ptr<double*[]> sv_coef;
+		std::unique_ptr<svm_node[]> nodes;
+		LVReadBinaryModel(reader, *model, SV, sv_coef, nodes);
+
+		LVConvertModel(*model, *model_out);
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_save_model_binary_scaled(lvError *lvErr, const char *path_in, const LVsvm_model *model_in, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in){
+	try{
+		std::shared_ptr<const LVScaling> scaling = LVConvertScaling(scale_in, shift_in);
+
+		// Convert LVsvm_model to svm_model
+		auto model = std::make_unique<svm_model>();
+		std::unique_ptr<svm_node*[]> SV;
+		std::unique_ptr<double*[]> sv_coef;
+		LVConvertModel(*model_in, *model, SV, sv_coef);
+
+		LVBinaryWriter writer(LVBinaryKind::Sparse);
+		LVsvm_binary_storage storage;
+		LVWriteBinaryModel(*model, writer, storage);
+		if (scaling)
+			LVWriteBinaryScaling(*scaling, writer);
+		writer.writeFile(path_in);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_serialize_model(lvError *lvErr, const LVsvm_model *model_in, LStrHandle model_out){
+	try{
+		// Convert LVsvm_model to svm_model
+		auto model = std::make_unique<svm_model>();
+		std::unique_ptr<svm_node*[]> SV;
+		std::unique_ptr<double*[]> sv_coef;
+		LVConvertModel(*model_in, *model, SV, sv_coef);
+
+		LVBinaryWriter writer(LVBinaryKind::Sparse);
+		LVsvm_binary_storage storage;
+		LVWriteBinaryModel(*model, writer, storage);
+		LVResizeStringHandle(model_out, writer.size());
+		writer.writeBuffer(reinterpret_cast<char*>((*model_out)->str));
+	}
+	catch (LVException &ex) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_serialize_model_text(lvError *lvErr, const LVsvm_model *model_in, LVBoolean round_trip, LStrHandle model_out){
+	try{
+		// Convert LVsvm_model to svm_model
+		auto model = std::make_unique<svm_model>();
+		std::unique_ptr<svm_node*[]> SV;
+		std::unique_ptr<double*[]> sv_coef;
+		LVConvertModel(*model_in, *model, SV, sv_coef);
+
+		LVWriteStringHandle(model_out, LVFormatTextModel(*model, round_trip != 0));
+	}
+	catch (LVException &ex) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		if (DSCheckHandle(model_out) == noErr)
+			(*model_out)->cnt = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_deserialize_model(lvError *lvErr, const LStrHandle model_in, LVsvm_model *model_out){
+	try{
+		// Input validation: Empty string
+		if (model_in == nullptr || (*model_in)->cnt <= 0)
+			throw LVException(__FILE__, __LINE__, "Empty string passed to LVsvm_deserialize_model.");
+
+		const char *data = reinterpret_cast<const char*>((*model_in)->str);
+		size_t size = static_cast<size_t>((*model_in)->cnt);
+
+		auto model = std::make_unique<svm_model>();
+		if (LVIsBinaryModel(data, size)){
+			// The sections are accessed in place, which requires aligned memory
+			std::unique_ptr<uint64_t[]> buffer = LVBinaryCopyAligned(data, size);
+			LVBinaryReader reader(reinterpret_cast<const char*>(buffer.get()), size, LVBinaryKind::Sparse);
+
+			std::unique_ptr<svm_node*[]> SV;
+			std::unique_ptr<double*[]> sv_coef;
+			std::unique_ptr<svm_node[]> nodes;
+			LVReadBinaryModel(reader, *model, SV, sv_coef, nodes);
+
+			LVConvertModel(*model, *model_out);
+		}
+		else{
+			LVsvm_text_storage storage;
+			LVReadTextModel(data, size, *model, storage);
+
+			LVConvertModel(*model, *model_out);
+		}
+	}
+	catch (LVException &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(model_out->label))->dimSize = 0;
+		(*(model_out->nSV))->dimSize = 0;
+		(*(model_out->probA))->dimSize = 0;
+		(*(model_out->probB))->dimSize = 0;
+		(*(model_out->rho))->dimSize = 0;
+		(*(model_out->SV))->dimSize = 0;
+		(*(model_out->sv_coef))->dimSize[0] = 0;
+		(*(model_out->sv_coef))->dimSize[1] = 0;
+		(*(model_out->sv_indices))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Native model handles
+//
+
+void LVsvm_load_model_handle(lvError *lvErr, const char *path_in, LVBoolean pack, uint64_t *handle_out){
+	try{
+		*handle_out = 0;
+		*handle_out = modelHandles.add(LVLoadNativeModel(path_in, pack != 0));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_free_model_handle(lvError *lvErr, uint64_t handle){
+	try{
+		modelHandles.remove(handle);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+double LVsvm_predict_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<LVsvm_node> x_in){
+	try{
+		LVLatencyScope latency;
+
+		// Input validation: Empty feature vector
+		if (x_in == nullptr || (*x_in)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, "Empty feature vector passed to libsvm_predict.");
+
+		// Input validation: Final index -1?
+		if ((*x_in)->elt[(*x_in)->dimSize - 1].index != -1)
+			throw LVException(__FILE__, __LINE__, "The index of the last element of the feature vector needs to be -1 (libsvm_predict).");
+
+		auto native = modelHandles.get(handle);
+		std::vector<svm_node> scaled;
+		const svm_node *x = LVScaleInput(*native, reinterpret_cast<svm_node*>((*x_in)->elt), scaled);
+
+		return svm_predict(&native->view, x);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+		return std::nan("");
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+		return std::nan("");
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+		return std::nan("");
+	}
+}
+
+double LVsvm_predict_values_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<LVsvm_node> x_in, LVArray_Hdl<double> dec_values_out){
+	try{
+		LVLatencyScope latency;
+
+		// Input validation: Empty feature vector
+		if (x_in == nullptr || (*x_in)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, "Empty feature vector passed to libsvm_predict_values.");
+
+		// Input validation: Final index -1?
+		if ((*x_in)->elt[(*x_in)->dimSize - 1].index != -1)
+			throw LVException(__FILE__, __LINE__, "The index of the last element of the feature vector needs to be -1 (libsvm_predict_values).");
+
+		auto native = modelHandles.get(handle);
+		const svm_model *model = &native->view;
+
+		// Allocate room for dec_values output
+		if (model->param.svm_type == ONE_CLASS ||
+			model->param.svm_type == EPSILON_SVR ||
+			model->param.svm_type == NU_SVR){
+			LVResizeNumericArrayHandle(dec_values_out, 1);
+			(*dec_values_out)->dimSize = 1;
+		}
+		else{
+			size_t nr_pairs = model->nr_class * (model->nr_class - 1) / 2;
+			LVResizeNumericArrayHandle(dec_values_out, nr_pairs);
+			(*dec_values_out)->dimSize = static_cast<uint32_t>(nr_pairs);
+		}
+
+		std::vector<svm_node> scaled;
+		const svm_node *x = LVScaleInput(*native, reinterpret_cast<svm_node*>((*x_in)->elt), scaled);
+
+		return svm_predict_values(model, x, (*dec_values_out)->elt);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+		(*dec_values_out)->dimSize = 0;
+		return std::nan("");
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+		(*dec_values_out)->dimSize = 0;
+		return std::nan("");
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+		(*dec_values_out)->dimSize = 0;
+		return std::nan("");
+	}
+}
+
+double LVsvm_predict_probability_handle(lvError *lvErr, uint64_t handle, const LVArray_Hdl<LVsvm_node> x_in, LVArray_Hdl<double> prob_estimates_out){
+	try{
+		LVLatencyScope latency;
+
+		// Input validation: Empty feature vector
+		if (x_in == nullptr || (*x_in)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, "Empty feature vector passed to libsvm_predict_probability.");
+
+		// Input validation: Final index -1?
+		if ((*x_in)->elt[(*x_in)->dimSize - 1].index != -1)
+			throw LVException(__FILE__, __LINE__, "The index of the last element of the feature vector needs to be -1 (libsvm_predict_probability).");
+
+		auto native = modelHandles.get(handle);
+		const svm_model *model = &native->view;
+
+		// Check probability model
+		if (!svm_check_probability_model(model))
+			throw LVException(__FILE__, __LINE__, "The probability model is not valid.");
+
+		// Allocate room for probability estimates
+		// Regression and one-class SVM does not modify this value (returns the same as svm_predict)
+		if (model->param.svm_type == C_SVC || model->param.svm_type == NU_SVC){
+			LVResizeNumericArrayHandle(prob_estimates_out, model->nr_class);
+			(*prob_estimates_out)->dimSize = model->nr_class;
+		}
+		else {
+			(*prob_estimates_out)->dimSize = 0;
+		}
+
+		std::vector<svm_node> scaled;
+		const svm_node *x = LVScaleInput(*native, reinterpret_cast<svm_node*>((*x_in)->elt), scaled);
+
+		return svm_predict_probability(model, x, (*prob_estimates_out)->elt);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+		(*prob_estimates_out)->dimSize = 0;
+		return std::nan("");
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+		(*prob_estimates_out)->dimSize = 0;
+		return std::nan("");
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+		(*prob_estimates_out)->dimSize = 0;
+		return std::nan("");
+	}
+}
+
+void LVsvm_set_model_handle_scaling(lvError *lvErr, uint64_t handle, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in){
+	try{
+		auto native = modelHandles.get(handle);
+		std::shared_ptr<const LVScaling> scaling = LVConvertScaling(scale_in, shift_in);
+
+		// Predictions in progress keep using the previous scaling
+		std::atomic_store(&native->scaling, scaling);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_get_model_handle_scaling(lvError *lvErr, uint64_t handle, LVArray_Hdl<double> scale_out, LVArray_Hdl<double> shift_out){
+	try{
+		auto native = modelHandles.get(handle);
+		std::shared_ptr<const LVScaling> scaling = std::atomic_load(&native->scaling);
+
+		LVCopyToArrayHandle(scale_out, scaling ? scaling->scale() : std::vector<double>());
+		LVCopyToArrayHandle(shift_out, scaling ? scaling->shift() : std::vector<double>());
+	}
+	catch (LVException &ex) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_train_handle(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, uint64_t *handle_out){
+	try{
+		LVThroughputScope throughput;
+
+		*handle_out = 0;
+		*handle_out = modelHandles.add(LVTrainNativeModel(*prob_in, *param_in));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Data files
+//
+
+void LVsvm_read_problem(lvError *lvErr, const char *path_in, LVBoolean skip_malformed, LVsvm_problem *prob_out, LVArray_Hdl<uint64_t> malformed_lines_out){
+	try{
+		// Index 0 is used for the serial number of precomputed kernels
+		LVDataset dataset;
+		LVReadDatasetFile(path_in, 0, skip_malformed != 0, dataset);
+
+		LVConvertDataset(dataset, *prob_out);
+		LVCopyToArrayHandle(malformed_lines_out, dataset.malformedLines);
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*malformed_lines_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*malformed_lines_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*malformed_lines_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_read_problem_csr(lvError *lvErr, const char *path_in, LVBoolean skip_malformed, LVsvm_csr_problem *prob_out, LVArray_Hdl<uint64_t> malformed_lines_out){
+	try{
+		LVDataset dataset;
+		LVReadDatasetFile(path_in, 0, skip_malformed != 0, dataset);
+
+		LVConvertDataset(dataset, *prob_out);
+		LVCopyToArrayHandle(malformed_lines_out, dataset.malformedLines);
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->row_ptr))->dimSize = 0;
+		(*(prob_out->index))->dimSize = 0;
+		(*(prob_out->value))->dimSize = 0;
+		(*malformed_lines_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->row_ptr))->dimSize = 0;
+		(*(prob_out->index))->dimSize = 0;
+		(*(prob_out->value))->dimSize = 0;
+		(*malformed_lines_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->row_ptr))->dimSize = 0;
+		(*(prob_out->index))->dimSize = 0;
+		(*(prob_out->value))->dimSize = 0;
+		(*malformed_lines_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_write_problem(lvError *lvErr, const char *path_in, const LVsvm_problem *prob_in){
+	try{
+		// Input verification: Problem dimensions
+		if (prob_in->x == nullptr || prob_in->y == nullptr || (*(prob_in->x))->dimSize != (*(prob_in->y))->dimSize)
+			throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and feature vectors (x and y).");
+
+		size_t l = (*(prob_in->y))->dimSize;
+		const double *y = (*(prob_in->y))->elt;
+		const LVArray_Hdl<LVsvm_node> *x = (*(prob_in->x))->elt;
+
+		// Nodes are written up to the terminating -1 index
+		LVWriteTextFile(path_in, LVFormatDataset(l, [&](size_t i, LVTextWriter &writer){
+			LVPutDatasetLabel(writer, y[i]);
+
+			LVArray_Hdl<LVsvm_node> xi = x[i];
+			if (xi != nullptr){
+				for (uint32_t k = 0; k < (*xi)->dimSize && (*xi)->elt[k].index != -1; k++)
+					LVPutDatasetNode(writer, (*xi)->elt[k].index, (*xi)->elt[k].value);
+			}
+
+			writer.put('\n');
+		}));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_write_problem_csr(lvError *lvErr, const char *path_in, const LVsvm_csr_problem *prob_in){
+	try{
+		// Input verification: Array dimensions
+		if (prob_in->y == nullptr || prob_in->row_ptr == nullptr || prob_in->index == nullptr || prob_in->value == nullptr)
+			throw LVException(__FILE__, __LINE__, "Uninitialized problem passed to LVsvm_write_problem_csr.");
+
+		size_t l = (*(prob_in->y))->dimSize;
+		size_t nnz = (*(prob_in->index))->dimSize;
+		if ((*(prob_in->row_ptr))->dimSize != l + 1 || (*(prob_in->value))->dimSize != nnz)
+			throw LVException(__FILE__, __LINE__, "The CSR problem must have l+1 row pointers and an equal number of indices and values.");
+
+		const int32_t *row_ptr = (*(prob_in->row_ptr))->elt;
+		if (row_ptr[0] != 0 || static_cast<size_t>(row_ptr[l]) != nnz)
+			throw LVException(__FILE__, __LINE__, "The first row pointer must be zero and the last equal to the number of nodes.");
+
+		for (size_t i = 0; i < l; i++){
+			if (row_ptr[i + 1] < row_ptr[i])
+				throw LVException(__FILE__, __LINE__, "The row pointers must be non-decreasing (row " + std::to_string(i) + ").");
+		}
+
+		const double *y = (*(prob_in->y))->elt;
+		const int32_t *index = (*(prob_in->index))->elt;
+		const double *value = (*(prob_in->value))->elt;
+
+		LVWriteTextFile(path_in, LVFormatDataset(l, [&](size_t i, LVTextWriter &writer){
+			LVPutDatasetLabel(writer, y[i]);
+			for (int32_t k = row_ptr[i]; k < row_ptr[i + 1]; k++)
+				LVPutDatasetNode(writer, index[k], value[k]);
+			writer.put('\n');
+		}));
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_read_delimited(lvError *lvErr, const char *path_in, uint8_t delimiter, int32_t header_rows, int32_t label_column, int32_t missing_policy, double missing_value, LVsvm_problem *prob_out, LVArray_Hdl<uint64_t> skipped_lines_out){
+	try{
+		LVDelimitedOptions options = LVMakeDelimitedOptions(delimiter, header_rows, label_column, missing_policy, missing_value);
+
+		LVDataset dataset;
+		{
+			LVDenseTable table;
+			LVReadDelimitedFile(path_in, options, table);
+			LVConvertTable(table, dataset);
+		}
+
+		LVConvertDataset(dataset, *prob_out);
+		LVCopyToArrayHandle(skipped_lines_out, dataset.malformedLines);
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*skipped_lines_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*skipped_lines_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+		(*skipped_lines_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_read_delimited_csr(lvError *lvErr, const char *path_in, uint8_t delimiter, int32_t header_rows, int32_t label_column, int32_t missing_policy, double missing_value, LVsvm_csr_problem *prob_out, LVArray_Hdl<uint64_t> skipped_lines_out){
+	try{
+		LVDelimitedOptions options = LVMakeDelimitedOptions(delimiter, header_rows, label_column, missing_policy, missing_value);
+
+		LVDataset dataset;
+		{
+			LVDenseTable table;
+			LVReadDelimitedFile(path_in, options, table);
+			LVConvertTable(table, dataset);
+		}
+
+		LVConvertDataset(dataset, *prob_out);
+		LVCopyToArrayHandle(skipped_lines_out, dataset.malformedLines);
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->row_ptr))->dimSize = 0;
+		(*(prob_out->index))->dimSize = 0;
+		(*(prob_out->value))->dimSize = 0;
+		(*skipped_lines_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->row_ptr))->dimSize = 0;
+		(*(prob_out->index))->dimSize = 0;
+		(*(prob_out->value))->dimSize = 0;
+		(*skipped_lines_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->row_ptr))->dimSize = 0;
+		(*(prob_out->index))->dimSize = 0;
+		(*(prob_out->value))->dimSize = 0;
+		(*skipped_lines_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Feature scaling
+//
+
+void LVsvm_compute_scaling(lvError *lvErr, const LVsvm_problem *prob_in, int32_t method, double lower, double upper, LVArray_Hdl<double> scale_out, LVArray_Hdl<double> shift_out){
+	try{
+		LVScalingMethod scaling_method = LVCheckScalingMethod(method, lower, upper);
+		LVScaling scaling = LVComputeProblemScaling(*prob_in, scaling_method, lower, upper);
+
+		LVCopyToArrayHandle(scale_out, scaling.scale());
+		LVCopyToArrayHandle(shift_out, scaling.shift());
+	}
+	catch (LVException &ex) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*scale_out)->dimSize = 0;
+		(*shift_out)->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_scale_problem(lvError *lvErr, LVsvm_problem *prob_inout, const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in){
+	try{
+		std::shared_ptr<const LVScaling> scaling = LVConvertScaling(scale_in, shift_in);
+		if (scaling)
+			LVScaleProblem(*scaling, *prob_inout);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Problem conversion
+//
+
+void LVsvm_problem_from_dense(lvError *lvErr, const LVsvm_dense_problem *prob_in, LVsvm_problem *prob_out){
+	try{
+		LVCheckProblemSize(prob_in->y, prob_in->x);
+		LVDenseMaxLength(prob_in->x);
+
+		LVDenseToSparse(prob_in->x, -1, 0, prob_out->x);
+		LVCopyLabels(prob_in->y, prob_out->y);
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_problem_from_linear(lvError *lvErr, const LVsvm_linear_problem *prob_in, LVsvm_problem *prob_out){
+	try{
+		LVCheckProblemSize(prob_in->y, prob_in->x);
+		LVSparseMaxIndex(prob_in->x, prob_in->bias >= 0);
+
+		LVSparseToSparse(prob_in->x, prob_in->bias >= 0, -1, 0, prob_out->x);
+		LVCopyLabels(prob_in->y, prob_out->y);
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Feature selection
+//
+
+void LVsvm_fscore(lvError *lvErr, const LVsvm_problem *prob_in, int32_t n_select, LVArray_Hdl<double> fscore_out, LVArray_Hdl<int32_t> ranking_out, LVsvm_problem *prob_out){
+	try{
+		size_t l = LVCheckProblemSize(prob_in->y, prob_in->x);
+		size_t n_features = static_cast<size_t>(LVSparseMaxIndex(prob_in->x, false)) + 1;
+		LVArray_Hdl<LVsvm_node> *x = (*(prob_in->x))->elt;
+
+		std::vector<double> fscore = LVComputeFScores((*(prob_in->y))->elt, l, n_features, [&](size_t i, LVClassStatistics &statistics){
+			for (const LVsvm_node *node = (*x[i])->elt; node->index != -1; node++)
+				statistics.add(node->index, node->value);
+		});
+		std::vector<int32_t> ranking = LVRankFeatures(fscore, 1);
+
+		size_t n = (n_select > 0) ? std::min(ranking.size(), static_cast<size_t>(n_select)) : ranking.size();
+		std::vector<char> mask = LVSelectionMask(ranking.data(), n, 1, 0);
+		LVSelectSparse(prob_in->x, false, mask, prob_out->x);
+		LVCopyLabels(prob_in->y, prob_out->y);
+
+		LVCopyToArrayHandle(fscore_out, fscore);
+		LVCopyToArrayHandle(ranking_out, ranking);
+	}
+	catch (LVException &ex) {
+		(*fscore_out)->dimSize = 0;
+		(*ranking_out)->dimSize = 0;
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*fscore_out)->dimSize = 0;
+		(*ranking_out)->dimSize = 0;
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*fscore_out)->dimSize = 0;
+		(*ranking_out)->dimSize = 0;
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_select_features(lvError *lvErr, const LVsvm_problem *prob_in, const LVArray_Hdl<int32_t> features_in, LVsvm_problem *prob_out){
+	try{
+		LVCheckProblemSize(prob_in->y, prob_in->x);
+
+		size_t n = (features_in != nullptr) ? (*features_in)->dimSize : 0;
+		std::vector<char> mask = LVSelectionMask((n > 0) ? (*features_in)->elt : nullptr, n, 1, 0);
+		LVSelectSparse(prob_in->x, false, mask, prob_out->x);
+		LVCopyLabels(prob_in->y, prob_out->y);
+	}
+	catch (LVException &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		(*(prob_out->y))->dimSize = 0;
+		(*(prob_out->x))->dimSize = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Engine selection
+//
+
+void LVsvm_analyze_problem(lvError *lvErr, const LVsvm_problem *prob_in, int32_t svm_type, int32_t kernel_type, LVProblemProfile *profile_out, int32_t *backend_out, LStrHandle reason_out){
+	try{
+		*profile_out = LVProblemProfile();
+		*backend_out = -1;
+
+		*profile_out = LVProfileProblem(*prob_in, kernel_type);
+		LVBackendChoice choice = LVSelectBackend(*profile_out, svm_type, kernel_type);
+
+		*backend_out = static_cast<int32_t>(choice.backend);
+		LVWriteStringHandle(reason_out, choice.reason);
+	}
+	catch (LVException &ex) {
+		if (DSCheckHandle(reason_out) == noErr)
+			(*reason_out)->cnt = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		if (DSCheckHandle(reason_out) == noErr)
+			(*reason_out)->cnt = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		if (DSCheckHandle(reason_out) == noErr)
+			(*reason_out)->cnt = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+void LVsvm_train_auto(lvError *lvErr, const LVsvm_problem *prob_in, const LVsvm_parameter *param_in, int32_t backend, uint64_t *handle_out, int32_t *backend_out, LStrHandle reason_out){
+	try{
+		LVThroughputScope throughput;
+
+		*handle_out = 0;
+		*backend_out = -1;
+
+		LVProblemProfile profile = LVProfileProblem(*prob_in, param_in->kernel_type);
+		LVBackendChoice choice;
+		if (LVCheckBackend(backend)){
+			choice.backend = static_cast<LVBackend>(backend);
+			choice.reason = std::string(LVBackendName(choice.backend)) + " selected by the caller";
+		}
+		else{
+			choice = LVSelectBackend(profile, param_in->svm_type, param_in->kernel_type);
+		}
+
+		if (choice.backend != LVBackend::Sparse && param_in->kernel_type == PRECOMPUTED)
+			throw LVException(__FILE__, __LINE__, "Precomputed kernels can only be trained by libsvm (LVsvm_train_auto).");
+
+		auto model = std::make_shared<LVsvm_auto_model>();
+		model->backend = choice.backend;
+		model->n_features = static_cast<size_t>(profile.n_features);
+
+		if (choice.backend == LVBackend::Sparse){
+			model->native = LVTrainNativeModel(*prob_in, *param_in);
+		}
+		else if (choice.backend == LVBackend::Dense){
+			model->library = LVLoadEngineLibrary("LabVIEW-libsvm-dense");
+			auto train = model->library->function<LVsvm_dense_train_function>("LVsvm_train_handle");
+			model->predict_dense = model->library->function<LVsvm_dense_predict_function>("LVsvm_predict_handle");
+			model->free_handle = model->library->function<LVsvm_free_handle_function>("LVsvm_free_model_handle");
+
+			// Temporary dense copy of the feature vectors, the labels are shared
+			LVTemporaryArrayHandle<LVArray_Hdl<LVArray_Hdl<double>>> x;
+			LVSparseToDense(prob_in->x, false, model->n_features, x.handle);
+			LVsvm_dense_problem prob = { prob_in->y, x.handle };
+
+			lvError err;
+			train(&err, &prob, param_in, &model->handle);
+			LVThrowLibraryError(err);
+		}
+		else{
+			LVsvm_linear_parameter param = LVConvertLinearParameter(*param_in);
+			if (model->n_features >= INT_MAX)
+				throw LVException(__FILE__, __LINE__, "Feature index too large for the bias feature of liblinear (LVsvm_train_auto).");
+
+			model->library = LVLoadEngineLibrary("LabVIEW-liblinear");
+			auto train = model->library->function<LVsvm_linear_train_function>("LVlinear_train_handle");
+			model->predict_linear = model->library->function<LVsvm_linear_predict_function>("LVlinear_predict_handle");
+			model->free_handle = model->library->function<LVsvm_free_handle_function>("LVlinear_free_model_handle");
+
+			// Temporary copy of the feature vectors with the bias feature appended, the labels are shared
+			model->bias_index = static_cast<int32_t>(model->n_features) + 1;
+			LVTemporaryArrayHandle<LVArray_Hdl<LVArray_Hdl<LVsvm_node>>> x;
+			LVSparseToSparse(prob_in->x, false, 1.0, model->bias_index, x.handle);
+			LVsvm_linear_problem prob = { prob_in->y, x.handle, 1.0 };
+
+			lvError err;
+			train(&err, &prob, &param, &model->handle);
+			LVThrowLibraryError(err);
+		}
+
+		*handle_out = autoHandles.add(model);
+		*backend_out = static_cast<int32_t>(choice.backend);
+		LVWriteStringHandle(reason_out, choice.reason);
+	}
+	catch (LVException &ex) {
+		*handle_out = 0;
+		if (DSCheckHandle(reason_out) == noErr)
+			(*reason_out)->cnt = 0;
+
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		*handle_out = 0;
+		if (DSCheckHandle(reason_out) == noErr)
+			(*reason_out)->cnt = 0;
+
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		*handle_out = 0;
+		if (DSCheckHandle(reason_out) == noErr)
+			(*reason_out)->cnt = 0;
+
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+double LVsvm_predict_auto(lvError *lvErr, uint64_t handle, const LVArray_Hdl<LVsvm_node> x_in){
+	try{
+		LVLatencyScope latency;
+
+		// Input validation: Empty feature vector
+		if (x_in == nullptr || (*x_in)->dimSize == 0)
+			throw LVException(__FILE__, __LINE__, "Empty feature vector passed to LVsvm_predict_auto.");
+
+		// Input validation: Final index -1?
+		if ((*x_in)->elt[(*x_in)->dimSize - 1].index != -1)
+			throw LVException(__FILE__, __LINE__, "The index of the last element of the feature vector needs to be -1 (LVsvm_predict_auto).");
+
+		auto model = autoHandles.get(handle);
+		const LVsvm_node *x = (*x_in)->elt;
+		size_t n = (*x_in)->dimSize - 1;
+
+		if (model->backend == LVBackend::Sparse)
+			return svm_predict(&model->native->view, reinterpret_cast<const svm_node*>(x));
+
+		lvError err;
+		double result;
+		if (model->backend == LVBackend::Dense){
+			// Dense vector of the width of the training problem, libsvm-dense truncates longer vectors anyway
+			size_t n_features = model->n_features;
+			LVTemporaryArrayHandle<LVArray_Hdl<double>> values;
+			LVResizeNumericArrayHandle(values.handle, n_features);
+			(*values.handle)->dimSize = static_cast<uint32_t>(n_features);
+
+			double *dense = (*values.handle)->elt;
+			std::fill(dense, dense + n_features, 0.0);
+			for (size_t k = 0; k < n; k++){
+				if (x[k].index > 0 && static_cast<size_t>(x[k].index) <= n_features)
+					dense[x[k].index - 1] = x[k].value;
+			}
+
+			result = model->predict_dense(&err, model->handle, values.handle);
+		}
+		else{
+			// Features the model was not trained on have no weight, they are dropped so that none is mistaken for the bias feature
+			LVTemporaryArrayHandle<LVArray_Hdl<LVsvm_node>> nodes;
+			LVResizeCompositeArrayHandle(nodes.handle, n + 2);
+			LVsvm_node *node = (*nodes.handle)->elt;
+			for (size_t k = 0; k < n; k++){
+				if (x[k].index > 0 && x[k].index < model->bias_index)
+					*node++ = x[k];
+			}
+
+			node->index = model->bias_index;
+			node->value = 1.0;
+			node++;
+			node->index = -1;
+			node->value = 0;
+			(*nodes.handle)->dimSize = static_cast<uint32_t>(node - (*nodes.handle)->elt + 1);
+
+			result = model->predict_linear(&err, model->handle, nodes.handle);
+		}
+
+		LVThrowLibraryError(err);
+		return result;
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+		return std::nan("");
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+		return std::nan("");
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+		return std::nan("");
+	}
+}
+
+void LVsvm_free_auto_handle(lvError *lvErr, uint64_t handle){
+	try{
+		autoHandles.remove(handle);
+	}
+	catch (LVException &ex) {
+		ex.returnError(lvErr);
+	}
+	catch (std::exception &ex) {
+		LVException::returnStdException(lvErr, __FILE__, __LINE__, ex);
+	}
+	catch (...) {
+		LVException ex(__FILE__, __LINE__, "Unknown exception has occurred");
+		ex.returnError(lvErr);
+	}
+}
+
+//
+//-- Binary model helpers
+//
+
+// svm_node can be used in place of LVsvm_binary_node if the layouts are identical
+static const bool svm_node_is_binary_node =
+	sizeof(svm_node) == sizeof(LVsvm_binary_node) &&
+	offsetof(svm_node, index) == offsetof(LVsvm_binary_node, index) &&
+	offsetof(svm_node, value) == offsetof(LVsvm_binary_node, value);
+
+void LVWriteBinaryModel(const svm_model &model_in, LVBinaryWriter &writer, LVsvm_binary_storage &storage){
+	const svm_parameter &param = model_in.param;
+	int nr_class = model_in.nr_class;
+	int nr_pairs = nr_class*(nr_class - 1) / 2;
+	int l = model_in.l;
+
+	if (l <= 0 || model_in.SV == nullptr || model_in.sv_coef == nullptr || model_in.rho == nullptr)
+		throw LVException(__FILE__, __LINE__, "Uninitialized model passed to binary model writer.");
+
+	// Parameters
+	LVsvm_binary_parameter &bparam = storage.param;
+	bparam = LVsvm_binary_parameter();
+	bparam.gamma = param.gamma;
+	bparam.coef0 = param.coef0;
+	bparam.cache_size = param.cache_size;
+	bparam.eps = param.eps;
+	bparam.C = param.C;
+	bparam.nu = param.nu;
+	bparam.p = param.p;
+	bparam.svm_type = param.svm_type;
+	bparam.kernel_type = param.kernel_type;
+	bparam.degree = param.degree;
+	bparam.shrinking = param.shrinking;
+	bparam.probability = param.probability;
+	bparam.nr_class = nr_class;
+	bparam.l = l;
+	writer.addSection(LVSVM_SECTION_PARAMETER, &bparam, 1);
+
+	int nr_weight = (param.weight != nullptr && param.weight_label != nullptr) ? param.nr_weight : 0;
+	writer.addSection<int32_t>(LVSVM_SECTION_WEIGHT_LABEL, param.weight_label, nr_weight);
+	writer.addSection<double>(LVSVM_SECTION_WEIGHT, param.weight, nr_weight);
+
+	// Model arrays (missing arrays are stored as empty sections)
+	writer.addSection<int32_t>(LVSVM_SECTION_LABEL, model_in.label, model_in.label ? nr_class : 0);
+	writer.addSection<int32_t>(LVSVM_SECTION_NSV, model_in.nSV, model_in.nSV ? nr_class : 0);
+	writer.addSection<double>(LVSVM_SECTION_RHO, model_in.rho, nr_pairs);
+	writer.addSection<double>(LVSVM_SECTION_PROBA, model_in.probA, (param.probability && model_in.probA) ? nr_pairs : 0);
+	writer.addSection<double>(LVSVM_SECTION_PROBB, model_in.probB, (param.probability && model_in.probB) ? nr_pairs : 0);
+	writer.addSection<int32_t>(LVSVM_SECTION_SV_INDICES, model_in.sv_indices, model_in.sv_indices ? l : 0);
+
+	// sv_coef is gathered row by row
+	writer.beginSection(LVSVM_SECTION_SV_COEF, sizeof(double));
+	for (int i = 0; i < nr_class - 1; i++)
+		writer.appendChunk(model_in.sv_coef[i], l);
+
+	// Node count of each support vector (-1 terminated, precomputed kernels store a single node)
+	storage.sv_offsets.resize(static_cast<size_t>(l) + 1);
+	storage.sv_offsets[0] = 0;
+	for (int i = 0; i < l; i++){
+		if (model_in.SV[i] == nullptr)
+			throw LVException(__FILE__, __LINE__, "Model error: support vector #" + std::to_string(i) + " is invalid (null).");
+
+		size_t n_nodes = 1;
+		if (param.kernel_type != PRECOMPUTED){
+			const svm_node *p = model_in.SV[i];
+			while (p->index != -1){
+				n_nodes++;
+				p++;
+			}
+		}
+		storage.sv_offsets[i + 1] = storage.sv_offsets[i] + n_nodes;
+	}
+	writer.addSection<uint64_t>(LVSVM_SECTION_SV_OFFSETS, storage.sv_offsets.data(), storage.sv_offsets.size());
+
+	// Support vectors, referenced directly if the node layout matches
+	writer.beginSection(LVSVM_SECTION_SV_NODES, sizeof(LVsvm_binary_node));
+	if (svm_node_is_binary_node){
+		for (int i = 0; i < l; i++)
+			writer.appendChunk(model_in.SV[i], static_cast<size_t>(storage.sv_offsets[i + 1] - storage.sv_offsets[i]));
+	}
+	else {
+		storage.nodes.resize(static_cast<size_t>(storage.sv_offsets[l]));
+		for (int i = 0; i < l; i++){
+			for (uint64_t j = storage.sv_offsets[i]; j < storage.sv_offsets[i + 1]; j++){
+				const svm_node &node = model_in.SV[i][j - storage.sv_offsets[i]];
+				storage.nodes[j].index = node.index;
+				storage.nodes[j].padding = 0;
+				storage.nodes[j].value = node.value;
+			}
+		}
+		writer.appendChunk(storage.nodes.data(), storage.nodes.size());
+	}
+}
+
+void LVReadBinaryModel(const LVBinaryReader &reader, svm_model &model_out, std::unique_ptr<svm_node*[]> &SV, std::unique_ptr<double*[]> &sv_coef, std::unique_ptr<svm_node[]> &nodes){
+	const LVsvm_binary_parameter &bparam = reader.scalar<LVsvm_binary_parameter>(LVSVM_SECTION_PARAMETER);
+
+	int nr_class = bparam.nr_class;
+	int l = bparam.l;
+	if (nr_class < 1 || l <= 0)
+		throw LVException(__FILE__, __LINE__, "Invalid binary model: number of classes or support vectors is invalid.");
+
+	size_t nr_pairs = static_cast<size_t>(nr_class)*(nr_class - 1) / 2;
+
+	// Parameters
+	svm_parameter &param = model_out.param;
+	param.svm_type = bparam.svm_type;
+	param.kernel_type = bparam.kernel_type;
+	param.degree = bparam.degree;
+	param.gamma = bparam.gamma;
+	param.coef0 = bparam.coef0;
+	param.cache_size = bparam.cache_size;
+	param.eps = bparam.eps;
+	param.C = bparam.C;
+	param.nu = bparam.nu;
+	param.p = bparam.p;
+	param.shrinking = bparam.shrinking;
+	param.probability = bparam.probability;
+
+	size_t nr_weight = 0, nr_weight_label = 0;
+	param.weight = const_cast<double*>(reader.section<double>(LVSVM_SECTION_WEIGHT, nr_weight));
+	param.weight_label = const_cast<int*>(reader.section<int32_t>(LVSVM_SECTION_WEIGHT_LABEL, nr_weight_label));
+	if (nr_weight != nr_weight_label)
+		throw LVException(__FILE__, __LINE__, "Invalid binary model: the number of elements in weight and weight_label does not match.");
+	param.nr_weight = static_cast<int>(nr_weight);
+
+	model_out.nr_class = nr_class;
+	model_out.l = l;
+	model_out.free_sv = 0;
+
+	// Helper to verify the expected section lengths (count 0 means the array is absent)
+	auto checkCount = [](size_t count, size_t expected, bool optional, const char *name){
+		if (count != expected && !(optional && count == 0))
+			throw LVException(__FILE__, __LINE__, std::string("Invalid binary model: unexpected number of elements in ") + name + ".");
+	};
+
+	size_t count = 0;
+	model_out.label = const_cast<int*>(reader.section<int32_t>(LVSVM_SECTION_LABEL, count));
+	checkCount(count, nr_class, true, "label");
+
+	model_out.nSV = const_cast<int*>(reader.section<int32_t>(LVSVM_SECTION_NSV, count));
+	checkCount(count, nr_class, true, "nSV");
+
+	model_out.rho = const_cast<double*>(reader.section<double>(LVSVM_SECTION_RHO, count));
+	checkCount(count, nr_pairs, false, "rho");
+	if (model_out.rho == nullptr)
+		throw LVException(__FILE__, __LINE__, "Invalid binary model: rho is missing.");
+
+	model_out.probA = const_cast<double*>(reader.section<double>(LVSVM_SECTION_PROBA, count));
+	checkCount(count, nr_pairs, true, "probA");
+
+	model_out.probB = const_cast<double*>(reader.section<double>(LVSVM_SECTION_PROBB, count));
+	checkCount(count, nr_pairs, true, "probB");
+
+	model_out.sv_indices = const_cast<int*>(reader.section<int32_t>(LVSVM_SECTION_SV_INDICES, count));
+	checkCount(count, l, true, "sv_indices");
+
+	// sv_coef ((nr_class-1) x l)
+	const double *coef = reader.section<double>(LVSVM_SECTION_SV_COEF, count);
+	checkCount(count, static_cast<size_t>(nr_class - 1) * l, false, "sv_coef");
+	sv_coef = std::make_unique<double*[]>(nr_class - 1);
+	for (int i = 0; i < nr_class - 1; i++)
+		sv_coef[i] = const_cast<double*>(coef + static_cast<size_t>(i) * l);
+	model_out.sv_coef = sv_coef.get();
+
+	// Support vectors
+	size_t n_offsets = 0, n_nodes = 0;
+	const uint64_t *offsets = reader.section<uint64_t>(LVSVM_SECTION_SV_OFFSETS, n_offsets);
+	const LVsvm_binary_node *bnodes = reader.section<LVsvm_binary_node>(LVSVM_SECTION_SV_NODES, n_nodes);
+	checkCount(n_offsets, static_cast<size_t>(l) + 1, false, "SV offsets");
+
+	if (offsets[0] != 0 || offsets[l] != n_nodes)
+		throw LVException(__FILE__, __LINE__, "Invalid binary model: support vector offsets do not match the node count.");
+
+	for (int i = 0; i < l; i++){
+		if (offsets[i + 1] <= offsets[i])
+			throw LVException(__FILE__, __LINE__, "Invalid binary model: support vector offsets must be increasing.");
+
+		// Rows must be -1 terminated, otherwise the kernel evaluation would read out of bounds
+		if (bparam.kernel_type != PRECOMPUTED && bnodes[offsets[i + 1] - 1].index != -1)
+			throw LVException(__FILE__, __LINE__, "Invalid binary model: support vector #" + std::to_string(i) + " is not terminated by index -1.");
+	}
+
+	const svm_node *base;
+	if (svm_node_is_binary_node){
+		base = reinterpret_cast<const svm_node*>(bnodes);
+	}
+	else {
+		nodes = std::make_unique<svm_node[]>(n_nodes);
+		for (size_t j = 0; j < n_nodes; j++){
+			nodes[j].index = bnodes[j].index;
+			nodes[j].value = bnodes[j].value;
+		}
+		base = nodes.get();
+	}
+
+	SV = std::make_unique<svm_node*[]>(l);
+	for (int i = 0; i < l; i++)
+		SV[i] = const_cast<svm_node*>(base + offsets[i]);
+	model_out.SV = SV.get();
+}
+
+//
+//-- Native model helpers
+//
+
+std::shared_ptr<LVsvm_native_model> LVLoadNativeModel(const char *path_in, bool pack){
+	auto native = std::make_shared<LVsvm_native_model>();
+
+	// Binary models are used directly from the mapping, the pages are shared between processes
+	native->map.open(path_in);
+	if (LVIsBinaryModel(native->map.data(), native->map.size())){
+		LVBinaryReader reader(native->map.data(), native->map.size(), LVBinaryKind::Sparse);
+		LVReadBinaryModel(reader, native->view, native->SV, native->sv_coef, native->nodes);
+		native->scaling = LVReadBinaryScaling(reader);
+	}
+	else{
+		// Text models are parsed into contiguous storage, the mapping is only needed while parsing
+		native->map.adviseSequential();
+		LVReadTextModel(native->map.data(), native->map.size(), native->view, native->text);
+		native->map.close();
+	}
+
+	// Text models are already packed
+	if (pack && native->map.isOpen()){
+		svm_model packed = native->view;
+		std::unique_ptr<svm_node*[]> SV;
+		std::unique_ptr<svm_node[]> nodes;
+		LVPackSupportVectors(native->view, packed, SV, nodes);
+
+		native->view = packed;
+		native->SV = std::move(SV);
+		native->nodes = std::move(nodes);
+	}
+
+	return native;
+}
+
+std::shared_ptr<LVsvm_native_model> LVTrainNativeModel(const LVsvm_problem &prob_in, const LVsvm_parameter &param_in){
+	size_t l = LVCheckProblem(prob_in, "libsvm_train");
+
+	// Input verification: Problem dimensions
+	if (prob_in.y == nullptr || (*(prob_in.y))->dimSize != l)
+		throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and feature vectors (x and y).");
+
+	// Input validation: Number of feature vectors too large (exceeds max signed int)
+	if (l > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Number of feature vectors too large (greater than " + std::to_string(INT_MAX) + ")");
+
+	svm_problem prob;
+	prob.l = static_cast<int>(l);
+	prob.y = (*(prob_in.y))->elt;
+
+	auto x = std::make_unique<svm_node*[]>(l);
+	prob.x = x.get();
+	for (size_t i = 0; i < l; i++)
+		x[i] = reinterpret_cast<svm_node*>((*(*(prob_in.x))->elt[i])->elt);
+
+	svm_parameter param;
+	LVConvertParameter(param_in, param);
+
+	return LVTrainNativeModel(prob, param);
+}
+
+std::shared_ptr<LVsvm_native_model> LVTrainNativeModel(const svm_problem &prob, const svm_parameter &param){
+	const char * param_check = svm_check_parameter(&prob, &param);
+	if (param_check != nullptr)
+		throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check));
+
+	auto native = std::make_shared<LVsvm_native_model>();
+	native->trained.reset(svm_train(&prob, &param));
+
+	// The weights reference the parameters and the support vectors the problem, neither outlives this call
+	native->trained->param.nr_weight = 0;
+	native->trained->param.weight_label = nullptr;
+	native->trained->param.weight = nullptr;
+
+	native->view = *native->trained;
+	LVPackSupportVectors(*native->trained, native->view, native->SV, native->nodes);
+
+	return native;
+}
+
+LVsvm_job::LVsvm_job(const LVsvm_problem &prob_in, const LVsvm_parameter &param_in, int32_t nr_fold) : nr_fold(nr_fold), prob(), param(){
+	size_t l = LVCheckProblem(prob_in, (nr_fold == 0) ? "libsvm_train_async" : "libsvm_cross_validation_async");
+
+	// Input verification: Problem dimensions
+	if (prob_in.y == nullptr || (*(prob_in.y))->dimSize != l)
+		throw LVException(__FILE__, __LINE__, "The problem must have an equal number of labels and feature vectors (x and y).");
+
+	// Input validation: Number of feature vectors too large (exceeds max signed int)
+	if (l > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Number of feature vectors too large (greater than " + std::to_string(INT_MAX) + ")");
+
+	y.assign((*(prob_in.y))->elt, (*(prob_in.y))->elt + l);
+
+	// The vectors (including their terminators) are copied into a single block
+	size_t n_nodes = 0;
+	for (size_t i = 0; i < l; i++)
+		n_nodes += (*(*(prob_in.x))->elt[i])->dimSize;
+
+	nodes.resize(n_nodes);
+	x.resize(l);
+	svm_node *next = nodes.data();
+	for (size_t i = 0; i < l; i++){
+		auto xi_in_Hdl = (*(prob_in.x))->elt[i];
+		const svm_node *xi = reinterpret_cast<const svm_node*>((*xi_in_Hdl)->elt);
+		x[i] = next;
+		next = std::copy(xi, xi + (*xi_in_Hdl)->dimSize, next);
+	}
+
+	prob.l = static_cast<int>(l);
+	prob.y = y.data();
+	prob.x = x.data();
+
+	LVConvertParameter(param_in, param);
+	if (param.nr_weight > 0){
+		weight_label.assign(param.weight_label, param.weight_label + param.nr_weight);
+		weight.assign(param.weight, param.weight + param.nr_weight);
+		param.weight_label = weight_label.data();
+		param.weight = weight.data();
+	}
+
+	const char * param_check = svm_check_parameter(&prob, &param);
+	if (param_check != nullptr)
+		throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check));
+}
+
+void LVsvm_job::run(){
+	// The print function counts the iterations of the library solvers into the budgets (the job runs under the stop condition of its token)
+	LVInstallPrintFunction(svm_set_print_string_function, LVsvm_print_function);
+
+	if (nr_fold == 0){
+		model = LVTrainNativeModel(prob, param);
+	}
+	else{
+		target.resize(y.size());
+		LVCrossValidate(prob, param, nr_fold, target.data());
+	}
+}
+
+std::shared_ptr<LVsvm_job> LVCollectJob(uint64_t job, bool crossValidation){
+	auto collected = std::dynamic_pointer_cast<LVsvm_job>(LVJobQueue::instance().get(job));
+	if (!collected || (collected->nr_fold != 0) != crossValidation)
+		throw LVException(__FILE__, __LINE__, std::string("The job is not a ") + (crossValidation ? "cross-validation" : "training") + " job.");
+
+	// The job is released whether it succeeded or not
+	LVJobQueue::instance().release(job);
+	collected->join();
+	return collected;
+}
+
+std::shared_ptr<const LVCancellationToken> LVGetCancellationToken(uint64_t token){
+	if (token == 0)
+		return nullptr;
+
+	return tokenHandles.get(token);
+}
+
+void LVCrossValidate(const svm_problem &prob, const svm_parameter &param, int nr_fold, double *target){
+	// The library's cross-validation cannot be stopped between its folds
+	if (LVStopCondition::current() == nullptr){
+		svm_cross_validation(&prob, &param, nr_fold, target);
+		return;
+	}
+
+	if (nr_fold < 2)
+		throw LVException(__FILE__, __LINE__, "The number of folds must be at least 2.");
+
+	bool classification = param.svm_type == C_SVC || param.svm_type == NU_SVC;
+	bool probability = classification && param.probability != 0;
+
+	// Stratified as svm_cross_validation
+	size_t l = static_cast<size_t>(prob.l);
+	LVFolds folds = LVMakeFolds(prob.y, l, static_cast<size_t>(nr_fold), classification);
+
+	// One pool task per fold, the checkpoints of the tasks stop the run between folds.
+	// At most half the folds run at once, so that every thread tests the stop condition between two of its folds
+	size_t max_threads = std::max<size_t>(1, folds.count() / 2);
+	LVThreadPool::instance().parallelFor(folds.count(), [&](size_t f){
+		size_t begin = folds.start[f];
+		size_t end = folds.start[f + 1];
+
+		// Training problem of the other folds, referencing the input vectors
+		std::vector<svm_node*> sub_x;
+		std::vector<double> sub_y;
+		for (size_t k = 0; k < l; k++){
+			if (k < begin || k >= end){
+				sub_x.push_back(prob.x[folds.perm[k]]);
+				sub_y.push_back(prob.y[folds.perm[k]]);
+			}
+		}
+
+		svm_problem sub_prob;
+		sub_prob.l = static_cast<int>(sub_y.size());
+		sub_prob.x = sub_x.data();
+		sub_prob.y = sub_y.data();
+
+		std::unique_ptr<svm_model, LVsvm_model_deleter> submodel(svm_train(&sub_prob, &param));
+
+		std::vector<double> prob_estimates(static_cast<size_t>(submodel->nr_class));
+		for (size_t k = begin; k < end; k++)
+			target[folds.perm[k]] = probability ? svm_predict_probability(submodel.get(), prob.x[folds.perm[k]], prob_estimates.data()) : svm_predict(submodel.get(), prob.x[folds.perm[k]]);
+	}, LVWorkPriority::Throughput, max_threads);
+
+	// The last folds may have exceeded the budgets
+	LVCheckpoint();
+}
+
+size_t LVGridSearch(const svm_problem &prob, const svm_parameter &param, int nr_fold, const std::vector<double> &C, const std::vector<double> &gamma, std::shared_ptr<const LVCancellationToken> token, std::vector<double> &score_out, std::unique_ptr<LVStopped> &stopped_out){
+	if (nr_fold < 2)
+		throw LVException(__FILE__, __LINE__, "The number of folds must be at least 2.");
+
+	// Grid points C by C, every one is verified before the search starts
+	std::vector<LVGridPoint> points;
+	for (double point_C : C){
+		for (double point_gamma : gamma){
+			svm_parameter point_param = param;
+			point_param.C = point_C;
+			point_param.gamma = point_gamma;
+
+			const char * param_check = svm_check_parameter(&prob, &point_param);
+			if (param_check != nullptr)
+				throw LVException(__FILE__, __LINE__, "Parameter check failed with the following error: " + std::string(param_check) + " (C = " + std::to_string(point_C) + ", gamma = " + std::to_string(point_gamma) + ")");
+
+			points.push_back(LVGridPoint{ point_C, point_gamma });
+		}
+	}
+
+	bool classification = param.svm_type == C_SVC || param.svm_type == NU_SVC;
+	bool regression = param.svm_type == EPSILON_SVR || param.svm_type == NU_SVR;
+	bool probability = classification && param.probability != 0;
+
+	// The same folds for every grid point, stratified as svm_cross_validation
+	size_t l = static_cast<size_t>(prob.l);
+	LVFolds folds = LVMakeFolds(prob.y, l, static_cast<size_t>(nr_fold), classification);
+
+	score_out = LVCrossValidateGrid(points, folds, token, [&](size_t point, size_t f){
+		size_t begin = folds.start[f];
+		size_t end = folds.start[f + 1];
+
+		// Training problem of the other folds, referencing the input vectors
+		std::vector<svm_node*> sub_x;
+		std::vector<double> sub_y;
+		for (size_t k = 0; k < l; k++){
+			if (k < begin || k >= end){
+				sub_x.push_back(prob.x[folds.perm[k]]);
+				sub_y.push_back(prob.y[folds.perm[k]]);
+			}
+		}
+
+		svm_problem sub_prob;
+		sub_prob.l = static_cast<int>(sub_y.size());
+		sub_prob.x = sub_x.data();
+		sub_prob.y = sub_y.data();
+
+		svm_parameter point_param = param;
+		point_param.C = points[point].C;
+		point_param.gamma = points[point].gamma;
+
+		std::unique_ptr<svm_model, LVsvm_model_deleter> submodel(svm_train(&sub_prob, &point_param));
+
+		// Correct predictions (classification) or squared errors (regression) of the fold, predicted as svm_cross_validation
+		std::vector<double> prob_estimates(static_cast<size_t>(submodel->nr_class));
+		double sum = 0;
+		for (size_t k = begin; k < end; k++){
+			double y = prob.y[folds.perm[k]];
+			double predicted = probability ? svm_predict_probability(submodel.get(), prob.x[folds.perm[k]], prob_estimates.data()) : svm_predict(submodel.get(), prob.x[folds.perm[k]]);
+			if (regression)
+				sum += (predicted - y) * (predicted - y);
+			else if (predicted == y)
+				sum++;
+		}
+		return sum;
+	}, stopped_out);
+
+	return LVBestGridPoint(score_out, regression);
+}
+
+void LVPackSupportVectors(const svm_model &model_in, svm_model &model_out, std::unique_ptr<svm_node*[]> &SV, std::unique_ptr<svm_node[]> &nodes){
+	int l = model_in.l;
+	if (l <= 0 || model_in.SV == nullptr)
+		throw LVException(__FILE__, __LINE__, "Uninitialized model passed to LVPackSupportVectors.");
+
+	// Count the nodes (including the -1 terminator, precomputed kernels use a single node)
+	auto n_nodes = std::make_unique<size_t[]>(l);
+	size_t total = 0;
+	for (int i = 0; i < l; i++){
+		size_t n = 1;
+		if (model_in.param.kernel_type != PRECOMPUTED){
+			for (const svm_node *p = model_in.SV[i]; p->index != -1; p++)
+				n++;
+		}
+		n_nodes[i] = n;
+		total += n;
+	}
+
+	// Copy into a single block in support vector order
+	nodes = std::make_unique<svm_node[]>(total);
+	SV = std::make_unique<svm_node*[]>(l);
+	svm_node *dst = nodes.get();
+	for (int i = 0; i < l; i++){
+		std::memcpy(dst, model_in.SV[i], n_nodes[i] * sizeof(svm_node));
+		SV[i] = dst;
+		dst += n_nodes[i];
+	}
+
+	model_out.SV = SV.get();
+}
+
+//
+//-- Text model helpers
+//
+
+// Keywords of the libsvm text format (indexed by svm_type/kernel_type)
+static const char *LVsvm_type_table[] = { "c_svc", "nu_svc", "one_class", "epsilon_svr", "nu_svr", nullptr };
+static const char *LVsvm_kernel_type_table[] = { "linear", "polynomial", "rbf", "sigmoid", "precomputed", nullptr };
+
+std::vector<std::string> LVFormatTextModel(const svm_model &model_in, bool roundTrip){
+	const svm_parameter &param = model_in.param;
+	int nr_class = model_in.nr_class;
+	int nr_pairs = nr_class*(nr_class - 1) / 2;
+	int l = model_in.l;
+
+	if (param.svm_type < C_SVC || param.svm_type > NU_SVR || param.kernel_type < LINEAR || param.kernel_type > PRECOMPUTED)
+		throw LVException(__FILE__, __LINE__, "The model has an invalid svm_type or kernel_type.");
+
+	if (nr_class < 1 || l < 0 || (nr_pairs > 0 && model_in.rho == nullptr) || (l > 0 && (model_in.SV == nullptr || (nr_class > 1 && model_in.sv_coef == nullptr))))
+		throw LVException(__FILE__, __LINE__, "Uninitialized model passed to LVFormatTextModel.");
+
+	std::vector<std::string> parts;
+
+	// Header (the formats match svm_save_model in libsvm 3.22)
+	LVTextWriter header;
+	header.put("svm_type ");
+	header.put(LVsvm_type_table[param.svm_type]);
+	header.put("\nkernel_type ");
+	header.put(LVsvm_kernel_type_table[param.kernel_type]);
+	header.put('\n');
+
+	if (param.kernel_type == POLY){
+		header.put("degree ");
+		header.putInt(param.degree);
+		header.put('\n');
+	}
+
+	if (param.kernel_type == POLY || param.kernel_type == RBF || param.kernel_type == SIGMOID){
+		header.put("gamma ");
+		header.putDouble(param.gamma, 6, roundTrip);
+		header.put('\n');
+	}
+
+	if (param.kernel_type == POLY || param.kernel_type == SIGMOID){
+		header.put("coef0 ");
+		header.putDouble(param.coef0, 6, roundTrip);
+		header.put('\n');
+	}
+
+	header.put("nr_class ");
+	header.putInt(nr_class);
+	header.put("\ntotal_sv ");
+	header.putInt(l);
+	header.put("\nrho");
+	for (int i = 0; i < nr_pairs; i++){
+		header.put(' ');
+		header.putDouble(model_in.rho[i], 6, roundTrip);
+	}
+	header.put('\n');
+
+	if (model_in.label != nullptr){
+		header.put("label");
+		for (int i = 0; i < nr_class; i++){
+			header.put(' ');
+			header.putInt(model_in.label[i]);
+		}
+		header.put('\n');
+	}
+
+	if (model_in.probA != nullptr){
+		header.put("probA");
+		for (int i = 0; i < nr_pairs; i++){
+			header.put(' ');
+			header.putDouble(model_in.probA[i], 6, roundTrip);
+		}
+		header.put('\n');
+	}
+
+	if (model_in.probB != nullptr){
+		header.put("probB");
+		for (int i = 0; i < nr_pairs; i++){
+			header.put(' ');
+			header.putDouble(model_in.probB[i], 6, roundTrip);
+		}
+		header.put('\n');
+	}
+
+	if (model_in.nSV != nullptr){
+		header.put("nr_sv");
+		for (int i = 0; i < nr_class; i++){
+			header.put(' ');
+			header.putInt(model_in.nSV[i]);
+		}
+		header.put('\n');
+	}
+
+	header.put("SV\n");
+	parts.push_back(std::move(header.str()));
+
+	// Support vectors, each thread formats a contiguous range of rows into its own part
+	size_t nThreads = LVThreadCount(l, 256);
+	size_t firstPart = parts.size();
+	parts.resize(firstPart + nThreads);
+
+	LVParallelFor(nThreads, [&](size_t t){
+		size_t begin = static_cast<size_t>(l) * t / nThreads;
+		size_t end = static_cast<size_t>(l) * (t + 1) / nThreads;
+
+		LVTextWriter writer;
+		for (size_t i = begin; i < end; i++){
+			for (int j = 0; j < nr_class - 1; j++){
+				writer.putDouble(model_in.sv_coef[j][i], 16, roundTrip);
+				writer.put(' ');
+			}
+
+			const svm_node *p = model_in.SV[i];
+			if (param.kernel_type == PRECOMPUTED){
+				writer.put("0:");
+				writer.putInt(static_cast<int>(p->value));
+				writer.put(' ');
+			}
+			else{
+				while (p->index != -1){
+					writer.putInt(p->index);
+					writer.put(':');
+					writer.putDouble(p->value, 8, roundTrip);
+					writer.put(' ');
+					p++;
+				}
+			}
+			writer.put('\n');
+		}
+
+		parts[firstPart + t] = std::move(writer.str());
+	});
+
+	return parts;
+}
+
+// Returns the index of word in a null-terminated table, or -1
+static int LVFindKeyword(const char *table[], const std::string &word){
+	for (int i = 0; table[i] != nullptr; i++){
+		if (word == table[i])
+			return i;
+	}
+	return -1;
+}
+
+void LVReadTextModel(const char *data, size_t size, svm_model &model_out, LVsvm_text_storage &storage){
+	const char *end = data + size;
+	LVTextCursor cursor(data, end);
+
+	model_out = svm_model();
+	storage = LVsvm_text_storage();
+	svm_parameter &param = model_out.param;
+
+	int nr_class = 0;
+	int l = -1;
+	bool sv_section = false;
+
+	auto requireClasses = [&](const std::string &key){
+		if (nr_class < 1)
+			cursor.fail("nr_class must precede " + key);
+	};
+
+	auto readDoubles = [&](std::vector<double> &values, int n){
+		values.resize(n);
+		for (int i = 0; i < n; i++)
+			values[i] = cursor.readDouble();
+	};
+
+	auto readInts = [&](std::vector<int> &values, int n){
+		values.resize(n);
+		for (int i = 0; i < n; i++)
+			values[i] = cursor.readInt();
+	};
+
+	// Header (same keywords as svm_load_model)
+	while (cursor.skipEmptyLines()){
+		std::string key = cursor.readWord();
+
+		if (key == "svm_type"){
+			std::string value = cursor.readWord();
+			param.svm_type = LVFindKeyword(LVsvm_type_table, value);
+			if (param.svm_type < 0)
+				cursor.fail("unknown svm type '" + value + "'");
+		}
+		else if (key == "kernel_type"){
+			std::string value = cursor.readWord();
+			param.kernel_type = LVFindKeyword(LVsvm_kernel_type_table, value);
+			if (param.kernel_type < 0)
+				cursor.fail("unknown kernel function '" + value + "'");
+		}
+		else if (key == "degree"){
+			param.degree = cursor.readInt();
+		}
+		else if (key == "gamma"){
+			param.gamma = cursor.readDouble();
+		}
+		else if (key == "coef0"){
+			param.coef0 = cursor.readDouble();
+		}
+		else if (key == "nr_class"){
+			nr_class = cursor.readInt();
+			if (nr_class < 1)
+				cursor.fail("nr_class must be positive");
+		}
+		else if (key == "total_sv"){
+			l = cursor.readInt();
+			if (l < 0)
+				cursor.fail("total_sv must be non-negative");
+		}
+		else if (key == "rho"){
+			requireClasses(key);
+			readDoubles(storage.rho, nr_class*(nr_class - 1) / 2);
+		}
+		else if (key == "label"){
+			requireClasses(key);
+			readInts(storage.label, nr_class);
+		}
+		else if (key == "probA"){
+			requireClasses(key);
+			readDoubles(storage.probA, nr_class*(nr_class - 1) / 2);
+		}
+		else if (key == "probB"){
+			requireClasses(key);
+			readDoubles(storage.probB, nr_class*(nr_class - 1) / 2);
+		}
+		else if (key == "nr_sv"){
+			requireClasses(key);
+			readInts(storage.nSV, nr_class);
+		}
+		else if (key == "SV"){
+			cursor.nextLine();
+			sv_section = true;
+			break;
+		}
+		else{
+			cursor.fail("unknown text in model file '" + key + "'");
+		}
+
+		if (!cursor.atEndOfLine())
+			cursor.fail("unexpected text after " + key);
+		cursor.nextLine();
+	}
+
+	if (!sv_section || nr_class < 1 || l < 0)
+		throw LVException(__FILE__, __LINE__, "Invalid model file: nr_class, total_sv or the SV section is missing.");
+
+	if (static_cast<int>(storage.rho.size()) != nr_class*(nr_class - 1) / 2)
+		throw LVException(__FILE__, __LINE__, "Invalid model file: rho is missing.");
+
+	// Support vectors
+	// First pass counts rows and nodes of each chunk, so that the second pass can parse directly into the final arrays
+	const char *body = cursor.position();
+	size_t bodyLine = cursor.line();
+	int nr_coef = nr_class - 1;
+
+	std::vector<const char*> bounds = LVSplitLines(body, end, LVThreadCount(static_cast<size_t>(end - body), 1 << 18));
+	size_t nChunks = bounds.size() - 1;
+
+	std::vector<size_t> rowOffset(nChunks + 1, 0);
+	std::vector<size_t> nodeOffset(nChunks + 1, 0);
+	std::vector<size_t> lineOffset(nChunks + 1, 0);
+
+	LVParallelFor(nChunks, [&](size_t c){
+		rowOffset[c + 1] = LVCountNonEmptyLines(bounds[c], bounds[c + 1]);
+		nodeOffset[c + 1] = static_cast<size_t>(std::count(bounds[c], bounds[c + 1], ':'));
+		lineOffset[c + 1] = LVCountLineBreaks(bounds[c], bounds[c + 1]);
+	});
+
+	for (size_t c = 0; c < nChunks; c++){
+		rowOffset[c + 1] += rowOffset[c];
+		nodeOffset[c + 1] += nodeOffset[c];
+		lineOffset[c + 1] += lineOffset[c];
+	}
+
+	if (rowOffset[nChunks] != static_cast<size_t>(l))
+		throw LVException(__FILE__, __LINE__, "Invalid model file: total_sv is " + std::to_string(l) + ", but the SV section contains " + std::to_string(rowOffset[nChunks]) + " support vectors.");
+
+	// Every node contains one ':', and every row is terminated by an index of -1
+	storage.coef.resize(static_cast<size_t>(nr_coef) * l);
+	storage.SV.resize(l);
+	storage.nodes.resize(nodeOffset[nChunks] + l);
+
+	LVParallelFor(nChunks, [&](size_t c){
+		LVTextCursor chunk(bounds[c], bounds[c + 1], bodyLine + lineOffset[c]);
+		size_t row = rowOffset[c];
+		svm_node *node = storage.nodes.data() + nodeOffset[c] + rowOffset[c];
+
+		while (chunk.skipEmptyLines()){
+			storage.SV[row] = node;
+			for (int j = 0; j < nr_coef; j++)
+				storage.coef[j * static_cast<size_t>(l) + row] = chunk.readDouble();
+
+			while (!chunk.atEndOfLine()){
+				node->index = chunk.readInt();
+				chunk.expect(':');
+				node->value = chunk.readDouble();
+				node++;
+			}
+
+			node->index = -1;
+			node->value = 0;
+			node++;
+			row++;
+
+			chunk.nextLine();
+		}
+	});
+
+	storage.sv_coef.resize(nr_coef);
+	for (int j = 0; j < nr_coef; j++)
+		storage.sv_coef[j] = storage.coef.data() + j * static_cast<size_t>(l);
+
+	// Assign the model
+	model_out.nr_class = nr_class;
+	model_out.l = l;
+	model_out.SV = (l > 0) ? storage.SV.data() : nullptr;
+	model_out.sv_coef = (nr_coef > 0) ? storage.sv_coef.data() : nullptr;
+	model_out.rho = storage.rho.empty() ? nullptr : storage.rho.data();
+	model_out.probA = storage.probA.empty() ? nullptr : storage.probA.data();
+	model_out.probB = storage.probB.empty() ? nullptr : storage.probB.data();
+	model_out.label = storage.label.empty() ? nullptr : storage.label.data();
+	model_out.nSV = storage.nSV.empty() ? nullptr : storage.nSV.data();
+	model_out.sv_indices = nullptr;
+	model_out.free_sv = 0;
+
+	// Only the kernel parameters are stored in the file, the LabVIEW model needs the probability flag to return probA/probB
+	param.probability = (model_out.probA != nullptr);
+}
+
+//
+//-- Data file helpers
+//
+
+void LVConvertDataset(const LVDataset &dataset_in, LVsvm_problem &prob_out){
+	size_t l = dataset_in.rows();
+
+	LVCopyToArrayHandle(prob_out.y, dataset_in.y);
+
+	// Handles are allocated on the calling thread, the nodes are copied in parallel
+	LVResizeHandleArrayHandle(prob_out.x, l);
+	for (size_t i = 0; i < l; i++){
+		size_t n_nodes = dataset_in.nodes(i) + 1;
+		LVResizeCompositeArrayHandle((*prob_out.x)->elt[i], n_nodes);
+		(*(*prob_out.x)->elt[i])->dimSize = static_cast<uint32_t>(n_nodes);
+	}
+	(*prob_out.x)->dimSize = static_cast<uint32_t>(l);
+
+	LVArray_Hdl<LVsvm_node> *x = (*prob_out.x)->elt;
+	size_t nThreads = LVThreadCount(dataset_in.nodes(), 1 << 16);
+
+	LVParallelFor(nThreads, [&](size_t t){
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++){
+			LVsvm_node *node = (*x[i])->elt;
+			for (size_t k = dataset_in.rowStart[i]; k < dataset_in.rowStart[i + 1]; k++, node++){
+				node->index = dataset_in.index[k];
+				node->value = dataset_in.value[k];
+			}
+
+			node->index = -1;
+			node->value = 0;
+		}
+	});
+}
+
+void LVConvertDataset(const LVDataset &dataset_in, LVsvm_csr_problem &prob_out){
+	size_t l = dataset_in.rows();
+	size_t nnz = dataset_in.nodes();
+
+	// Row pointers are int32 in LabVIEW
+	if (nnz > INT_MAX)
+		throw LVException(__FILE__, __LINE__, "Number of nodes too large for the CSR layout (greater than " + std::to_string(INT_MAX) + ").");
+
+	LVCopyToArrayHandle(prob_out.y, dataset_in.y);
+	LVCopyToArrayHandle(prob_out.index, dataset_in.index);
+	LVCopyToArrayHandle(prob_out.value, dataset_in.value);
+
+	LVResizeNumericArrayHandle(prob_out.row_ptr, l + 1);
+	int32_t *row_ptr = (*prob_out.row_ptr)->elt;
+	for (size_t i = 0; i <= l; i++)
+		row_ptr[i] = static_cast<int32_t>(dataset_in.rowStart[i]);
+	(*prob_out.row_ptr)->dimSize = static_cast<uint32_t>(l + 1);
+}
+
+//
+//-- Scaling helpers
+//
+
+size_t LVCheckProblem(const LVsvm_problem &prob_in, const char *caller){
+	if (prob_in.x == nullptr || (*(prob_in.x))->dimSize == 0)
+		throw LVException(__FILE__, __LINE__, std::string("Empty problem passed to ") + caller + ".");
+
+	size_t l = (*(prob_in.x))->dimSize;
+	for (size_t i = 0; i < l; i++){
+		auto xi_in_Hdl = (*(prob_in.x))->elt[i];
+		// Input validation: Final index -1?
+		if (xi_in_Hdl == nullptr || (*xi_in_Hdl)->dimSize == 0 || (*xi_in_Hdl)->elt[(*xi_in_Hdl)->dimSize - 1].index != -1)
+			throw LVException(__FILE__, __LINE__, std::string("The index of the last element of each feature vector needs to be -1 (") + caller + ").");
+	}
+
+	return l;
+}
+
+LVScaling LVComputeProblemScaling(const LVsvm_problem &prob_in, LVScalingMethod method, double lower, double upper){
+	size_t l = LVCheckProblem(prob_in, "LVsvm_compute_scaling");
+	LVArray_Hdl<LVsvm_node> *x = (*prob_in.x)->elt;
+
+	// The largest index determines the number of features
+	size_t nThreads = LVThreadCount(l, 1024);
+	std::vector<int32_t> maxIndex(nThreads, 0);
+	LVParallelFor(nThreads, [&](size_t t){
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++){
+			for (const LVsvm_node *node = (*x[i])->elt; node->index != -1; node++)
+				maxIndex[t] = std::max(maxIndex[t], node->index);
+		}
+	});
+	size_t nFeatures = static_cast<size_t>(*std::max_element(maxIndex.begin(), maxIndex.end())) + 1;
+
+	// Index 0 is the serial number of precomputed kernels
+	return LVComputeScaling(l, nFeatures, 1, method, lower, upper, [&](size_t i, LVFeatureStatistics &statistics){
+		for (const LVsvm_node *node = (*x[i])->elt; node->index != -1; node++)
+			statistics.add(node->index, node->value);
+	});
+}
+
+void LVScaleProblem(const LVScaling &scaling, LVsvm_problem &prob_inout){
+	size_t l = LVCheckProblem(prob_inout, "LVsvm_scale_problem");
+	LVArray_Hdl<LVsvm_node> *x = (*prob_inout.x)->elt;
+
+	// Features with a nonzero shift are inserted where missing, so vectors can only grow
+	std::vector<size_t> size(l);
+	size_t nThreads = LVThreadCount(l, 1024);
+	LVParallelFor(nThreads, [&](size_t t){
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++)
+			size[i] = scaling.scaledSize((*x[i])->elt) + 1;
+	});
+
+	// Handles are resized on the calling thread (the stored nodes are preserved), the nodes are scaled in parallel
+	for (size_t i = 0; i < l; i++){
+		if (size[i] != (*x[i])->dimSize)
+			LVResizeCompositeArrayHandle(x[i], size[i]);
+	}
+
+	LVParallelFor(nThreads, [&](size_t t){
+		std::vector<LVsvm_node> original;
+		for (size_t i = l * t / nThreads; i < l * (t + 1) / nThreads; i++){
+			LVsvm_node *xi = (*x[i])->elt;
+			size_t n = (*x[i])->dimSize;
+			if (size[i] == n){
+				// Same nodes, scaled in place
+				for (LVsvm_node *node = xi; node->index != -1; node++)
+					node->value = scaling.apply(node->index, node->value);
+			}
+			else{
+				original.assign(xi, xi + n);
+				scaling.applySparse(original.data(), xi);
+				(*x[i])->dimSize = static_cast<uint32_t>(size[i]);
+			}
+		}
+	});
+}
+
+std::shared_ptr<const LVScaling> LVConvertScaling(const LVArray_Hdl<double> scale_in, const LVArray_Hdl<double> shift_in){
+	size_t n_scale = (scale_in != nullptr) ? (*scale_in)->dimSize : 0;
+	size_t n_shift = (shift_in != nullptr) ? (*shift_in)->dimSize : 0;
+	if (n_scale == 0 && n_shift == 0)
+		return nullptr;
+
+	if (n_scale != n_shift)
+		throw LVException(__FILE__, __LINE__, "The scale and shift arrays of the scaling must have the same length.");
+
+	const double *scale = (*scale_in)->elt;
+	const double *shift = (*shift_in)->elt;
+	return std::make_shared<const LVScaling>(std::vector<double>(scale, scale + n_scale), std::vector<double>(shift, shift + n_shift));
+}
+
+const svm_node * LVScaleInput(const LVsvm_native_model &native, const svm_node *x, std::vector<svm_node> &buffer){
+	std::shared_ptr<const LVScaling> scaling = std::atomic_load(&native.scaling);
+	if (!scaling)
+		return x;
+
+	buffer.resize(scaling->scaledSize(x) + 1);
+	scaling->applySparse(x, buffer.data());
+	return buffer.data();
+}
+
+//
+//-- Engine selection helpers
+//
+
+LVProblemProfile LVProfileProblem(const LVsvm_problem &prob_in, int32_t kernel_type){
+	LVCheckProblemSize(prob_in.y, prob_in.x);
+
+	// The vectors of precomputed kernels are kernel values (index 0 is the serial number), only the size is meaningful
+	if (kernel_type == PRECOMPUTED){
+		LVProblemProfile profile = LVProblemProfile();
+		profile.l = LVCheckProblem(prob_in, "LVsvm_analyze_problem");
+		return profile;
+	}
+
+	return LVProfileSparse(prob_in.x, false);
+}
+
+std::shared_ptr<LVSharedLibrary> LVLoadEngineLibrary(const char *baseName){
+	// A library stays loaded while a model trained by it exists, later calls share it
+	static std::mutex mutex;
+	static std::map<std::string, std::weak_ptr<LVSharedLibrary>> libraries;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	std::shared_ptr<LVSharedLibrary> library = libraries[baseName].lock();
+	if (!library){
+		library = std::make_shared<LVSharedLibrary>(baseName);
+		libraries[baseName] = library;
+	}
+
+	return library;
+}
+
+LVsvm_linear_parameter LVConvertLinearParameter(const LVsvm_parameter &param_in){
+	if (param_in.kernel_type != LINEAR)
+		throw LVException(__FILE__, __LINE__, "liblinear can only train linear kernels (LVsvm_train_auto).");
+
+	// Dual solvers of the L1-loss (hinge) problems, i.e. the same problems libsvm solves (solver_type values of liblinear)
+	LVsvm_linear_parameter param_out;
+	if (param_in.svm_type == C_SVC)
+		param_out.solver_type = 3;	// L2R_L1LOSS_SVC_DUAL
+	else if (param_in.svm_type == EPSILON_SVR)
+		param_out.solver_type = 13;	// L2R_L1LOSS_SVR_DUAL
+	else
+		throw LVException(__FILE__, __LINE__, "liblinear can only train C_SVC and EPSILON_SVR (LVsvm_train_auto).");
+
+	param_out.eps = param_in.eps;
+	param_out.C = param_in.C;
+	param_out.weight_label = param_in.weight_label;
+	param_out.weight = param_in.weight;
+	param_out.p = param_in.p;
+
+	return param_out;
+}
+
+LVsvm_auto_model::~LVsvm_auto_model(){
+	// The model handle of the other library is released before the library itself (errors are ignored)
+	if (handle != 0 && free_handle != nullptr){
+		lvError err;
+		free_handle(&err, handle);
+		if (err.source != nullptr && DSCheckHandle(err.source) == noErr)
+			DSDisposeHandle(err.source);
+	}
+}